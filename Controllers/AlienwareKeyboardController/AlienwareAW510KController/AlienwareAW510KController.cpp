@@ -68,12 +68,13 @@ void AlienwareAW510KController::SendCommit()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 20 milliseconds                                 |
+    | Wait 20 milliseconds before the next packet           |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pacer.ReportSent(std::chrono::milliseconds(20));
 }
 
 void AlienwareAW510KController::SendfeatureReport
@@ -103,12 +104,13 @@ void AlienwareAW510KController::SendfeatureReport
     /*-----------------------------------------------------*\
     | Send Feature report packet                            |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 10 milliseconds                                 |
+    | Wait 10 milliseconds before the next packet           |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pacer.ReportSent(std::chrono::milliseconds(10));
 }
 
 void AlienwareAW510KController::SendEdit()
@@ -131,12 +133,13 @@ void AlienwareAW510KController::SendEdit()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 2 milliseconds                                  |
+    | Wait 2 milliseconds before the next packet            |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    pacer.ReportSent(std::chrono::milliseconds(2));
 }
 
 void AlienwareAW510KController::SendInitialize()
@@ -166,12 +169,13 @@ void AlienwareAW510KController::SendInitialize()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 2 milliseconds                                  |
+    | Wait 2 milliseconds before the next packet            |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    pacer.ReportSent(std::chrono::milliseconds(2));
 }
 
 void AlienwareAW510KController::SetDirect
@@ -207,12 +211,13 @@ void AlienwareAW510KController::SetDirect
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, (unsigned char *)usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 2 milliseconds                                  |
+    | Wait 2 milliseconds before the next packet            |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    pacer.ReportSent(std::chrono::milliseconds(2));
 }
 
 void AlienwareAW510KController::SendDirectOn
@@ -292,7 +297,9 @@ void AlienwareAW510KController::SendDirectOn
         usb_buf[0x3A]           = frame_data[packet_idx].blue;
         usb_buf[0x3F]           = 0x01;
 
+        pacer.WaitForReport();
         hid_write(dev, (unsigned char *)usb_buf, 65);
+        pacer.ReportSent();
     }
 }
 
@@ -352,12 +359,13 @@ void AlienwareAW510KController::UpdateSingleLED
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
 
     /*-----------------------------------------------------*\
-    | Delay 20 milliseconds                                 |
+    | Wait 20 milliseconds before the next packet           |
     \*-----------------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pacer.ReportSent(std::chrono::milliseconds(20));
 
 }
 void AlienwareAW510KController::SendMode
@@ -398,7 +406,9 @@ void AlienwareAW510KController::SendMode
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
+    pacer.ReportSent();
 }
 
 void AlienwareAW510KController::SetMorphMode
@@ -442,5 +452,7 @@ void AlienwareAW510KController::SetMorphMode
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, 65);
+    pacer.ReportSent();
 }
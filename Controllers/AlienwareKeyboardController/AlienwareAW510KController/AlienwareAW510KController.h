@@ -13,6 +13,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "HIDReportPacer.h"
 #include "RGBController.h"
 
 enum
@@ -142,6 +143,7 @@ public:
 private:
     hid_device*             dev;
     std::string             location;
+    HIDReportPacer          pacer;
 
     void        SendMode
                     (
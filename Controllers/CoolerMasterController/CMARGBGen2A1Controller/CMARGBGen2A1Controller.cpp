@@ -58,9 +58,9 @@ void CMARGBGen2A1controller::SaveToFlash()
     usb_buf[2] = CM_ARGB_GEN2_A1_FLASH;
     usb_buf[3] = CM_ARGB_GEN2_A1_WRITE;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 }
 
 void CMARGBGen2A1controller::SetupDirectMode()
@@ -84,9 +84,9 @@ void CMARGBGen2A1controller::SetupDirectMode()
     usb_buf[10] = 0xFF; // G
     usb_buf[11] = 0xFF; // B
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
 
     std::vector<RGBColor> colorOffChain;
     colorOffChain.push_back(0);
@@ -162,9 +162,9 @@ void CMARGBGen2A1controller::SetupZoneSize(unsigned int zone_id, unsigned int si
     usb_buf[5] = speed;
     usb_buf[6] = size;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 
     /*---------------------------------------------*\
     | Refresh direct mode to cycle the strips       |
@@ -220,6 +220,7 @@ void CMARGBGen2A1controller::SendChannelColors(unsigned int zone_id, unsigned in
             usb_buf[1] = p + 0x80;
         }
 
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
 
         /*-----------------------------------------------*\
@@ -229,13 +230,13 @@ void CMARGBGen2A1controller::SendChannelColors(unsigned int zone_id, unsigned in
         | still latching its input buffer.                |
         | Reducing this may start to introduce artifacts  |
         \*-----------------------------------------------*/
-        std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_MEDIUM));
+        pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_MEDIUM));
     }
 
     /*---------------------------------------------*\
     | Next channel needs some delay as well         |
     \*---------------------------------------------*/
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
+    pacer.Delay(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
 }
 
 void CMARGBGen2A1controller::SetMode(unsigned int mode_value, unsigned char speed, unsigned char brightness, RGBColor color, bool random)
@@ -253,11 +254,11 @@ void CMARGBGen2A1controller::SetMode(unsigned int mode_value, unsigned char spee
         usb_buf[2] = CM_ARGB_GEN2_A1_LIGHTNING_CONTROL;
         usb_buf[3] = CM_ARGB_GEN2_A1_WRITE;
 
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
+        pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 
         software_mode_activated = false;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
     }
 
     /*---------------------------------------------*\
@@ -294,9 +295,9 @@ void CMARGBGen2A1controller::SetMode(unsigned int mode_value, unsigned char spee
         usb_buf[12] = random;
     }
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 
     if(is_custom_mode)
     {
@@ -336,9 +337,9 @@ void CMARGBGen2A1controller::SetCustomSequence(unsigned int zone_id)
     usb_buf[4] = 1 << zone_id; // CHANNEL
     usb_buf[5] = 0x32;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_SHORT));
 
     SetPipelineStaticSequence(zone_id);
 }
@@ -358,9 +359,9 @@ void CMARGBGen2A1controller::SetPipelineStaticSequence(unsigned int zone_id)
     usb_buf[3]  = CM_ARGB_GEN2_A1_WRITE;
     usb_buf[4]  = 1 << zone_id;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 }
 
 void CMARGBGen2A1controller::ResetDevice()
@@ -372,7 +373,7 @@ void CMARGBGen2A1controller::ResetDevice()
     usb_buf[2]  = CM_ARGB_GEN2_A1_RESET;
     usb_buf[3]  = CM_ARGB_GEN2_A1_WRITE;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, CM_ARGB_GEN2_A1_PACKET_LENGTH);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
+    pacer.ReportSent(std::chrono::milliseconds(CM_ARGB_GEN2_A1_SLEEP_LONG));
 }
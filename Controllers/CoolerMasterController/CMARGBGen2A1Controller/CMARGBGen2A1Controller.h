@@ -14,6 +14,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "HIDReportPacer.h"
 #include "RGBController.h"
 
 #define CM_ARGB_GEN2_A1_PACKET_LENGTH 65
@@ -103,6 +104,7 @@ private:
     std::string                 location;
     bool                        software_mode_activated = false;
     hid_device*                 dev;
+    HIDReportPacer              pacer;
 
     void                        SetCustomSequence(unsigned int zone_id);
     void                        SetPipelineStaticSequence(unsigned int zone_id);
@@ -17,8 +17,9 @@
 
 using namespace std::chrono_literals;
 
-CorsairCommanderCoreController::CorsairCommanderCoreController(hid_device* dev_handle, const char* path, int pid)
+CorsairCommanderCoreController::CorsairCommanderCoreController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, int pid)
 {
+    wrapper                 = hid_wrapper;
     dev                     = dev_handle;
     location                = path;
     keepalive_thread_run    = 1;
@@ -51,7 +52,7 @@ CorsairCommanderCoreController::~CorsairCommanderCoreController()
     /*-----------------------------------------------------*\
     | Close HID device                                      |
     \*-----------------------------------------------------*/
-    hid_close(dev);
+    wrapper.hid_close(dev);
     delete guard_manager_ptr;
 }
 
@@ -183,10 +184,10 @@ void CorsairCommanderCoreController::SendCommand(unsigned char command[2], unsig
     {
         DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
 
-        hid_write(dev, buf, packet_size);
+        wrapper.hid_write(dev, buf, packet_size);
         do
         {
-            hid_read(dev, buf, packet_size);
+            wrapper.hid_read(dev, buf, packet_size);
         }
         while (buf[0] != 0x00);
     }
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <vector>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 #include "DeviceGuardManager.h"
 
@@ -33,7 +34,7 @@ enum
 class CorsairCommanderCoreController
 {
 public:
-    CorsairCommanderCoreController(hid_device* dev_handle, const char* path, int pid);
+    CorsairCommanderCoreController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, int pid);
     ~CorsairCommanderCoreController();
 
     std::string GetFirmwareString();
@@ -50,6 +51,7 @@ public:
     void        SetFanMode();
 
 private:
+    hidapi_wrapper                                      wrapper;
     hid_device*                                         dev;
     std::thread*                                        keepalive_thread;
     std::atomic<bool>                                   keepalive_thread_run;
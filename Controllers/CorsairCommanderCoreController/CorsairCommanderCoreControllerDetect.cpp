@@ -11,6 +11,7 @@
 
 #include <hidapi.h>
 #include "Detector.h"
+#include "hidapi_wrapper.h"
 #include "CorsairCommanderCoreController.h"
 #include "RGBController_CorsairCommanderCore.h"
 
@@ -37,13 +38,13 @@
 *                                                                                          *
 \******************************************************************************************/
 
-void DetectCorsairCapellixHIDControllers(hid_device_info* info, const std::string& name)
+void DetectCorsairCapellixHIDControllers(hidapi_wrapper wrapper, hid_device_info* info, const std::string& name)
 {
-    hid_device* dev = hid_open_path(info->path);
+    hid_device* dev = wrapper.hid_open_path(info->path);
 
     if(dev)
     {
-        CorsairCommanderCoreController*     controller     = new CorsairCommanderCoreController(dev, info->path, info->product_id);
+        CorsairCommanderCoreController*     controller     = new CorsairCommanderCoreController(wrapper, dev, info->path, info->product_id);
         RGBController_CorsairCommanderCore* rgb_controller = new RGBController_CorsairCommanderCore(controller);
 
         rgb_controller->name = name;
@@ -52,9 +53,9 @@ void DetectCorsairCapellixHIDControllers(hid_device_info* info, const std::strin
     }
 }
 
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE_PID, 0x00, 0xFF42, 0x01);
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE2_PID, 0x00, 0xFF42, 0x01);
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE3_PID, 0x00, 0xFF42, 0x01);
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE4_PID, 0x00, 0xFF42, 0x01);
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE5_PID, 0x00, 0xFF42, 0x01);
-REGISTER_HID_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE6_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE2_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE3_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE4_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE5_PID, 0x00, 0xFF42, 0x01);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair Commander Core", DetectCorsairCapellixHIDControllers, CORSAIR_VID, CORSAIR_COMMANDER_CORE6_PID, 0x00, 0xFF42, 0x01);
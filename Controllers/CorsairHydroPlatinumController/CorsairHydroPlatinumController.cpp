@@ -85,8 +85,9 @@ static const uint8_t MAGIC_3[61] =
     0xff, 0xff, 0xff, 0xff, 0xff
 };
 
-CorsairHydroPlatinumController::CorsairHydroPlatinumController(hid_device* dev_handle, const char* path)
+CorsairHydroPlatinumController::CorsairHydroPlatinumController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper     = hid_wrapper;
     dev         = dev_handle;
     location    = path;
     guard_manager_ptr = new DeviceGuardManager(new CorsairDeviceGuard());
@@ -98,7 +99,7 @@ CorsairHydroPlatinumController::CorsairHydroPlatinumController(hid_device* dev_h
 
 CorsairHydroPlatinumController::~CorsairHydroPlatinumController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
     delete guard_manager_ptr;
 }
 
@@ -163,8 +164,8 @@ void CorsairHydroPlatinumController::SendMagic(const uint8_t* magic, unsigned in
     {
         DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
 
-        hid_write(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
-        hid_read(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
+        wrapper.hid_write(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
+        wrapper.hid_read(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
     }
     /*---------------------------------------------------------*\
     | HID I/O end (lock released)                               |
@@ -225,7 +226,7 @@ void CorsairHydroPlatinumController::SendColors(std::vector<RGBColor> colors, un
     {
         DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
 
-        hid_write(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
+        wrapper.hid_write(dev, usb_buf, CORSAIR_HYDRO_PLATINUM_PACKET_SIZE);
     }
     /*---------------------------------------------------------*\
     | HID I/O end (lock released)                               |
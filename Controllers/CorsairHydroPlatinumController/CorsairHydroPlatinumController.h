@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 #include "DeviceGuardManager.h"
 
@@ -34,7 +35,7 @@ enum
 class CorsairHydroPlatinumController
 {
 public:
-    CorsairHydroPlatinumController(hid_device* dev_handle, const char* path);
+    CorsairHydroPlatinumController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairHydroPlatinumController();
 
     std::string GetLocation();
@@ -42,6 +43,7 @@ public:
     void SetupColors(std::vector<RGBColor> colors);
 
 private:
+    hidapi_wrapper              wrapper;
     hid_device*                 dev;
     std::string                 location;
     std::string                 firmware_version;
@@ -19,8 +19,9 @@
 
 using namespace std::chrono_literals;
 
-CorsairLightingNodeController::CorsairLightingNodeController(hid_device* dev_handle, const char* path)
+CorsairLightingNodeController::CorsairLightingNodeController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper     = hid_wrapper;
     dev         = dev_handle;
     location    = path;
     guard_manager_ptr = new DeviceGuardManager(new CorsairDeviceGuard());
@@ -43,7 +44,7 @@ CorsairLightingNodeController::~CorsairLightingNodeController()
     keepalive_thread->join();
     delete keepalive_thread;
 
-    hid_close(dev);
+    wrapper.hid_close(dev);
     delete guard_manager_ptr;
 }
 
@@ -72,7 +73,7 @@ std::string CorsairLightingNodeController::GetLocationString()
 std::string CorsairLightingNodeController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -516,14 +517,14 @@ int CorsairLightingNodeController::WriteAndRead
     {
         DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
 
-        hid_write(dev, buf, CORSAIR_LIGHTING_NODE_WRITE_PACKET_SIZE);
+        wrapper.hid_write(dev, buf, CORSAIR_LIGHTING_NODE_WRITE_PACKET_SIZE);
         if(read_timeout_ms > 0)
         {
-            hid_read_ret = hid_read_timeout(dev, buf, CORSAIR_LIGHTING_NODE_READ_PACKET_SIZE, read_timeout_ms);
+            hid_read_ret = wrapper.hid_read_timeout(dev, buf, CORSAIR_LIGHTING_NODE_READ_PACKET_SIZE, read_timeout_ms);
         }
         else
         {
-            hid_read_ret = hid_read(dev, buf, CORSAIR_LIGHTING_NODE_READ_PACKET_SIZE);
+            hid_read_ret = wrapper.hid_read(dev, buf, CORSAIR_LIGHTING_NODE_READ_PACKET_SIZE);
         }
     }
     /*---------------------------------------------------------*\
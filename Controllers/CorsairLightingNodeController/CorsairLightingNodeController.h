@@ -14,6 +14,7 @@
 #include <chrono>
 #include <vector>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "DeviceGuardManager.h"
 #include "RGBController.h"
 
@@ -88,7 +89,7 @@ enum
 class CorsairLightingNodeController
 {
 public:
-    CorsairLightingNodeController(hid_device* dev_handle, const char* path);
+    CorsairLightingNodeController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairLightingNodeController();
 
     std::string     GetFirmwareString();
@@ -121,6 +122,7 @@ public:
     void            KeepaliveThread();
 
 private:
+    hidapi_wrapper                                      wrapper;
     hid_device*                                         dev;
     std::string                                         firmware_version;
     std::string                                         location;
@@ -38,8 +38,9 @@ static const unsigned char filler[] =
       0x6D };
 
 
-CorsairK55RGBPROXTController::CorsairK55RGBPROXTController(hid_device* dev_handle, const char* path)
+CorsairK55RGBPROXTController::CorsairK55RGBPROXTController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper         = hid_wrapper;
     dev             = dev_handle;
     location        = path;
 
@@ -48,7 +49,7 @@ CorsairK55RGBPROXTController::CorsairK55RGBPROXTController(hid_device* dev_handl
 
 CorsairK55RGBPROXTController::~CorsairK55RGBPROXTController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 std::string CorsairK55RGBPROXTController::GetDeviceLocation()
@@ -64,7 +65,7 @@ std::string CorsairK55RGBPROXTController::GetFirmwareString()
 std::string CorsairK55RGBPROXTController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -83,19 +84,19 @@ void CorsairK55RGBPROXTController::LightingControl()
     usb_buf[0x02] = 0x01;
     usb_buf[0x03] = 0x03;
     usb_buf[0x05] = 0x02;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
     usb_buf[0x02] = 0x02;
     usb_buf[0x03] = 0x5F;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
     usb_buf[0x02] = 0x0D;
     usb_buf[0x04] = 0x01;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 }
 
 void CorsairK55RGBPROXTController::SetLEDs(std::vector<RGBColor>colors)
@@ -119,7 +120,7 @@ void CorsairK55RGBPROXTController::SetLEDs(std::vector<RGBColor>colors)
 
     memcpy(&usb_buf[12], color_ptr, HID_PAYLOAD_SIZE1);
     color_ptr += HID_PAYLOAD_SIZE1;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     usb_buf[0x02] = 0x07;
 
@@ -127,7 +128,7 @@ void CorsairK55RGBPROXTController::SetLEDs(std::vector<RGBColor>colors)
     {
         memcpy(&usb_buf[4], color_ptr, HID_PAYLOAD_SIZE2);
         color_ptr += HID_PAYLOAD_SIZE2;
-        hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+        wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
     }
 }
 
@@ -149,13 +150,13 @@ void CorsairK55RGBPROXTController::SetHardwareMode
     usb_buf[0x03] = 0x01;
     usb_buf[0x04] = 0x61;
     usb_buf[0x05] = 0x6D;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
     usb_buf[0x02] = 0x09;
     usb_buf[0x03] = 0x01;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
@@ -241,7 +242,7 @@ void CorsairK55RGBPROXTController::SetHardwareMode
 
     memcpy(&usb_buf[fill_dest_index], &filler[fill_src_index], HID_PACKET_LENGTH - fill_dest_index);
     fill_src_index += (HID_PACKET_LENGTH - fill_dest_index);
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
@@ -249,21 +250,21 @@ void CorsairK55RGBPROXTController::SetHardwareMode
     usb_buf[0x03] = 0x01;
     memcpy(&usb_buf[4], &filler[fill_src_index], HID_PACKET_LENGTH - 4);
     fill_src_index += (HID_PACKET_LENGTH - 4);
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
     usb_buf[0x02] = 0x07;
     usb_buf[0x03] = 0x01;
     memcpy(&usb_buf[4], &filler[fill_src_index], sizeof(filler) - fill_src_index);
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 
     memset(usb_buf, 0x00, sizeof(usb_buf));
     usb_buf[0x01] = 0x08;
     usb_buf[0x02] = 0x05;
     usb_buf[0x03] = 0x01;
     usb_buf[0x04] = 0x01;
-    hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+    wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
 }
 
 void CorsairK55RGBPROXTController::SwitchMode(bool software)
@@ -281,6 +282,6 @@ void CorsairK55RGBPROXTController::SwitchMode(bool software)
         usb_buf[0x02] = 0x01;
         usb_buf[0x03] = 0x03;
         usb_buf[0x05] = 0x01;
-        hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
+        wrapper.hid_write(dev, (unsigned char *)usb_buf, HID_PACKET_LENGTH);
     }
 }
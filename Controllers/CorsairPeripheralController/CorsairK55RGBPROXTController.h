@@ -11,12 +11,13 @@
 
 #include <string>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 
 class CorsairK55RGBPROXTController
 {
 public:
-    CorsairK55RGBPROXTController(hid_device* dev_handle, const char* path);
+    CorsairK55RGBPROXTController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairK55RGBPROXTController();
     std::string GetDeviceLocation();
     std::string GetFirmwareString();
@@ -77,6 +78,7 @@ public:
     };
 
 private:
+    hidapi_wrapper wrapper;
     hid_device* dev;
 
     std::string firmware_version;
@@ -11,8 +11,9 @@
 #include "LogManager.h"
 #include "StringUtils.h"
 
-CorsairK65MiniController::CorsairK65MiniController(hid_device* dev_handle, const char* path)
+CorsairK65MiniController::CorsairK65MiniController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper         = hid_wrapper;
     dev             = dev_handle;
     location        = path;
 
@@ -21,7 +22,7 @@ CorsairK65MiniController::CorsairK65MiniController(hid_device* dev_handle, const
 
 CorsairK65MiniController::~CorsairK65MiniController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 std::string CorsairK65MiniController::GetDeviceLocation()
@@ -37,7 +38,7 @@ std::string CorsairK65MiniController::GetFirmwareString()
 std::string CorsairK65MiniController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -61,7 +62,7 @@ void CorsairK65MiniController::LightingControl()
     usb_buf[0x03] = 0x03;
     usb_buf[0x05] = 0x02;
 
-    hid_write(dev, usb_buf, PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, PACKET_LENGTH);
 
     memset(usb_buf, 0x00, PACKET_LENGTH);
 
@@ -69,7 +70,7 @@ void CorsairK65MiniController::LightingControl()
     usb_buf[0x02] = 0x02;
     usb_buf[0x03] = 0x6E;
 
-    hid_write(dev, usb_buf, PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, PACKET_LENGTH);
 
     memset(usb_buf, 0x00, PACKET_LENGTH);
 
@@ -78,7 +79,7 @@ void CorsairK65MiniController::LightingControl()
     usb_buf[0x03] = 0x01;
     usb_buf[0x04] = 0x22;
 
-    hid_write(dev, usb_buf, PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, PACKET_LENGTH);
 }
 
 void CorsairK65MiniController::SetLEDs(std::vector<RGBColor>colors, std::vector<unsigned int> positions)
@@ -106,5 +107,5 @@ void CorsairK65MiniController::SetLEDs(std::vector<RGBColor>colors, std::vector<
         usb_buf[0x0A + position * 3 + 2]  = RGBGetBValue(colors[i]);
     }
 
-    hid_write(dev, usb_buf, PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, PACKET_LENGTH);
 }
@@ -11,6 +11,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 
 #define PACKET_LENGTH 1025
@@ -19,7 +20,7 @@
 class CorsairK65MiniController
 {
 public:
-    CorsairK65MiniController(hid_device* dev_handle, const char* path);
+    CorsairK65MiniController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairK65MiniController();
 
     std::string             GetDeviceLocation();
@@ -29,6 +30,7 @@ public:
     void                    SetLEDs(std::vector<RGBColor> colors, std::vector<unsigned int> positions);
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
 
     std::string             firmware_version;
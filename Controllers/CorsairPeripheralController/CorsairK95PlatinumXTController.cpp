@@ -12,8 +12,9 @@
 #include "CorsairK95PlatinumXTController.h"
 #include "StringUtils.h"
 
-CorsairK95PlatinumXTController::CorsairK95PlatinumXTController(hid_device* dev_handle, const char* path)
+CorsairK95PlatinumXTController::CorsairK95PlatinumXTController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper         = hid_wrapper;
     dev             = dev_handle;
     location        = path;
 
@@ -22,7 +23,7 @@ CorsairK95PlatinumXTController::CorsairK95PlatinumXTController(hid_device* dev_h
 
 CorsairK95PlatinumXTController::~CorsairK95PlatinumXTController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 std::string CorsairK95PlatinumXTController::GetDeviceLocation()
@@ -43,7 +44,7 @@ std::string CorsairK95PlatinumXTController::GetName()
 std::string CorsairK95PlatinumXTController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -62,20 +63,20 @@ void CorsairK95PlatinumXTController::Init()
     usb_buf[0x02] = 0x01;
     usb_buf[0x03] = 0x03;
     usb_buf[0x05] = 0x02;
-    hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
+    wrapper.hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
 
     memset(usb_buf, 0x00, K95_PLATINUM_XT_REPORT_LENGTH);
     usb_buf[0x01] = K95_PLATINUM_XT_REPORT_ID;
     usb_buf[0x02] = 0x02;
     usb_buf[0x03] = 0x6E;
-    hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
+    wrapper.hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
 
     memset(usb_buf, 0x00, K95_PLATINUM_XT_REPORT_LENGTH);
     usb_buf[0x01] = K95_PLATINUM_XT_REPORT_ID;
     usb_buf[0x02] = 0x0D;
     usb_buf[0x03] = 0x01;
     usb_buf[0x04] = 0x01;
-    hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
+    wrapper.hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
 }
 
 void CorsairK95PlatinumXTController::SendDirect(const std::vector<RGBColor>& colors, const std::vector<std::tuple<std::string,unsigned int>>& leds_positions)
@@ -133,7 +134,7 @@ void CorsairK95PlatinumXTController::SendDirect(const std::vector<RGBColor>& col
         /*-----------------------------------------------------*\
         | Send the buffer                                       |
         \*-----------------------------------------------------*/
-        hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
+        wrapper.hid_write(dev, usb_buf, K95_PLATINUM_XT_REPORT_LENGTH);
 
         /*-----------------------------------------------------*\
         | Next pages start with 0x07                            |
@@ -13,6 +13,7 @@
 
 #include <string.h>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 
 #define K95_PLATINUM_XT_REPORT_LENGTH           65
@@ -26,7 +27,7 @@
 class CorsairK95PlatinumXTController
 {
 public:
-    CorsairK95PlatinumXTController(hid_device* dev_handle, const char* path);
+    CorsairK95PlatinumXTController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairK95PlatinumXTController();
 
     std::string     GetDeviceLocation();
@@ -37,6 +38,7 @@ public:
     void            SendDirect(const std::vector<RGBColor>& colors, const std::vector<std::tuple<std::string,unsigned int>>& leds_positions);
 
 private:
+    hidapi_wrapper  wrapper;
     hid_device*     dev;
 
     std::string     firmware_version;
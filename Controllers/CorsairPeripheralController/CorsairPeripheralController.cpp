@@ -66,8 +66,9 @@ static unsigned int key_mapping_k70_mk2_plat_iso[] = { 0x3f, 0x41, 0x42, 0x50, 0
 
 #define CORSAIR_PERIPHERAL_CONTROLLER_NAME "Corsair peripheral"
 
-CorsairPeripheralController::CorsairPeripheralController(hid_device* dev_handle, const char* path)
+CorsairPeripheralController::CorsairPeripheralController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper     = hid_wrapper;
     dev         = dev_handle;
     location    = path;
 
@@ -91,7 +92,7 @@ CorsairPeripheralController::CorsairPeripheralController(hid_device* dev_handle,
 
 CorsairPeripheralController::~CorsairPeripheralController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 device_type CorsairPeripheralController::GetDeviceType()
@@ -127,7 +128,7 @@ std::string CorsairPeripheralController::GetName()
 std::string CorsairPeripheralController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -363,7 +364,7 @@ void CorsairPeripheralController::SwitchMode(bool software)
         usb_buf[2] = CORSAIR_PROPERTY_SPECIAL_FUNCTION;
         usb_buf[3] = CORSAIR_LIGHTING_CONTROL_HARDWARE;
 
-        hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+        wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
     }
 }
 
@@ -415,7 +416,7 @@ void CorsairPeripheralController::LightingControl()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 /*-----------------------------------------------------*\
@@ -444,7 +445,7 @@ void CorsairPeripheralController::SetupK55AndK95LightingControl()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 
     unsigned int* skipped_identifiers = key_mapping_k95_plat_ansi;
     int skipped_identifiers_count = sizeof(key_mapping_k95_plat_ansi) / sizeof(key_mapping_k95_plat_ansi[0]);
@@ -496,7 +497,7 @@ void CorsairPeripheralController::SetupK55AndK95LightingControl()
         /*-----------------------------------------------------*\
         | Send packet                                           |
         \*-----------------------------------------------------*/
-        hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+        wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
     }
 }
 
@@ -520,7 +521,7 @@ void CorsairPeripheralController::SpecialFunctionControl()
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::ReadFirmwareInfo()
@@ -546,8 +547,8 @@ void CorsairPeripheralController::ReadFirmwareInfo()
     | If that fails, repeat the send and read the reply as  |
     | a feature report.                                     |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
-    actual = hid_read_timeout(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH, 1000);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    actual = wrapper.hid_read_timeout(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH, 1000);
 
     if(actual == 0)
     {
@@ -563,8 +564,8 @@ void CorsairPeripheralController::ReadFirmwareInfo()
         usb_buf[0x01]   = CORSAIR_COMMAND_READ;
         usb_buf[0x02]   = CORSAIR_PROPERTY_FIRMWARE_INFO;
 
-        hid_send_feature_report(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
-        actual = hid_get_feature_report(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+        wrapper.hid_send_feature_report(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+        actual = wrapper.hid_get_feature_report(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
         offset = 1;
     }
 
@@ -711,7 +712,7 @@ void CorsairPeripheralController::StreamPacket
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SetHardwareMode
@@ -735,7 +736,7 @@ void CorsairPeripheralController::SetHardwareMode
     usb_buf[3] = 0x02;
     usb_buf[5] = brightness;
 
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 
     /*-----------------------------------------------------*\
     | Send "lght_00.d"                                      |
@@ -755,7 +756,7 @@ void CorsairPeripheralController::SetHardwareMode
     usb_buf[12] = 0x2E;
     usb_buf[13] = 0x64;
 
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 
     /*-----------------------------------------------------*\
     | Stream the mode data                                  |
@@ -796,7 +797,7 @@ void CorsairPeripheralController::SetHardwareMode
         usb_buf[17] = 0xFF;
     }
 
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 
     /*-----------------------------------------------------*\
     | Stop stream and commit                                |
@@ -807,11 +808,11 @@ void CorsairPeripheralController::SetHardwareMode
     usb_buf[2]  = 0x17;
     usb_buf[3]  = 0x09;
 
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 
     usb_buf[3]  = 0x08;
 
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SubmitKeyboardFullColors
@@ -841,7 +842,7 @@ void CorsairPeripheralController::SubmitKeyboardFullColors
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SubmitKeyboardZonesColors
@@ -879,7 +880,7 @@ void CorsairPeripheralController::SubmitKeyboardZonesColors
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SubmitKeyboardLimitedColors
@@ -905,7 +906,7 @@ void CorsairPeripheralController::SubmitKeyboardLimitedColors
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SubmitMouseColors
@@ -944,7 +945,7 @@ void CorsairPeripheralController::SubmitMouseColors
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
 
 void CorsairPeripheralController::SubmitMousematColors
@@ -983,5 +984,5 @@ void CorsairPeripheralController::SubmitMousematColors
     | Send packet using feature reports, as headset stand   |
     | seems to not update completely using HID writes       |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
+    wrapper.hid_write(dev, usb_buf, CORSAIR_PERIPHERAL_PACKET_LENGTH);
 }
@@ -13,6 +13,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 
 #define CORSAIR_PERIPHERAL_PACKET_LENGTH 65
@@ -94,7 +95,7 @@ enum
 class CorsairPeripheralController
 {
 public:
-    CorsairPeripheralController(hid_device* dev_handle, const char* path);
+    CorsairPeripheralController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairPeripheralController();
 
     int             GetLogicalLayout();
@@ -125,6 +126,7 @@ public:
     void SwitchMode(bool software);
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
 
     std::string             firmware_version;
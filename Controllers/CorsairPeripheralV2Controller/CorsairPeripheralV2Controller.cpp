@@ -14,8 +14,9 @@
 
 using namespace std::chrono_literals;
 
-CorsairPeripheralV2Controller::CorsairPeripheralV2Controller(hid_device* dev_handle, const char* path, std::string /*name*/)
+CorsairPeripheralV2Controller::CorsairPeripheralV2Controller(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, std::string /*name*/)
 {
+    wrapper             = hid_wrapper;
     dev                 = dev_handle;
     location            = path;
 
@@ -24,10 +25,10 @@ CorsairPeripheralV2Controller::CorsairPeripheralV2Controller(hid_device* dev_han
     \*---------------------------------------------------------*/
     wchar_t name_string[HID_MAX_STR];
 
-    hid_get_manufacturer_string(dev, name_string, HID_MAX_STR);
+    wrapper.hid_get_manufacturer_string(dev, name_string, HID_MAX_STR);
     device_name = StringUtils::wstring_to_string(name_string);
 
-    hid_get_product_string(dev, name_string, HID_MAX_STR);
+    wrapper.hid_get_product_string(dev, name_string, HID_MAX_STR);
     device_name.append(" ").append(StringUtils::wstring_to_string(name_string));
 
     /*---------------------------------------------------------*\
@@ -64,12 +65,35 @@ CorsairPeripheralV2Controller::CorsairPeripheralV2Controller(hid_device* dev_han
     buffer[1] = write_cmd;
     buffer[2] = CORSAIR_V2_CMD_GET;
     buffer[3] = 0x11;
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    uint16_t result = hid_read_timeout(dev, buffer, CORSAIR_V2_PACKET_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    uint16_t result = wrapper.hid_read_timeout(dev, buffer, CORSAIR_V2_PACKET_SIZE, CORSAIR_V2_TIMEOUT);
     result++;
     pkt_sze = std::max(result, (uint16_t)CORSAIR_V2_WRITE_SIZE);
     LOG_DEBUG("[%s] Packet length set to %d", device_name.c_str(), pkt_sze);
 
+    /*---------------------------------------------------------*\
+    | Set up the LED block write layout.  The first packet      |
+    | carries the data length and the data starts at byte 8,    |
+    | the remaining packets continue it from byte 4.  The       |
+    | colors are sent as blocks of red, green and blue.         |
+    \*---------------------------------------------------------*/
+    hid_frame_layout layout;
+
+    layout.report_type          = HID_FRAME_REPORT_OUTPUT;
+    layout.report_size          = pkt_sze;
+    layout.header               = { 0x00, write_cmd, CORSAIR_V2_CMD_BLK_WN };
+    layout.payload_offset       = 4;
+    layout.first_header         = { 0x00, write_cmd, CORSAIR_V2_CMD_BLK_W1 };
+    layout.first_payload_offset = 8;
+    layout.max_payload          = 0;
+    layout.length_offset        = 4;
+    layout.packing              = HID_FRAME_PACKING_PLANAR;
+    layout.color_order          = RGB_COLOR_ORDER_RGB;
+    layout.ack_timeout          = CORSAIR_V2_TIMEOUT_SHORT;
+
+    uploader.SetDevice(wrapper, dev);
+    uploader.SetLayout(layout);
+
     /*---------------------------------------------------------*\
     | NB: If the device is not found in the device list         |
     |   then wireless mode may not work reliably                |
@@ -114,7 +138,7 @@ CorsairPeripheralV2Controller::CorsairPeripheralV2Controller(hid_device* dev_han
 
 CorsairPeripheralV2Controller::~CorsairPeripheralV2Controller()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 const corsair_v2_device* CorsairPeripheralV2Controller::GetDeviceData()
@@ -155,7 +179,7 @@ std::string CorsairPeripheralV2Controller::GetName()
 std::string CorsairPeripheralV2Controller::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -179,8 +203,8 @@ void CorsairPeripheralV2Controller::SetRenderMode(corsair_v2_device_mode mode)
     buffer[3]   = CORSAIR_V2_VALUE_MODE;
     buffer[5]   = mode;
 
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    wrapper.hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
 }
 
 void CorsairPeripheralV2Controller::LightingControl(uint8_t opt1)
@@ -199,8 +223,8 @@ void CorsairPeripheralV2Controller::LightingControl(uint8_t opt1)
     buffer[3]   = opt1;
     buffer[5]   = 0x00;
 
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    wrapper.hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
 }
 
 unsigned int CorsairPeripheralV2Controller::GetKeyboardLayout()
@@ -220,8 +244,8 @@ unsigned int CorsairPeripheralV2Controller::GetAddress(uint8_t address)
     buffer[2]   = CORSAIR_V2_CMD_GET;
     buffer[3]   = address;
 
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    hid_read_timeout(dev, read, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    wrapper.hid_read_timeout(dev, read, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
 
     unsigned int temp = (unsigned int)(read[6] << 24 | read[5] << 16 | read[4] << 8 | read[3]);
     LOG_DEBUG("[%s] GetAddress %02X - %02X %02X - %02X %02X %02X %02X   %02X %02X %02X %02X", device_name.c_str(),
@@ -248,8 +272,8 @@ unsigned char CorsairPeripheralV2Controller::StartTransaction(uint8_t opt1)
     buffer[3]   = opt1;
     buffer[4]   = light_ctrl;
 
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    wrapper.hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
 
     return buffer[2];
 }
@@ -265,8 +289,8 @@ void CorsairPeripheralV2Controller::StopTransaction(uint8_t opt1)
     buffer[3]   = 0x01;
     buffer[4]   = opt1;
 
-    hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
-    hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
+    wrapper.hid_write(dev, buffer, CORSAIR_V2_WRITE_SIZE);
+    wrapper.hid_read_timeout(dev, buffer, CORSAIR_V2_WRITE_SIZE, CORSAIR_V2_TIMEOUT);
 }
 
 void CorsairPeripheralV2Controller::ClearPacketBuffer()
@@ -276,68 +300,35 @@ void CorsairPeripheralV2Controller::ClearPacketBuffer()
 
     do
     {
-        result = hid_read_timeout(dev, buffer, pkt_sze, CORSAIR_V2_TIMEOUT_SHORT);
+        result = wrapper.hid_read_timeout(dev, buffer, pkt_sze, CORSAIR_V2_TIMEOUT_SHORT);
     }
     while(result > 0);
 }
 
 void CorsairPeripheralV2Controller::SetLEDs(uint8_t *data, uint16_t data_size)
 {
-    const uint8_t offset1   = 8;
-    const uint8_t offset2   = 4;
-    uint16_t remaining      = data_size;
-
-    uint8_t buffer[CORSAIR_V2_PACKET_SIZE];
-    memset(buffer, 0, CORSAIR_V2_PACKET_SIZE);
-
     ClearPacketBuffer();
     StartTransaction(0);
-    /*---------------------------------------------------------*\
-    | Set the data header in packet 1 with the data length      |
-    |   signaling how many packets to expect to the device      |
-    \*---------------------------------------------------------*/
-    buffer[1]               = write_cmd;
-    buffer[2]               = CORSAIR_V2_CMD_BLK_W1;
-    buffer[4]               = data_size & 0xFF;
-    buffer[5]               = data_size >> 8;
 
     /*---------------------------------------------------------*\
-    | Check if the data needs more than 1 packet                |
+    | Send the data as a block write, the first packet's header |
+    |   has the data length signaling how many packets to       |
+    |   expect to the device                                    |
     \*---------------------------------------------------------*/
-    uint16_t copy_bytes     = pkt_sze - offset1;
-    if(remaining < copy_bytes)
-    {
-        copy_bytes          = remaining;
-    }
+    uploader.Upload(data, data_size);
 
-    memcpy(&buffer[offset1], &data[0], copy_bytes);
-
-    hid_write(dev, buffer, pkt_sze);
-    hid_read_timeout(dev, buffer, pkt_sze, CORSAIR_V2_TIMEOUT_SHORT);
+    StopTransaction(0);
+}
 
-    remaining              -= copy_bytes;
-    buffer[2]               = CORSAIR_V2_CMD_BLK_WN;
-    copy_bytes              = pkt_sze - offset2;
+void CorsairPeripheralV2Controller::SetLEDs(const std::vector<RGBColor *>& colors)
+{
+    ClearPacketBuffer();
+    StartTransaction(0);
 
     /*---------------------------------------------------------*\
-    | Send the remaining packets                                |
+    | Pack the colors straight into the block write packets     |
     \*---------------------------------------------------------*/
-    while(remaining)
-    {
-        uint16_t index      = data_size - remaining;
-        if(remaining < copy_bytes)
-        {
-            memset(&buffer[offset2], 0, copy_bytes);
-            copy_bytes      = remaining;
-        }
-
-        memcpy(&buffer[offset2], &data[index], copy_bytes);
-
-        hid_write(dev, buffer, pkt_sze);
-        hid_read_timeout(dev, buffer, pkt_sze, CORSAIR_V2_TIMEOUT_SHORT);
-
-        remaining          -= copy_bytes;
-    }
+    uploader.Upload(colors);
 
     StopTransaction(0);
 }
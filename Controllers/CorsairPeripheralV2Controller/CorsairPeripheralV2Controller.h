@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
+#include "HIDFrameUploader.h"
 #include "LogManager.h"
 #include "RGBController.h"
 #include "CorsairPeripheralV2Devices.h"
@@ -75,7 +77,7 @@ enum corsair_v2_color
 class CorsairPeripheralV2Controller
 {
 public:
-    CorsairPeripheralV2Controller(hid_device* dev_handle, const char* path, std::string name);
+    CorsairPeripheralV2Controller(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, std::string name);
     virtual ~CorsairPeripheralV2Controller();
 
     std::string                     GetDeviceLocation();
@@ -89,10 +91,11 @@ public:
     void                            SetRenderMode(corsair_v2_device_mode mode);
     void                            LightingControl(uint8_t opt1);
     void                            SetLEDs(uint8_t *data, uint16_t data_size);
+    void                            SetLEDs(const std::vector<RGBColor *>& colors);
     void                            UpdateHWMode(uint16_t mode, corsair_v2_color color_mode, uint8_t speed,
                                                  uint8_t direction, uint8_t brightness, std::vector<RGBColor> colors);
 
-    virtual void                    SetLedsDirect(std::vector<RGBColor *> colors)                   = 0;
+    virtual void                    SetLedsDirect(const std::vector<RGBColor *>& colors)            = 0;
 
 protected:
     uint16_t                        device_index;
@@ -105,7 +108,9 @@ private:
     unsigned char                   StartTransaction(uint8_t opt1);
     void                            StopTransaction(uint8_t opt1);
 
+    hidapi_wrapper                  wrapper;
     hid_device*                     dev;
+    HIDFrameUploader                uploader;
 
     uint8_t                         write_cmd           = CORSAIR_V2_WRITE_WIRED_ID;
     uint16_t                        pkt_sze             = CORSAIR_V2_WRITE_SIZE;
@@ -12,7 +12,7 @@
 #include "LogManager.h"
 #include "CorsairPeripheralV2HardwareController.h"
 
-CorsairPeripheralV2HWController::CorsairPeripheralV2HWController(hid_device* dev_handle, const char* path, std::string name) : CorsairPeripheralV2Controller(dev_handle, path, name)
+CorsairPeripheralV2HWController::CorsairPeripheralV2HWController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, std::string name) : CorsairPeripheralV2Controller(hid_wrapper, dev_handle, path, name)
 {
     SetRenderMode(CORSAIR_V2_MODE_SW);
     LightingControl(0x5F);
@@ -23,7 +23,7 @@ CorsairPeripheralV2HWController::~CorsairPeripheralV2HWController()
 
 }
 
-void CorsairPeripheralV2HWController::SetLedsDirect(std::vector<RGBColor *>colors)
+void CorsairPeripheralV2HWController::SetLedsDirect(const std::vector<RGBColor *>& colors)
 {
     switch(light_ctrl)
     {
@@ -40,30 +40,15 @@ void CorsairPeripheralV2HWController::SetLedsDirect(std::vector<RGBColor *>color
     }
 }
 
-void CorsairPeripheralV2HWController::SetLedsDirectColourBlocks(std::vector<RGBColor *>colors)
+void CorsairPeripheralV2HWController::SetLedsDirectColourBlocks(const std::vector<RGBColor *>& colors)
 {
-    uint16_t count          = (uint16_t)colors.size();
-    uint16_t green          = count;
-    uint16_t blue           = (count * 2);
-    uint16_t length         = (count * 3);
-    uint8_t* buffer         = new uint8_t[length];
-
-    memset(buffer, 0, length);
-
-    for(std::size_t i = 0; i < count; i++)
-    {
-        RGBColor color      = *colors[i];
-
-        buffer[i]           = RGBGetRValue(color);
-        buffer[i + green]   = RGBGetGValue(color);
-        buffer[i + blue]    = RGBGetBValue(color);
-    }
-
-    SetLEDs(buffer, length);
-    delete[] buffer;
+    /*---------------------------------------------------------*\
+    | Colour blocks are the planar layout SetLEDs packs itself  |
+    \*---------------------------------------------------------*/
+    SetLEDs(colors);
 }
 
-void CorsairPeripheralV2HWController::SetLedsDirectTriplets(std::vector<RGBColor *>colors)
+void CorsairPeripheralV2HWController::SetLedsDirectTriplets(const std::vector<RGBColor *>& colors)
 {
     uint16_t count          = (uint16_t)colors.size();
     uint16_t length         = (count * 3)   + CORSAIR_V2HW_DATA_OFFSET;
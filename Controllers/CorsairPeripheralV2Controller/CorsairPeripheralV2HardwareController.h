@@ -24,12 +24,12 @@
 class CorsairPeripheralV2HWController : public CorsairPeripheralV2Controller
 {
 public:
-    CorsairPeripheralV2HWController(hid_device* dev_handle, const char* path, std::string name);
+    CorsairPeripheralV2HWController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, std::string name);
     ~CorsairPeripheralV2HWController();
 
-    void    SetLedsDirect(std::vector<RGBColor *> colors);
+    void    SetLedsDirect(const std::vector<RGBColor *>& colors);
 
 private:
-    void    SetLedsDirectColourBlocks(std::vector<RGBColor *> colors);
-    void    SetLedsDirectTriplets(std::vector<RGBColor *> colors);
+    void    SetLedsDirectColourBlocks(const std::vector<RGBColor *>& colors);
+    void    SetLedsDirectTriplets(const std::vector<RGBColor *>& colors);
 };
@@ -20,10 +20,10 @@
 class CorsairPeripheralV2SWController : public CorsairPeripheralV2Controller
 {
 public:
-    CorsairPeripheralV2SWController(hid_device* dev_handle, const char* path, std::string name);
+    CorsairPeripheralV2SWController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, std::string name);
     ~CorsairPeripheralV2SWController();
 
-    void    SetLedsDirect(std::vector<RGBColor *> colors);
+    void    SetLedsDirect(const std::vector<RGBColor *>& colors);
 
 private:
 
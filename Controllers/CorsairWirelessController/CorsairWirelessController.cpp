@@ -15,8 +15,9 @@
 
 using namespace std::chrono_literals;
 
-CorsairWirelessController::CorsairWirelessController(hid_device* dev_handle, const char* path)
+CorsairWirelessController::CorsairWirelessController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path)
 {
+    wrapper     = hid_wrapper;
     dev         = dev_handle;
     location    = path;
 
@@ -27,7 +28,7 @@ CorsairWirelessController::CorsairWirelessController(hid_device* dev_handle, con
 
 CorsairWirelessController::~CorsairWirelessController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 device_type CorsairWirelessController::GetDeviceType()
@@ -53,7 +54,7 @@ std::string CorsairWirelessController::GetName()
 std::string CorsairWirelessController::GetSerialString()
 {
     wchar_t serial_string[128];
-    int ret = hid_get_serial_number_string(dev, serial_string, 128);
+    int ret = wrapper.hid_get_serial_number_string(dev, serial_string, 128);
 
     if(ret != 0)
     {
@@ -117,7 +118,7 @@ void CorsairWirelessController::EnterDirectMode()
     | Send packet using feature reports, as headset stand   |
     | seems to not update completely using HID writes       |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, 65);
+    wrapper.hid_write(dev, usb_buf, 65);
 
 }
 
@@ -143,7 +144,7 @@ void CorsairWirelessController::StartDirectMode()
     | Send packet using feature reports, as headset stand   |
     | seems to not update completely using HID writes       |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, 65);
+    wrapper.hid_write(dev, usb_buf, 65);
 
 }
 
@@ -170,7 +171,7 @@ void CorsairWirelessController::ExitDirectMode()
     | Send packet using feature reports, as headset stand   |
     | seems to not update completely using HID writes       |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, 65);
+    wrapper.hid_write(dev, usb_buf, 65);
 
 }
 
@@ -213,5 +214,5 @@ void CorsairWirelessController::SendDirectFrame(bool first_frame, unsigned char*
     | Send packet using feature reports, as headset stand   |
     | seems to not update completely using HID writes       |
     \*-----------------------------------------------------*/
-    hid_write(dev, usb_buf, 65);
+    wrapper.hid_write(dev, usb_buf, 65);
 }
@@ -13,12 +13,13 @@
 
 #include <string>
 #include <hidapi.h>
+#include "hidapi_wrapper.h"
 #include "RGBController.h"
 
 class CorsairWirelessController
 {
 public:
-    CorsairWirelessController(hid_device* dev_handle, const char* path);
+    CorsairWirelessController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path);
     ~CorsairWirelessController();
 
     device_type     GetDeviceType();
@@ -31,6 +32,7 @@ public:
     void            SetName(std::string device_name);
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
 
     std::string             firmware_version;
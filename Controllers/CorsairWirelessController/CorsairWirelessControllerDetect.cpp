@@ -11,6 +11,7 @@
 
 #include <hidapi.h>
 #include "Detector.h"
+#include "hidapi_wrapper.h"
 #include "CorsairWirelessController.h"
 #include "RGBController.h"
 #include "RGBController_CorsairWireless.h"
@@ -34,13 +35,13 @@
 *                                                                                          *
 \******************************************************************************************/
 
-void DetectCorsairWirelessControllers(hid_device_info* info, const std::string& name)
+void DetectCorsairWirelessControllers(hidapi_wrapper wrapper, hid_device_info* info, const std::string& name)
 {
-    hid_device* dev = hid_open_path(info->path);
+    hid_device* dev = wrapper.hid_open_path(info->path);
 
     if(dev)
     {
-        CorsairWirelessController* controller = new CorsairWirelessController(dev, info->path);
+        CorsairWirelessController* controller = new CorsairWirelessController(wrapper, dev, info->path);
         controller->SetName(name);
 
         if(controller->GetDeviceType() != DEVICE_TYPE_UNKNOWN)
@@ -58,5 +59,5 @@ void DetectCorsairWirelessControllers(hid_device_info* info, const std::string&
 /*-----------------------------------------------------------------------------------------------------*\
 | Keyboards                                                                                             |
 \*-----------------------------------------------------------------------------------------------------*/
-REGISTER_HID_DETECTOR_IPU("Corsair K57 RGB (Wired)",         DetectCorsairWirelessControllers,   CORSAIR_VID,    CORSAIR_K57_RGB_WIRED_PID,     1,  0xFF42, 1);
-//REGISTER_HID_DETECTOR_IPU("Corsair K57 RGB (Wireless)",      DetectCorsairWirelessControllers,   CORSAIR_VID,    CORSAIR_K57_RGB_WIRELESS_PID,  1,  0xFF42, 1);
+REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair K57 RGB (Wired)",         DetectCorsairWirelessControllers,   CORSAIR_VID,    CORSAIR_K57_RGB_WIRED_PID,     1,  0xFF42, 1);
+//REGISTER_HID_WRAPPED_DETECTOR_IPU("Corsair K57 RGB (Wireless)",      DetectCorsairWirelessControllers,   CORSAIR_VID,    CORSAIR_K57_RGB_WIRELESS_PID,  1,  0xFF42, 1);
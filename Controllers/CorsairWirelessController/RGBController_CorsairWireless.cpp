@@ -204,6 +204,7 @@ RGBController_CorsairWireless::RGBController_CorsairWireless(CorsairWirelessCont
     version     = controller->GetFirmwareString();
     location    = controller->GetDeviceLocation();
     serial      = controller->GetSerialString();
+    flags      |= CONTROLLER_FLAG_ADAPTIVE_RATE;
 
     mode Direct;
     Direct.name       = "Direct";
@@ -8,7 +8,9 @@
 \*---------------------------------------------------------*/
 
 #include "DDPController.h"
+#include "net_reactor.h"
 #include "LogManager.h"
+#include "RGBControllerColorFormat.h"
 #include <cstring>
 #include <algorithm>
 
@@ -19,23 +21,28 @@ DDPController::DDPController(const std::vector<DDPDevice>& device_list)
     num_endpoints   = 0;
     sequence_number = 0;
     keepalive_time_ms = 1000;
-    keepalive_thread_run = false;
+    keepalive_timer = 0;
     
     InitializeNetPorts();
     
+    /*-----------------------------------------------------*\
+    | Check every 100ms on the shared network reactor       |
+    | thread whether the last frame needs to be resent      |
+    \*-----------------------------------------------------*/
     if(!devices.empty())
     {
-        keepalive_thread_run = true;
-        keepalive_thread = std::thread(&DDPController::KeepaliveThreadFunction, this);
+        keepalive_timer = net_reactor::get()->add_timer(100, [this]()
+        {
+            KeepaliveTimer();
+        });
     }
 }
 
 DDPController::~DDPController()
 {
-    keepalive_thread_run = false;
-    if(keepalive_thread.joinable())
+    if(keepalive_timer != 0)
     {
-        keepalive_thread.join();
+        net_reactor::get()->remove(keepalive_timer);
     }
     
     CloseNetPorts();
@@ -160,18 +167,9 @@ void DDPController::UpdateLEDs(const std::vector<unsigned int>& colors)
         unsigned int total_bytes = devices[dev_idx].num_leds * bytes_per_pixel;
         std::vector<unsigned char> device_data(total_bytes);
         
-        for(unsigned int led_idx = 0; led_idx < devices[dev_idx].num_leds && (color_index + led_idx) < colors.size(); led_idx++)
-        {
-            unsigned int color = colors[color_index + led_idx];
-            unsigned char r = color & 0xFF;
-            unsigned char g = (color >> 8) & 0xFF;
-            unsigned char b = (color >> 16) & 0xFF;
-            unsigned int pixel_offset = led_idx * bytes_per_pixel;
-            
-            device_data[pixel_offset + 0] = r;
-            device_data[pixel_offset + 1] = g;
-            device_data[pixel_offset + 2] = b;
-        }
+        unsigned int leds_to_pack = std::min(devices[dev_idx].num_leds, (unsigned int)(colors.size() - color_index));
+
+        rgb_color_pack(&colors[color_index], leds_to_pack, device_data.data(), RGB_COLOR_ORDER_RGB);
         
         unsigned int max_data_per_packet = DDP_MAX_DATA_SIZE;
         unsigned int bytes_sent = 0;
@@ -239,71 +237,66 @@ void DDPController::SetKeepaliveTime(unsigned int time_ms)
     keepalive_time_ms = time_ms;
 }
 
-void DDPController::KeepaliveThreadFunction()
+void DDPController::KeepaliveTimer()
 {
-    while(keepalive_thread_run)
-    {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if(keepalive_time_ms == 0)
+        return;
         
-        if(keepalive_time_ms == 0)
-            continue;
-            
-        std::vector<unsigned int> colors_to_send;
-        bool should_send = false;
+    std::vector<unsigned int> colors_to_send;
+    bool should_send = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(last_update_mutex);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        long long time_since_update = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_time).count();
         
+        if(time_since_update >= keepalive_time_ms && !last_colors.empty())
         {
-            std::lock_guard<std::mutex> lock(last_update_mutex);
-            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-            long long time_since_update = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_time).count();
-            
-            if(time_since_update >= keepalive_time_ms && !last_colors.empty())
-            {
-                colors_to_send = last_colors;
-                should_send = true;
-                last_update_time = now;
-            }
+            colors_to_send = last_colors;
+            should_send = true;
+            last_update_time = now;
         }
+    }
+    
+    if(should_send)
+    {
+        unsigned int color_index = 0;
         
-        if(should_send)
+        for(unsigned int dev_idx = 0; dev_idx < devices.size(); dev_idx++)
         {
-            unsigned int color_index = 0;
+            if(color_index >= colors_to_send.size()) break;
+                
+            unsigned int bytes_per_pixel = 3;
+            unsigned int total_bytes = devices[dev_idx].num_leds * bytes_per_pixel;
+            std::vector<unsigned char> device_data(total_bytes);
             
-            for(unsigned int dev_idx = 0; dev_idx < devices.size(); dev_idx++)
+            for(unsigned int led_idx = 0; led_idx < devices[dev_idx].num_leds && (color_index + led_idx) < colors_to_send.size(); led_idx++)
             {
-                if(color_index >= colors_to_send.size()) break;
-                    
-                unsigned int bytes_per_pixel = 3;
-                unsigned int total_bytes = devices[dev_idx].num_leds * bytes_per_pixel;
-                std::vector<unsigned char> device_data(total_bytes);
-                
-                for(unsigned int led_idx = 0; led_idx < devices[dev_idx].num_leds && (color_index + led_idx) < colors_to_send.size(); led_idx++)
-                {
-                    unsigned int color = colors_to_send[color_index + led_idx];
-                    unsigned char r = color & 0xFF;
-                    unsigned char g = (color >> 8) & 0xFF;
-                    unsigned char b = (color >> 16) & 0xFF;
-                    unsigned int pixel_offset = led_idx * bytes_per_pixel;
-                    
-                    device_data[pixel_offset + 0] = r;
-                    device_data[pixel_offset + 1] = g;
-                    device_data[pixel_offset + 2] = b;
-                }
+                unsigned int color = colors_to_send[color_index + led_idx];
+                unsigned char r = color & 0xFF;
+                unsigned char g = (color >> 8) & 0xFF;
+                unsigned char b = (color >> 16) & 0xFF;
+                unsigned int pixel_offset = led_idx * bytes_per_pixel;
                 
-                unsigned int max_data_per_packet = DDP_MAX_DATA_SIZE;
-                unsigned int bytes_sent = 0;
+                device_data[pixel_offset + 0] = r;
+                device_data[pixel_offset + 1] = g;
+                device_data[pixel_offset + 2] = b;
+            }
+            
+            unsigned int max_data_per_packet = DDP_MAX_DATA_SIZE;
+            unsigned int bytes_sent = 0;
+            
+            while(bytes_sent < total_bytes)
+            {
+                unsigned int chunk_size = (max_data_per_packet < (total_bytes - bytes_sent)) ? max_data_per_packet : (total_bytes - bytes_sent);
                 
-                while(bytes_sent < total_bytes)
-                {
-                    unsigned int chunk_size = (max_data_per_packet < (total_bytes - bytes_sent)) ? max_data_per_packet : (total_bytes - bytes_sent);
-                    
-                    if(!SendDDPPacket(devices[dev_idx], device_data.data() + bytes_sent, (unsigned short)chunk_size, bytes_sent))
-                        break;
-                    
-                    bytes_sent += chunk_size;
-                }
+                if(!SendDDPPacket(devices[dev_idx], device_data.data() + bytes_sent, (unsigned short)chunk_size, bytes_sent))
+                    break;
                 
-                color_index += devices[dev_idx].num_leds;
+                bytes_sent += chunk_size;
             }
+            
+            color_index += devices[dev_idx].num_leds;
         }
     }
 }
@@ -79,8 +79,7 @@ private:
     unsigned char           sequence_number;
     
 
-    std::atomic<bool>       keepalive_thread_run;
-    std::thread             keepalive_thread;
+    unsigned int            keepalive_timer;
     std::mutex              last_update_mutex;
     std::chrono::steady_clock::time_point last_update_time;
     std::vector<unsigned int> last_colors;
@@ -93,5 +92,5 @@ private:
                                          const unsigned char* data, 
                                          unsigned short length, 
                                          unsigned int offset = 0);
-    void                    KeepaliveThreadFunction();
+    void                    KeepaliveTimer();
 };
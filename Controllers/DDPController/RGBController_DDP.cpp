@@ -27,6 +27,7 @@ RGBController_DDP::RGBController_DDP(std::vector<DDPDevice> device_list)
     type = DEVICE_TYPE_LEDSTRIP;
     description = "Distributed Display Protocol Device";
     location = "DDP: ";
+    flags |= CONTROLLER_FLAG_OUTPUT_COLORS;
 
     if(devices.size() == 1)
         name = devices[0].name;
@@ -88,13 +89,15 @@ void RGBController_DDP::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_DDP::DeviceUpdateLEDs()
 {
+    const std::vector<RGBColor>& output = GetOutputColors();
+
     std::vector<unsigned int> brightness_adjusted_colors;
-    brightness_adjusted_colors.reserve(colors.size());
+    brightness_adjusted_colors.reserve(output.size());
     float brightness_scale = (float)modes[active_mode].brightness / 100.0f;
     
-    for(unsigned int color_idx = 0; color_idx < colors.size(); color_idx++)
+    for(unsigned int color_idx = 0; color_idx < output.size(); color_idx++)
     {
-        unsigned int color = colors[color_idx];
+        unsigned int color = output[color_idx];
         unsigned char r = color & 0xFF;
         unsigned char g = (color >> 8) & 0xFF;
         unsigned char b = (color >> 16) & 0xFF;
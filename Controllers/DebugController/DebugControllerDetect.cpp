@@ -7,6 +7,7 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,6 +30,41 @@ static unsigned int dummy_keyboard_underglow_map[3][10] =
       {   10,  11,  12,  13,  14,  15,  16,  17,  18,  19 },
       {   20,  21,  22,  23,  24,  25,  26,  27,  28,  29 } };
 
+/*---------------------------------------------------------*\
+| Apply the optional simulated transport of a debug device  |
+|   "transport":  "hid", "serial", "i2c" or "network"       |
+|   "latency_us": time each LED update blocks for           |
+\*---------------------------------------------------------*/
+static void SetupDebugTransport(RGBController_Dummy* controller, json& device_settings)
+{
+    int             transport   = -1;
+    unsigned int    latency_us  = 0;
+
+    if(device_settings.contains("transport"))
+    {
+        std::string transport_str = device_settings["transport"];
+
+        for(int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+        {
+            std::string name = rgb_controller_transport_to_str(transport_idx);
+
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+            if(name == transport_str)
+            {
+                transport = transport_idx;
+            }
+        }
+    }
+
+    if(device_settings.contains("latency_us"))
+    {
+        latency_us = device_settings["latency_us"];
+    }
+
+    controller->SetSimulatedTransport(transport, latency_us);
+}
+
 /******************************************************************************************\
 *                                                                                          *
 *   DetectDebugControllers                                                                 *
@@ -131,6 +167,8 @@ void DetectDebugControllers()
 
                 dummy_motherboard->SetupColors();
 
+                SetupDebugTransport(dummy_motherboard, debug_settings["devices"][device_idx]);
+
                 /*---------------------------------------------------------*\
                 | Push the dummy motherboard onto the controller list       |
                 \*---------------------------------------------------------*/
@@ -207,6 +245,8 @@ void DetectDebugControllers()
 
                 dummy_dram->SetupColors();
 
+                SetupDebugTransport(dummy_dram, debug_settings["devices"][device_idx]);
+
                 /*---------------------------------------------------------*\
                 | Push the dummy DRAM onto the controller list              |
                 \*---------------------------------------------------------*/
@@ -283,6 +323,8 @@ void DetectDebugControllers()
 
                 dummy_gpu->SetupColors();
 
+                SetupDebugTransport(dummy_gpu, debug_settings["devices"][device_idx]);
+
                 /*---------------------------------------------------------*\
                 | Push the dummy GPU onto the controller list               |
                 \*---------------------------------------------------------*/
@@ -483,6 +525,8 @@ void DetectDebugControllers()
 
                 dummy_keyboard->SetupColors();
 
+                SetupDebugTransport(dummy_keyboard, debug_settings["devices"][device_idx]);
+
                 /*---------------------------------------------------------*\
                 | Push the dummy Keyboard onto the controller list          |
                 \*---------------------------------------------------------*/
@@ -531,6 +575,8 @@ void DetectDebugControllers()
                 dummy_argb->SetupColors();
                 dummy_argb->ResizeZone(0, 60);
 
+                SetupDebugTransport(dummy_argb, debug_settings["devices"][device_idx]);
+
                 /*---------------------------------------------------------*\
                 | Push the dummy ARGB onto the controller list              |
                 \*---------------------------------------------------------*/
@@ -748,6 +794,8 @@ void DetectDebugControllers()
 
             dummy_custom->SetupColors();
 
+            SetupDebugTransport(dummy_custom, CustomDev);
+
             ResourceManager::get()->RegisterRGBController(dummy_custom);
         }
     }
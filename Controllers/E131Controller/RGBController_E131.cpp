@@ -11,7 +11,10 @@
 
 #include <e131.h>
 #include <math.h>
+#include <string.h>
 #include "RGBController_E131.h"
+#include "RGBControllerColorFormat.h"
+#include "net_reactor.h"
 
 using namespace std::chrono_literals;
 
@@ -36,6 +39,7 @@ RGBController_E131::RGBController_E131(std::vector<E131Device> device_list)
     type        = DEVICE_TYPE_LEDSTRIP;
     description = "E1.31 Streaming ACN Device";
     location    = "E1.31: ";
+    flags      |= CONTROLLER_FLAG_OUTPUT_COLORS;
 
     /*-----------------------------------------*\
     | If this controller only represents a      |
@@ -296,25 +300,28 @@ RGBController_E131::RGBController_E131(std::vector<E131Device> device_list)
         }
     }
 
+    /*-----------------------------------------------------*\
+    | Check twice per keepalive delay on the shared network |
+    | reactor thread whether a keepalive update is due      |
+    \*-----------------------------------------------------*/
     if(keepalive_delay.count() > 0)
     {
-        keepalive_thread_run = 1;
-        keepalive_thread = new std::thread(&RGBController_E131::KeepaliveThreadFunction, this);
+        keepalive_timer = net_reactor::get()->add_timer((unsigned int)(keepalive_delay.count() / 2), [this]()
+        {
+            KeepaliveTimer();
+        });
     }
     else
     {
-        keepalive_thread_run = 0;
-        keepalive_thread = nullptr;
+        keepalive_timer = 0;
     }
 }
 
 RGBController_E131::~RGBController_E131()
 {
-    if(keepalive_thread != nullptr)
+    if(keepalive_timer != 0)
     {
-        keepalive_thread_run = 0;
-        keepalive_thread->join();
-        delete keepalive_thread;
+        net_reactor::get()->remove(keepalive_timer);
     }
 
     /*---------------------------------------------------------*\
@@ -380,7 +387,9 @@ void RGBController_E131::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_E131::DeviceUpdateLEDs()
 {
-    int color_idx = 0;
+    const std::vector<RGBColor>& output = GetOutputColors();
+
+    unsigned int color_idx = 0;
 
     last_update_time = std::chrono::steady_clock::now();
 
@@ -389,9 +398,24 @@ void RGBController_E131::DeviceUpdateLEDs()
         float universe_size = (float)devices[device_idx].universe_size;
         unsigned int total_universes = (unsigned int)ceil( ( ( devices[device_idx].num_leds * 3 ) + devices[device_idx].start_channel ) / universe_size );
         unsigned int channel_idx = devices[device_idx].start_channel;
-        unsigned int led_idx = 0;
-        unsigned int rgb_idx = 0;
-        bool         done = false;
+
+        /*-----------------------------------------------------*\
+        | Pack this device's colors into RGB channel data once, |
+        | then copy it into each universe's channel range       |
+        \*-----------------------------------------------------*/
+        unsigned int num_leds = devices[device_idx].num_leds;
+
+        if((color_idx + num_leds) > output.size())
+        {
+            num_leds = (unsigned int)(output.size() - color_idx);
+        }
+
+        channel_buf.resize(num_leds * 3);
+
+        rgb_color_pack(&output[color_idx], num_leds, channel_buf.data(), RGB_COLOR_ORDER_RGB);
+
+        unsigned int data_idx = 0;
+        unsigned int data_size = (unsigned int)channel_buf.size();
 
         for (unsigned int univ_idx = 0; univ_idx < total_universes; univ_idx++)
         {
@@ -399,40 +423,26 @@ void RGBController_E131::DeviceUpdateLEDs()
 
             for(std::size_t packet_idx = 0; packet_idx < packets.size(); packet_idx++)
             {
-                if(!done && (universes[packet_idx] == universe))
+                if((data_idx < data_size) && (universes[packet_idx] == universe) && (channel_idx <= devices[device_idx].universe_size))
                 {
-                    while(!done && (channel_idx <= universe_size))
+                    unsigned int chunk_size = devices[device_idx].universe_size - channel_idx + 1;
+
+                    if(chunk_size > (data_size - data_idx))
                     {
-                        switch(rgb_idx)
-                        {
-                            case 0:
-                                packets[packet_idx].dmp.prop_val[channel_idx] = RGBGetRValue( colors[color_idx] );
-                                rgb_idx = 1;
-                                break;
-                            case 1:
-                                packets[packet_idx].dmp.prop_val[channel_idx] = RGBGetGValue( colors[color_idx] );
-                                rgb_idx = 2;
-                                break;
-                            case 2:
-                                packets[packet_idx].dmp.prop_val[channel_idx] = RGBGetBValue( colors[color_idx] );
-                                rgb_idx = 0;
-                                led_idx++;
-                                color_idx++;
-                                break;
-                        }
+                        chunk_size = data_size - data_idx;
+                    }
 
-                        if(led_idx >= devices[device_idx].num_leds)
-                        {
-                            done = true;
-                        }
+                    memcpy(&packets[packet_idx].dmp.prop_val[channel_idx], &channel_buf[data_idx], chunk_size);
 
-                        channel_idx++;
-                    }
+                    data_idx    += chunk_size;
+                    channel_idx += chunk_size;
                 }
             }
 
             channel_idx = 1;
         }
+
+        color_idx += num_leds;
     }
 
     for(std::size_t packet_idx = 0; packet_idx < packets.size(); packet_idx++)
@@ -457,14 +467,10 @@ void RGBController_E131::DeviceUpdateMode()
 
 }
 
-void RGBController_E131::KeepaliveThreadFunction()
+void RGBController_E131::KeepaliveTimer()
 {
-    while(keepalive_thread_run.load())
+    if((std::chrono::steady_clock::now() - last_update_time) > ( keepalive_delay * 0.95f ) )
     {
-        if((std::chrono::steady_clock::now() - last_update_time) > ( keepalive_delay * 0.95f ) )
-        {
-            UpdateLEDs();
-        }
-        std::this_thread::sleep_for(keepalive_delay / 2);
+        UpdateLEDs();
     }
 }
@@ -12,7 +12,6 @@
 #pragma once
 
 #include <chrono>
-#include <thread>
 #include <e131.h>
 #include "RGBController.h"
 
@@ -74,16 +73,16 @@ public:
 
     void        DeviceUpdateMode();
 
-    void        KeepaliveThreadFunction();
+    void        KeepaliveTimer();
 
 private:
 	std::vector<E131Device> 	devices;
     std::vector<e131_packet_t> 	packets;
 	std::vector<e131_addr_t> 	dest_addrs;
 	std::vector<unsigned int> 	universes;
+    std::vector<unsigned char>  channel_buf;
 	int 						sockfd;
-    std::thread *               keepalive_thread;
-    std::atomic<bool>           keepalive_thread_run;
+    unsigned int                keepalive_timer;
     std::chrono::milliseconds                           keepalive_delay;
     std::chrono::time_point<std::chrono::steady_clock>  last_update_time;
 };
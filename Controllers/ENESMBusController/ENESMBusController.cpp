@@ -12,6 +12,7 @@
 #include <cstring>
 #include "ENESMBusController.h"
 #include "LogManager.h"
+#include "RGBControllerColorFormat.h"
 
 static const char* ene_channels[] =                 /* ENE channel strings                  */
 {
@@ -357,12 +358,7 @@ void ENESMBusController::SetAllColorsDirect(RGBColor* colors)
     unsigned char* color_buf   = new unsigned char[led_count * 3];
     unsigned int   bytes_sent  = 0;
 
-    for(unsigned int i = 0; i < (led_count * 3); i += 3)
-    {
-        color_buf[i + 0] = RGBGetRValue(colors[i / 3]);
-        color_buf[i + 1] = RGBGetBValue(colors[i / 3]);
-        color_buf[i + 2] = RGBGetGValue(colors[i / 3]);
-    }
+    rgb_color_pack(colors, led_count, color_buf, RGB_COLOR_ORDER_RBG);
 
     while(bytes_sent < (led_count * 3))
     {
@@ -386,12 +382,7 @@ void ENESMBusController::SetAllColorsEffect(RGBColor* colors)
     unsigned char* color_buf   = new unsigned char[led_count * 3];
     unsigned int   bytes_sent  = 0;
 
-    for(unsigned int i = 0; i < (led_count * 3); i += 3)
-    {
-        color_buf[i + 0] = RGBGetRValue(colors[i / 3]);
-        color_buf[i + 1] = RGBGetBValue(colors[i / 3]);
-        color_buf[i + 2] = RGBGetGValue(colors[i / 3]);
-    }
+    rgb_color_pack(colors, led_count, color_buf, RGB_COLOR_ORDER_RBG);
 
     while(bytes_sent < (led_count * 3))
     {
@@ -30,21 +30,14 @@ RGBController_ENESMBus::RGBController_ENESMBus(ENESMBusController * controller_p
     controller  = controller_ptr;
 
     /*---------------------------------------------------------*\
-    | Get ENEController settings                                |
-    \*---------------------------------------------------------*/
-    json ene_settings = ResourceManager::get()->GetSettingsManager()->GetSettings("ENESMBusSettings");
-
-    /*---------------------------------------------------------*\
-    | Check if save to device is enabled                        |
+    | Check if save to device is enabled in the ENEController   |
+    | settings                                                  |
     \*---------------------------------------------------------*/
     unsigned int save_flag = 0;
 
-    if(ene_settings.contains("enable_save"))
+    if(ResourceManager::get()->GetSettingsManager()->GetSetting<bool>("ENESMBusSettings", "enable_save", false))
     {
-        if(ene_settings["enable_save"] == true)
-        {
-            save_flag = MODE_FLAG_MANUAL_SAVE;
-        }
+        save_flag = MODE_FLAG_MANUAL_SAVE;
     }
 
     /*---------------------------------------------------------*\
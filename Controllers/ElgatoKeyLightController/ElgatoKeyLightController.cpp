@@ -23,9 +23,12 @@ ElgatoKeyLightController::ElgatoKeyLightController(std::string ip)
     location    = "IP: " + ip;
 
     /*-----------------------------------------------------------------*\
-    | Open a TCP client sending to the device's IP, port 9123          |
+    | Open a persistent TCP connection to the device's IP, port 9123,   |
+    | waiting for each HTTP response before sending the next request    |
     \*-----------------------------------------------------------------*/
-    port.tcp_client(ip.c_str(), "9123");
+    port.open(ip.c_str(), "9123");
+    port.set_response_delimiter(TCP_CONNECTION_HTTP_DELIMITER);
+    port.set_pipeline_depth(1);
 }
 
 ElgatoKeyLightController::~ElgatoKeyLightController()
@@ -62,11 +65,8 @@ void ElgatoKeyLightController::SetColor(hsv_t hsv_color)
     // Weird elgato color format
     int k_value = HSVToK(hsv_color.hue);
 
-    port.tcp_client_connect();
     std::string buf = GetRequest(hsv_color.value, k_value);
-    port.tcp_client_write((char *)buf.c_str(), (int)buf.length() + 1);
-
-    port.tcp_close();
+    port.queue_write(buf.c_str(), (int)buf.length(), ELGATO_KEYLIGHT_COALESCE_COLOR);
 }
 
 std::string ElgatoKeyLightController::GetRequest(int brightness, int temperature)
@@ -82,7 +82,7 @@ std::string ElgatoKeyLightController::GetRequest(int brightness, int temperature
     std::string command_str = command.dump();
     std::string buf = "PUT /elgato/lights HTTP/1.1\r\nContent-Type: application/json\r\nContent-Length: " +
                       std::to_string(command_str.length()) +
-                      "\r\nConnection: close\r\n\r\n" + command_str + "\r\n\r\n";
+                      "\r\nConnection: keep-alive\r\n\r\n" + command_str;
     return(buf);
 }
 
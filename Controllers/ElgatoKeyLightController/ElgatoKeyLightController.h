@@ -16,9 +16,14 @@
 #include <thread>
 #include <vector>
 #include "RGBController.h"
-#include "net_port.h"
+#include "tcp_connection.h"
 #include "hsv.h"
 
+/*---------------------------------------------------------*\
+| Write queue key for color requests                        |
+\*---------------------------------------------------------*/
+#define ELGATO_KEYLIGHT_COALESCE_COLOR          1
+
 class ElgatoKeyLightController
 {
 public:
@@ -37,5 +42,5 @@ private:
     std::string GetRequest(int brightness, int temperature);
     int HSVToK(int hue);
     std::string         location;
-    net_port            port;
+    tcp_connection      port;
 };
@@ -9,6 +9,7 @@
 
 #include "Detector.h"
 #include "ElgatoKeyLightController.h"
+#include "NetworkDetection.h"
 #include "RGBController_ElgatoKeyLight.h"
 #include "SettingsManager.h"
 
@@ -40,10 +41,13 @@ void DetectElgatoKeyLightControllers()
             {
                 std::string elgato_keylight_ip = elgato_keylight_settings["devices"][device_idx]["ip"];
 
-                ElgatoKeyLightController*     controller     = new ElgatoKeyLightController(elgato_keylight_ip);
-                RGBController_ElgatoKeyLight* rgb_controller = new RGBController_ElgatoKeyLight(controller);
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(elgato_keylight_ip, [elgato_keylight_ip]() -> RGBController*
+                {
+                    ElgatoKeyLightController*     controller     = new ElgatoKeyLightController(elgato_keylight_ip);
+                    RGBController_ElgatoKeyLight* rgb_controller = new RGBController_ElgatoKeyLight(controller);
 
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(rgb_controller);
+                });
             }
         }
     }
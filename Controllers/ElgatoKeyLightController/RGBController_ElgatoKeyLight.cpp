@@ -23,6 +23,7 @@ RGBController_ElgatoKeyLight::RGBController_ElgatoKeyLight(ElgatoKeyLightControl
     description         = "Elgato KeyLight Device";
     serial              = controller->GetUniqueID();
     location            = controller->GetLocation();
+    flags              |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
 
     mode Static;
     Static.name         = "Static";
@@ -67,7 +68,7 @@ void RGBController_ElgatoKeyLight::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_ElgatoKeyLight::DeviceUpdateLEDs()
 {
-    RGBColor rgb_color = colors[0];
+    RGBColor rgb_color = GetOutputColors()[0];
     hsv_t hsv_color;
     rgb2hsv(rgb_color, &hsv_color);
     controller->SetColor(hsv_color);
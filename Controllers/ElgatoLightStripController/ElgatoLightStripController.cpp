@@ -28,27 +28,28 @@ ElgatoLightStripController::ElgatoLightStripController(std::string ip)
     location = "IP: " + ip;
 
     /*-----------------------------------------------------------------*\
-    | Open a TCP client sending to the device's IP, port 9123           |
+    | Open a persistent TCP connection to the device's IP, port 9123,   |
+    | waiting for each HTTP response before sending the next request    |
     \*-----------------------------------------------------------------*/
-    port.tcp_client(ip.c_str(), "9123");
+    port.open(ip.c_str(), "9123");
+    port.set_response_delimiter(TCP_CONNECTION_HTTP_DELIMITER);
+    port.set_pipeline_depth(1);
 
     /*-----------------------------------------------------------*\
     | Handle responses received from the Elgato LightStrip device |
     \*-----------------------------------------------------------*/
-    port.tcp_client_connect();
-    std::string buf = "GET /elgato/accessory-info HTTP/1.1\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n";
-    port.tcp_client_write((char *)buf.c_str(), (int)buf.length() + 1);
+    std::string buf = "GET /elgato/accessory-info HTTP/1.1\r\nContent-Type: application/json\r\nConnection: keep-alive\r\n\r\n";
+    port.write(buf.c_str(), (int)buf.length());
 
     char recv_buf[1024];
-    int size = port.tcp_listen(recv_buf, sizeof(recv_buf));
-    port.tcp_close();
+    int size = port.read(recv_buf, sizeof(recv_buf), ELGATO_LIGHTSTRIP_RESPONSE_TIMEOUT_MS);
 
     if(size > 0)
     {
         /*-----------------------------------------------------------*\
         | Get response body                                           |
         \*-----------------------------------------------------------*/
-        std::istringstream recv_stream(recv_buf);
+        std::istringstream recv_stream(std::string(recv_buf, size));
         std::vector<std::string> recv_list;
         std::string current_line;
 
@@ -114,10 +115,8 @@ void ElgatoLightStripController::SetColor(hsv_t hsv_color)
     \*-------------------------------------------------*/
     std::this_thread::sleep_for(std::chrono::milliseconds(150));
 
-    port.tcp_client_connect();
     std::string buf = GetRequest(hsv_color.hue, hsv_color.saturation, GetBrightness());
-    port.tcp_client_write((char *)buf.c_str(), (int)buf.length() + 1);
-    port.tcp_close();
+    port.queue_write(buf.c_str(), (int)buf.length(), ELGATO_LIGHTSTRIP_COALESCE_COLOR);
 }
 
 std::string ElgatoLightStripController::GetRequest(int hue, int saturation, int brightness)
@@ -133,7 +132,7 @@ std::string ElgatoLightStripController::GetRequest(int hue, int saturation, int
     std::string command_str = command.dump();
     std::string buf = "PUT /elgato/lights HTTP/1.1\r\nContent-Type: application/json\r\nContent-Length: " +
                       std::to_string(command_str.length()) +
-                      "\r\nConnection: close\r\n\r\n" + command_str + "\r\n\r\n";
+                      "\r\nConnection: keep-alive\r\n\r\n" + command_str;
 
     return(buf);
 }
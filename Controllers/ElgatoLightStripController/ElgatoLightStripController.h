@@ -13,9 +13,15 @@
 #pragma once
 
 #include <string>
-#include "net_port.h"
+#include "tcp_connection.h"
 #include "hsv.h"
 
+/*---------------------------------------------------------*\
+| Write queue key for color requests                        |
+\*---------------------------------------------------------*/
+#define ELGATO_LIGHTSTRIP_COALESCE_COLOR        1
+#define ELGATO_LIGHTSTRIP_RESPONSE_TIMEOUT_MS   2000
+
 class ElgatoLightStripController
 {
     public:
@@ -38,6 +44,6 @@ class ElgatoLightStripController
         std::string firmware_version;
         std::string serialnumber;
         std::string displayname;
-        net_port port;
+        tcp_connection port;
         int device_brightness;
 };
@@ -9,6 +9,7 @@
 
 #include "Detector.h"
 #include "ElgatoLightStripController.h"
+#include "NetworkDetection.h"
 #include "RGBController_ElgatoLightStrip.h"
 #include "SettingsManager.h"
 
@@ -38,10 +39,13 @@ void DetectElgatoLightStripControllers()
             {
                 std::string elgato_lightstrip_ip = elgato_lightstrip_settings["devices"][device_idx]["ip"];
 
-                ElgatoLightStripController*     controller     = new ElgatoLightStripController(elgato_lightstrip_ip);
-                RGBController_ElgatoLightStrip* rgb_controller = new RGBController_ElgatoLightStrip(controller);
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(elgato_lightstrip_ip, [elgato_lightstrip_ip]() -> RGBController*
+                {
+                    ElgatoLightStripController*     controller     = new ElgatoLightStripController(elgato_lightstrip_ip);
+                    RGBController_ElgatoLightStrip* rgb_controller = new RGBController_ElgatoLightStrip(controller);
 
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(rgb_controller);
+                });
             }
         }
     }
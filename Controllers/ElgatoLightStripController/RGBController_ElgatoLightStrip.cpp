@@ -24,6 +24,7 @@ RGBController_ElgatoLightStrip::RGBController_ElgatoLightStrip(ElgatoLightStripC
     description         = "Elgato LightStrip Device";
     serial              = controller->GetUniqueID();
     location            = controller->GetLocation();
+    flags              |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
 
     mode Direct;
     Direct.name             = "Direct";
@@ -70,7 +71,7 @@ void RGBController_ElgatoLightStrip::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_ElgatoLightStrip::DeviceUpdateLEDs()
 {
-    RGBColor rgb_color = colors[0];
+    RGBColor rgb_color = GetOutputColors()[0];
     hsv_t hsv_color;
     rgb2hsv(rgb_color, &hsv_color);
     controller->SetColor(hsv_color);
@@ -17,11 +17,12 @@
 
 EspurnaController::EspurnaController()
 {
-
+    tcpport = NULL;
 }
 
 EspurnaController::~EspurnaController()
 {
+    delete tcpport;
 }
 
 void EspurnaController::Initialize(char* ledstring)
@@ -54,8 +55,15 @@ void EspurnaController::InitializeEspurna(char * clientname, char * port, char *
     port_name   = port;
 
     strcpy(espurna_apikey, apikey);
-    tcpport = new net_port;
-    tcpport->tcp_client(client_name.c_str(), port_name.c_str());
+
+    /*-----------------------------------------------------*\
+    | Keep the HTTP connection open between requests and    |
+    | wait for each response before sending the next one    |
+    \*-----------------------------------------------------*/
+    tcpport = new tcp_connection;
+    tcpport->open(client_name.c_str(), port_name.c_str());
+    tcpport->set_response_delimiter(TCP_CONNECTION_HTTP_DELIMITER);
+    tcpport->set_pipeline_depth(1);
 }
 
 std::string EspurnaController::GetLocation()
@@ -71,8 +79,6 @@ void EspurnaController::SetLEDs(std::vector<RGBColor> colors)
 
         char get_request[1024];
         snprintf(get_request, 1024, "GET /api/rgb?apikey=%s&value=%%23%02X%02X%02X HTTP/1.1\r\nHost: %s\r\n\r\n", espurna_apikey, RGBGetRValue(color), RGBGetGValue(color), RGBGetBValue(color), client_name.c_str());
-        tcpport->tcp_client_connect();
-        tcpport->tcp_client_write(get_request, (int)strlen(get_request));
-        tcpport->tcp_close();
+        tcpport->queue_write(get_request, (int)strlen(get_request), ESPURNA_COALESCE_COLOR);
     }
 }
@@ -13,7 +13,12 @@
 
 #include <vector>
 #include "RGBController.h"
-#include "net_port.h"
+#include "tcp_connection.h"
+
+/*---------------------------------------------------------*\
+| Write queue key for color requests                        |
+\*---------------------------------------------------------*/
+#define ESPURNA_COALESCE_COLOR      1
 
 #ifndef TRUE
 #define TRUE true
@@ -43,5 +48,5 @@ private:
     std::string client_name;
     char espurna_apikey[128];
 
-    net_port *tcpport;
+    tcp_connection *tcpport;
 };
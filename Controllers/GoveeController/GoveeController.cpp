@@ -35,13 +35,15 @@ GoveeController::GoveeController(std::string ip)
     \*-----------------------------------------------------*/
     ip_address  = ip;
 
+    broadcast_received = false;
+
     /*-----------------------------------------------------*\
-    | Register callback for receiving broadcasts            |
+    | Start the shared broadcast receiver and register      |
+    | callback for receiving broadcasts                     |
     \*-----------------------------------------------------*/
+    StartBroadcastReceiver();
     RegisterReceiveBroadcastCallback(this);
 
-    broadcast_received = false;
-
     /*-----------------------------------------------------*\
     | Request device information                            |
     \*-----------------------------------------------------*/
@@ -50,16 +52,22 @@ GoveeController::GoveeController(std::string ip)
     /*-----------------------------------------------------*\
     | Wait up to 5s for device information to be received   |
     \*-----------------------------------------------------*/
-    for(unsigned int wait_count = 0; wait_count < 500; wait_count++)
     {
-        if(broadcast_received)
-        {
-            break;
-        }
+        std::unique_lock<std::mutex> lock(broadcast_mutex);
 
-        std::this_thread::sleep_for(10ms);
+        broadcast_cv.wait_for(lock, 5s, [this]()
+        {
+            return(broadcast_received.load());
+        });
     }
 
+    /*-----------------------------------------------------*\
+    | Device information is only needed once, release the   |
+    | broadcast receiver                                    |
+    \*-----------------------------------------------------*/
+    UnregisterReceiveBroadcastCallback(this);
+    StopBroadcastReceiver();
+
     /*-----------------------------------------------------*\
     | Open a UDP client sending to the Govee device IP,     |
     | port 4003                                             |
@@ -77,6 +85,11 @@ std::string GoveeController::GetLocation()
     return("IP: " + ip_address);
 }
 
+bool GoveeController::GetBroadcastReceived()
+{
+    return(broadcast_received);
+}
+
 std::string GoveeController::GetSku()
 {
     return(sku);
@@ -153,7 +166,12 @@ void GoveeController::ReceiveBroadcast(char* recv_buf, int size)
                                 wifiVersionSoft = response["msg"]["data"]["wifiVersionSoft"];
                             }
 
-                            broadcast_received = true;
+                            {
+                                std::lock_guard<std::mutex> lock(broadcast_mutex);
+                                broadcast_received = true;
+                            }
+
+                            broadcast_cv.notify_all();
                         }
                     }
                 }
@@ -180,7 +198,7 @@ void GoveeController::SetColor(unsigned char red, unsigned char green, unsigned
     port.udp_write((char *)command_str.c_str(), (int)command_str.length() + 1);
 }
 
-void GoveeController::SendRazerData(RGBColor* colors, unsigned int size)
+void GoveeController::SendRazerData(const RGBColor* colors, unsigned int size)
 {
     std::vector<base64::byte> pkt = { 0xBB, 0x00, 0x00, 0xB0, 0x00, 0x00 };
     json command;
@@ -261,55 +279,86 @@ void GoveeController::SendScan()
 \*---------------------------------------------------------*/
 net_port                        GoveeController::broadcast_port;
 std::vector<GoveeController*>   GoveeController::callbacks;
-std::thread*                    GoveeController::ReceiveThread;
-std::atomic<bool>               GoveeController::ReceiveThreadRun;
+std::mutex                      GoveeController::callbacks_mutex;
+unsigned int                    GoveeController::receiver_users;
+std::mutex                      GoveeController::receiver_mutex;
 
-void GoveeController::ReceiveBroadcastThreadFunction()
+void GoveeController::StartBroadcastReceiver()
 {
-    char recv_buf[1024];
+    std::lock_guard<std::mutex> lock(receiver_mutex);
 
-    broadcast_port.set_receive_timeout(1, 0);
+    if(receiver_users++ > 0)
+    {
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Open a UDP client sending to and receiving from the   |
+    | Govee Multicast IP, send port 4001 and receive port   |
+    | 4002                                                  |
+    \*-----------------------------------------------------*/
+    broadcast_port.udp_client("239.255.255.250", "4001", "4002");
+    broadcast_port.udp_join_multicast_group("239.255.255.250");
 
-    while(ReceiveThreadRun.load())
+    /*-----------------------------------------------------*\
+    | Handle responses received from the Govee devices on   |
+    | the shared network reactor thread                     |
+    \*-----------------------------------------------------*/
+    broadcast_port.set_receive_callback(&GoveeController::ReceiveBroadcastFunction);
+}
+
+void GoveeController::StopBroadcastReceiver()
+{
+    std::lock_guard<std::mutex> lock(receiver_mutex);
+
+    if(--receiver_users > 0)
     {
-        /*-------------------------------------------------*\
-        | Receive up to 1024 bytes from the device with a   |
-        | 1s timeout                                        |
-        \*-------------------------------------------------*/
-        int size = broadcast_port.udp_listen(recv_buf, 1024);
+        return;
+    }
 
-        /*-------------------------------------------------*\
-        | If data was received, loop through registered     |
-        | callback controllers and call the                 |
-        | ReceiveBroadcast function for the controller      |
-        | matching the received data                        |
-        |                                                   |
-        | NOTE: As implemented, it doesn't actually match   |
-        | the intended controller and just calls all        |
-        | registered controllers.  As they are all called   |
-        | sequence, this should work, but if parallel calls |
-        | are ever needed, receives should be filtered by   |
-        | IP address                                        |
-        \*-------------------------------------------------*/
-        if(size > 0)
+    broadcast_port.clear_receive_callback();
+    broadcast_port.tcp_close();
+}
+
+void GoveeController::ReceiveBroadcastFunction(char* recv_buf, int size)
+{
+    /*-----------------------------------------------------*\
+    | If data was received, loop through registered         |
+    | callback controllers and call the ReceiveBroadcast    |
+    | function for the controller matching the received     |
+    | data                                                  |
+    |                                                       |
+    | NOTE: As implemented, it doesn't actually match the   |
+    | intended controller and just calls all registered     |
+    | controllers.  Each controller only accepts the scan   |
+    | response carrying its own IP address, so controllers  |
+    | being constructed in parallel each pick up their own  |
+    | response                                              |
+    \*-----------------------------------------------------*/
+    if(size > 0)
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex);
+
+        for(std::size_t callback_idx = 0; callback_idx < callbacks.size(); callback_idx++)
         {
-            for(std::size_t callback_idx = 0; callback_idx < callbacks.size(); callback_idx++)
-            {
-                GoveeController* controller = callbacks[callback_idx];
+            GoveeController* controller = callbacks[callback_idx];
 
-                controller->ReceiveBroadcast(recv_buf, size);
-            }
+            controller->ReceiveBroadcast(recv_buf, size);
         }
     }
 }
 
 void GoveeController::RegisterReceiveBroadcastCallback(GoveeController* controller_ptr)
 {
+    std::lock_guard<std::mutex> lock(callbacks_mutex);
+
     callbacks.push_back(controller_ptr);
 }
 
 void GoveeController::UnregisterReceiveBroadcastCallback(GoveeController* controller_ptr)
 {
+    std::lock_guard<std::mutex> lock(callbacks_mutex);
+
     for(std::size_t callback_idx = 0; callback_idx < callbacks.size(); callback_idx++)
     {
         if(callbacks[callback_idx] == controller_ptr)
@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 #include "RGBController.h"
 #include "net_port.h"
@@ -27,9 +29,11 @@ public:
     std::string GetSku();
     std::string GetVersion();
 
+    bool        GetBroadcastReceived();
+
     void ReceiveBroadcast(char* recv_buf, int size);
 
-    void SendRazerData(RGBColor* colors, unsigned int size);
+    void SendRazerData(const RGBColor* colors, unsigned int size);
     void SendRazerDisable();
     void SendRazerEnable();
 
@@ -49,23 +53,29 @@ private:
     std::string         wifiVersionHard;
     std::string         wifiVersionSoft;
 
-    bool                broadcast_received;
+    std::atomic<bool>       broadcast_received;
+    std::mutex              broadcast_mutex;
+    std::condition_variable broadcast_cv;
 
     net_port            port;
 
 public:
     /*-----------------------------------------------------*\
-    | One receive thread is shared among all instances of   |
-    | GoveeController, so the receive thread function is    |
-    | static and the thread is initialized in the detector  |
-    | if any GoveeControllers are created.                  |
+    | One broadcast port is shared among all instances of   |
+    | GoveeController, so the receive function is static.   |
+    | The port is watched by the network reactor while any  |
+    | GoveeController is being constructed, which may       |
+    | happen on several detection threads at once.          |
     \*-----------------------------------------------------*/
     static net_port                             broadcast_port;
     static std::vector<GoveeController*>        callbacks;
-    static std::thread*                         ReceiveThread;
-    static std::atomic<bool>                    ReceiveThreadRun;
+    static std::mutex                           callbacks_mutex;
+    static unsigned int                         receiver_users;
+    static std::mutex                           receiver_mutex;
 
-    static void ReceiveBroadcastThreadFunction();
+    static void StartBroadcastReceiver();
+    static void StopBroadcastReceiver();
+    static void ReceiveBroadcastFunction(char* recv_buf, int size);
     static void RegisterReceiveBroadcastCallback(GoveeController* controller_ptr);
     static void UnregisterReceiveBroadcastCallback(GoveeController* controller_ptr);
 };
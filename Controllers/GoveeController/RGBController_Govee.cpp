@@ -11,6 +11,7 @@
 
 #include <map>
 #include "RGBController_Govee.h"
+#include "net_reactor.h"
 
 using namespace std::chrono_literals;
 
@@ -29,6 +30,7 @@ RGBController_Govee::RGBController_Govee(GoveeController* controller_ptr)
     type        = DEVICE_TYPE_LIGHT;
     description = "Govee Device";
     location    = controller->GetLocation();
+    flags      |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
     version     = controller->GetVersion();
 
     mode Static;
@@ -50,15 +52,19 @@ RGBController_Govee::RGBController_Govee(GoveeController* controller_ptr)
 
     SetupZones();
 
-    keepalive_thread_run    = 1;
-    keepalive_thread        = new std::thread(&RGBController_Govee::KeepaliveThread, this);
+    /*-----------------------------------------------------*\
+    | Check every 10s on the shared network reactor thread  |
+    | whether the device needs a keepalive update           |
+    \*-----------------------------------------------------*/
+    keepalive_timer = net_reactor::get()->add_timer(10000, [this]()
+    {
+        KeepaliveTimer();
+    });
 }
 
 RGBController_Govee::~RGBController_Govee()
 {
-    keepalive_thread_run = 0;
-    keepalive_thread->join();
-    delete keepalive_thread;
+    net_reactor::get()->remove(keepalive_timer);
 
     delete controller;
 }
@@ -99,7 +105,9 @@ void RGBController_Govee::DeviceUpdateLEDs()
 
     if(modes[active_mode].color_mode == MODE_COLORS_PER_LED)
     {
-        controller->SendRazerData(&colors[0], (unsigned int)colors.size());
+        const std::vector<RGBColor>& output = GetOutputColors();
+
+        controller->SendRazerData(output.data(), (unsigned int)output.size());
     }
 }
 
@@ -129,14 +137,14 @@ void RGBController_Govee::DeviceUpdateMode()
     }
 }
 
-void RGBController_Govee::KeepaliveThread()
+void RGBController_Govee::KeepaliveTimer()
 {
-    while(keepalive_thread_run.load())
+    /*-----------------------------------------------------*\
+    | Queue the update for the device thread, the reactor   |
+    | thread must not block on the device                   |
+    \*-----------------------------------------------------*/
+    if((std::chrono::steady_clock::now() - last_update_time) > std::chrono::seconds(30))
     {
-        if((std::chrono::steady_clock::now() - last_update_time) > std::chrono::seconds(30))
-        {
-            DeviceUpdateLEDs();
-        }
-        std::this_thread::sleep_for(10s);
+        UpdateLEDs();
     }
 }
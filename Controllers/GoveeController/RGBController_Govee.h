@@ -29,11 +29,10 @@ public:
 
     void        DeviceUpdateMode();
 
-    void        KeepaliveThread();
+    void        KeepaliveTimer();
 
 private:
     GoveeController*                                    controller;
-    std::thread*                                        keepalive_thread;
-    std::atomic<bool>                                   keepalive_thread_run;
+    unsigned int                                        keepalive_timer;
     std::chrono::time_point<std::chrono::steady_clock>  last_update_time;
 };
@@ -119,7 +119,7 @@ void HyperXAlloyEliteController::SetMode
         mode_colors[8]
         );
 
-    std::this_thread::sleep_for(100ms);
+    pacer.ReportSent(100ms);
 }
 
 void HyperXAlloyEliteController::SetLEDsDirect(std::vector<RGBColor> colors)
@@ -149,7 +149,7 @@ void HyperXAlloyEliteController::SetLEDsDirect(std::vector<RGBColor> colors)
         red_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendDirect
         (
@@ -157,7 +157,7 @@ void HyperXAlloyEliteController::SetLEDsDirect(std::vector<RGBColor> colors)
         grn_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendDirect
         (
@@ -165,7 +165,7 @@ void HyperXAlloyEliteController::SetLEDsDirect(std::vector<RGBColor> colors)
         blu_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendDirectExtended
         (
@@ -201,7 +201,7 @@ void HyperXAlloyEliteController::SetLEDs(std::vector<RGBColor> colors)
         red_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendColor
         (
@@ -210,7 +210,7 @@ void HyperXAlloyEliteController::SetLEDs(std::vector<RGBColor> colors)
         grn_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendColor
         (
@@ -219,7 +219,7 @@ void HyperXAlloyEliteController::SetLEDs(std::vector<RGBColor> colors)
         blu_color_data
         );
 
-    std::this_thread::sleep_for(5ms);
+    pacer.ReportSent(5ms);
 
     SendExtendedColor
         (
@@ -257,7 +257,9 @@ void HyperXAlloyEliteController::SelectProfile
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
 
 void HyperXAlloyEliteController::SendEffect
@@ -359,7 +361,9 @@ void HyperXAlloyEliteController::SendEffect
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
 
 void HyperXAlloyEliteController::SendColor
@@ -395,7 +399,9 @@ void HyperXAlloyEliteController::SendColor
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
 
 void HyperXAlloyEliteController::SendExtendedColor
@@ -430,7 +436,9 @@ void HyperXAlloyEliteController::SendExtendedColor
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
 
 void HyperXAlloyEliteController::SendDirect
@@ -465,7 +473,9 @@ void HyperXAlloyEliteController::SendDirect
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
 
 void HyperXAlloyEliteController::SendDirectExtended
@@ -499,5 +509,7 @@ void HyperXAlloyEliteController::SendDirectExtended
     /*-----------------------------------------------------*\
     | Send packet                                           |
     \*-----------------------------------------------------*/
+    pacer.WaitForReport();
     hid_send_feature_report(dev, buf, 264);
+    pacer.ReportSent();
 }
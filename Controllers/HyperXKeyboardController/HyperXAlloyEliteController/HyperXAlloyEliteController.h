@@ -13,6 +13,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "HIDReportPacer.h"
 #include "RGBController.h"
 
 enum
@@ -89,6 +90,7 @@ private:
     unsigned char           active_direction;
     unsigned char           active_speed;
     std::string             location;
+    HIDReportPacer          pacer;
 
     void    SelectProfile
                 (
@@ -26,9 +26,10 @@ KasaSmartController::KasaSmartController(std::string ipAddress, std::string name
     location = "IP: " + ipAddress;
 
     /*---------------------------------------------------------*\
-    | Create a TCP client sending to the device's IP, port 9999 |
+    | Open a persistent TCP connection to the device's IP, port |
+    | 9999, kept open across commands                           |
     \*---------------------------------------------------------*/
-    port.tcp_client(ipAddress.c_str(), "9999");
+    port.open(ipAddress.c_str(), "9999");
 }
 
 bool KasaSmartController::Initialize()
@@ -36,25 +37,20 @@ bool KasaSmartController::Initialize()
     is_initialized = false;
     retry_count = 0;
 
-    /*--------------*\
-    | Try to connect |
-    \*--------------*/
-    while(!port.connected && !port.tcp_client_connect() && retry_count < KASA_SMART_MAX_CONNECTION_ATTEMPTS)
+    /*-----------------------------------*\
+    | Try to connect and query the device |
+    \*-----------------------------------*/
+    const std::string system_info_query(KASA_SMART_SYSTEM_INFO_QUERY);
+    std::string system_info_json;
+    bool command_sent = false;
+
+    while(!command_sent && retry_count < KASA_SMART_MAX_CONNECTION_ATTEMPTS)
     {
+        command_sent = KasaSmartController::SendCommand(system_info_query, system_info_json);
         ++retry_count;
     }
-    if(!port.connected)
-    {
-        /*----------------*\
-        | Couldn't connect |
-        \*----------------*/
-        return is_initialized;
-    }
+    retry_count = 0;
 
-    const std::string system_info_query(KASA_SMART_SYSTEM_INFO_QUERY);
-    std::string system_info_json;
-    bool command_sent = KasaSmartController::SendCommand(system_info_query, system_info_json);
-    port.tcp_close();
     if(!command_sent || system_info_json.empty())
     {
         /*---------------------------------------*\
@@ -147,10 +143,7 @@ bool KasaSmartController::Initialize()
 
 KasaSmartController::~KasaSmartController()
 {
-    if(port.connected)
-    {
-        port.tcp_close();
-    }
+    port.close();
 }
 
 std::string KasaSmartController::GetLocation()
@@ -208,16 +201,6 @@ void KasaSmartController::SetColor(unsigned char red, unsigned char green, unsig
     unsigned int normalized_saturation = hsv.saturation * 100 / 255;
     unsigned int normalized_value      = hsv.value * 100 / 255;
 
-
-    /*-------------------*\
-    | Open TCP connection |
-    \*-------------------*/
-    if(!port.connected && !port.tcp_client_connect() && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
-    {
-        is_initialized = false;
-        return;
-    }
-
     /*----------------------------*\
     | Hack to handle/emulate black |
     \*----------------------------*/
@@ -242,7 +225,6 @@ void KasaSmartController::SetColor(unsigned char red, unsigned char green, unsig
     int size = std::snprintf(nullptr, 0, set_lightstate_command_format.c_str(), normalized_hue, normalized_saturation, normalized_value) + 1;
     if(size <= 0)
     {
-        port.tcp_close();
         return;
     }
     char* buf = new char[size];
@@ -254,8 +236,10 @@ void KasaSmartController::SetColor(unsigned char red, unsigned char green, unsig
     | Send command, ignore response |
     \*-----------------------------*/
     std::string response;
-    KasaSmartController::SendCommand(set_lightstate_command, response);
-    port.tcp_close();
+    if(!KasaSmartController::SendCommand(set_lightstate_command, response) && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
+    {
+        is_initialized = false;
+    }
 }
 
 void KasaSmartController::SetEffect(std::string effect)
@@ -265,18 +249,11 @@ void KasaSmartController::SetEffect(std::string effect)
         return;
     }
 
-    /*-------------------*\
-    | Open TCP connection |
-    \*-------------------*/
-    if(!port.connected && !port.tcp_client_connect() && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
+    std::string response;
+    if(!KasaSmartController::SendCommand(effect, response) && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
     {
         is_initialized = false;
-        return;
     }
-
-    std::string response;
-    KasaSmartController::SendCommand(effect, response);
-    port.tcp_close();
 }
 
 void KasaSmartController::TurnOff(int device_type)
@@ -296,39 +273,55 @@ void KasaSmartController::TurnOff(int device_type)
         turn_off_command = KASA_SMART_LEDSTRIP_OFF_COMMAND;
     }
 
-    if(!port.connected && !port.tcp_client_connect() && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
+    std::string response;
+    if(!KasaSmartController::SendCommand(turn_off_command, response) && ++retry_count >= KASA_SMART_MAX_CONNECTION_ATTEMPTS)
     {
         is_initialized = false;
-        return;
     }
-    std::string response;
-    KasaSmartController::SendCommand(turn_off_command, response);
-    port.tcp_close();
 }
 
 bool KasaSmartController::SendCommand(std::string command, std::string &response)
 {
     const unsigned char* encrypted_payload = KasaSmartController::Encrypt(command);
-    port.tcp_client_write((char*)encrypted_payload, (int)(command.length() + sizeof(unsigned long)));
-    delete[] encrypted_payload;
+    int payload_length = (int)(command.length() + sizeof(uint32_t));
 
     unsigned char* receive_buffer = new unsigned char[KASA_SMART_RECEIVE_BUFFER_SIZE];
-    int response_length = port.tcp_listen((char*)receive_buffer, KASA_SMART_RECEIVE_BUFFER_SIZE);
-    if(response_length > KASA_SMART_RECEIVE_BUFFER_SIZE || response_length <= 0) {
+    int response_length = 0;
+
+    /*-------------------------------------------------------------*\
+    | The device may have closed the connection while it was idle,  |
+    | which only shows up as an empty response.  Retry once on a    |
+    | fresh connection.                                             |
+    \*-------------------------------------------------------------*/
+    for(unsigned int attempt = 0; attempt < 2 && response_length <= 0; attempt++)
+    {
+        if(port.write((const char*)encrypted_payload, payload_length) < 0)
+        {
+            break;
+        }
+
+        response_length = port.read((char*)receive_buffer, KASA_SMART_RECEIVE_BUFFER_SIZE, KASA_SMART_RESPONSE_TIMEOUT_MS);
+    }
+    delete[] encrypted_payload;
+
+    if(response_length > KASA_SMART_RECEIVE_BUFFER_SIZE || response_length < (int)sizeof(uint32_t)) {
         /*-------------------------------------------------------------*\
         | Small fail safes to prevent decrypting bad or empty responses |
         \*-------------------------------------------------------------*/
+        delete[] receive_buffer;
         return false;
     }
 
+    /*-------------------------------------------------------------*\
+    | The size field does not count itself.  Read exactly one       |
+    | response so nothing is left over on the connection.           |
+    \*-------------------------------------------------------------*/
     unsigned long received_length = response_length;
-    unsigned long response_full_length = 0;
-    if(response_length > 0)
-    {
-        response_full_length = ntohl(*(uint32_t*)receive_buffer);
-    }
+    unsigned long response_full_length = ntohl(*(uint32_t*)receive_buffer) + sizeof(uint32_t);
 
     if(response_full_length > KASA_SMART_RECEIVE_BUFFER_SIZE) {
+        port.close();
+        delete[] receive_buffer;
         return false;
     }
 
@@ -337,16 +330,22 @@ bool KasaSmartController::SendCommand(std::string command, std::string &response
     \*--------------------------*/
     while(received_length < response_full_length)
     {
-        received_length += port.tcp_listen((char*)receive_buffer + received_length, KASA_SMART_RECEIVE_BUFFER_SIZE - received_length);
-    }
+        int chunk_length = port.read((char*)receive_buffer + received_length, (int)(response_full_length - received_length), KASA_SMART_RESPONSE_TIMEOUT_MS);
 
-    if(received_length > 0)
-    {
-        /*------------------------------------------------*\
-        | Decrypt payload data preceeding the payload size |
-        \*------------------------------------------------*/
-        KasaSmartController::Decrypt(receive_buffer + sizeof(uint32_t), received_length - sizeof(uint32_t), response);
+        if(chunk_length <= 0)
+        {
+            delete[] receive_buffer;
+            return false;
+        }
+
+        received_length += chunk_length;
     }
+
+    /*------------------------------------------------*\
+    | Decrypt payload data preceeding the payload size |
+    \*------------------------------------------------*/
+    KasaSmartController::Decrypt(receive_buffer + sizeof(uint32_t), (int)(response_full_length - sizeof(uint32_t)), response);
+
     delete[] receive_buffer;
     return true;
 }
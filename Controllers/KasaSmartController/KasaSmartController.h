@@ -15,7 +15,7 @@
 #include <thread>
 #include <vector>
 #include "RGBController.h"
-#include "net_port.h"
+#include "tcp_connection.h"
 
 enum
 {
@@ -34,6 +34,7 @@ enum
 #define KASA_SMART_INITIALIZATION_VECTOR 0xAB
 #define KASA_SMART_RECEIVE_BUFFER_SIZE 4096
 #define KASA_SMART_MAX_CONNECTION_ATTEMPTS 3
+#define KASA_SMART_RESPONSE_TIMEOUT_MS 2000
 
 /*-------------------------*\
 | Kasa Smart Light Commands |
@@ -67,7 +68,7 @@ public:
     void TurnOff(int device_type);
 
 private:
-    net_port port;
+    tcp_connection port;
     std::string name;
     bool is_initialized;
     unsigned int retry_count;
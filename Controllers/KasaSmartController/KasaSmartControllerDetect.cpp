@@ -11,6 +11,7 @@
 
 #include "Detector.h"
 #include "KasaSmartController.h"
+#include "NetworkDetection.h"
 #include "RGBController_KasaSmart.h"
 #include "SettingsManager.h"
 
@@ -43,14 +44,17 @@ void DetectKasaSmartControllers()
                 std::string kasa_smart_ip = kasa_smart_settings["devices"][device_idx]["ip"];
                 std::string name          = kasa_smart_settings["devices"][device_idx]["name"];
 
-                KasaSmartController* controller = new KasaSmartController(kasa_smart_ip, name);
-                if(!controller->Initialize())
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(kasa_smart_ip, [kasa_smart_ip, name]() -> RGBController*
                 {
-                    continue;
-                }
+                    KasaSmartController* controller = new KasaSmartController(kasa_smart_ip, name);
+                    if(!controller->Initialize())
+                    {
+                        delete controller;
+                        return(nullptr);
+                    }
 
-                RGBController_KasaSmart* rgb_controller = new RGBController_KasaSmart(controller);
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(new RGBController_KasaSmart(controller));
+                });
             }
         }
     }
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <string>
 #include "LEDStripController.h"
+#include "RGBControllerColorFormat.h"
 #include "ResourceManager.h"
 
 LEDStripController::LEDStripController()
@@ -212,14 +213,7 @@ void LEDStripController::SetLEDsKeyboardVisualizer(std::vector<RGBColor> colors)
     /*-------------------------------------------------------------*\
     | Copy in color data in RGB order                               |
     \*-------------------------------------------------------------*/
-    for(unsigned int color_idx = 0; color_idx < colors.size(); color_idx++)
-    {
-        unsigned int color_offset = color_idx * 3;
-
-        serial_buf[0x01 + color_offset]     = RGBGetRValue(colors[color_idx]);
-        serial_buf[0x02 + color_offset]     = RGBGetGValue(colors[color_idx]);
-        serial_buf[0x03 + color_offset]     = RGBGetBValue(colors[color_idx]);
-    }
+    rgb_color_pack(colors.data(), (unsigned int)colors.size(), &serial_buf[0x01], RGB_COLOR_ORDER_RGB);
 
     /*-------------------------------------------------------------*\
     | Calculate the checksum                                        |
@@ -288,14 +282,7 @@ void LEDStripController::SetLEDsAdalight(std::vector<RGBColor> colors)
     /*-------------------------------------------------------------*\
     | Copy in color data in RGB order                               |
     \*-------------------------------------------------------------*/
-    for(unsigned int color_idx = 0; color_idx < led_count; color_idx++)
-    {
-        unsigned int color_offset = color_idx * 3;
-
-        serial_buf[0x06 + color_offset]     = RGBGetRValue(colors[color_idx]);
-        serial_buf[0x07 + color_offset]     = RGBGetGValue(colors[color_idx]);
-        serial_buf[0x08 + color_offset]     = RGBGetBValue(colors[color_idx]);
-    }
+    rgb_color_pack(colors.data(), led_count, &serial_buf[0x06], RGB_COLOR_ORDER_RGB);
 
     /*-------------------------------------------------------------*\
     | Send the packet                                               |
@@ -341,14 +328,7 @@ void LEDStripController::SetLEDsTPM2(std::vector<RGBColor> colors)
     /*-------------------------------------------------------------*\
     | Copy in color data in RGB order                               |
     \*-------------------------------------------------------------*/
-    for(unsigned int color_idx = 0; color_idx < colors.size(); color_idx++)
-    {
-        unsigned int color_offset = color_idx * 3;
-
-        serial_buf[0x04 + color_offset]     = RGBGetRValue(colors[color_idx]);
-        serial_buf[0x05 + color_offset]     = RGBGetGValue(colors[color_idx]);
-        serial_buf[0x06 + color_offset]     = RGBGetBValue(colors[color_idx]);
-    }
+    rgb_color_pack(colors.data(), (unsigned int)colors.size(), &serial_buf[0x04], RGB_COLOR_ORDER_RGB);
 
     /*-------------------------------------------------------------*\
     | Send the packet                                               |
@@ -10,8 +10,11 @@
 \*---------------------------------------------------------*/
 
 #include "LIFXController.h"
+#include <condition_variable>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include "hsv.h"
+#include "net_reactor.h"
 
 using json = nlohmann::json;
 using namespace std::chrono_literals;
@@ -116,6 +119,29 @@ void LIFXController::FetchZoneCount()
         return;
     }
 
+    /*-----------------------------------------------------------------*\
+    | Listen for the state zone packet on the shared network reactor    |
+    | thread, registered before the request goes out so a fast reply    |
+    | is not missed                                                     |
+    \*-----------------------------------------------------------------*/
+    std::vector<unsigned char>  response;
+    bool                        response_received = false;
+    std::mutex                  response_mutex;
+    std::condition_variable     response_cv;
+
+    port.set_receive_callback([&](char* recv_buf, int size)
+    {
+        std::lock_guard<std::mutex> lock(response_mutex);
+
+        if(!response_received && (size > 0))
+        {
+            response.assign(recv_buf, recv_buf + size);
+            response_received = true;
+
+            response_cv.notify_all();
+        }
+    });
+
     /*---------------------------*\
     | Send get color zones packet |
     \*---------------------------*/
@@ -131,21 +157,32 @@ void LIFXController::FetchZoneCount()
     port.udp_write((char*)data, (int)data_buf_size);
     delete[] data;
 
-    /*----------------------------*\
-    | Listen for state zone packet |
-    \*----------------------------*/
+    /*---------------------------------------*\
+    | Wait up to 5s for the state zone packet |
+    \*---------------------------------------*/
+    {
+        std::unique_lock<std::mutex> lock(response_mutex);
+
+        response_cv.wait_for(lock, 5s, [&]()
+        {
+            return(response_received);
+        });
+    }
+
+    port.clear_receive_callback();
+
     data_buf_size = LIFX_PACKET_HEADER_LENGTH + LIFX_STATE_ZONE_PACKET_LENGTH;
     data = new unsigned char[data_buf_size];
     memset(data, 0, data_buf_size);
 
-    port.set_receive_timeout(5, 0);
-    port.udp_listen((char*)data, (int)data_buf_size);
+    memcpy(data, response.data(), std::min(response.size(), data_buf_size));
 
     /*-----------------*\
     | Validate response |
     \*-----------------*/
     if(HeaderPacketGetSize() != data_buf_size || HeaderPacketGetProtocol() != LIFX_PROTOCOL || HeaderPacketGetPacketType() != LIFX_PACKET_TYPE_STATE_ZONE)
     {
+        delete[] data;
         return;
     }
 
@@ -11,6 +11,7 @@
 
 #include "Detector.h"
 #include "LIFXController.h"
+#include "NetworkDetection.h"
 #include "RGBController_LIFX.h"
 #include "SettingsManager.h"
 
@@ -45,12 +46,15 @@ void DetectLIFXControllers()
                 bool multizone          = lifx_settings["devices"][device_idx]["multizone"];
                 bool extended_multizone = lifx_settings["devices"][device_idx]["extended_multizone"];
 
-                LIFXController* controller = new LIFXController(lifx_ip, name, multizone, extended_multizone);
-                controller->FetchZoneCount();
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(lifx_ip, [lifx_ip, name, multizone, extended_multizone]() -> RGBController*
+                {
+                    LIFXController* controller = new LIFXController(lifx_ip, name, multizone, extended_multizone);
+                    controller->FetchZoneCount();
 
-                RGBController_LIFX* rgb_controller = new RGBController_LIFX(controller);
+                    RGBController_LIFX* rgb_controller = new RGBController_LIFX(controller);
 
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(rgb_controller);
+                });
             }
         }
     }
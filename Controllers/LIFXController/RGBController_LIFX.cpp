@@ -33,6 +33,7 @@ RGBController_LIFX::RGBController_LIFX(LIFXController* controller_ptr)
     description = "LIFX Device";
     serial      = controller->GetUniqueID();
     location    = controller->GetLocation();
+    flags      |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
 
     mode Direct;
     Direct.name       = "Direct";
@@ -113,7 +114,7 @@ void RGBController_LIFX::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_LIFX::DeviceUpdateLEDs()
 {
-    controller->SetColors(colors);
+    controller->SetColors(GetOutputColors());
 }
 
 void RGBController_LIFX::UpdateZoneLEDs(int /*zone*/)
@@ -42,6 +42,7 @@ RGBController_LogitechLightspeed::RGBController_LogitechLightspeed(LogitechLight
         description                 = "Logitech Wireless Lightspeed Device";
         location                    = controller->GetDeviceLocation();
         serial                      = controller->GetSerialString();
+        flags                      |= CONTROLLER_FLAG_ADAPTIVE_RATE;
 
         switch(controller->lightspeed->logitech_device_type)
         {
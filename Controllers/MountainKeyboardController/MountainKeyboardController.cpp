@@ -11,7 +11,6 @@
 
 #include <chrono>
 #include <cstring>
-#include <thread>
 #include "MountainKeyboardController.h"
 #include "StringUtils.h"
 
@@ -55,8 +54,9 @@ void MountainKeyboardController::SelectMode(unsigned char mode_idx)
     usb_buf[0x02] = MOUNTAIN_KEYBOARD_SELECT_MODE_CMD;
     usb_buf[0x05] = 0x01; //constant data
     usb_buf[0x06] = mode_idx;
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(200ms);
+    pacer.ReportSent(200ms);
 }
 
 void MountainKeyboardController::SaveData(unsigned char mode_idx)
@@ -67,8 +67,9 @@ void MountainKeyboardController::SaveData(unsigned char mode_idx)
     usb_buf[0x01] = MOUNTAIN_KEYBOARD_SAVE_CMD;
     usb_buf[0x02] = MOUNTAIN_KEYBOARD_SAVE_MAGIC1;
     usb_buf[0x05] = mode_idx;
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(200ms);
+    pacer.ReportSent(200ms);
 }
 
 void MountainKeyboardController::SendOffCmd()
@@ -87,8 +88,9 @@ void MountainKeyboardController::SendOffCmd()
     usb_buf[0x08] = 0xFF; // constant data
     usb_buf[0x09] = 0xFF; // constant data
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 
@@ -111,8 +113,9 @@ void MountainKeyboardController::SendColorStaticCmd(color_setup setup)
     usb_buf[0x0B] = setup.mode.one_color.g;
     usb_buf[0x0C] = setup.mode.one_color.b;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorWaveCmd(color_setup setup)
@@ -185,8 +188,9 @@ void MountainKeyboardController::SendColorWaveCmd(color_setup setup)
         break;
     }
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorTornadoCmd(color_setup setup)
@@ -232,8 +236,9 @@ void MountainKeyboardController::SendColorTornadoCmd(color_setup setup)
         default:
         break;
     }
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorBreathingCmd( color_setup setup)
@@ -286,8 +291,9 @@ void MountainKeyboardController::SendColorBreathingCmd( color_setup setup)
         default:
         break;
     }
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorMatrixCmd(color_setup setup)
@@ -313,8 +319,9 @@ void MountainKeyboardController::SendColorMatrixCmd(color_setup setup)
     usb_buf[0x14] = setup.mode.two_colors.g2;
     usb_buf[0x15] = setup.mode.two_colors.b2;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorReactiveCmd(color_setup setup)
@@ -340,8 +347,9 @@ void MountainKeyboardController::SendColorReactiveCmd(color_setup setup)
     usb_buf[0x14] = setup.mode.two_colors.g2;
     usb_buf[0x15] = setup.mode.two_colors.b2;
 
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorStartPacketCmd(unsigned char brightness)
@@ -355,8 +363,9 @@ void MountainKeyboardController::SendColorStartPacketCmd(unsigned char brightnes
     usb_buf[0x03] = MOUNTAIN_KEYBOARD_CUSTOM_MSG; // constant data
     usb_buf[0x04] = 0x00; // constant data
     usb_buf[0x06] = brightness;
+    pacer.WaitForReport();
     hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-    std::this_thread::sleep_for(10ms);
+    pacer.ReportSent(10ms);
 }
 
 void MountainKeyboardController::SendColorPacketCmd(unsigned char pkt_no,unsigned char brightness, unsigned char *data, unsigned int data_size)
@@ -377,8 +386,9 @@ void MountainKeyboardController::SendColorPacketCmd(unsigned char pkt_no,unsigne
         {
             memset(&usb_buf[MOUNTAIN_KEYBOARD_USB_BUFFER_HEADER_SIZE + data_size],0x00,MOUNTAIN_KEYBOARD_USB_MAX_DIRECT_PAYLOAD_SIZE-data_size);
         }
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-        std::this_thread::sleep_for(5ms);
+        pacer.ReportSent(5ms);
     }
 }
 
@@ -400,8 +410,9 @@ void MountainKeyboardController::SendColorEdgePacketCmd(unsigned char pkt_no, un
         {
             memset(&usb_buf[MOUNTAIN_KEYBOARD_USB_BUFFER_HEADER_SIZE + data_size],0x00,MOUNTAIN_KEYBOARD_USB_MAX_DIRECT_PAYLOAD_SIZE-data_size);
         }
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-        std::this_thread::sleep_for(5ms);
+        pacer.ReportSent(5ms);
     }
 }
 
@@ -416,8 +427,9 @@ void MountainKeyboardController::SendColorPacketFinishCmd()
     for(unsigned char i=0;i<3;i++)
     {
         usb_buf[0x03] = i;
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_USB_BUFFER_SIZE);
-        std::this_thread::sleep_for(10ms);
+        pacer.ReportSent(10ms);
     }
 }
 
@@ -433,7 +445,9 @@ void MountainKeyboardController::SendWheelColorChange(unsigned char color_data [
         usb_buf->r = color_data[0];
         usb_buf->g = color_data[1];
         usb_buf->b = color_data[2];
+        pacer.WaitForReport();
         hid_write(dev, (unsigned char *) usb_buf, MOUNTAIN_KEYBOARD_WHEEL_CONFIG_BUFFER_SIZE);
+        pacer.ReportSent();
     }
 
 }
@@ -452,7 +466,9 @@ wheel_config * MountainKeyboardController::GetWheelConfig()
         wheel_config * usb_conf = (wheel_config *) usb_buf;
         usb_conf->config_start_first = 0x11;
         usb_conf->config_start_second = 0x14;
+        pacer.WaitForReport();
         hid_write(dev, usb_buf, MOUNTAIN_KEYBOARD_WHEEL_CONFIG_BUFFER_SIZE);
+        pacer.ReportSent();
         memset(usb_buf, 0x00, MOUNTAIN_KEYBOARD_WHEEL_CONFIG_BUFFER_SIZE+1);
         hid_read_timeout(dev, recv_buf, MOUNTAIN_KEYBOARD_WHEEL_CONFIG_BUFFER_SIZE, 1);
         if (usb_conf->config_start_first == MOUNTAIN_KEYBOARD_WHEEL_CONFIG_FIRST_BYTE &&
@@ -13,6 +13,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "HIDReportPacer.h"
 
 /*-----------------------------------------------------*\
 | Mountain vendor ID                                    |
@@ -177,4 +178,5 @@ private:
 
     hid_device*             dev;
     std::string             location;
+    HIDReportPacer          pacer;
 };
@@ -9,21 +9,13 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include "NanoleafController.h"
 #include "LogManager.h"
 #include "httplib.h"
 
-long APIRequest(std::string method, std::string location, std::string URI, json* request_data = nullptr, json* response_data = nullptr)
+static long APIRequest(httplib::Client& client, std::string method, std::string location, std::string URI, json* request_data = nullptr, json* response_data = nullptr)
 {
-    /*-------------------------------------------------------------*\
-    | Append http:// to the location field to create the URL        |
-    \*-------------------------------------------------------------*/
-    const std::string url("http://" + location);
-
-    /*-------------------------------------------------------------*\
-    | Create httplib Client and variables to hold result            |
-    \*-------------------------------------------------------------*/
-    httplib::Client client(url.c_str());
     int             status  = 0;
     std::string     body    = "";
 
@@ -96,12 +88,25 @@ long APIRequest(std::string method, std::string location, std::string URI, json*
     }
     else
     {
-        LOG_DEBUG("[Nanoleaf] HTTP %i:Could not %s from %s", status, method.c_str(), url.c_str());
+        LOG_DEBUG("[Nanoleaf] HTTP %i:Could not %s from http://%s", status, method.c_str(), location.c_str());
     }
 
     return status;
 }
 
+static long APIRequest(std::string method, std::string location, std::string URI, json* request_data = nullptr, json* response_data = nullptr)
+{
+    /*-------------------------------------------------------------*\
+    | Append http:// to the location field to create the URL and    |
+    | create a httplib Client for this one request                  |
+    \*-------------------------------------------------------------*/
+    const std::string url("http://" + location);
+
+    httplib::Client client(url.c_str());
+
+    return APIRequest(client, method, location, URI, request_data, response_data);
+}
+
 NanoleafController::NanoleafController(std::string a_address, int a_port, std::string a_auth_token)
 {
     address                 = a_address;
@@ -109,8 +114,21 @@ NanoleafController::NanoleafController(std::string a_address, int a_port, std::s
     auth_token              = a_auth_token;
     location                = address + ":" + std::to_string(port);
 
+    external_control_open   = false;
+    stream_header_size      = 0;
+    stream_record_size      = 0;
+    stream_color_offset     = 0;
+
+    /*-------------------------------------------------------------*\
+    | Keep one HTTP connection to the device open for all requests  |
+    \*-------------------------------------------------------------*/
+    const std::string url("http://" + location);
+
+    http_client             = new httplib::Client(url.c_str());
+    http_client->set_keep_alive(true);
+
     json data;
-    if(APIRequest("GET", location, "/api/v1/"+auth_token, nullptr, &data) == 200)
+    if(APIRequest(*http_client, "GET", location, "/api/v1/"+auth_token, nullptr, &data) == 200)
     {
         name                = data["name"];
         serial              = data["serialNo"];
@@ -133,10 +151,16 @@ NanoleafController::NanoleafController(std::string a_address, int a_port, std::s
     }
     else
     {
+        delete http_client;
         throw std::exception();
     }
 }
 
+NanoleafController::~NanoleafController()
+{
+    delete http_client;
+}
+
 std::string NanoleafController::Pair(std::string address, int port)
 {
     const std::string location = address+":"+std::to_string(port);
@@ -162,11 +186,35 @@ void NanoleafController::Unpair(std::string address, int port, std::string auth_
     APIRequest("DELETE", location, "/api/v1/"+auth_token, nullptr, nullptr);
 }
 
-void NanoleafController::UpdateLEDs(std::vector<RGBColor>& colors)
+void NanoleafController::UpdateLEDs(const std::vector<RGBColor>& colors)
 {
     /*-------------------------------------------------------------*\
     | Requires StartExternalControl() to have been called prior.    |
+    | The message already holds the panel IDs, fill in the colors.  |
     \*-------------------------------------------------------------*/
+    if(!external_control_open || stream_message.empty())
+    {
+        return;
+    }
+
+    std::size_t size    = std::min(panel_ids.size(), colors.size());
+    uint8_t*    record  = stream_message.data() + stream_header_size + stream_color_offset;
+
+    for(std::size_t i = 0; i < size; i++)
+    {
+        record[0]       = (uint8_t)RGBGetRValue(colors[i]);                 /* R                */
+        record[1]       = (uint8_t)RGBGetGValue(colors[i]);                 /* G                */
+        record[2]       = (uint8_t)RGBGetBValue(colors[i]);                 /* B                */
+
+        record         += stream_record_size;
+    }
+
+    external_control_socket.udp_write((char *)stream_message.data(), (int)stream_message.size());
+}
+
+void NanoleafController::BuildStreamMessage()
+{
+    std::size_t size    = panel_ids.size();
 
     if(model == NANOLEAF_LIGHT_PANELS_MODEL)
     {
@@ -185,26 +233,21 @@ void NanoleafController::UpdateLEDs(std::vector<RGBColor>& colors)
         | 1         W               White channel (ignored)         |
         | 1         transitionTime  Transition time (x 100ms)       |
         \*---------------------------------------------------------*/
-        std::size_t size    = panel_ids.size();
+        stream_header_size  = 1;
+        stream_record_size  = 7;
+        stream_color_offset = 2;
 
-        uint8_t* message    = (uint8_t*)malloc((size * 7) + 1);
+        stream_message.assign((size * stream_record_size) + stream_header_size, 0);
 
-        message[0]          = (uint8_t)size;                                /* nPanels          */
+        stream_message[0]   = (uint8_t)size;                                /* nPanels          */
 
-        for(unsigned int i = 0; i < size; i++)
+        for(std::size_t i = 0; i < size; i++)
         {
-            message[(7 * i) + 0 + 1] = (uint8_t)panel_ids[i];               /* panelId          */
-            message[(7 * i) + 1 + 1] = (uint8_t)1;                          /* nFrames          */
-            message[(7 * i) + 2 + 1] = (uint8_t)RGBGetRValue(colors[i]);    /* R                */
-            message[(7 * i) + 3 + 1] = (uint8_t)RGBGetGValue(colors[i]);    /* G                */
-            message[(7 * i) + 4 + 1] = (uint8_t)RGBGetBValue(colors[i]);    /* B                */
-            message[(7 * i) + 5 + 1] = (uint8_t)0;                          /* W                */
-            message[(7 * i) + 6 + 1] = (uint8_t)0;                          /* transitionTime   */
-        }
+            uint8_t* record = &stream_message[(stream_record_size * i) + stream_header_size];
 
-        external_control_socket.udp_write((char*)message, ((int)size * 7) + 1);
-
-        free(message);
+            record[0]       = (uint8_t)panel_ids[i];                        /* panelId          */
+            record[1]       = (uint8_t)1;                                   /* nFrames          */
+        }
     }
     else if((model == NANOLEAF_CANVAS_MODEL)
          || (model == NANOLEAF_SHAPES_MODEL))
@@ -223,33 +266,38 @@ void NanoleafController::UpdateLEDs(std::vector<RGBColor>& colors)
         | 1         W               White channel (ignored)         |
         | 2         transitionTime  Transition time (x 100ms)       |
         \*---------------------------------------------------------*/
-        std::size_t size    = panel_ids.size();
+        stream_header_size  = 2;
+        stream_record_size  = 8;
+        stream_color_offset = 2;
 
-        uint8_t* message    = (uint8_t*)malloc((size * 8) + 2);
+        stream_message.assign((size * stream_record_size) + stream_header_size, 0);
 
-        message[0]          = (uint8_t)(size >> 8);                         /* nPanels H        */
-        message[1]          = (uint8_t)(size & 0xFF);                       /* nPanels L        */
+        stream_message[0]   = (uint8_t)(size >> 8);                         /* nPanels H        */
+        stream_message[1]   = (uint8_t)(size & 0xFF);                       /* nPanels L        */
 
-        for(unsigned int i = 0; i < size; i++)
+        for(std::size_t i = 0; i < size; i++)
         {
-            message[(8 * i) + 0 + 2] = (uint8_t)(panel_ids[i] >> 8);        /* panelId H        */
-            message[(8 * i) + 1 + 2] = (uint8_t)(panel_ids[i] & 0xFF);      /* panelId L        */
-            message[(8 * i) + 2 + 2] = (uint8_t)RGBGetRValue(colors[i]);    /* R                */
-            message[(8 * i) + 3 + 2] = (uint8_t)RGBGetGValue(colors[i]);    /* G                */
-            message[(8 * i) + 4 + 2] = (uint8_t)RGBGetBValue(colors[i]);    /* B                */
-            message[(8 * i) + 5 + 2] = (uint8_t)0;                          /* W                */
-            message[(8 * i) + 6 + 2] = (uint8_t)0;                          /* transitionTime H */
-            message[(8 * i) + 7 + 2] = (uint8_t)0;                          /* transitionTime L */
-        }
-
-        external_control_socket.udp_write((char *)message, ((int)size * 8) + 2);
+            uint8_t* record = &stream_message[(stream_record_size * i) + stream_header_size];
 
-        free(message);
+            record[0]       = (uint8_t)(panel_ids[i] >> 8);                 /* panelId H        */
+            record[1]       = (uint8_t)(panel_ids[i] & 0xFF);               /* panelId L        */
+        }
+    }
+    else
+    {
+        stream_message.clear();
     }
 }
 
 void NanoleafController::StartExternalControl()
 {
+    /*-------------------------------------------------------------*\
+    | The stream socket is opened on the first call and kept for    |
+    | later calls, which only switch the device back to external    |
+    | control.  It is reopened if the stream address changes.       |
+    \*-------------------------------------------------------------*/
+    BuildStreamMessage();
+
     json request;
     request["write"]["command"]     = "display";
     request["write"]["animType"]    = "extControl";
@@ -266,9 +314,9 @@ void NanoleafController::StartExternalControl()
         request["write"]["extControlVersion"] = "v1";
 
         json response;
-        if((APIRequest("PUT", location, "/api/v1/"+auth_token+"/effects", &request, &response) / 100) == 2)
+        if((APIRequest(*http_client, "PUT", location, "/api/v1/"+auth_token+"/effects", &request, &response) / 100) == 2)
         {
-            external_control_socket.udp_client(response["streamControlIpAddr"].get<std::string>().c_str(), std::to_string(response["streamControlPort"].get<int>()).c_str());
+            OpenStream(response["streamControlIpAddr"].get<std::string>(), std::to_string(response["streamControlPort"].get<int>()));
 
             selectedEffect = NANOLEAF_DIRECT_MODE_EFFECT_NAME;
         }
@@ -282,21 +330,47 @@ void NanoleafController::StartExternalControl()
         \*---------------------------------------------------------*/
         request["write"]["extControlVersion"] = "v2";
 
-        if((APIRequest("PUT", location, "/api/v1/"+auth_token+"/effects", &request) / 100) == 2)
+        if((APIRequest(*http_client, "PUT", location, "/api/v1/"+auth_token+"/effects", &request) / 100) == 2)
         {
-            external_control_socket.udp_client(address.c_str(), "60222");
+            OpenStream(address, "60222");
 
             selectedEffect = NANOLEAF_DIRECT_MODE_EFFECT_NAME;
         }
     }
 }
 
+void NanoleafController::OpenStream(const std::string& stream_address, const std::string& stream_port)
+{
+    /*-------------------------------------------------------------*\
+    | Protocol v1 may hand out a different port each time external  |
+    | control starts, close the old socket before opening the new   |
+    \*-------------------------------------------------------------*/
+    if(external_control_open)
+    {
+        if((stream_address == external_control_address) && (stream_port == external_control_port))
+        {
+            return;
+        }
+
+        external_control_socket.udp_close();
+        external_control_open = false;
+    }
+
+    external_control_open = external_control_socket.udp_client(stream_address.c_str(), stream_port.c_str());
+
+    if(external_control_open)
+    {
+        external_control_address    = stream_address;
+        external_control_port       = stream_port;
+    }
+}
+
 void NanoleafController::SelectEffect(std::string effect_name)
 {
     json request;
     request["select"] = effect_name;
 
-    if((APIRequest("PUT", location, "/api/v1/"+auth_token+"/effects", &request) / 100) == 2)
+    if((APIRequest(*http_client, "PUT", location, "/api/v1/"+auth_token+"/effects", &request) / 100) == 2)
     {
         selectedEffect = effect_name;
     }
@@ -307,7 +381,7 @@ void NanoleafController::SetBrightness(int a_brightness)
     json request;
     request["brightness"]["value"] = a_brightness;
 
-    if((APIRequest("PUT", location, "/api/v1/"+auth_token+"/state", &request) / 100) == 2)
+    if((APIRequest(*http_client, "PUT", location, "/api/v1/"+auth_token+"/state", &request) / 100) == 2)
     {
         brightness = a_brightness;
     }
@@ -19,10 +19,16 @@
 #define NANOLEAF_CANVAS_MODEL               "NL29"
 #define NANOLEAF_SHAPES_MODEL               "NL42"
 
+namespace httplib
+{
+    class Client;
+}
+
 class NanoleafController
 {
 public:
     NanoleafController(std::string a_address, int a_port, std::string a_auth_token);
+    ~NanoleafController();
 
     static std::string          Pair(std::string address, int port);
     static void                 Unpair(std::string address, int port, std::string auth_token);
@@ -30,7 +36,7 @@ public:
     void                        SelectEffect(std::string effect_name);
     void                        StartExternalControl();
     void                        SetBrightness(int a_brightness);
-    void                        UpdateLEDs(std::vector<RGBColor>& colors);
+    void                        UpdateLEDs(const std::vector<RGBColor>& colors);
 
     std::string                 GetAuthToken();
     std::string                 GetName();
@@ -44,7 +50,27 @@ public:
     int                         GetBrightness();
 
 private:
+    /*---------------------------------------------------------*\
+    | HTTP connection kept open across API requests             |
+    \*---------------------------------------------------------*/
+    httplib::Client*            http_client;
+
+    /*---------------------------------------------------------*\
+    | External control stream.  The message is built once when  |
+    | external control starts, every frame only fills in the    |
+    | panel colors.                                             |
+    \*---------------------------------------------------------*/
     net_port                    external_control_socket;
+    bool                        external_control_open;
+    std::string                 external_control_address;
+    std::string                 external_control_port;
+    std::vector<uint8_t>        stream_message;
+    std::size_t                 stream_header_size;
+    std::size_t                 stream_record_size;
+    std::size_t                 stream_color_offset;
+
+    void                        BuildStreamMessage();
+    void                        OpenStream(const std::string& stream_address, const std::string& stream_port);
 
     std::string                 address;
     int                         port;
@@ -10,6 +10,7 @@
 \*---------------------------------------------------------*/
 
 #include "Detector.h"
+#include "NetworkDetection.h"
 #include "RGBController_Nanoleaf.h"
 #include "SettingsManager.h"
 #include "LogManager.h"
@@ -34,15 +35,23 @@ void DetectNanoleafControllers()
 
             if(device.contains("ip") && device.contains("port") && device.contains("auth_token"))
             {
-                try
-                {
-                    RGBController_Nanoleaf* rgb_controller = new RGBController_Nanoleaf(device["ip"], device["port"], device["auth_token"]);
-                    ResourceManager::get()->RegisterRGBController(rgb_controller);
-                }
-                catch(...)
+                std::string ip          = device["ip"];
+                int         port        = device["port"];
+                std::string auth_token  = device["auth_token"];
+
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(ip, [ip, port, auth_token]() -> RGBController*
                 {
-                    LOG_DEBUG("[Nanoleaf] Could not connect to device at %s:%d using auth_token %s", device["ip"].get<std::string>().c_str(), device["port"].get<int>(), device["auth_token"].get<std::string>().c_str());
-                }
+                    try
+                    {
+                        return(new RGBController_Nanoleaf(ip, port, auth_token));
+                    }
+                    catch(...)
+                    {
+                        LOG_DEBUG("[Nanoleaf] Could not connect to device at %s:%d using auth_token %s", ip.c_str(), port, auth_token.c_str());
+                    }
+
+                    return(nullptr);
+                });
             }
         }
     }
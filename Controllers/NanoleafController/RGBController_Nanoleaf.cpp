@@ -31,6 +31,7 @@ RGBController_Nanoleaf::RGBController_Nanoleaf(std::string a_address, int a_port
     controller(a_address, a_port, a_auth_token)
 {
     location    = a_address+":"+std::to_string(a_port);
+    flags      |= CONTROLLER_FLAG_OUTPUT_COLORS;
     name        = controller.GetName();
     serial      = controller.GetSerial();
     vendor      = controller.GetManufacturer();
@@ -118,7 +119,7 @@ void RGBController_Nanoleaf::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_Nanoleaf::DeviceUpdateLEDs()
 {
-    controller.UpdateLEDs(colors);
+    controller.UpdateLEDs(GetOutputColors());
 }
 
 void RGBController_Nanoleaf::UpdateZoneLEDs(int /*zone*/)
@@ -35,10 +35,13 @@ PhilipsWizController::PhilipsWizController(std::string ip, bool use_cool, bool u
     port.udp_client(ip.c_str(), "38899");
 
     /*-----------------------------------------------------------------*\
-    | Start a thread to handle responses received from the Wiz device   |
+    | Handle responses received from the Wiz device on the shared       |
+    | network reactor thread                                            |
     \*-----------------------------------------------------------------*/
-    ReceiveThreadRun = 1;
-    ReceiveThread = new std::thread(&PhilipsWizController::ReceiveThreadFunction, this);
+    port.set_receive_callback([this](char* recv_buf, int size)
+    {
+        ReceiveResponse(recv_buf, size);
+    });
 
     /*-----------------------------------------------------------------*\
     | Request the system config (name, firmware version, MAC address)   |
@@ -48,9 +51,7 @@ PhilipsWizController::PhilipsWizController(std::string ip, bool use_cool, bool u
 
 PhilipsWizController::~PhilipsWizController()
 {
-    ReceiveThreadRun = 0;
-    ReceiveThread->join();
-    delete ReceiveThread;
+    port.clear_receive_callback();
 }
 
 std::string PhilipsWizController::GetLocation()
@@ -65,11 +66,15 @@ std::string PhilipsWizController::GetName()
 
 std::string PhilipsWizController::GetVersion()
 {
+    std::lock_guard<std::mutex> lock(response_mutex);
+
     return(module_name + " " + firmware_version);
 }
 
 std::string PhilipsWizController::GetModuleName()
 {
+    std::lock_guard<std::mutex> lock(response_mutex);
+
     return(module_name);
 }
 
@@ -80,6 +85,8 @@ std::string PhilipsWizController::GetManufacturer()
 
 std::string PhilipsWizController::GetUniqueID()
 {
+    std::lock_guard<std::mutex> lock(response_mutex);
+
     return(module_mac);
 }
 
@@ -171,64 +178,59 @@ void PhilipsWizController::SetScene(int scene, unsigned char brightness)
     port.udp_write((char*)command_str.c_str(), (int)command_str.length() + 1);
 }
 
-void PhilipsWizController::ReceiveThreadFunction()
+void PhilipsWizController::ReceiveResponse(char* recv_buf, int size)
 {
-    char recv_buf[1025];
+    if(size <= 0)
+    {
+        return;
+    }
+
+    /*-----------------------------------------------------------------*\
+    | Responses are not null-terminated, the reactor leaves room for    |
+    | the termination after the received data                           |
+    \*-----------------------------------------------------------------*/
+    recv_buf[size] = '\0';
 
-    port.set_receive_timeout(1, 0);
+    /*-----------------------------------------------------------------*\
+    | Convert null-terminated response to JSON                          |
+    \*-----------------------------------------------------------------*/
+    json response = json::parse(recv_buf);
 
-    while(ReceiveThreadRun.load())
+    /*-----------------------------------------------------------------*\
+    | Check if the response contains the method name                    |
+    \*-----------------------------------------------------------------*/
+    if(response.contains("method"))
     {
-        /*-----------------------------------------------------------------*\
-        | Receive up to 1024 bytes from the device with a 1s timeout        |
-        \*-----------------------------------------------------------------*/
-        int size = port.udp_listen(recv_buf, 1024);
-
-        if(size > 0)
+        /*-------------------------------------------------------------*\
+        | Handle responses for getSystemConfig method                   |
+        | This method's response should contain a result object         |
+        | containing fwVersion, moduleName, and mac, among others.      |
+        \*-------------------------------------------------------------*/
+        if(response["method"] == "getSystemConfig")
         {
-            /*-----------------------------------------------------------------*\
-            | Responses are not null-terminated, so add termination             |
-            \*-----------------------------------------------------------------*/
-            recv_buf[size] = '\0';
-
-            /*-----------------------------------------------------------------*\
-            | Convert null-terminated response to JSON                          |
-            \*-----------------------------------------------------------------*/
-            json response = json::parse(recv_buf);
-
-            /*-----------------------------------------------------------------*\
-            | Check if the response contains the method name                    |
-            \*-----------------------------------------------------------------*/
-            if(response.contains("method"))
+            if(response.contains("result"))
             {
-                /*-------------------------------------------------------------*\
-                | Handle responses for getSystemConfig method                   |
-                | This method's response should contain a result object         |
-                | containing fwVersion, moduleName, and mac, among others.      |
-                \*-------------------------------------------------------------*/
-                if(response["method"] == "getSystemConfig")
+                json result = response["result"];
+
+                std::lock_guard<std::mutex> lock(response_mutex);
+
+                if(result.contains("fwVersion"))
+                {
+                    firmware_version = result["fwVersion"];
+                }
+
+                if(result.contains("moduleName"))
+                {
+                    module_name = result["moduleName"];
+                }
+
+                if(result.contains("mac"))
                 {
-                    if(response.contains("result"))
-                    {
-                        json result = response["result"];
-
-                        if(result.contains("fwVersion"))
-                        {
-                            firmware_version = result["fwVersion"];
-                        }
-
-                        if(result.contains("moduleName"))
-                        {
-                            module_name = result["moduleName"];
-                        }
-
-                        if(result.contains("mac"))
-                        {
-                            module_mac = result["mac"];
-                        }
-                    }
+                    module_mac = result["mac"];
                 }
             }
+
+            response_cv.notify_all();
         }
     }
 }
@@ -252,13 +254,10 @@ void PhilipsWizController::RequestSystemConfig()
     /*-----------------------------------------------------------------*\
     | Wait up to 1s to give it time to receive and process response     |
     \*-----------------------------------------------------------------*/
-    for(unsigned int wait_count = 0; wait_count < 100; wait_count++)
-    {
-        if(firmware_version != "")
-        {
-            return;
-        }
+    std::unique_lock<std::mutex> lock(response_mutex);
 
-        std::this_thread::sleep_for(10ms);
-    }
+    response_cv.wait_for(lock, 1s, [this]()
+    {
+        return(firmware_version != "");
+    });
 }
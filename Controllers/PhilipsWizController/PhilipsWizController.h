@@ -11,8 +11,9 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 #include "RGBController.h"
 #include "net_port.h"
@@ -74,7 +75,7 @@ public:
 
     void SetScene(int scene, unsigned char brightness);
 
-    void ReceiveThreadFunction();
+    void ReceiveResponse(char* recv_buf, int size);
     void RequestSystemConfig();
 
 private:
@@ -83,8 +84,9 @@ private:
     std::string         module_mac;
     std::string         location;
     net_port            port;
-    std::thread*        ReceiveThread;
-    std::atomic<bool>   ReceiveThreadRun;
+
+    std::mutex              response_mutex;
+    std::condition_variable response_cv;
 
     bool                use_cool_white;
     bool                use_warm_white;
@@ -11,6 +11,7 @@
 
 #include "Detector.h"
 #include "PhilipsWizController.h"
+#include "NetworkDetection.h"
 #include "RGBController_PhilipsWiz.h"
 #include "SettingsManager.h"
 
@@ -60,10 +61,13 @@ void DetectPhilipsWizControllers()
                     wiz_white_strategy = wiz_settings["devices"][device_idx]["selected_white_strategy"];
                 }
 
-                PhilipsWizController*     controller     = new PhilipsWizController(wiz_ip, wiz_cool, wiz_warm, wiz_white_strategy);
-                RGBController_PhilipsWiz* rgb_controller = new RGBController_PhilipsWiz(controller);
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(wiz_ip, [wiz_ip, wiz_cool, wiz_warm, wiz_white_strategy]() -> RGBController*
+                {
+                    PhilipsWizController*     controller     = new PhilipsWizController(wiz_ip, wiz_cool, wiz_warm, wiz_white_strategy);
+                    RGBController_PhilipsWiz* rgb_controller = new RGBController_PhilipsWiz(controller);
 
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(rgb_controller);
+                });
             }
         }
     }
@@ -33,6 +33,7 @@ RGBController_PhilipsWiz::RGBController_PhilipsWiz(PhilipsWizController* control
     description = "Philips Wiz Device";
     serial      = controller->GetUniqueID();
     location    = controller->GetLocation();
+    flags      |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
 
     mode Direct;
     Direct.name           = "Direct";
@@ -407,9 +408,10 @@ void RGBController_PhilipsWiz::DeviceUpdateLEDs()
 {
     if (modes[active_mode].value == PHILLIPSWIZ_MODE_STATIC)
     {
-        unsigned char red = RGBGetRValue(colors[0]);
-        unsigned char grn = RGBGetGValue(colors[0]);
-        unsigned char blu = RGBGetBValue(colors[0]);
+        RGBColor      color = GetOutputColors()[0];
+        unsigned char red   = RGBGetRValue(color);
+        unsigned char grn   = RGBGetGValue(color);
+        unsigned char blu   = RGBGetBValue(color);
 
         controller->SetColor(red, grn, blu, modes[active_mode].brightness);
     }
@@ -150,7 +150,7 @@ qmk_keycodes qmk_keycode_keyname_map =
     { 231, KEY_EN_RIGHT_WINDOWS         },
 };
 
-QMKOpenRGBBaseController::QMKOpenRGBBaseController(hid_device *dev_handle, const char *path, unsigned char max_led_count)
+QMKOpenRGBBaseController::QMKOpenRGBBaseController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid, unsigned char max_led_count)
 {
     /*-------------------------------------------------*\
     | Get QMKOpenRGB settings                           |
@@ -185,8 +185,12 @@ QMKOpenRGBBaseController::QMKOpenRGBBaseController(hid_device *dev_handle, const
         delay = 0ms;
     }
 
-    dev         = dev_handle;
-    location    = path;
+    dev                 = dev_handle;
+    location            = path;
+    usb_vid             = vid;
+    usb_pid             = pid;
+    protocol_version    = 0;
+    qmk_version_read    = false;
 
     GetDeviceInfo();
     GetModeInfo();
@@ -259,6 +263,15 @@ std::vector<RGBColor>  QMKOpenRGBBaseController::GetLEDColors()
 
 unsigned int QMKOpenRGBBaseController::GetProtocolVersion()
 {
+    /*-----------------------------------------------------*\
+    | The protocol version cannot change while the device   |
+    | is open, only query it once                           |
+    \*-----------------------------------------------------*/
+    if(protocol_version != 0)
+    {
+        return protocol_version;
+    }
+
     unsigned char usb_buf[QMK_OPENRGB_PACKET_SIZE];
 
     /*-----------------------------------------------------*\
@@ -279,11 +292,18 @@ unsigned int QMKOpenRGBBaseController::GetProtocolVersion()
         bytes_read = hid_read_timeout(dev, usb_buf, QMK_OPENRGB_PACKET_SIZE, QMK_OPENRGB_HID_READ_TIMEOUT);
     } while(bytes_read <= 0);
 
-    return usb_buf[1];
+    protocol_version = usb_buf[1];
+
+    return protocol_version;
 }
 
 std::string QMKOpenRGBBaseController::GetQMKVersion()
 {
+    if(qmk_version_read)
+    {
+        return qmk_version;
+    }
+
     unsigned char usb_buf[QMK_OPENRGB_PACKET_SIZE];
 
     /*-----------------------------------------------------*\
@@ -300,7 +320,6 @@ std::string QMKOpenRGBBaseController::GetQMKVersion()
     hid_write(dev, usb_buf, QMK_OPENRGB_PACKET_SIZE);
     hid_read(dev, usb_buf, QMK_OPENRGB_PACKET_SIZE);
 
-    std::string qmk_version;
     int i = 1;
     while (usb_buf[i] != 0)
     {
@@ -308,9 +327,80 @@ std::string QMKOpenRGBBaseController::GetQMKVersion()
         i++;
     }
 
+    qmk_version_read = true;
+
     return qmk_version;
 }
 
+std::string QMKOpenRGBBaseController::GetLEDInfoCacheKey()
+{
+    /*-----------------------------------------------------*\
+    | The firmware does not report a build hash, so the     |
+    | QMK version string (which includes the git revision   |
+    | of the build) together with the device info stands    |
+    | in for it                                             |
+    \*-----------------------------------------------------*/
+    char id_buf[16];
+
+    snprintf(id_buf, sizeof(id_buf), "%04X:%04X:%02X", usb_vid, usb_pid, GetProtocolVersion());
+
+    return(std::string(id_buf) + ":" + GetQMKVersion() + ":" + device_vendor + ":" + device_name + ":"
+         + std::to_string(total_number_of_leds) + ":" + std::to_string(total_number_of_leds_with_empty_space));
+}
+
+void QMKOpenRGBBaseController::GetLEDInfoJson(json& entry)
+{
+    entry["points"] = json::array();
+
+    for(std::size_t led_idx = 0; led_idx < led_points.size(); led_idx++)
+    {
+        entry["points"].push_back({ led_points[led_idx].x, led_points[led_idx].y });
+    }
+
+    entry["flags"]  = led_flags;
+    entry["names"]  = led_names;
+}
+
+bool QMKOpenRGBBaseController::SetLEDInfoJson(const json& entry)
+{
+    if(!entry.contains("points") || !entry.contains("flags") || !entry.contains("names"))
+    {
+        return(false);
+    }
+
+    try
+    {
+        std::vector<point_t> points;
+
+        for(const json& point : entry["points"])
+        {
+            points.push_back(point_t{point.at(0).get<uint8_t>(), point.at(1).get<uint8_t>()});
+        }
+
+        std::vector<unsigned int>   flags   = entry["flags"].get<std::vector<unsigned int>>();
+        std::vector<std::string>    names   = entry["names"].get<std::vector<std::string>>();
+
+        /*-------------------------------------------------*\
+        | Names are only reported for LEDs with a keycode   |
+        | or for underglow, so there may be fewer of them   |
+        \*-------------------------------------------------*/
+        if((flags.size() != points.size()) || (names.size() > points.size()))
+        {
+            return(false);
+        }
+
+        led_points  = points;
+        led_flags   = flags;
+        led_names   = names;
+    }
+    catch(const std::exception&)
+    {
+        return(false);
+    }
+
+    return(true);
+}
+
 void QMKOpenRGBBaseController::GetDeviceInfo()
 {
     unsigned char usb_buf[QMK_OPENRGB_PACKET_SIZE];
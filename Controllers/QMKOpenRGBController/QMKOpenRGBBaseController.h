@@ -23,7 +23,7 @@ extern qmk_keycodes                     qmk_keycode_keyname_map;
 class QMKOpenRGBBaseController
 {
 public:
-    QMKOpenRGBBaseController(hid_device *dev_handle, const char *path, unsigned char max_led_count);
+    QMKOpenRGBBaseController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid, unsigned char max_led_count);
     virtual ~QMKOpenRGBBaseController();
 
     std::string                 GetLocation();
@@ -46,6 +46,17 @@ public:
     void                        GetDeviceInfo();
     void                        GetModeInfo();
 
+    /*-----------------------------------------------------*\
+    | LED info cache support.  The key identifies the       |
+    | keyboard and firmware, the JSON functions convert the |
+    | LED info read by GetLEDInfo() to and from a cache     |
+    | entry.  Colors are not cached, a cache hit starts     |
+    | from blank colors without any LED info request.       |
+    \*-----------------------------------------------------*/
+    std::string                 GetLEDInfoCacheKey();
+    virtual void                GetLEDInfoJson(json& entry);
+    virtual bool                SetLEDInfoJson(const json& entry);
+
     void                        SetMode(hsv_t hsv_color, unsigned char mode, unsigned char speed);
     void                        SetMode(hsv_t hsv_color, unsigned char mode, unsigned char speed, bool save);
 
@@ -60,6 +71,13 @@ protected:
 
     std::string                 location;
 
+    unsigned short              usb_vid;
+    unsigned short              usb_pid;
+
+    unsigned int                protocol_version;
+    std::string                 qmk_version;
+    bool                        qmk_version_read;
+
     std::string                 device_name;
     std::string                 device_vendor;
 
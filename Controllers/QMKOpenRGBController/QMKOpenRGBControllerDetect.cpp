@@ -80,35 +80,35 @@ void DetectQMKOpenRGBControllers(hid_device_info *info, const std::string&)
         {
             case QMK_OPENRGB_PROTOCOL_VERSION_9:
                 {
-                QMKOpenRGBRev9Controller*     controller     = new QMKOpenRGBRev9Controller(dev, info->path);
+                QMKOpenRGBRev9Controller*     controller     = new QMKOpenRGBRev9Controller(dev, info->path, info->vendor_id, info->product_id);
                 RGBController_QMKOpenRGBRev9* rgb_controller = new RGBController_QMKOpenRGBRev9(controller);
                 ResourceManager::get()->RegisterRGBController(rgb_controller);
                 }
                 break;
             case QMK_OPENRGB_PROTOCOL_VERSION_B:
                 {
-                QMKOpenRGBRevBController*     controller     = new QMKOpenRGBRevBController(dev, info->path);
+                QMKOpenRGBRevBController*     controller     = new QMKOpenRGBRevBController(dev, info->path, info->vendor_id, info->product_id);
                 RGBController_QMKOpenRGBRevB* rgb_controller = new RGBController_QMKOpenRGBRevB(controller, false);
                 ResourceManager::get()->RegisterRGBController(rgb_controller);
                 }
                 break;
             case QMK_OPENRGB_PROTOCOL_VERSION_C:
                 {
-                QMKOpenRGBRevBController*     controller     = new QMKOpenRGBRevBController(dev, info->path);
+                QMKOpenRGBRevBController*     controller     = new QMKOpenRGBRevBController(dev, info->path, info->vendor_id, info->product_id);
                 RGBController_QMKOpenRGBRevB* rgb_controller = new RGBController_QMKOpenRGBRevB(controller, true);
                 ResourceManager::get()->RegisterRGBController(rgb_controller);
                 }
                 break;
             case QMK_OPENRGB_PROTOCOL_VERSION_D:
                 {
-                QMKOpenRGBRevDController*     controller     = new QMKOpenRGBRevDController(dev, info->path);
+                QMKOpenRGBRevDController*     controller     = new QMKOpenRGBRevDController(dev, info->path, info->vendor_id, info->product_id);
                 RGBController_QMKOpenRGBRevD* rgb_controller = new RGBController_QMKOpenRGBRevD(controller, true);
                 ResourceManager::get()->RegisterRGBController(rgb_controller);
                 }
                 break;
             case QMK_OPENRGB_PROTOCOL_VERSION_E:
                 {
-                QMKOpenRGBRevDController*     controller     = new QMKOpenRGBRevDController(dev, info->path);
+                QMKOpenRGBRevDController*     controller     = new QMKOpenRGBRevDController(dev, info->path, info->vendor_id, info->product_id);
                 RGBController_QMKOpenRGBRevE* rgb_controller = new RGBController_QMKOpenRGBRevE(controller, true);
                 ResourceManager::get()->RegisterRGBController(rgb_controller);
                 }
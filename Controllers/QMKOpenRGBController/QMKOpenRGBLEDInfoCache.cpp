@@ -0,0 +1,96 @@
+/*---------------------------------------------------------*\
+| QMKOpenRGBLEDInfoCache.cpp                                |
+|                                                           |
+|   On-disk cache of QMK OpenRGB LED layouts, so that the   |
+|   per-LED info queries only run the first time a given    |
+|   keyboard and firmware is detected                       |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <fstream>
+#include "FileUtils.h"
+#include "LogManager.h"
+#include "QMKOpenRGBLEDInfoCache.h"
+#include "ResourceManager.h"
+
+/*---------------------------------------------------------*\
+| Bump when the layout of a cache entry changes, older      |
+| files are then discarded                                  |
+\*---------------------------------------------------------*/
+#define QMK_OPENRGB_CACHE_VERSION   1
+#define QMK_OPENRGB_CACHE_FILENAME  "QMKOpenRGBCache.json"
+
+std::mutex  QMKOpenRGBLEDInfoCache::mutex;
+json        QMKOpenRGBLEDInfoCache::cache;
+bool        QMKOpenRGBLEDInfoCache::cache_read = false;
+
+void QMKOpenRGBLEDInfoCache::ReadCacheFile()
+{
+    if(cache_read)
+    {
+        return;
+    }
+
+    cache_read = true;
+
+    filesystem::path    filename = ResourceManager::get()->GetConfigurationDirectory() / QMK_OPENRGB_CACHE_FILENAME;
+    std::ifstream       cache_file(filename, std::ios::in | std::ios::binary);
+
+    if(cache_file)
+    {
+        try
+        {
+            cache_file >> cache;
+        }
+        catch(const std::exception& e)
+        {
+            LOG_WARNING("[QMK OpenRGB] LED info cache is corrupt and will be rebuilt: %s", e.what());
+            cache = json();
+        }
+    }
+
+    if(!cache.is_object() || !cache.contains("version") || (cache["version"] != QMK_OPENRGB_CACHE_VERSION) || !cache.contains("devices"))
+    {
+        cache                   = json::object();
+        cache["version"]        = QMK_OPENRGB_CACHE_VERSION;
+        cache["devices"]        = json::object();
+    }
+}
+
+bool QMKOpenRGBLEDInfoCache::Load(const std::string& key, json& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ReadCacheFile();
+
+    if(!cache["devices"].contains(key))
+    {
+        return(false);
+    }
+
+    entry = cache["devices"][key];
+
+    return(true);
+}
+
+void QMKOpenRGBLEDInfoCache::Store(const std::string& key, const json& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ReadCacheFile();
+
+    cache["devices"][key] = entry;
+
+    /*-----------------------------------------------------*\
+    | Replace the cache in one step so a partial write is   |
+    | never read back                                       |
+    \*-----------------------------------------------------*/
+    filesystem::path filename = ResourceManager::get()->GetConfigurationDirectory() / QMK_OPENRGB_CACHE_FILENAME;
+
+    if(!FileUtils::write_file_atomic(filename, cache.dump()))
+    {
+        LOG_WARNING("[QMK OpenRGB] Unable to write LED info cache");
+    }
+}
@@ -0,0 +1,32 @@
+/*---------------------------------------------------------*\
+| QMKOpenRGBLEDInfoCache.h                                  |
+|                                                           |
+|   On-disk cache of QMK OpenRGB LED layouts, so that the   |
+|   per-LED info queries only run the first time a given   |
+|   keyboard and firmware is detected                       |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+class QMKOpenRGBLEDInfoCache
+{
+public:
+    static bool Load(const std::string& key, json& entry);
+    static void Store(const std::string& key, const json& entry);
+
+private:
+    static void ReadCacheFile();
+
+    static std::mutex   mutex;
+    static json         cache;
+    static bool         cache_read;
+};
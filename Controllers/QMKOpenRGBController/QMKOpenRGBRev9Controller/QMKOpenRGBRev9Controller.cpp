@@ -15,8 +15,8 @@
 
 using namespace std::chrono_literals;
 
-QMKOpenRGBRev9Controller::QMKOpenRGBRev9Controller(hid_device *dev_handle, const char *path) :
-        QMKOpenRGBBaseController(dev_handle, path, 20)
+QMKOpenRGBRev9Controller::QMKOpenRGBRev9Controller(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid) :
+        QMKOpenRGBBaseController(dev_handle, path, vid, pid, 20)
 {
 }
 
@@ -18,7 +18,7 @@
 class QMKOpenRGBRev9Controller : public QMKOpenRGBBaseController
 {
 public:
-    QMKOpenRGBRev9Controller(hid_device *dev_handle, const char *path);
+    QMKOpenRGBRev9Controller(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid);
     ~QMKOpenRGBRev9Controller();
 
     //Virtual function implementations
@@ -14,8 +14,8 @@
 
 using namespace std::chrono_literals;
 
-QMKOpenRGBRevBController::QMKOpenRGBRevBController(hid_device *dev_handle, const char *path) :
-        QMKOpenRGBBaseController(dev_handle, path, 20)
+QMKOpenRGBRevBController::QMKOpenRGBRevBController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid) :
+        QMKOpenRGBBaseController(dev_handle, path, vid, pid, 20)
 {
 }
 
@@ -17,7 +17,7 @@
 class QMKOpenRGBRevBController : public QMKOpenRGBBaseController
 {
 public:
-    QMKOpenRGBRevBController(hid_device *dev_handle, const char *path);
+    QMKOpenRGBRevBController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid);
     ~QMKOpenRGBRevBController();
 
     //Virtual function implementations
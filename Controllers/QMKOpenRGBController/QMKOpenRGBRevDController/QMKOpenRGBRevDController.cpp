@@ -13,8 +13,8 @@
 
 using namespace std::chrono_literals;
 
-QMKOpenRGBRevDController::QMKOpenRGBRevDController(hid_device *dev_handle, const char *path) :
-    QMKOpenRGBBaseController(dev_handle, path, 15)
+QMKOpenRGBRevDController::QMKOpenRGBRevDController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid) :
+    QMKOpenRGBBaseController(dev_handle, path, vid, pid, 15)
 {
 }
 
@@ -119,6 +119,32 @@ void QMKOpenRGBRevDController::GetLEDInfo(unsigned int leds_count)
     led_values.insert(led_values.end(), underglow_values.begin(), underglow_values.end());
 }
 
+void QMKOpenRGBRevDController::GetLEDInfoJson(json& entry)
+{
+    QMKOpenRGBBaseController::GetLEDInfoJson(entry);
+
+    entry["values"] = led_values;
+}
+
+bool QMKOpenRGBRevDController::SetLEDInfoJson(const json& entry)
+{
+    if(!entry.contains("values") || !QMKOpenRGBBaseController::SetLEDInfoJson(entry))
+    {
+        return(false);
+    }
+
+    try
+    {
+        led_values = entry["values"].get<std::vector<unsigned int>>();
+    }
+    catch(const std::exception&)
+    {
+        return(false);
+    }
+
+    return(true);
+}
+
 std::vector<unsigned int> QMKOpenRGBRevDController::GetEnabledModes()
 {
     unsigned char usb_buf[QMK_OPENRGB_PACKET_SIZE];
@@ -16,7 +16,7 @@
 class QMKOpenRGBRevDController : public QMKOpenRGBBaseController
 {
 public:
-    QMKOpenRGBRevDController(hid_device *dev_handle, const char *path);
+    QMKOpenRGBRevDController(hid_device *dev_handle, const char *path, unsigned short vid, unsigned short pid);
     ~QMKOpenRGBRevDController();
 
     //Virtual function implementations
@@ -24,6 +24,9 @@ public:
     void            DirectModeSetSingleLED(unsigned int led, unsigned char red, unsigned char green, unsigned char blue);
     void            DirectModeSetLEDs(std::vector<RGBColor> colors, unsigned int num_colors);
 
+    void            GetLEDInfoJson(json& entry);
+    bool            SetLEDInfoJson(const json& entry);
+
     //Protocol Specific functions
     std::vector<unsigned int>   GetLEDValues();
     std::vector<unsigned int>   GetEnabledModes();
@@ -12,6 +12,7 @@
 
 #include "hsv.h"
 #include "LogManager.h"
+#include "QMKOpenRGBLEDInfoCache.h"
 #include "RGBController_QMKOpenRGBRevD.h"
 
 RGBController_QMKOpenRGBRevD::RGBController_QMKOpenRGBRevD(QMKOpenRGBRevDController* controller_ptr, bool save)
@@ -278,9 +279,28 @@ void RGBController_QMKOpenRGBRevD::SetupZones()
     LOG_INFO("[%s] Keyboard has %u LEDs total", name.c_str(), total_number_of_leds);
 
     /*---------------------------------------------------------*\
-    | Get information for each LED                              |
+    | Get information for each LED, from the LED info cache if  |
+    | this keyboard and firmware has been seen before           |
     \*---------------------------------------------------------*/
-    controller->GetLEDInfo(std::max(total_number_of_leds, total_number_of_leds_with_empty_space));
+    std::string cache_key   = controller->GetLEDInfoCacheKey();
+    json        cache_entry;
+    bool        cache_hit   = QMKOpenRGBLEDInfoCache::Load(cache_key, cache_entry)
+                           && cache_entry.contains("matrix_map")
+                           && cache_entry.contains("underglow_map")
+                           && controller->SetLEDInfoJson(cache_entry);
+
+    if(cache_hit)
+    {
+        /*-----------------------------------------------------*\
+        | The cache holds the layout only, the colors start     |
+        | blank rather than costing the LED info round trips    |
+        \*-----------------------------------------------------*/
+        LOG_DEBUG("[%s] Using cached LED info", name.c_str());
+    }
+    else
+    {
+        controller->GetLEDInfo(std::max(total_number_of_leds, total_number_of_leds_with_empty_space));
+    }
 
     /*---------------------------------------------------------*\
     | Get LED vectors from controller                           |
@@ -305,27 +325,57 @@ void RGBController_QMKOpenRGBRevD::SetupZones()
     bool            has_underglow                               = number_of_underglow_leds > 0;
     LOG_INFO("[%s] Keyboard has %u underglow LEDs", name.c_str(), number_of_underglow_leds);
 
-    /*---------------------------------------------------------*\
-    | Create sets for row and column position values            |
-    \*---------------------------------------------------------*/
-    std::set<int> rows, columns;
-    for (unsigned int i = 0; i < number_of_leds; i++)
+    VectorMatrix matrix_map;
+    VectorMatrix underglow_map;
+
+    if(cache_hit)
     {
-        rows.insert(led_points[i].y);
-        columns.insert(led_points[i].x);
+        try
+        {
+            matrix_map      = cache_entry["matrix_map"].get<VectorMatrix>();
+            underglow_map   = cache_entry["underglow_map"].get<VectorMatrix>();
+        }
+        catch(const std::exception&)
+        {
+            matrix_map.clear();
+            underglow_map.clear();
+        }
     }
 
-    /*---------------------------------------------------------*\
-    | Calculate matrix map from QMK positions                   |
-    \*---------------------------------------------------------*/
-    unsigned int divisor = CalculateDivisor(led_points, rows, columns);
-    LOG_DEBUG("[%s] Distance between standard keys calculated to be %u", name.c_str(), divisor);
+    if(matrix_map.empty() || matrix_map[0].empty() || (has_underglow && (underglow_map.empty() || underglow_map[0].empty())))
+    {
+        /*---------------------------------------------------------*\
+        | Create sets for row and column position values            |
+        \*---------------------------------------------------------*/
+        std::set<int> rows, columns;
+        for (unsigned int i = 0; i < number_of_leds; i++)
+        {
+            rows.insert(led_points[i].y);
+            columns.insert(led_points[i].x);
+        }
 
-    VectorMatrix matrix_map;
-    VectorMatrix underglow_map;
+        /*---------------------------------------------------------*\
+        | Calculate matrix map from QMK positions                   |
+        \*---------------------------------------------------------*/
+        unsigned int divisor = CalculateDivisor(led_points, rows, columns);
+        LOG_DEBUG("[%s] Distance between standard keys calculated to be %u", name.c_str(), divisor);
+
+        matrix_map.clear();
+        underglow_map.clear();
+
+        PlaceLEDsInMaps(rows, columns, divisor, led_points, led_flags, matrix_map, underglow_map);
+        CleanMatrixMaps(matrix_map, underglow_map, (unsigned int)rows.size(), has_underglow);
 
-    PlaceLEDsInMaps(rows, columns, divisor, led_points, led_flags, matrix_map, underglow_map);
-    CleanMatrixMaps(matrix_map, underglow_map, (unsigned int)rows.size(), has_underglow);
+        /*---------------------------------------------------------*\
+        | Store the LED info and matrix maps for the next start     |
+        \*---------------------------------------------------------*/
+        cache_entry                     = json::object();
+        controller->GetLEDInfoJson(cache_entry);
+        cache_entry["matrix_map"]       = matrix_map;
+        cache_entry["underglow_map"]    = underglow_map;
+
+        QMKOpenRGBLEDInfoCache::Store(cache_key, cache_entry);
+    }
 
     /*---------------------------------------------------------*\
     | These vectors are class members because if they go out of |
@@ -398,9 +448,11 @@ void RGBController_QMKOpenRGBRevD::SetupZones()
     /*---------------------------------------------------------*\
     | Initialize colors from device values                      |
     \*---------------------------------------------------------*/
-    for(unsigned int i = 0; i < leds.size(); i++)
+    std::vector<RGBColor> led_colors = controller->GetLEDColors();
+
+    for(unsigned int i = 0; i < leds.size() && i < led_colors.size(); i++)
     {
-        colors[i] = controller->GetLEDColors()[i];
+        colors[i] = led_colors[i];
     }
 }
 
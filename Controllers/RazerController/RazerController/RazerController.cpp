@@ -9,6 +9,7 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include <string.h>
 #include "RazerController.h"
 #include "RazerDevices.h"
@@ -17,8 +18,9 @@
 
 using namespace std::chrono_literals;
 
-RazerController::RazerController(hid_device* dev_handle, hid_device* dev_argb_handle, const char* path, unsigned short pid, std::string dev_name)
+RazerController::RazerController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, hid_device* dev_argb_handle, const char* path, unsigned short pid, std::string dev_name)
 {
+    wrapper           = hid_wrapper;
     dev               = dev_handle;
     dev_argb          = dev_argb_handle;
     dev_pid           = pid;
@@ -62,6 +64,11 @@ RazerController::RazerController(hid_device* dev_handle, hid_device* dev_argb_ha
     \*-----------------------------------------------------------------*/
     dev_transaction_id = device_list[device_index]->transaction_id;
 
+    /*-----------------------------------------------------------------*\
+    | Preallocate the report used to poll device status                 |
+    \*-----------------------------------------------------------------*/
+    status_report = razer_create_response();
+
     switch(dev_pid)
     {
         case RAZER_CHARGING_PAD_CHROMA_PID:
@@ -177,7 +184,7 @@ RazerController::RazerController(hid_device* dev_handle, hid_device* dev_argb_ha
 
 RazerController::~RazerController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
     delete guard_manager_ptr;
 }
 
@@ -255,10 +262,12 @@ void RazerController::SetLEDs(RGBColor* colors)
     unsigned int matrix_rows = device_list[device_index]->rows;
 
     /*---------------------------------------------------------*\
-    | Create an output array large enough to hold RGB data for  |
-    | a single row                                              |
+    | Size the output array to hold RGB data for a single row,  |
+    | it is kept between frames to avoid reallocating it        |
     \*---------------------------------------------------------*/
-    unsigned char* output_array = new unsigned char[matrix_cols * 3];
+    row_buffer.resize(matrix_cols * 3);
+
+    unsigned char* output_array = row_buffer.data();
 
     /*---------------------------------------------------------*\
     | Send one row of the custom frame at a time                |
@@ -281,22 +290,17 @@ void RazerController::SetLEDs(RGBColor* colors)
         /*-----------------------------------------------------*\
         | Send the output array to the device                   |
         \*-----------------------------------------------------*/
-        std::this_thread::sleep_for(1ms);
+        razer_usb_wait_ready(1ms);
 
         razer_set_custom_frame(row, 0, matrix_cols - 1, output_array);
     }
 
-    std::this_thread::sleep_for(1ms);
+    razer_usb_wait_ready(1ms);
 
     /*---------------------------------------------------------*\
     | Set custom mode to apply frame                            |
     \*---------------------------------------------------------*/
     razer_set_mode_custom();
-
-    /*---------------------------------------------------------*\
-    | Delete the output array                                   |
-    \*---------------------------------------------------------*/
-    delete[] output_array;
 }
 
 void RazerController::SetModeBreathingOneColor(unsigned char red, unsigned char grn, unsigned char blu)
@@ -1002,9 +1006,9 @@ std::string RazerController::razer_get_firmware()
     struct razer_report report                  = razer_create_report(0x00, RAZER_COMMAND_ID_GET_FIRMWARE_VERSION, 0x02);
     struct razer_report response_report         = razer_create_response();
 
-    std::this_thread::sleep_for(2ms);
+    razer_usb_wait_ready(2ms);
     razer_usb_send(&report);
-    std::this_thread::sleep_for(5ms);
+    razer_usb_wait_ready(5ms);
     razer_usb_receive(&response_report);
 
     firmware_string = "v" + std::to_string(response_report.arguments[0]) + "." + std::to_string(response_report.arguments[1]);
@@ -1018,9 +1022,9 @@ std::string RazerController::razer_get_serial()
     struct razer_report report              = razer_create_report(0x00, RAZER_COMMAND_ID_GET_SERIAL_STRING, 0x16);
     struct razer_report response_report     = razer_create_response();
 
-    std::this_thread::sleep_for(2ms);
+    razer_usb_wait_ready(2ms);
     razer_usb_send(&report);
-    std::this_thread::sleep_for(5ms);
+    razer_usb_wait_ready(5ms);
     razer_usb_receive(&response_report);
 
     memcpy(&serial_string[0], &response_report.arguments[0], 22);
@@ -1043,9 +1047,9 @@ void RazerController::razer_get_keyboard_info(unsigned char* layout, unsigned ch
     struct razer_report report              = razer_create_report(0x00, RAZER_COMMAND_ID_GET_KEYBOARD_INFO, 0x00);
     struct razer_report response_report     = razer_create_response();
 
-    std::this_thread::sleep_for(1ms);
+    razer_usb_wait_ready(1ms);
     razer_usb_send(&report);
-    std::this_thread::sleep_for(1ms);
+    razer_usb_wait_ready(1ms);
     razer_usb_receive(&response_report);
 
     *layout = response_report.arguments[0];
@@ -1253,7 +1257,7 @@ void RazerController::razer_set_custom_frame(unsigned char row_index, unsigned c
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, rgb_data);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, &rgb_data[3]);
                     razer_usb_send(&report);
@@ -1362,17 +1366,17 @@ void RazerController::razer_set_mode_breathing_one_color(unsigned char red, unsi
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, rgb_data);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, 2);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, &rgb_data[3]);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, 2);
                     razer_usb_send(&report);
@@ -1507,7 +1511,7 @@ void RazerController::razer_set_mode_custom()
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, 0);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, 0);
                     razer_usb_send(&report);
@@ -1586,17 +1590,17 @@ void RazerController::razer_set_mode_none()
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, rgb_data);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, 0);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, &rgb_data[3]);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, 0);
                     razer_usb_send(&report);
@@ -1663,7 +1667,7 @@ void RazerController::razer_set_mode_spectrum_cycle()
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, 4);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, 4);
                     razer_usb_send(&report);
@@ -1742,17 +1746,17 @@ void RazerController::razer_set_mode_static(unsigned char red, unsigned char grn
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, rgb_data);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_SCROLL_WHEEL, 0);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_rgb_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, &rgb_data[3]);
                     razer_usb_send(&report);
 
-                    std::this_thread::sleep_for(1ms);
+                    razer_usb_wait_ready(1ms);
 
                     report                  = razer_create_set_led_effect_report(RAZER_STORAGE_NO_SAVE, RAZER_LED_ID_BACKLIGHT, 0);
                     razer_usb_send(&report);
@@ -1815,9 +1819,49 @@ void RazerController::razer_set_mode_wave(unsigned char direction)
 | USB transfer functions                                                            |
 \*---------------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------*\
+| Wait until the device has finished processing the last    |
+| report, polling its status with an exponential backoff    |
+| instead of sleeping for a fixed time.  If the device does |
+| not answer status reads, fall back to waiting the full    |
+| max_wait.                                                 |
+\*---------------------------------------------------------*/
+void RazerController::razer_usb_wait_ready(std::chrono::microseconds max_wait)
+{
+    std::chrono::steady_clock::time_point   deadline    = std::chrono::steady_clock::now() + max_wait;
+    std::chrono::microseconds               backoff     = 50us;
+
+    while(true)
+    {
+        status_report.report_id = response_index;
+
+        if(razer_usb_receive(&status_report) < 0)
+        {
+            std::this_thread::sleep_until(deadline);
+            return;
+        }
+
+        if((status_report.status != RAZER_STATUS_NEW) && (status_report.status != RAZER_STATUS_BUSY))
+        {
+            return;
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if(now >= deadline)
+        {
+            return;
+        }
+
+        std::this_thread::sleep_for(std::min(backoff, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now)));
+
+        backoff = std::min(backoff * 2, std::chrono::microseconds(1000));
+    }
+}
+
 int RazerController::razer_usb_receive(razer_report* report)
 {
-    return hid_get_feature_report(dev, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_get_feature_report(dev, (unsigned char*)report, sizeof(*report));
 }
 
 int RazerController::razer_usb_send(razer_report* report)
@@ -1825,11 +1869,11 @@ int RazerController::razer_usb_send(razer_report* report)
     report->crc = razer_calculate_crc(report);
 
     DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
-    return hid_send_feature_report(dev, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_send_feature_report(dev, (unsigned char*)report, sizeof(*report));
 }
 
 int RazerController::razer_usb_send_argb(razer_argb_report* report)
 {
     DeviceGuardLock _ = guard_manager_ptr->AwaitExclusiveAccess();
-    return hid_send_feature_report(dev_argb, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_send_feature_report(dev_argb, (unsigned char*)report, sizeof(*report));
 }
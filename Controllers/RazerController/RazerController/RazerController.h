@@ -11,9 +11,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <vector>
 #include <hidapi.h>
 #include "RGBController.h"
+#include "hidapi_wrapper.h"
 #include "DeviceGuardManager.h"
 
 /*---------------------------------------------------------*\
@@ -36,6 +39,19 @@ enum
     RAZER_DEVICE_MODE_SOFTWARE                      = 0x03,
 };
 
+/*---------------------------------------------------------*\
+| Razer Report Status                                       |
+\*---------------------------------------------------------*/
+enum
+{
+    RAZER_STATUS_NEW                                = 0x00,
+    RAZER_STATUS_BUSY                               = 0x01,
+    RAZER_STATUS_SUCCESSFUL                         = 0x02,
+    RAZER_STATUS_FAILURE                            = 0x03,
+    RAZER_STATUS_TIMEOUT                            = 0x04,
+    RAZER_STATUS_NOT_SUPPORTED                      = 0x05,
+};
+
 /*---------------------------------------------------------*\
 | Razer Command IDs                                         |
 \*---------------------------------------------------------*/
@@ -217,7 +233,7 @@ PACK(struct razer_argb_report
 class RazerController
 {
 public:
-    RazerController(hid_device* dev_handle, hid_device* dev_argb_handle, const char* path, unsigned short pid, std::string dev_name);
+    RazerController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, hid_device* dev_argb_handle, const char* path, unsigned short pid, std::string dev_name);
     ~RazerController();
 
     unsigned int            GetDeviceIndex();
@@ -250,6 +266,7 @@ public:
     bool                    SupportsWave();
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
     hid_device*             dev_argb;
     unsigned short          dev_pid;
@@ -288,6 +305,12 @@ private:
     \*---------------------------------------------------------*/
     DeviceGuardManager*     guard_manager_ptr;
 
+    /*---------------------------------------------------------*\
+    | Buffers reused across frames                              |
+    \*---------------------------------------------------------*/
+    std::vector<unsigned char>  row_buffer;
+    razer_report                status_report;
+
     /*---------------------------------------------------------*\
     | Private functions based on OpenRazer                      |
     \*---------------------------------------------------------*/
@@ -341,6 +364,7 @@ private:
     void                    razer_set_mode_static(unsigned char red, unsigned char grn, unsigned char blu);
     void                    razer_set_mode_wave(unsigned char direction);
 
+    void                    razer_usb_wait_ready(std::chrono::microseconds max_wait);
     int                     razer_usb_receive(razer_report* report);
     int                     razer_usb_send(razer_report* report);
     int                     razer_usb_send_argb(razer_argb_report* report);
@@ -15,8 +15,9 @@
 
 using namespace std::chrono_literals;
 
-RazerHanboController::RazerHanboController(hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name)
+RazerHanboController::RazerHanboController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name)
 {
+    wrapper         = hid_wrapper;
     dev             = dev_handle;
     dev_pid         = pid;
     location        = path;
@@ -37,7 +38,7 @@ RazerHanboController::RazerHanboController(hid_device* dev_handle, const char* p
 
 RazerHanboController::~RazerHanboController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 unsigned int RazerHanboController::GetDeviceIndex()
@@ -253,10 +254,10 @@ void RazerHanboController::GetFirmware()
 
 int RazerHanboController::UsbReceive(razer_hanbo_report* report)
 {
-    return hid_read_timeout(dev, (unsigned char*)report, sizeof(*report),2);
+    return wrapper.hid_read_timeout(dev, (unsigned char*)report, sizeof(*report),2);
 }
 
 int RazerHanboController::UsbSend(razer_hanbo_report* report)
 {
-    return hid_write(dev, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_write(dev, (unsigned char*)report, sizeof(*report));
 }
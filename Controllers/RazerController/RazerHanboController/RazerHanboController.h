@@ -14,6 +14,7 @@
 #include <string>
 #include <hidapi.h>
 #include "RGBController.h"
+#include "hidapi_wrapper.h"
 
 /*---------------------------------------------------------*\
 | Struct packing macro for GCC and MSVC                     |
@@ -61,7 +62,7 @@ enum
 class RazerHanboController
 {
 public:
-    RazerHanboController(hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name);
+    RazerHanboController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name);
     ~RazerHanboController();
 
     unsigned int            GetDeviceIndex();
@@ -77,6 +78,7 @@ public:
     void                    SetBrightness(int zone, unsigned int brightness);
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
     unsigned short          dev_pid;
 
@@ -15,8 +15,9 @@
 
 using namespace std::chrono_literals;
 
-RazerKrakenController::RazerKrakenController(hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name)
+RazerKrakenController::RazerKrakenController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name)
 {
+    wrapper         = hid_wrapper;
     dev             = dev_handle;
     dev_pid         = pid;
     location        = path;
@@ -65,7 +66,7 @@ RazerKrakenController::RazerKrakenController(hid_device* dev_handle, const char*
 
 RazerKrakenController::~RazerKrakenController()
 {
-    hid_close(dev);
+    wrapper.hid_close(dev);
 }
 
 std::string RazerKrakenController::GetName()
@@ -392,10 +393,10 @@ void RazerKrakenController::razer_set_mode_static(unsigned char red, unsigned ch
 
 int RazerKrakenController::razer_usb_receive(razer_kraken_response_report* report)
 {
-    return hid_read(dev, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_read(dev, (unsigned char*)report, sizeof(*report));
 }
 
 int RazerKrakenController::razer_usb_send(razer_kraken_request_report* report)
 {
-    return hid_write(dev, (unsigned char*)report, sizeof(*report));
+    return wrapper.hid_write(dev, (unsigned char*)report, sizeof(*report));
 }
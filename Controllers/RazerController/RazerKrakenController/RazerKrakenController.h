@@ -14,6 +14,7 @@
 #include <string>
 #include <hidapi.h>
 #include "RGBController.h"
+#include "hidapi_wrapper.h"
 
 /*---------------------------------------------------------*\
 | Struct packing macro for GCC and MSVC                     |
@@ -63,7 +64,7 @@ PACK(struct razer_kraken_response_report
 class RazerKrakenController
 {
 public:
-    RazerKrakenController(hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name);
+    RazerKrakenController(hidapi_wrapper hid_wrapper, hid_device* dev_handle, const char* path, unsigned short pid, std::string dev_name);
     ~RazerKrakenController();
 
     unsigned int            GetDeviceIndex();
@@ -82,6 +83,7 @@ public:
     void                    SetModeStatic(unsigned char red, unsigned char grn, unsigned char blu);
 
 private:
+    hidapi_wrapper          wrapper;
     hid_device*             dev;
     unsigned short          dev_pid;
 
@@ -20,6 +20,8 @@ ValkyrieKeyboardController::ValkyrieKeyboardController(hid_device* dev_handle, c
     location      = path;
     usb_pid       = pid;
     interface_num = interface;
+
+    pacer.SetSpacing(std::chrono::milliseconds(1));
 }
 
 ValkyrieKeyboardController::~ValkyrieKeyboardController()
@@ -121,11 +123,17 @@ void ValkyrieKeyboardController::SendColors(unsigned char* color_data, unsigned
         /*-----------------------------------------------------*\
         | Send packet                                           |
         \*-----------------------------------------------------*/
+        pacer.WaitForReport();
         hid_send_feature_report(dev, (unsigned char *)send_usb_buf, 65);
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        pacer.ReportSent();
     }
     SendTerminateColorPacket();
-    std::this_thread::sleep_for(std::chrono::milliseconds(33));
+
+    /*-----------------------------------------------------*\
+    | The keyboard needs a while after the frame, waited    |
+    | before the next frame instead of blocking this one    |
+    \*-----------------------------------------------------*/
+    pacer.ReportSent(std::chrono::milliseconds(33));
 }
 
 void ValkyrieKeyboardController::SendInitializeColorPacket()
@@ -137,10 +145,12 @@ void ValkyrieKeyboardController::SendInitializeColorPacket()
     usb_write_buf[1]   = 0x04;
     usb_write_buf[2]   = 0x20;
     usb_write_buf[9]   = 0x08;
+    pacer.WaitForReport();
     hid_send_feature_report(dev, (unsigned char *)usb_write_buf, 65);
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pacer.ReportSent();
+    pacer.WaitForReport();
     hid_get_feature_report (dev, (unsigned char *)usb_read_buf, 65);
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pacer.ReportSent();
 }
 
 void ValkyrieKeyboardController::SendTerminateColorPacket()
@@ -149,12 +159,15 @@ void ValkyrieKeyboardController::SendTerminateColorPacket()
     uint8_t usb_read_buf[65];
     memset(usb_write_buf, 0x00, sizeof(usb_write_buf));
     memset(usb_read_buf, 0x00, sizeof(usb_read_buf));
+    pacer.WaitForReport();
     hid_send_feature_report(dev, (unsigned char *)usb_write_buf, 65);
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pacer.ReportSent();
     usb_write_buf[1]   = 0x04;
     usb_write_buf[2]   = 0x02;
+    pacer.WaitForReport();
     hid_send_feature_report(dev, (unsigned char *)usb_write_buf, 65);
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pacer.ReportSent();
+    pacer.WaitForReport();
     hid_get_feature_report (dev, (unsigned char *)usb_read_buf, 65);
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pacer.ReportSent();
 }
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <hidapi.h>
+#include "HIDReportPacer.h"
 #include "RGBController.h"
 
 /*-----------------------------------------------------*\
@@ -49,6 +50,7 @@ private:
     std::string             location;
     unsigned short          usb_pid;
     int                     interface_num;
+    HIDReportPacer          pacer;
 
     void SendInitializeColorPacket();
     void SendTerminateColorPacket();
@@ -36,4 +36,4 @@ void DetectWushiL50USBControllers(hidapi_wrapper wrapper, hid_device_info* info,
     }
 }
 
-REGISTER_HID_WRAPPED_DETECTOR("JSAUX RGB Docking Station", DetectWushiL50USBControllers, WUSHI_VID, WUSHI_PID);
+REGISTER_HID_LIBUSB_DETECTOR("JSAUX RGB Docking Station", DetectWushiL50USBControllers, WUSHI_VID, WUSHI_PID);
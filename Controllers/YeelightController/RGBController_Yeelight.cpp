@@ -33,6 +33,7 @@ RGBController_Yeelight::RGBController_Yeelight(YeelightController* controller_pt
     description = "Yeelight Device";
     serial      = controller->GetUniqueID();
     location    = controller->GetLocation();
+    flags      |= CONTROLLER_FLAG_ADAPTIVE_RATE | CONTROLLER_FLAG_OUTPUT_COLORS;
 
     /*---------------------------------------------------------*\
     | If using music mode, use mode name "Direct" as the music  |
@@ -96,9 +97,10 @@ void RGBController_Yeelight::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_Yeelight::DeviceUpdateLEDs()
 {
-    unsigned char red = RGBGetRValue(colors[0]);
-    unsigned char grn = RGBGetGValue(colors[0]);
-    unsigned char blu = RGBGetBValue(colors[0]);
+    RGBColor      color = GetOutputColors()[0];
+    unsigned char red   = RGBGetRValue(color);
+    unsigned char grn   = RGBGetGValue(color);
+    unsigned char blu   = RGBGetBValue(color);
 
     controller->SetColor(red, grn, blu);
 }
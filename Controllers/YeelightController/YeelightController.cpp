@@ -9,9 +9,16 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <stdio.h>
 #include "YeelightController.h"
+#include "LogManager.h"
+#include "RGBControllerStats.h"
 #include <nlohmann/json.hpp>
 
+#ifdef _WIN32
+#define MSG_NOSIGNAL 0
+#endif
+
 using json = nlohmann::json;
 
 YeelightController::YeelightController(std::string ip, std::string host_ip, bool music_mode_val)
@@ -22,11 +29,19 @@ YeelightController::YeelightController(std::string ip, std::string host_ip, bool
     location    = "IP: " + ip;
     music_mode  = music_mode_val;
     this->host_ip = host_ip;
+    music_mode_sock = NULL;
+    music_mode_listening = false;
 
     /*-----------------------------------------------------------------*\
-    | Open a TCP client sending to the device's IP, port 38899          |
+    | Open a persistent TCP connection to the device's IP, port 55443.  |
+    | The bulb answers every command with one line, wait for the answer |
+    | before sending the next command.  Answers carry the command id,   |
+    | state change notifications ("props") do not and are skipped.      |
     \*-----------------------------------------------------------------*/
-    port.tcp_client(ip.c_str(), "55443");
+    port.open(ip.c_str(), "55443");
+    port.set_response_delimiter("\r\n");
+    port.set_response_match(YEELIGHT_RESPONSE_MATCH);
+    port.set_pipeline_depth(1);
 
     SetPower();
 
@@ -72,18 +87,29 @@ YeelightController::YeelightController(std::string ip, std::string host_ip, bool
             /*-----------------------------------------------------------------*\
             | Command bulb to connect to our TCP server                         |
             \*-----------------------------------------------------------------*/
+            music_mode_listening = true;
+
             SetMusicMode();
 
             /*-----------------------------------------------------------------*\
-            | Get the client socket for the music mode connection               |
+            | Get the client socket for the music mode connection.  The bulb    |
+            | keeps this connection open and accepts commands on it at any      |
+            | rate.  If it does not connect back, use the command connection.   |
             \*-----------------------------------------------------------------*/
-            music_mode_sock = music_mode_server.tcp_server_listen();
+            music_mode_sock = music_mode_server.tcp_server_listen(YEELIGHT_MUSIC_MODE_TIMEOUT_MS);
+
+            if(music_mode_sock == NULL)
+            {
+                LOG_WARNING("[Yeelight] %s did not connect for music mode, using command connection", ip.c_str());
+                CloseMusicMode();
+            }
         }
     }
 }
 
 YeelightController::~YeelightController()
 {
+    CloseMusicMode();
 }
 
 std::string YeelightController::GetLocation()
@@ -156,9 +182,7 @@ void YeelightController::SetMusicMode()
     \*-----------------------------------------------------------------*/
     std::string command_str     = command.dump().append("\r\n");
 
-    port.tcp_client_connect();
-    port.tcp_client_write((char *)command_str.c_str(), (int)command_str.length() + 1);
-    port.tcp_close();
+    port.queue_write(command_str.c_str(), (int)command_str.length());
 }
 
 void YeelightController::SetPower()
@@ -182,15 +206,11 @@ void YeelightController::SetPower()
     \*-----------------------------------------------------------------*/
     std::string command_str     = command.dump().append("\r\n");
 
-    port.tcp_client_connect();
-    port.tcp_client_write((char *)command_str.c_str(), (int)command_str.length() + 1);
-    port.tcp_close();
+    port.queue_write(command_str.c_str(), (int)command_str.length());
 }
 
 void YeelightController::SetColor(unsigned char red, unsigned char green, unsigned char blue)
 {
-    json command;
-
     /*-----------------------------------------------------------------*\
     | Yeelight doesn't seem to support proper RGB, it just uses RGB to  |
     | calculate hue and saturation.  It doesn't affect brightness.  To  |
@@ -221,31 +241,53 @@ void YeelightController::SetColor(unsigned char red, unsigned char green, unsign
     | the Color Flow option but configure only one frame.  Because the  |
     | set_cf option provides both RGB and brightness in one command, it |
     | allows better RGB control than the set_rgb function.              |
+    |                                                                   |
+    | The command is formatted into a fixed buffer, as this runs for    |
+    | every frame in music mode.                                        |
     \*-----------------------------------------------------------------*/
-    std::string cf = "50,1," + std::to_string(rgb) +"," + std::to_string((int)bright);
+    int command_len = snprintf(color_command, sizeof(color_command), YEELIGHT_COLOR_COMMAND_FORMAT, rgb, (int)bright);
+
+    if(music_mode)
+    {
+        RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_NETWORK, command_len);
+
+        if(send(*music_mode_sock, color_command, command_len, MSG_NOSIGNAL) == command_len)
+        {
+            return;
+        }
+
+        /*-------------------------------------------------------------*\
+        | The bulb closed the music mode connection, continue on the    |
+        | command connection                                            |
+        \*-------------------------------------------------------------*/
+        LOG_WARNING("[Yeelight] Music mode connection lost, using command connection");
+        CloseMusicMode();
+    }
 
     /*-----------------------------------------------------------------*\
-    | Fill in the set_cf command with the color flow string.            |
+    | Only the newest color matters, replace any color command that has |
+    | not been sent yet                                                 |
     \*-----------------------------------------------------------------*/
-    command["id"]               = 1;
-    command["method"]           = "start_cf";
-    command["params"][0]        = 1;
-    command["params"][1]        = 1;
-    command["params"][2]        = cf;
+    port.queue_write(color_command, command_len, YEELIGHT_COALESCE_COLOR);
+}
 
+void YeelightController::CloseMusicMode()
+{
     /*-----------------------------------------------------------------*\
-    | Convert the JSON object to a string and write it                  |
+    | Close the bulb's music mode connection and the server it          |
+    | connected to, further commands use the command connection         |
     \*-----------------------------------------------------------------*/
-    std::string command_str     = command.dump().append("\r\n");
-
-    if(music_mode)
+    if(music_mode_sock != NULL)
     {
-        send(*music_mode_sock, (char *)command_str.c_str(), (int)command_str.length(), 0);
+        music_mode_server.tcp_server_close_client(music_mode_sock);
+        music_mode_sock = NULL;
     }
-    else
+
+    if(music_mode_listening)
     {
-        port.tcp_client_connect();
-        port.tcp_client_write((char *)command_str.c_str(), (int)command_str.length() + 1);
-        port.tcp_close();
+        music_mode_server.tcp_close();
+        music_mode_listening = false;
     }
+
+    music_mode = false;
 }
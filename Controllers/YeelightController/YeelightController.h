@@ -16,6 +16,30 @@
 #include <vector>
 #include "RGBController.h"
 #include "net_port.h"
+#include "tcp_connection.h"
+
+/*---------------------------------------------------------*\
+| Write queue key for color commands                        |
+\*---------------------------------------------------------*/
+#define YEELIGHT_COALESCE_COLOR     1
+
+/*---------------------------------------------------------*\
+| Time to wait for the bulb to connect back in music mode   |
+\*---------------------------------------------------------*/
+#define YEELIGHT_MUSIC_MODE_TIMEOUT_MS  5000
+
+/*---------------------------------------------------------*\
+| One frame color flow command, filled in with the RGB      |
+| value and brightness for every color update               |
+\*---------------------------------------------------------*/
+#define YEELIGHT_COLOR_COMMAND_FORMAT   "{\"id\":1,\"method\":\"start_cf\",\"params\":[1,1,\"50,1,%u,%d\"]}\r\n"
+#define YEELIGHT_COLOR_COMMAND_SIZE     96
+
+/*---------------------------------------------------------*\
+| Every command is sent with id 1, the bulb echoes it in    |
+| its answer                                                |
+\*---------------------------------------------------------*/
+#define YEELIGHT_RESPONSE_MATCH         "\"id\":1"
 
 class YeelightController
 {
@@ -38,9 +62,13 @@ public:
 private:
     std::string         location;
     std::string         host_ip;
-    net_port            port;
+    tcp_connection      port;
     bool                music_mode;
     unsigned int        music_mode_port;
     net_port            music_mode_server;
     SOCKET *            music_mode_sock;
+    bool                music_mode_listening;
+    char                color_command[YEELIGHT_COLOR_COMMAND_SIZE];
+
+    void CloseMusicMode();
 };
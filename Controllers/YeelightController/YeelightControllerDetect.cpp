@@ -11,6 +11,7 @@
 
 #include "Detector.h"
 #include "YeelightController.h"
+#include "NetworkDetection.h"
 #include "RGBController_Yeelight.h"
 #include "SettingsManager.h"
 
@@ -55,10 +56,13 @@ void DetectYeelightControllers()
                     music_mode = yeelight_settings["devices"][device_idx]["music_mode"];
                 }
 
-                YeelightController*     controller     = new YeelightController(yeelight_ip, yeelight_host_ip, music_mode);
-                RGBController_Yeelight* rgb_controller = new RGBController_Yeelight(controller);
+                ResourceManager::get()->GetNetworkDetection()->StartProbe(yeelight_ip, [yeelight_ip, yeelight_host_ip, music_mode]() -> RGBController*
+                {
+                    YeelightController*     controller     = new YeelightController(yeelight_ip, yeelight_host_ip, music_mode);
+                    RGBController_Yeelight* rgb_controller = new RGBController_Yeelight(controller);
 
-                ResourceManager::get()->RegisterRGBController(rgb_controller);
+                    return(rgb_controller);
+                });
             }
         }
     }
@@ -0,0 +1,602 @@
+/*---------------------------------------------------------*\
+| EffectsEngine.cpp                                         |
+|                                                           |
+|   Built-in effects rendered by the server directly into   |
+|   RGBController color buffers                             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "EffectsEngine.h"
+#include "LogManager.h"
+#include "hsv.h"
+
+/*---------------------------------------------------------*\
+| Cycle length used when the parameters leave it at zero    |
+\*---------------------------------------------------------*/
+#define EFFECTS_ENGINE_DEFAULT_PERIOD_MS    4000
+
+/*---------------------------------------------------------*\
+| Fixed part of the effect description, see                 |
+| GetEffectDescription()                                    |
+\*---------------------------------------------------------*/
+#define EFFECTS_ENGINE_DESCRIPTION_SIZE     16
+
+const char* effect_id_to_str(int effect)
+{
+    switch(effect)
+    {
+    case EFFECT_ID_NONE:
+        return "None";
+    case EFFECT_ID_SOLID:
+        return "Solid";
+    case EFFECT_ID_BREATHING:
+        return "Breathing";
+    case EFFECT_ID_SPECTRUM_CYCLE:
+        return "Spectrum Cycle";
+    case EFFECT_ID_WAVE:
+        return "Wave";
+    case EFFECT_ID_GRADIENT:
+        return "Gradient";
+    default:
+        return "Unknown";
+    }
+}
+
+EffectParams::EffectParams()
+{
+    effect      = EFFECT_ID_NONE;
+    period_ms   = 0;
+    brightness  = 255;
+    direction   = EFFECT_DIRECTION_FORWARD;
+}
+
+EffectsEngine::EffectsEngine(FrameClock* clock)
+{
+    frame_clock = clock;
+    epoch_us    = RGBControllerStats::NowMicroseconds();
+
+    /*-----------------------------------------------------*\
+    | Precompute the fully saturated hue wheel used by the  |
+    | spectrum cycle and wave effects                       |
+    \*-----------------------------------------------------*/
+    for(unsigned int hue = 0; hue < 360; hue++)
+    {
+        hsv_t hsv;
+
+        hsv.hue         = hue;
+        hsv.saturation  = 255;
+        hsv.value       = 255;
+
+        hue_table[hue]  = hsv2rgb(&hsv);
+    }
+
+    frame_clock->RegisterFrameCallback(FrameCallback, this);
+}
+
+EffectsEngine::~EffectsEngine()
+{
+    frame_clock->UnregisterFrameCallback(this);
+
+    StopAll();
+}
+
+bool EffectsEngine::StartEffect(RGBController* controller, const EffectParams& params)
+{
+    /*-----------------------------------------------------*\
+    | Only locally owned controllers are driven.  Remote    |
+    | controllers are deleted by their network client       |
+    | without going through the resource manager, and the   |
+    | remote server can run the effect itself.              |
+    \*-----------------------------------------------------*/
+    if((controller == nullptr) || !(controller->flags & CONTROLLER_FLAG_LOCAL))
+    {
+        return(false);
+    }
+
+    if((params.effect <= EFFECT_ID_NONE) || (params.effect >= EFFECT_ID_COUNT))
+    {
+        return(false);
+    }
+
+    LOG_INFO("[%s] Starting %s effect", controller->name.c_str(), effect_id_to_str(params.effect));
+
+    /*-----------------------------------------------------*\
+    | Switch the controller to a per-LED mode, unless it is |
+    | in one already                                        |
+    \*-----------------------------------------------------*/
+    int previous_mode = controller->active_mode;
+
+    if((previous_mode < 0)
+    || ((std::size_t)previous_mode >= controller->modes.size())
+    || (controller->modes[previous_mode].color_mode != MODE_COLORS_PER_LED))
+    {
+        controller->SetCustomMode();
+
+        if(controller->active_mode != previous_mode)
+        {
+            controller->UpdateMode();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(DevicesMutex);
+
+    EffectDevice* device = nullptr;
+
+    for(EffectDevice* existing : devices)
+    {
+        if(existing->controller == controller)
+        {
+            device = existing;
+            break;
+        }
+    }
+
+    if(device == nullptr)
+    {
+        device              = new EffectDevice;
+        device->controller  = controller;
+
+        devices.push_back(device);
+    }
+
+    device->params      = params;
+    device->rendered    = false;
+    device->positions.clear();
+
+    lock.unlock();
+
+    frame_clock->Wake();
+
+    return(true);
+}
+
+void EffectsEngine::StopEffect(RGBController* controller)
+{
+    std::lock_guard<std::mutex> lock(DevicesMutex);
+
+    for(std::size_t device_idx = 0; device_idx < devices.size(); device_idx++)
+    {
+        if(devices[device_idx]->controller == controller)
+        {
+            LOG_INFO("[%s] Stopping %s effect", controller->name.c_str(), effect_id_to_str(devices[device_idx]->params.effect));
+
+            delete devices[device_idx];
+            devices.erase(devices.begin() + device_idx);
+            break;
+        }
+    }
+}
+
+void EffectsEngine::StopAll()
+{
+    std::lock_guard<std::mutex> lock(DevicesMutex);
+
+    for(EffectDevice* device : devices)
+    {
+        delete device;
+    }
+
+    devices.clear();
+}
+
+bool EffectsEngine::GetEffect(RGBController* controller, EffectParams* params)
+{
+    std::lock_guard<std::mutex> lock(DevicesMutex);
+
+    for(EffectDevice* device : devices)
+    {
+        if(device->controller == controller)
+        {
+            *params = device->params;
+            return(true);
+        }
+    }
+
+    *params = EffectParams();
+
+    return(false);
+}
+
+/*---------------------------------------------------------*\
+| Effect description layout                                 |
+|                                                           |
+|   unsigned int        data_size                           |
+|   unsigned int        effect                              |
+|   unsigned int        period_ms                           |
+|   unsigned char       brightness                          |
+|   unsigned char       direction                           |
+|   unsigned short      num_colors                          |
+|   RGBColor            colors[num_colors]                  |
+\*---------------------------------------------------------*/
+unsigned char* EffectsEngine::GetEffectDescription(const EffectParams& params)
+{
+    unsigned short  num_colors  = (unsigned short)std::min(params.colors.size(), (std::size_t)0xFFFF);
+    unsigned int    data_size   = EFFECTS_ENGINE_DESCRIPTION_SIZE + (num_colors * sizeof(RGBColor));
+    unsigned int    effect      = (unsigned int)params.effect;
+    unsigned int    data_ptr    = 0;
+    unsigned char*  data_buf    = new unsigned char[data_size];
+
+    memcpy(&data_buf[data_ptr], &data_size, sizeof(data_size));
+    data_ptr += sizeof(data_size);
+
+    memcpy(&data_buf[data_ptr], &effect, sizeof(effect));
+    data_ptr += sizeof(effect);
+
+    memcpy(&data_buf[data_ptr], &params.period_ms, sizeof(params.period_ms));
+    data_ptr += sizeof(params.period_ms);
+
+    data_buf[data_ptr++] = params.brightness;
+    data_buf[data_ptr++] = params.direction;
+
+    memcpy(&data_buf[data_ptr], &num_colors, sizeof(num_colors));
+    data_ptr += sizeof(num_colors);
+
+    if(num_colors > 0)
+    {
+        memcpy(&data_buf[data_ptr], params.colors.data(), num_colors * sizeof(RGBColor));
+    }
+
+    return(data_buf);
+}
+
+bool EffectsEngine::ReadEffectDescription(unsigned char* data_buf, unsigned int data_size, EffectParams* params)
+{
+    unsigned int    description_size;
+    unsigned int    effect;
+    unsigned short  num_colors;
+    unsigned int    data_ptr    = 0;
+
+    if(data_size < EFFECTS_ENGINE_DESCRIPTION_SIZE)
+    {
+        return(false);
+    }
+
+    memcpy(&description_size, &data_buf[data_ptr], sizeof(description_size));
+    data_ptr += sizeof(description_size);
+
+    memcpy(&effect, &data_buf[data_ptr], sizeof(effect));
+    data_ptr += sizeof(effect);
+
+    memcpy(&params->period_ms, &data_buf[data_ptr], sizeof(params->period_ms));
+    data_ptr += sizeof(params->period_ms);
+
+    params->brightness  = data_buf[data_ptr++];
+    params->direction   = data_buf[data_ptr++];
+
+    memcpy(&num_colors, &data_buf[data_ptr], sizeof(num_colors));
+    data_ptr += sizeof(num_colors);
+
+    /*-----------------------------------------------------*\
+    | The embedded size must match both the packet and the  |
+    | color count                                           |
+    \*-----------------------------------------------------*/
+    if((description_size != data_size)
+    || (description_size != (EFFECTS_ENGINE_DESCRIPTION_SIZE + (num_colors * sizeof(RGBColor)))))
+    {
+        return(false);
+    }
+
+    params->effect = (int)effect;
+    params->colors.resize(num_colors);
+
+    if(num_colors > 0)
+    {
+        memcpy(params->colors.data(), &data_buf[data_ptr], num_colors * sizeof(RGBColor));
+    }
+
+    return(true);
+}
+
+bool EffectsEngine::FrameCallback(void * this_ptr, long long tick_us)
+{
+    return(((EffectsEngine *)this_ptr)->RenderFrame(tick_us));
+}
+
+/*---------------------------------------------------------*\
+| Called on every frame clock tick.  All devices render     |
+| with the tick time so effects stay in phase across        |
+| controllers, and are committed as one frame.  Returns     |
+| false once only static effects that have already been     |
+| submitted remain, letting the clock go idle.              |
+\*---------------------------------------------------------*/
+bool EffectsEngine::RenderFrame(long long tick_us)
+{
+    std::lock_guard<std::mutex> lock(DevicesMutex);
+
+    if(devices.empty())
+    {
+        return(false);
+    }
+
+    unsigned long long  time_ms     = (unsigned long long)((tick_us - epoch_us) / 1000);
+    bool                animating   = false;
+
+    frame_clock->BeginFrame();
+
+    for(EffectDevice* device : devices)
+    {
+        if(RenderEffect(device, time_ms))
+        {
+            frame_clock->MarkDirty(device->controller);
+        }
+
+        if(!device->rendered)
+        {
+            animating = true;
+        }
+    }
+
+    frame_clock->CommitFrame();
+
+    return(animating);
+}
+
+bool EffectsEngine::RenderEffect(EffectDevice* device, unsigned long long time_ms)
+{
+    RGBController*      controller  = device->controller;
+    const EffectParams& params      = device->params;
+
+    /*-----------------------------------------------------*\
+    | Take the lock the device thread holds while it reads  |
+    | colors.  If the device is busy with an update, skip   |
+    | it this frame rather than stall the other devices.  A |
+    | static effect stays unrendered and is retried.        |
+    \*-----------------------------------------------------*/
+    std::unique_lock<std::mutex> colors_lock(controller->colors_mutex, std::try_to_lock);
+
+    if(!colors_lock.owns_lock())
+    {
+        return(false);
+    }
+
+    std::size_t         num_leds    = controller->colors.size();
+
+    /*-----------------------------------------------------*\
+    | Rebuild the layout on start and after a zone resize,  |
+    | which also re-renders static effects                  |
+    \*-----------------------------------------------------*/
+    if(device->positions.size() != num_leds)
+    {
+        BuildLayout(controller, &device->positions);
+        device->rendered = false;
+    }
+
+    if(device->rendered || (num_leds == 0))
+    {
+        return(false);
+    }
+
+    RGBColor*           colors      = controller->colors.data();
+    const float*        positions   = device->positions.data();
+    unsigned int        period_ms   = (params.period_ms == 0) ? EFFECTS_ENGINE_DEFAULT_PERIOD_MS : params.period_ms;
+    unsigned long long  cycle       = time_ms / period_ms;
+    float               phase       = (float)(time_ms % period_ms) / (float)period_ms;
+    unsigned char       brightness  = params.brightness;
+    bool                reverse     = (params.direction == EFFECT_DIRECTION_REVERSE);
+
+    switch(params.effect)
+    {
+    case EFFECT_ID_SOLID:
+        std::fill(colors, colors + num_leds, params.colors.empty() ? ToRGBColor(255, 255, 255) : params.colors[0]);
+        device->rendered = true;
+        break;
+
+    case EFFECT_ID_BREATHING:
+        {
+            /*---------------------------------------------*\
+            | Raised cosine, dark at the start of each      |
+            | cycle.  Each cycle moves to the next color.   |
+            \*---------------------------------------------*/
+            float    intensity  = 0.5f - (0.5f * cosf(2.0f * 3.14159265f * phase));
+            RGBColor color      = ToRGBColor(255, 255, 255);
+
+            if(!params.colors.empty())
+            {
+                color = params.colors[cycle % params.colors.size()];
+            }
+
+            brightness = (unsigned char)(brightness * intensity);
+
+            std::fill(colors, colors + num_leds, color);
+        }
+        break;
+
+    case EFFECT_ID_SPECTRUM_CYCLE:
+        {
+            unsigned int hue = (unsigned int)(phase * 360.0f) % 360;
+
+            if(reverse)
+            {
+                hue = 359 - hue;
+            }
+
+            std::fill(colors, colors + num_leds, hue_table[hue]);
+        }
+        break;
+
+    case EFFECT_ID_WAVE:
+        {
+            /*---------------------------------------------*\
+            | Forward moves the pattern toward position 1.0 |
+            \*---------------------------------------------*/
+            float offset = reverse ? phase : (1.0f - phase);
+
+            for(std::size_t led_idx = 0; led_idx < num_leds; led_idx++)
+            {
+                float position = positions[led_idx] + offset;
+
+                position -= floorf(position);
+
+                if(params.colors.size() < 2)
+                {
+                    colors[led_idx] = hue_table[(unsigned int)(position * 360.0f) % 360];
+                }
+                else
+                {
+                    colors[led_idx] = SampleColors(params.colors, position, true);
+                }
+            }
+        }
+        break;
+
+    case EFFECT_ID_GRADIENT:
+        {
+            static const std::vector<RGBColor> default_colors = { ToRGBColor(255, 0, 0), ToRGBColor(0, 0, 255) };
+
+            const std::vector<RGBColor>& gradient_colors = params.colors.empty() ? default_colors : params.colors;
+
+            for(std::size_t led_idx = 0; led_idx < num_leds; led_idx++)
+            {
+                float position = reverse ? (1.0f - positions[led_idx]) : positions[led_idx];
+
+                colors[led_idx] = SampleColors(gradient_colors, position, false);
+            }
+
+            device->rendered = true;
+        }
+        break;
+
+    default:
+        device->rendered = true;
+        return(false);
+    }
+
+    if(brightness != 255)
+    {
+        rgb_color_correct(colors, (unsigned int)num_leds, colors, RGB_COLOR_ORDER_RGB, brightness);
+    }
+
+    return(true);
+}
+
+/*---------------------------------------------------------*\
+| Linear interpolation across a color list.  With wrap the  |
+| last color blends back into the first over the final      |
+| 1/N of the range.                                         |
+\*---------------------------------------------------------*/
+RGBColor EffectsEngine::SampleColors(const std::vector<RGBColor>& colors, float position, bool wrap)
+{
+    std::size_t num_colors = colors.size();
+
+    if(num_colors == 1)
+    {
+        return(colors[0]);
+    }
+
+    float       scaled      = position * (wrap ? num_colors : (num_colors - 1));
+    std::size_t color_idx   = (std::size_t)scaled;
+
+    if(!wrap && (color_idx >= (num_colors - 1)))
+    {
+        color_idx = num_colors - 2;
+    }
+
+    color_idx %= num_colors;
+
+    std::size_t next_idx    = (color_idx + 1) % num_colors;
+    unsigned int weight     = (unsigned int)((scaled - color_idx) * 256.0f);
+
+    if(weight > 256)
+    {
+        weight = 256;
+    }
+
+    RGBColor    from        = colors[color_idx];
+    RGBColor    to          = colors[next_idx];
+
+    unsigned int red        = ((RGBGetRValue(from) * (256 - weight)) + (RGBGetRValue(to) * weight)) >> 8;
+    unsigned int grn        = ((RGBGetGValue(from) * (256 - weight)) + (RGBGetGValue(to) * weight)) >> 8;
+    unsigned int blu        = ((RGBGetBValue(from) * (256 - weight)) + (RGBGetBValue(to) * weight)) >> 8;
+
+    return(ToRGBColor(red, grn, blu));
+}
+
+/*---------------------------------------------------------*\
+| Assign each LED a position from 0.0 to 1.0 along the      |
+| device.  Matrix zones use the LED's column in the matrix  |
+| map, zones with segments are laid out per segment, other  |
+| linear zones by index, and single LED zones are spread    |
+| across the device by zone index.                          |
+\*---------------------------------------------------------*/
+void EffectsEngine::BuildLayout(RGBController* controller, std::vector<float>* positions)
+{
+    std::size_t num_leds    = controller->colors.size();
+    std::size_t num_zones   = controller->zones.size();
+
+    positions->assign(num_leds, 0.0f);
+
+    for(std::size_t zone_idx = 0; zone_idx < num_zones; zone_idx++)
+    {
+        zone&        current_zone   = controller->zones[zone_idx];
+        unsigned int zone_start     = current_zone.start_idx;
+        unsigned int zone_leds      = current_zone.leds_count;
+
+        if((zone_start >= num_leds) || (zone_leds == 0))
+        {
+            continue;
+        }
+
+        if(zone_leds > (num_leds - zone_start))
+        {
+            zone_leds = (unsigned int)(num_leds - zone_start);
+        }
+
+        float*       zone_positions = positions->data() + zone_start;
+
+        if((current_zone.type == ZONE_TYPE_MATRIX) && (current_zone.matrix_map != NULL) && (current_zone.matrix_map->width > 0))
+        {
+            matrix_map_type* matrix_map = current_zone.matrix_map;
+            float            column_max = (matrix_map->width > 1) ? (float)(matrix_map->width - 1) : 1.0f;
+
+            for(unsigned int y = 0; y < matrix_map->height; y++)
+            {
+                for(unsigned int x = 0; x < matrix_map->width; x++)
+                {
+                    unsigned int led_idx = matrix_map->map[(y * matrix_map->width) + x];
+
+                    if(led_idx < zone_leds)
+                    {
+                        zone_positions[led_idx] = x / column_max;
+                    }
+                }
+            }
+        }
+        else if(current_zone.type == ZONE_TYPE_SINGLE)
+        {
+            float zone_position = (num_zones > 1) ? ((float)zone_idx / (float)(num_zones - 1)) : 0.0f;
+
+            std::fill(zone_positions, zone_positions + zone_leds, zone_position);
+        }
+        else
+        {
+            for(unsigned int led_idx = 0; led_idx < zone_leds; led_idx++)
+            {
+                zone_positions[led_idx] = (zone_leds > 1) ? ((float)led_idx / (float)(zone_leds - 1)) : 0.0f;
+            }
+
+            /*---------------------------------------------*\
+            | Segments are separate physical runs, lay each |
+            | one out over the full range                   |
+            \*---------------------------------------------*/
+            for(const segment& current_segment : current_zone.segments)
+            {
+                for(unsigned int led_idx = 0; led_idx < current_segment.leds_count; led_idx++)
+                {
+                    unsigned int zone_led_idx = current_segment.start_idx + led_idx;
+
+                    if(zone_led_idx >= zone_leds)
+                    {
+                        break;
+                    }
+
+                    zone_positions[zone_led_idx] = (current_segment.leds_count > 1) ? ((float)led_idx / (float)(current_segment.leds_count - 1)) : 0.0f;
+                }
+            }
+        }
+    }
+}
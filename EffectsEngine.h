@@ -0,0 +1,115 @@
+/*---------------------------------------------------------*\
+| EffectsEngine.h                                           |
+|                                                           |
+|   Built-in effects rendered by the server directly into   |
+|   RGBController color buffers                             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "FrameClock.h"
+#include "RGBController.h"
+
+/*------------------------------------------------------------------*\
+| Effect Types                                                       |
+\*------------------------------------------------------------------*/
+enum
+{
+    EFFECT_ID_NONE                      = 0,    /* No effect running            */
+    EFFECT_ID_SOLID                     = 1,    /* Static single color          */
+    EFFECT_ID_BREATHING                 = 2,    /* Fade in and out, cycling     */
+                                                /* through the colors           */
+    EFFECT_ID_SPECTRUM_CYCLE            = 3,    /* Whole device cycles hue      */
+    EFFECT_ID_WAVE                      = 4,    /* Rainbow, or the colors, as a */
+                                                /* moving gradient              */
+    EFFECT_ID_GRADIENT                  = 5,    /* Static gradient across the   */
+                                                /* colors                       */
+    EFFECT_ID_COUNT
+};
+
+/*------------------------------------------------------------------*\
+| Effect Directions                                                  |
+\*------------------------------------------------------------------*/
+enum
+{
+    EFFECT_DIRECTION_FORWARD            = 0,    /* Left to right, start to end  */
+    EFFECT_DIRECTION_REVERSE            = 1,    /* Right to left, end to start  */
+};
+
+const char* effect_id_to_str(int effect);
+
+/*------------------------------------------------------------------*\
+| Effect Parameters                                                  |
+\*------------------------------------------------------------------*/
+class EffectParams
+{
+public:
+    int                     effect;         /* EFFECT_ID_*                          */
+    unsigned int            period_ms;      /* Length of one cycle, 0 for default   */
+    unsigned char           brightness;     /* Output scale, 255 = unchanged        */
+    unsigned char           direction;      /* EFFECT_DIRECTION_*                   */
+    std::vector<RGBColor>   colors;         /* Effect colors, may be empty          */
+
+    EffectParams();
+};
+
+class EffectsEngine
+{
+public:
+    EffectsEngine(FrameClock* clock);
+    ~EffectsEngine();
+
+    /*---------------------------------------------------------*\
+    | Start an effect on a locally owned controller, replacing  |
+    | any effect already running on it.  Switches the           |
+    | controller to its custom (direct) mode unless it is       |
+    | already in a per-LED mode.  Returns false if the          |
+    | controller is remote or the parameters are invalid.       |
+    \*---------------------------------------------------------*/
+    bool                    StartEffect(RGBController* controller, const EffectParams& params);
+
+    /*---------------------------------------------------------*\
+    | Stop the effect on a controller.  Once this returns the   |
+    | engine no longer touches the controller, so it must be    |
+    | called before a controller is unregistered or deleted.    |
+    \*---------------------------------------------------------*/
+    void                    StopEffect(RGBController* controller);
+    void                    StopAll();
+
+    bool                    GetEffect(RGBController* controller, EffectParams* params);
+
+    /*---------------------------------------------------------*\
+    | SDK packet helpers, see Documentation/OpenRGBSDK.md       |
+    \*---------------------------------------------------------*/
+    static unsigned char*   GetEffectDescription(const EffectParams& params);
+    static bool             ReadEffectDescription(unsigned char* data_buf, unsigned int data_size, EffectParams* params);
+
+private:
+    typedef struct
+    {
+        RGBController*          controller;
+        EffectParams            params;
+        std::vector<float>      positions;      /* Per LED position, 0.0 to 1.0     */
+        bool                    rendered;       /* Static effect already submitted  */
+    } EffectDevice;
+
+    std::mutex                              DevicesMutex;
+    std::vector<EffectDevice*>              devices;
+
+    FrameClock*                             frame_clock;
+    long long                               epoch_us;
+
+    RGBColor                                hue_table[360];
+
+    static bool             FrameCallback(void * this_ptr, long long tick_us);
+    bool                    RenderFrame(long long tick_us);
+    bool                    RenderEffect(EffectDevice* device, unsigned long long time_ms);
+    RGBColor                SampleColors(const std::vector<RGBColor>& colors, float position, bool wrap);
+
+    static void             BuildLayout(RGBController* controller, std::vector<float>* positions);
+};
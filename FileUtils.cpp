@@ -0,0 +1,49 @@
+/*---------------------------------------------------------*\
+| FileUtils.cpp                                             |
+|                                                           |
+|   File utility functions                                  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <fstream>
+#include "FileUtils.h"
+#include "LogManager.h"
+
+bool FileUtils::write_file_atomic(const filesystem::path& filename, const std::string& contents)
+{
+    filesystem::path temp_filename = filename;
+    temp_filename += ".tmp";
+
+    std::ofstream file(temp_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if(!file)
+    {
+        LOG_ERROR("[FileUtils] Cannot open file for writing: %s", temp_filename.generic_u8string().c_str());
+        return(false);
+    }
+
+    file << contents;
+    file.close();
+
+    std::error_code ec;
+
+    if(file.fail())
+    {
+        LOG_ERROR("[FileUtils] Cannot write to file: %s", temp_filename.generic_u8string().c_str());
+        filesystem::remove(temp_filename, ec);
+        return(false);
+    }
+
+    filesystem::rename(temp_filename, filename, ec);
+
+    if(ec)
+    {
+        LOG_ERROR("[FileUtils] Cannot replace file %s: %s", filename.generic_u8string().c_str(), ec.message().c_str());
+        filesystem::remove(temp_filename, ec);
+        return(false);
+    }
+
+    return(true);
+}
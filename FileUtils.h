@@ -0,0 +1,25 @@
+/*---------------------------------------------------------*\
+| FileUtils.h                                               |
+|                                                           |
+|   File utility functions                                  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include "filesystem.h"
+
+class FileUtils
+{
+public:
+    /*-----------------------------------------------------*\
+    | Write to a temporary file and rename it over the      |
+    | target, so an interrupted write never leaves a        |
+    | truncated file behind.  Returns false and logs the    |
+    | reason if the file was not replaced.                  |
+    \*-----------------------------------------------------*/
+    static bool write_file_atomic(const filesystem::path& filename, const std::string& contents);
+};
@@ -0,0 +1,386 @@
+/*---------------------------------------------------------*\
+| FrameClock.cpp                                            |
+|                                                           |
+|   Shared frame clock that batches color updates from      |
+|   effect sources and dispatches them to all controllers   |
+|   on the same tick                                        |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include "FrameClock.h"
+
+FrameClock::FrameClock()
+{
+    open_frames             = 0;
+    wake_requested          = false;
+    dispatching             = nullptr;
+    frame_rate              = FRAME_CLOCK_DEFAULT_RATE;
+
+    ResetStats();
+
+    clock_thread_running    = true;
+    ClockThread             = new std::thread(&FrameClock::ClockThreadFunction, this);
+}
+
+FrameClock::~FrameClock()
+{
+    {
+        std::lock_guard<std::mutex> lock(ClockMutex);
+        clock_thread_running = false;
+    }
+
+    ClockCondition.notify_all();
+
+    ClockThread->join();
+    delete ClockThread;
+    ClockThread = nullptr;
+}
+
+void FrameClock::SetFrameRate(unsigned int new_frame_rate)
+{
+    if(new_frame_rate < 1)
+    {
+        new_frame_rate = 1;
+    }
+
+    frame_rate = new_frame_rate;
+}
+
+unsigned int FrameClock::GetFrameRate()
+{
+    return(frame_rate);
+}
+
+void FrameClock::RegisterFrameCallback(FrameClockCallback new_callback, void * new_callback_arg)
+{
+    {
+        std::lock_guard<std::mutex> lock(CallbackMutex);
+
+        FrameCallbacks.push_back(new_callback);
+        FrameCallbackArgs.push_back(new_callback_arg);
+    }
+
+    Wake();
+}
+
+/*---------------------------------------------------------*\
+| Takes the callback mutex, so once this returns the        |
+| callback is not running and will not be called again      |
+\*---------------------------------------------------------*/
+void FrameClock::UnregisterFrameCallback(void * callback_arg)
+{
+    std::lock_guard<std::mutex> lock(CallbackMutex);
+
+    for(std::size_t callback_idx = 0; callback_idx < FrameCallbackArgs.size(); callback_idx++)
+    {
+        if(FrameCallbackArgs[callback_idx] == callback_arg)
+        {
+            FrameCallbackArgs.erase(FrameCallbackArgs.begin() + callback_idx);
+            FrameCallbacks.erase(FrameCallbacks.begin() + callback_idx);
+            break;
+        }
+    }
+}
+
+void FrameClock::BeginFrame()
+{
+    std::lock_guard<std::mutex> lock(ClockMutex);
+
+    open_frames++;
+}
+
+void FrameClock::MarkDirty(RGBController* controller)
+{
+    std::lock_guard<std::mutex> lock(ClockMutex);
+
+    /*-----------------------------------------------------*\
+    | A controller already pending keeps its entry, and if  |
+    | already committed its original commit time, so the    |
+    | latency covers the oldest data in the frame           |
+    \*-----------------------------------------------------*/
+    for(const FrameClockDevice& device : pending)
+    {
+        if(device.controller == controller)
+        {
+            return;
+        }
+    }
+
+    FrameClockDevice new_device;
+
+    new_device.controller   = controller;
+    new_device.commit_us    = 0;
+
+    pending.push_back(new_device);
+}
+
+void FrameClock::CommitFrame()
+{
+    long long commit_us = RGBControllerStats::NowMicroseconds();
+
+    {
+        std::lock_guard<std::mutex> lock(ClockMutex);
+
+        if(open_frames > 0)
+        {
+            open_frames--;
+        }
+
+        for(FrameClockDevice& device : pending)
+        {
+            if(device.commit_us == 0)
+            {
+                device.commit_us = commit_us;
+            }
+        }
+
+        wake_requested = true;
+    }
+
+    ClockCondition.notify_all();
+}
+
+void FrameClock::RemoveController(RGBController* controller)
+{
+    std::unique_lock<std::mutex> lock(ClockMutex);
+
+    for(std::size_t device_idx = 0; device_idx < pending.size(); device_idx++)
+    {
+        if(pending[device_idx].controller == controller)
+        {
+            pending.erase(pending.begin() + device_idx);
+            break;
+        }
+    }
+
+    for(std::size_t device_idx = 0; device_idx < dispatch_queue.size(); device_idx++)
+    {
+        if(dispatch_queue[device_idx].controller == controller)
+        {
+            dispatch_queue.erase(dispatch_queue.begin() + device_idx);
+            break;
+        }
+    }
+
+    /*-----------------------------------------------------*\
+    | A callback removing the controller being dispatched   |
+    | must not wait for itself                              |
+    \*-----------------------------------------------------*/
+    if(std::this_thread::get_id() != ClockThread->get_id())
+    {
+        DispatchCondition.wait(lock, [this, controller]()
+        {
+            return(dispatching != controller);
+        });
+    }
+}
+
+void FrameClock::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(ClockMutex);
+        wake_requested = true;
+    }
+
+    ClockCondition.notify_all();
+}
+
+void FrameClock::GetStats(frame_clock_stats* stats)
+{
+    stats->frame_rate           = frame_rate.load(std::memory_order_relaxed);
+    stats->ticks                = ticks.load(std::memory_order_relaxed);
+    stats->frames_dispatched    = frames_dispatched.load(std::memory_order_relaxed);
+    stats->frames_deferred      = frames_deferred.load(std::memory_order_relaxed);
+
+    for(unsigned int group_idx = 0; group_idx < FRAME_CLOCK_NUM_GROUPS; group_idx++)
+    {
+        stats->devices_dispatched[group_idx] = devices_dispatched[group_idx].load(std::memory_order_relaxed);
+    }
+
+    tick_jitter.Snapshot(&stats->tick_jitter);
+    dispatch_time.Snapshot(&stats->dispatch_time);
+}
+
+void FrameClock::ResetStats()
+{
+    ticks               = 0;
+    frames_dispatched   = 0;
+    frames_deferred     = 0;
+
+    for(unsigned int group_idx = 0; group_idx < FRAME_CLOCK_NUM_GROUPS; group_idx++)
+    {
+        devices_dispatched[group_idx] = 0;
+    }
+
+    tick_jitter.Reset();
+    dispatch_time.Reset();
+}
+
+void FrameClock::ClockThreadFunction()
+{
+    std::chrono::steady_clock::time_point next_tick = std::chrono::steady_clock::now();
+    bool                                  animating = false;
+
+    while(clock_thread_running)
+    {
+        std::chrono::microseconds frame_period(1000000 / frame_rate);
+
+        {
+            std::unique_lock<std::mutex> lock(ClockMutex);
+
+            /*---------------------------------------------*\
+            | Sleep while no source wants frames and there  |
+            | is nothing committed to dispatch              |
+            \*---------------------------------------------*/
+            if(!animating && !wake_requested)
+            {
+                ClockCondition.wait(lock, [this]()
+                {
+                    return(!clock_thread_running || wake_requested);
+                });
+            }
+
+            wake_requested = false;
+
+            /*---------------------------------------------*\
+            | Stay on the frame grid, skipping ticks that   |
+            | have already passed rather than bursting      |
+            \*---------------------------------------------*/
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+            while(next_tick < now)
+            {
+                next_tick += frame_period;
+            }
+
+            ClockCondition.wait_until(lock, next_tick, [this]()
+            {
+                return(!clock_thread_running);
+            });
+        }
+
+        if(!clock_thread_running)
+        {
+            break;
+        }
+
+        std::chrono::steady_clock::time_point tick_start = std::chrono::steady_clock::now();
+        long long                             tick_us    = std::chrono::duration_cast<std::chrono::microseconds>(tick_start.time_since_epoch()).count();
+
+        tick_jitter.Record(std::chrono::duration_cast<std::chrono::microseconds>(tick_start - next_tick).count());
+        ticks.fetch_add(1, std::memory_order_relaxed);
+
+        animating = RunCallbacks(tick_us);
+
+        Dispatch(tick_us);
+
+        next_tick += frame_period;
+    }
+}
+
+bool FrameClock::RunCallbacks(long long tick_us)
+{
+    std::lock_guard<std::mutex> lock(CallbackMutex);
+
+    bool animating = false;
+
+    for(std::size_t callback_idx = 0; callback_idx < FrameCallbacks.size(); callback_idx++)
+    {
+        if(FrameCallbacks[callback_idx](FrameCallbackArgs[callback_idx], tick_us))
+        {
+            animating = true;
+        }
+    }
+
+    return(animating);
+}
+
+void FrameClock::Dispatch(long long tick_us)
+{
+    std::unique_lock<std::mutex> lock(ClockMutex);
+
+    std::vector<FrameClockDevice> groups[FRAME_CLOCK_NUM_GROUPS];
+    std::size_t                   num_committed = 0;
+
+    for(std::size_t device_idx = 0; device_idx < pending.size(); device_idx++)
+    {
+        if(pending[device_idx].commit_us != 0)
+        {
+            num_committed++;
+        }
+    }
+
+    if(num_committed == 0)
+    {
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Hold the frame back while a source is still writing   |
+    | colors, CommitFrame() wakes the clock again           |
+    \*-----------------------------------------------------*/
+    if(open_frames > 0)
+    {
+        frames_deferred.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Split committed controllers by transport, leaving     |
+    | controllers marked but not yet committed pending      |
+    \*-----------------------------------------------------*/
+    std::vector<FrameClockDevice> still_pending;
+
+    for(const FrameClockDevice& device : pending)
+    {
+        if(device.commit_us == 0)
+        {
+            still_pending.push_back(device);
+            continue;
+        }
+
+        int transport = device.controller->GetPrimaryTransport();
+
+        groups[(transport < 0) ? FRAME_CLOCK_GROUP_UNKNOWN : transport].push_back(device);
+    }
+
+    pending.swap(still_pending);
+
+    for(unsigned int group_idx = 0; group_idx < FRAME_CLOCK_NUM_GROUPS; group_idx++)
+    {
+        dispatch_queue.insert(dispatch_queue.end(), groups[group_idx].begin(), groups[group_idx].end());
+
+        devices_dispatched[group_idx].fetch_add(groups[group_idx].size(), std::memory_order_relaxed);
+    }
+
+    /*-----------------------------------------------------*\
+    | Wake every device thread back to back, one transport  |
+    | group after another.  ClockMutex is released around   |
+    | each update so update callbacks may call MarkDirty(), |
+    | CommitFrame() or RemoveController().                  |
+    \*-----------------------------------------------------*/
+    std::chrono::steady_clock::time_point dispatch_start = std::chrono::steady_clock::now();
+
+    while(!dispatch_queue.empty())
+    {
+        FrameClockDevice device = dispatch_queue.front();
+
+        dispatch_queue.erase(dispatch_queue.begin());
+
+        dispatching = device.controller;
+
+        lock.unlock();
+
+        device.controller->UpdateLEDsCommitted(device.commit_us, tick_us);
+
+        lock.lock();
+
+        dispatching = nullptr;
+        DispatchCondition.notify_all();
+    }
+
+    dispatch_time.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - dispatch_start).count());
+    frames_dispatched.fetch_add(1, std::memory_order_relaxed);
+}
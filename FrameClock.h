@@ -0,0 +1,133 @@
+/*---------------------------------------------------------*\
+| FrameClock.h                                              |
+|                                                           |
+|   Shared frame clock that batches color updates from      |
+|   effect sources and dispatches them to all controllers   |
+|   on the same tick                                        |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RGBController.h"
+
+#define FRAME_CLOCK_DEFAULT_RATE            60
+
+/*------------------------------------------------------------------*\
+| Dispatch groups, one per transport plus one for controllers that   |
+| have not written anything yet                                      |
+\*------------------------------------------------------------------*/
+#define FRAME_CLOCK_NUM_GROUPS              (RGBCONTROLLER_TRANSPORT_COUNT + 1)
+#define FRAME_CLOCK_GROUP_UNKNOWN           RGBCONTROLLER_TRANSPORT_COUNT
+
+/*------------------------------------------------------------------*\
+| Frame callback, called on the clock thread at every tick with the  |
+| tick time in microseconds on the steady clock.  Return true while  |
+| more frames are wanted; once every callback returns false the      |
+| clock sleeps until Wake() or CommitFrame() is called.              |
+\*------------------------------------------------------------------*/
+typedef bool (*FrameClockCallback)(void *, long long);
+
+/*------------------------------------------------------------------*\
+| Frame clock statistics snapshot                                    |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    unsigned int        frame_rate;         /* Ticks per second                         */
+    unsigned long long  ticks;              /* Ticks run                                */
+    unsigned long long  frames_dispatched;  /* Ticks that dispatched at least one       */
+                                            /* device                                   */
+    unsigned long long  frames_deferred;    /* Ticks held back by an open BeginFrame()  */
+    unsigned long long  devices_dispatched[FRAME_CLOCK_NUM_GROUPS];
+    stats_histogram     tick_jitter;        /* Tick start past its scheduled time       */
+    stats_histogram     dispatch_time;      /* Time to dispatch all devices of a tick   */
+} frame_clock_stats;
+
+class FrameClock
+{
+public:
+    FrameClock();
+    ~FrameClock();
+
+    void                    SetFrameRate(unsigned int frame_rate);
+    unsigned int            GetFrameRate();
+
+    void                    RegisterFrameCallback(FrameClockCallback new_callback, void * new_callback_arg);
+    void                    UnregisterFrameCallback(void * callback_arg);
+
+    /*---------------------------------------------------------*\
+    | Batched commit                                            |
+    |                                                           |
+    | A source calls BeginFrame(), writes colors and calls      |
+    | MarkDirty() for each controller it changed, then          |
+    | CommitFrame().  Committed controllers are dispatched      |
+    | together on the next tick, grouped by transport.  Ticks   |
+    | are held back while any source is between BeginFrame()    |
+    | and CommitFrame().                                        |
+    \*---------------------------------------------------------*/
+    void                    BeginFrame();
+    void                    MarkDirty(RGBController* controller);
+    void                    CommitFrame();
+
+    /*---------------------------------------------------------*\
+    | Drop a controller from the pending frame.  Once this      |
+    | returns the clock no longer touches the controller, so it |
+    | must be called before a controller is deleted.  Called    |
+    | from the clock thread it does not wait for a dispatch in  |
+    | progress.                                                 |
+    \*---------------------------------------------------------*/
+    void                    RemoveController(RGBController* controller);
+
+    void                    Wake();
+
+    void                    GetStats(frame_clock_stats* stats);
+    void                    ResetStats();
+
+private:
+    typedef struct
+    {
+        RGBController*      controller;
+        long long           commit_us;      /* 0 until committed                */
+    } FrameClockDevice;
+
+    std::mutex                              ClockMutex;
+    std::condition_variable                 ClockCondition;
+    std::vector<FrameClockDevice>           pending;
+    unsigned int                            open_frames;
+    bool                                    wake_requested;
+
+    /*---------------------------------------------------------*\
+    | Controllers taken from pending for the running dispatch,  |
+    | and the one being updated with ClockMutex released        |
+    \*---------------------------------------------------------*/
+    std::condition_variable                 DispatchCondition;
+    std::vector<FrameClockDevice>           dispatch_queue;
+    RGBController*                          dispatching;
+
+    std::mutex                              CallbackMutex;
+    std::vector<FrameClockCallback>         FrameCallbacks;
+    std::vector<void *>                     FrameCallbackArgs;
+
+    std::thread*                            ClockThread;
+    std::atomic<bool>                       clock_thread_running;
+    std::atomic<unsigned int>               frame_rate;
+
+    std::atomic<unsigned long long>         ticks;
+    std::atomic<unsigned long long>         frames_dispatched;
+    std::atomic<unsigned long long>         frames_deferred;
+    std::atomic<unsigned long long>         devices_dispatched[FRAME_CLOCK_NUM_GROUPS];
+    RGBControllerStatsHistogram             tick_jitter;
+    RGBControllerStatsHistogram             dispatch_time;
+
+    void                    ClockThreadFunction();
+    bool                    RunCallbacks(long long tick_us);
+    void                    Dispatch(long long tick_us);
+};
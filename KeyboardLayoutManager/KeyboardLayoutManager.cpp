@@ -9,9 +9,16 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <mutex>
 #include "LogManager.h"
 #include "KeyboardLayoutManager.h"
 
+/*---------------------------------------------------------*\
+| Marks a key value in the precomputed layout table as      |
+| still holding the base key index in the low bits          |
+\*---------------------------------------------------------*/
+#define KLM_BASE_VALUE_TAG      0x80000000
+
 const char* KLM_CLASS_NAME              = "KLM";
 const char* KEYBOARD_NAME_DEFAULT       = "DEFAULT ";
 const char* KEYBOARD_NAME_ISO           = "ISO ";
@@ -300,8 +307,9 @@ KeyboardLayoutManager::KeyboardLayoutManager(KEYBOARD_LAYOUT layout, KEYBOARD_SI
 KeyboardLayoutManager::KeyboardLayoutManager(KEYBOARD_LAYOUT layout, KEYBOARD_SIZE size, layout_values values)
 {
     /*---------------------------------------------------------------------*\
-    | Store given size bitfield                                             |
+    | Store given layout and size bitfield                                  |
     \*---------------------------------------------------------------------*/
+    this->layout  = layout;
     physical_size = size;
 
     /*---------------------------------------------------------------------*\
@@ -314,37 +322,179 @@ KeyboardLayoutManager::KeyboardLayoutManager(KEYBOARD_LAYOUT layout, KEYBOARD_SI
     }
 
     /*---------------------------------------------------------------------*\
-    | Add sections to the keymap based on KEYBOARD_SIZE bitfield            |
+    | Standard sizes start from the precomputed table, which already has    |
+    |   the base blocks, regional layout and size fixes applied.  Only the  |
+    |   driver values and driver regional overlay are applied here.         |
     \*---------------------------------------------------------------------*/
-    if(physical_size & KEYBOARD_ZONE_MAIN)
+    std::string tmp_name;
+    bool        found_overlay = (bool)values.regional_overlay.count(layout);
+
+    if(IsStandardSize(size))
     {
-        InsertKeys(keyboard_zone_main);
+        const klm_precomputed_layout& precomputed = GetPrecomputedLayout(layout, size);
+
+        tmp_name = precomputed.layout_name;
+
+        if(found_overlay)
+        {
+            keymap = precomputed.regional_keymap;
+            ResolveBaseValues(precomputed.base_values, values.default_values);
+            UpdateDimensions();
+
+            LOG_DEBUG("[%s] Processing regional overlay for %s", KLM_CLASS_NAME, tmp_name.c_str());
+            SwapKeys(values.regional_overlay.find(layout)->second);
+
+            ApplySizeFixes(size);
+        }
+        else
+        {
+            keymap = precomputed.keymap;
+            ResolveBaseValues(precomputed.base_values, values.default_values);
+
+            name = precomputed.size_name;
+        }
     }
+    /*---------------------------------------------------------------------*\
+    | Any other combination of blocks is built up dynamically               |
+    \*---------------------------------------------------------------------*/
+    else
+    {
+        InsertBaseBlocks(size);
+
+        /*-----------------------------------------------------------------*\
+        | Add any values passed into the constructor before switching       |
+        |   layouts and declare a value set for any changes afterwards      |
+        \*-----------------------------------------------------------------*/
+        for(size_t key_idx = 0; key_idx < (unsigned int)values.default_values.size() && key_idx < keymap.size(); key_idx++)
+        {
+            keymap[key_idx].value = values.default_values[key_idx];
+        }
+
+        tmp_name = ApplyRegionalLayout(layout);
+
+        /*-----------------------------------------------------------------*\
+        | If the regional layouts were passed in count() returns true       |
+        |   before attempting to swap keys.                                 |
+        \*-----------------------------------------------------------------*/
+        LOG_DEBUG("[%s] Regional overlay %d was %sfound.", KLM_CLASS_NAME, layout, (found_overlay) ? KEY_EN_UNUSED : "not ");
+        if(found_overlay)
+        {
+            LOG_DEBUG("[%s] Processing regional overlay for %s", KLM_CLASS_NAME, tmp_name.c_str());
+            SwapKeys(values.regional_overlay.find(layout)->second);
+        }
+
+        ApplySizeFixes(size);
+    }
+
+    /*---------------------------------------------------------------------*\
+    | Ensure rows and cols are accurate by updating dimensions              |
+    \*---------------------------------------------------------------------*/
+    UpdateDimensions();
+
+    LOG_INFO(LOG_MSG_CREATED_NEW, KLM_CLASS_NAME, name.c_str(), tmp_name.c_str(), rows, cols, keymap.size());
+}
+
+KeyboardLayoutManager::KeyboardLayoutManager()
+{
+    /*---------------------------------------------------------------------*\
+    | Empty manager used to build the precomputed layout table              |
+    \*---------------------------------------------------------------------*/
+    layout        = KEYBOARD_LAYOUT::KEYBOARD_LAYOUT_DEFAULT;
+    physical_size = KEYBOARD_SIZE::KEYBOARD_SIZE_EMPTY;
+}
+
+bool KeyboardLayoutManager::IsStandardSize(KEYBOARD_SIZE size)
+{
+    return((size == KEYBOARD_SIZE::KEYBOARD_SIZE_FULL)
+        || (size == KEYBOARD_SIZE::KEYBOARD_SIZE_TKL)
+        || (size == KEYBOARD_SIZE::KEYBOARD_SIZE_SEVENTY_FIVE)
+        || (size == KEYBOARD_SIZE::KEYBOARD_SIZE_SIXTY));
+}
+
+const klm_precomputed_layout& KeyboardLayoutManager::GetPrecomputedLayout(KEYBOARD_LAYOUT layout, KEYBOARD_SIZE size)
+{
+    static std::mutex                                                               table_mutex;
+    static std::map<std::pair<KEYBOARD_LAYOUT, KEYBOARD_SIZE>, klm_precomputed_layout> table;
+
+    std::lock_guard<std::mutex> lock(table_mutex);
 
-    if(physical_size & KEYBOARD_ZONE_FN_ROW)
+    std::pair<KEYBOARD_LAYOUT, KEYBOARD_SIZE>                                       table_key(layout, size);
+    std::map<std::pair<KEYBOARD_LAYOUT, KEYBOARD_SIZE>, klm_precomputed_layout>::iterator it = table.find(table_key);
+
+    if(it != table.end())
     {
-        InsertKeys(keyboard_zone_fn_row);
+        return(it->second);
     }
 
-    if(physical_size & KEYBOARD_ZONE_EXTRA)
+    /*---------------------------------------------------------------------*\
+    | Run the dynamic edit pass once with every base key value replaced by  |
+    |   a tag holding its base index.  Keys that keep a tag afterwards take |
+    |   their value from the driver default values, keys without a tag got  |
+    |   their value from a layout edit.                                     |
+    \*---------------------------------------------------------------------*/
+    KeyboardLayoutManager   builder;
+    klm_precomputed_layout  entry;
+
+    builder.InsertBaseBlocks(size);
+
+    for(std::size_t key_idx = 0; key_idx < builder.keymap.size(); key_idx++)
     {
-        InsertKeys(keyboard_zone_extras);
+        entry.base_values.push_back(builder.keymap[key_idx].value);
+        builder.keymap[key_idx].value = KLM_BASE_VALUE_TAG | (unsigned int)key_idx;
     }
 
-    if(physical_size & KEYBOARD_ZONE_NUMPAD)
+    entry.layout_name       = builder.ApplyRegionalLayout(layout);
+    entry.regional_keymap   = builder.keymap;
+
+    builder.ApplySizeFixes(size);
+
+    entry.size_name         = builder.name;
+    entry.keymap            = builder.keymap;
+
+    return(table.emplace(table_key, entry).first->second);
+}
+
+void KeyboardLayoutManager::ResolveBaseValues(const std::vector<unsigned int>& base_values, const std::vector<unsigned int>& default_values)
+{
+    for(std::size_t key_idx = 0; key_idx < keymap.size(); key_idx++)
     {
-        InsertKeys(keyboard_zone_numpad);
+        if(keymap[key_idx].value & KLM_BASE_VALUE_TAG)
+        {
+            unsigned int base_idx = keymap[key_idx].value & ~KLM_BASE_VALUE_TAG;
+
+            keymap[key_idx].value = (base_idx < default_values.size()) ? default_values[base_idx] : base_values[base_idx];
+        }
     }
+}
 
+void KeyboardLayoutManager::InsertBaseBlocks(KEYBOARD_SIZE size)
+{
     /*---------------------------------------------------------------------*\
-    | Add any values passed into the constructor before switching layouts   |
-    |   and declare a value set for any changes afterwards                  |
+    | Add sections to the keymap based on KEYBOARD_SIZE bitfield            |
     \*---------------------------------------------------------------------*/
-    for(size_t key_idx = 0; key_idx < (unsigned int)values.default_values.size() && key_idx < keymap.size(); key_idx++)
+    if(size & KEYBOARD_ZONE_MAIN)
+    {
+        InsertKeys(keyboard_zone_main);
+    }
+
+    if(size & KEYBOARD_ZONE_FN_ROW)
     {
-        keymap[key_idx].value = values.default_values[key_idx];
+        InsertKeys(keyboard_zone_fn_row);
     }
 
+    if(size & KEYBOARD_ZONE_EXTRA)
+    {
+        InsertKeys(keyboard_zone_extras);
+    }
+
+    if(size & KEYBOARD_ZONE_NUMPAD)
+    {
+        InsertKeys(keyboard_zone_numpad);
+    }
+}
+
+std::string KeyboardLayoutManager::ApplyRegionalLayout(KEYBOARD_LAYOUT layout)
+{
     /*---------------------------------------------------------------------*\
     | Modify the base default QWERTY layout to the desired regional layout  |
     \*---------------------------------------------------------------------*/
@@ -389,19 +539,11 @@ KeyboardLayoutManager::KeyboardLayoutManager(KEYBOARD_LAYOUT layout, KEYBOARD_SI
             break;
     }
 
-    /*---------------------------------------------------------------------*\
-    | If the regional layouts were passed in count() returns true before    |
-    |   attempting to swap keys.                                            |
-    \*---------------------------------------------------------------------*/
-    bool found_overlay = (bool)values.regional_overlay.count(layout);
-
-    LOG_DEBUG("[%s] Regional overlay %d was %sfound.", KLM_CLASS_NAME, layout, (found_overlay) ? KEY_EN_UNUSED : "not ");
-    if(found_overlay)
-    {
-        LOG_DEBUG("[%s] Processing regional overlay for %s", KLM_CLASS_NAME, tmp_name.c_str());
-        SwapKeys(values.regional_overlay.find(layout)->second);
-    }
+    return(tmp_name);
+}
 
+void KeyboardLayoutManager::ApplySizeFixes(KEYBOARD_SIZE size)
+{
     /*---------------------------------------------------------------------*\
     | Size specific fixes                                                   |
     \*---------------------------------------------------------------------*/
@@ -436,13 +578,6 @@ KeyboardLayoutManager::KeyboardLayoutManager(KEYBOARD_LAYOUT layout, KEYBOARD_SI
             name = "Size (";
             name.append(std::to_string(size) + ") ");
     }
-
-    /*---------------------------------------------------------------------*\
-    | Ensure rows and cols are accurate by updating dimensions              |
-    \*---------------------------------------------------------------------*/
-    UpdateDimensions();
-
-    LOG_INFO(LOG_MSG_CREATED_NEW, KLM_CLASS_NAME, name.c_str(), tmp_name.c_str(), rows, cols, keymap.size());
 }
 
 KeyboardLayoutManager::~KeyboardLayoutManager()
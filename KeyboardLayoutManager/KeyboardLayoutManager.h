@@ -103,6 +103,21 @@ typedef struct
     key_set                                 edit_keys;
 }   keyboard_keymap_overlay_values;
 
+/*---------------------------------------------------------*\
+| Standard size and layout combination with the base        |
+| blocks and regional layout already applied.  Values of    |
+| base keys are tagged with their base key index until the  |
+| driver's default values are known.                        |
+\*---------------------------------------------------------*/
+typedef struct
+{
+    std::vector<unsigned int>               base_values;
+    std::vector<keyboard_led>               regional_keymap;
+    std::vector<keyboard_led>               keymap;
+    std::string                             layout_name;
+    std::string                             size_name;
+}   klm_precomputed_layout;
+
 class KeyboardLayoutManager
 {
 public:
@@ -137,6 +152,17 @@ public:
                                           std::uint8_t height, std::uint8_t width);
 
 private:
+    KeyboardLayoutManager();
+
+    static bool                             IsStandardSize(KEYBOARD_SIZE size);
+    static const klm_precomputed_layout&    GetPrecomputedLayout(KEYBOARD_LAYOUT layout, KEYBOARD_SIZE size);
+
+    void                        ResolveBaseValues(const std::vector<unsigned int>& base_values,
+                                                  const std::vector<unsigned int>& default_values);
+    void                        InsertBaseBlocks(KEYBOARD_SIZE size);
+    std::string                 ApplyRegionalLayout(KEYBOARD_LAYOUT layout);
+    void                        ApplySizeFixes(KEYBOARD_SIZE size);
+
     void                        OpCodeSwitch(key_set change_keys);
     void                        InsertKey(keyboard_led key);
     void                        InsertKeys(std::vector<keyboard_led> keys);
@@ -43,6 +43,12 @@ NetworkClient::NetworkClient(std::vector<RGBController *>& control) : controller
     server_protocol_version             = 0;
     server_reinitialize                 = false;
     change_in_progress                  = false;
+    controller_stats_idx                = 0;
+    controller_stats_received           = false;
+    controller_correction_idx           = 0;
+    controller_correction_received      = false;
+    controller_rate_idx                 = 0;
+    controller_rate_received            = false;
 
     ListenThread            = NULL;
     ConnectionThread        = NULL;
@@ -543,6 +549,18 @@ void NetworkClient::ListenThreadFunction()
             case NET_PACKET_ID_DEVICE_LIST_UPDATED:
                 ProcessRequest_DeviceListChanged();
                 break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_GETSTATS:
+                ProcessReply_ControllerStats(header.pkt_size, data, header.pkt_dev_idx);
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_GETCORRECTION:
+                ProcessReply_ControllerCorrection(header.pkt_size, data, header.pkt_dev_idx);
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_GETRATE:
+                ProcessReply_ControllerRate(header.pkt_size, data, header.pkt_dev_idx);
+                break;
         }
 
         delete[] data;
@@ -677,6 +695,90 @@ void NetworkClient::ProcessReply_ProtocolVersion(unsigned int data_size, char *
     }
 }
 
+void NetworkClient::ProcessReply_ControllerStats(unsigned int data_size, char * data, unsigned int dev_idx)
+{
+    /*---------------------------------------------------------*\
+    | Verify the statistics description size (first 4 bytes of  |
+    | data) matches the packet size in the header               |
+    \*---------------------------------------------------------*/
+    if((data == NULL) || (data_size < sizeof(unsigned int)) || (data_size != *((unsigned int*)data)))
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> stats_lock(controller_stats_mutex);
+
+    ControllerListMutex.lock();
+
+    if(dev_idx < server_controllers.size())
+    {
+        server_controllers[dev_idx]->ReadStatsDescription((unsigned char *)data, &controller_stats);
+
+        controller_stats_idx      = dev_idx;
+        controller_stats_received = true;
+    }
+
+    ControllerListMutex.unlock();
+
+    controller_stats_cv.notify_all();
+}
+
+void NetworkClient::ProcessReply_ControllerCorrection(unsigned int data_size, char * data, unsigned int dev_idx)
+{
+    /*---------------------------------------------------------*\
+    | Verify the correction description size (first 4 bytes of  |
+    | data) matches the packet size in the header               |
+    \*---------------------------------------------------------*/
+    if((data == NULL) || (data_size < sizeof(unsigned int)) || (data_size != *((unsigned int*)data)))
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> correction_lock(controller_correction_mutex);
+
+    ControllerListMutex.lock();
+
+    if(dev_idx < server_controllers.size())
+    {
+        server_controllers[dev_idx]->ReadColorCorrectionDescription((unsigned char *)data, &controller_correction);
+
+        controller_correction_idx      = dev_idx;
+        controller_correction_received = true;
+    }
+
+    ControllerListMutex.unlock();
+
+    controller_correction_cv.notify_all();
+}
+
+void NetworkClient::ProcessReply_ControllerRate(unsigned int data_size, char * data, unsigned int dev_idx)
+{
+    /*---------------------------------------------------------*\
+    | Verify the rate control description size (first 4 bytes   |
+    | of data) matches the packet size in the header            |
+    \*---------------------------------------------------------*/
+    if((data == NULL) || (data_size < sizeof(unsigned int)) || (data_size != *((unsigned int*)data)))
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> rate_lock(controller_rate_mutex);
+
+    ControllerListMutex.lock();
+
+    if(dev_idx < server_controllers.size())
+    {
+        server_controllers[dev_idx]->ReadRateControlDescription((unsigned char *)data, &controller_rate);
+
+        controller_rate_idx      = dev_idx;
+        controller_rate_received = true;
+    }
+
+    ControllerListMutex.unlock();
+
+    controller_rate_cv.notify_all();
+}
+
 void NetworkClient::ProcessRequest_DeviceListChanged()
 {
     change_in_progress = true;
@@ -1021,6 +1123,167 @@ void NetworkClient::SendRequest_DeleteProfile(std::string profile_name)
     send_in_progress.unlock();
 }
 
+void NetworkClient::SendRequest_RGBController_GetStats(unsigned int dev_idx)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETSTATS, 0);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send_in_progress.unlock();
+}
+
+bool NetworkClient::RequestControllerStats(unsigned int dev_idx, rgb_controller_stats* stats)
+{
+    std::unique_lock<std::mutex> stats_lock(controller_stats_mutex);
+
+    controller_stats_received = false;
+
+    SendRequest_RGBController_GetStats(dev_idx);
+
+    /*---------------------------------------------------------*\
+    | Wait up to 1 second for the server to reply               |
+    \*---------------------------------------------------------*/
+    if(!controller_stats_cv.wait_for(stats_lock, 1s, [this, dev_idx]{ return(controller_stats_received && (controller_stats_idx == dev_idx)); }))
+    {
+        return(false);
+    }
+
+    *stats = controller_stats;
+
+    return(true);
+}
+
+void NetworkClient::SendRequest_RGBController_GetCorrection(unsigned int dev_idx)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETCORRECTION, 0);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send_in_progress.unlock();
+}
+
+void NetworkClient::SendRequest_RGBController_SetCorrection(unsigned int dev_idx, unsigned char * data, unsigned int size)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_SETCORRECTION, size);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send(client_sock, (char *)data, size, 0);
+    send_in_progress.unlock();
+}
+
+bool NetworkClient::RequestControllerCorrection(unsigned int dev_idx, rgb_color_correction* correction)
+{
+    std::unique_lock<std::mutex> correction_lock(controller_correction_mutex);
+
+    controller_correction_received = false;
+
+    SendRequest_RGBController_GetCorrection(dev_idx);
+
+    /*---------------------------------------------------------*\
+    | Wait up to 1 second for the server to reply               |
+    \*---------------------------------------------------------*/
+    if(!controller_correction_cv.wait_for(correction_lock, 1s, [this, dev_idx]{ return(controller_correction_received && (controller_correction_idx == dev_idx)); }))
+    {
+        return(false);
+    }
+
+    *correction = controller_correction;
+
+    return(true);
+}
+
+void NetworkClient::SendRequest_RGBController_GetRate(unsigned int dev_idx)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETRATE, 0);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send_in_progress.unlock();
+}
+
+bool NetworkClient::RequestControllerRate(unsigned int dev_idx, rgb_rate_control* rate)
+{
+    std::unique_lock<std::mutex> rate_lock(controller_rate_mutex);
+
+    controller_rate_received = false;
+
+    SendRequest_RGBController_GetRate(dev_idx);
+
+    /*---------------------------------------------------------*\
+    | Wait up to 1 second for the server to reply               |
+    \*---------------------------------------------------------*/
+    if(!controller_rate_cv.wait_for(rate_lock, 1s, [this, dev_idx]{ return(controller_rate_received && (controller_rate_idx == dev_idx)); }))
+    {
+        return(false);
+    }
+
+    *rate = controller_rate;
+
+    return(true);
+}
+
+void NetworkClient::SendRequest_RGBController_StartEffect(unsigned int dev_idx, unsigned char * data, unsigned int size)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_STARTEFFECT, size);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send(client_sock, (char *)data, size, 0);
+    send_in_progress.unlock();
+}
+
+void NetworkClient::SendRequest_RGBController_StopEffect(unsigned int dev_idx)
+{
+    if(change_in_progress)
+    {
+        return;
+    }
+
+    NetPacketHeader request_hdr;
+
+    InitNetPacketHeader(&request_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_STOPEFFECT, 0);
+
+    send_in_progress.lock();
+    send(client_sock, (char *)&request_hdr, sizeof(NetPacketHeader), MSG_NOSIGNAL);
+    send_in_progress.unlock();
+}
+
 void NetworkClient::SendRequest_GetProfileList()
 {
     NetPacketHeader reply_hdr;
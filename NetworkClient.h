@@ -52,6 +52,9 @@ public:
     void        ProcessReply_ControllerCount(unsigned int data_size, char * data);
     void        ProcessReply_ControllerData(unsigned int data_size, char * data, unsigned int dev_idx);
     void        ProcessReply_ProtocolVersion(unsigned int data_size, char * data);
+    void        ProcessReply_ControllerStats(unsigned int data_size, char * data, unsigned int dev_idx);
+    void        ProcessReply_ControllerCorrection(unsigned int data_size, char * data, unsigned int dev_idx);
+    void        ProcessReply_ControllerRate(unsigned int data_size, char * data, unsigned int dev_idx);
 
     void        ProcessRequest_DeviceListChanged();
 
@@ -76,6 +79,19 @@ public:
     void        SendRequest_RGBController_UpdateMode(unsigned int dev_idx, unsigned char * data, unsigned int size);
     void        SendRequest_RGBController_SaveMode(unsigned int dev_idx, unsigned char * data, unsigned int size);
 
+    void        SendRequest_RGBController_GetStats(unsigned int dev_idx);
+    bool        RequestControllerStats(unsigned int dev_idx, rgb_controller_stats* stats);
+
+    void        SendRequest_RGBController_GetCorrection(unsigned int dev_idx);
+    void        SendRequest_RGBController_SetCorrection(unsigned int dev_idx, unsigned char * data, unsigned int size);
+    bool        RequestControllerCorrection(unsigned int dev_idx, rgb_color_correction* correction);
+
+    void        SendRequest_RGBController_GetRate(unsigned int dev_idx);
+    bool        RequestControllerRate(unsigned int dev_idx, rgb_rate_control* rate);
+
+    void        SendRequest_RGBController_StartEffect(unsigned int dev_idx, unsigned char * data, unsigned int size);
+    void        SendRequest_RGBController_StopEffect(unsigned int dev_idx);
+
 
     std::vector<std::string> * ProcessReply_ProfileList(unsigned int data_size, char * data);
 
@@ -115,6 +131,24 @@ private:
     unsigned int    requested_controllers;
     std::mutex      send_in_progress;
 
+    std::mutex              controller_stats_mutex;
+    std::condition_variable controller_stats_cv;
+    rgb_controller_stats    controller_stats;
+    unsigned int            controller_stats_idx;
+    bool                    controller_stats_received;
+
+    std::mutex              controller_correction_mutex;
+    std::condition_variable controller_correction_cv;
+    rgb_color_correction    controller_correction;
+    unsigned int            controller_correction_idx;
+    bool                    controller_correction_received;
+
+    std::mutex              controller_rate_mutex;
+    std::condition_variable controller_rate_cv;
+    rgb_rate_control        controller_rate;
+    unsigned int            controller_rate_idx;
+    bool                    controller_rate_received;
+
     std::mutex      connection_mutex;
     std::condition_variable connection_cv;
 
@@ -0,0 +1,417 @@
+/*---------------------------------------------------------*\
+| NetworkDetection.cpp                                      |
+|                                                           |
+|   Concurrent probing of configured network devices with   |
+|   a shared deadline and background retry                  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "NetworkDetection.h"
+#include "LogManager.h"
+
+typedef struct
+{
+    std::string                             location;
+    NetworkProbeFunction                    probe;
+    unsigned int                            generation;
+    unsigned int                            attempts;
+    bool                                    in_pass;
+    unsigned int                            pass;
+    std::chrono::steady_clock::time_point   retry_time;
+} NetworkProbeEntry;
+
+/*---------------------------------------------------------*\
+| State shared with the probe threads.  The probe thread    |
+| handles are kept here and joined, by the next spawn once  |
+| a thread has exited and by the destructor on shutdown.    |
+\*---------------------------------------------------------*/
+class NetworkDetectionState
+{
+public:
+    std::mutex                              ProbeMutex;
+    std::condition_variable                 ProbeCondition;
+    std::deque<NetworkProbeEntry>           queue;
+    std::vector<NetworkProbeEntry>          pending;
+    std::deque<RGBController*>              finished;
+    unsigned int                            generation;
+    unsigned int                            workers;
+    std::vector<std::thread*>               threads;
+    std::vector<std::thread::id>            exited;
+    bool                                    running;
+
+    bool                                    pass_active;
+    unsigned int                            pass_id;
+    unsigned int                            pass_outstanding;
+    std::chrono::steady_clock::time_point   pass_start;
+
+    std::mutex                              RegisterMutex;
+    NetworkRegisterFunction                 register_function;
+};
+
+/*---------------------------------------------------------*\
+| Start probe threads for queued probes, called with        |
+| ProbeMutex held                                           |
+\*---------------------------------------------------------*/
+static void SpawnProbeThreads(std::shared_ptr<NetworkDetectionState> state);
+
+static void RegisterLate(std::shared_ptr<NetworkDetectionState> state, RGBController* controller, const NetworkProbeEntry& entry)
+{
+    /*-----------------------------------------------------*\
+    | Hold RegisterMutex across the check so CancelAll()    |
+    | can wait out a registration already in progress       |
+    \*-----------------------------------------------------*/
+    std::lock_guard<std::mutex> register_lock(state->RegisterMutex);
+
+    bool current;
+
+    {
+        std::lock_guard<std::mutex> lock(state->ProbeMutex);
+        current = (entry.generation == state->generation);
+    }
+
+    if(!current)
+    {
+        delete controller;
+        return;
+    }
+
+    LOG_INFO("[NetworkDetection] %s answered after detection, registering", entry.location.c_str());
+
+    state->register_function(controller);
+}
+
+static void ProbeThreadFunction(std::shared_ptr<NetworkDetectionState> state)
+{
+    std::unique_lock<std::mutex> lock(state->ProbeMutex);
+
+    while(!state->queue.empty())
+    {
+        NetworkProbeEntry entry = state->queue.front();
+        state->queue.pop_front();
+
+        lock.unlock();
+
+        RGBController* controller = nullptr;
+
+        try
+        {
+            controller = entry.probe();
+        }
+        catch(...)
+        {
+            controller = nullptr;
+        }
+
+        lock.lock();
+
+        /*-------------------------------------------------*\
+        | Probes cancelled while running throw their result |
+        | away                                              |
+        \*-------------------------------------------------*/
+        if(entry.generation != state->generation)
+        {
+            lock.unlock();
+            delete controller;
+            lock.lock();
+            continue;
+        }
+
+        /*-------------------------------------------------*\
+        | A pass that timed out or was replaced has already |
+        | stopped counting its probes                       |
+        \*-------------------------------------------------*/
+        if(entry.in_pass && state->pass_active && (entry.pass == state->pass_id) && (state->pass_outstanding > 0))
+        {
+            state->pass_outstanding--;
+            state->ProbeCondition.notify_all();
+        }
+
+        entry.in_pass = false;
+
+        /*-------------------------------------------------*\
+        | Unreachable devices are retried in the background |
+        | with an increasing interval                       |
+        \*-------------------------------------------------*/
+        if(controller == nullptr)
+        {
+            unsigned int retry_ms = NETWORK_DETECTION_RETRY_MAX_MS;
+
+            if(entry.attempts < 16)
+            {
+                retry_ms = std::min(NETWORK_DETECTION_RETRY_MIN_MS << entry.attempts, NETWORK_DETECTION_RETRY_MAX_MS);
+            }
+
+            if(entry.attempts == 0)
+            {
+                LOG_INFO("[NetworkDetection] %s did not answer, retrying in background", entry.location.c_str());
+            }
+
+            entry.attempts++;
+            entry.retry_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(retry_ms);
+
+            state->pending.push_back(entry);
+            state->ProbeCondition.notify_all();
+            continue;
+        }
+
+        /*-------------------------------------------------*\
+        | The detection thread registers controllers found  |
+        | during a pass, later ones are registered here     |
+        \*-------------------------------------------------*/
+        if(state->pass_active)
+        {
+            state->finished.push_back(controller);
+            state->ProbeCondition.notify_all();
+            continue;
+        }
+
+        lock.unlock();
+        RegisterLate(state, controller, entry);
+        lock.lock();
+    }
+
+    state->workers--;
+    state->exited.push_back(std::this_thread::get_id());
+}
+
+static void SpawnProbeThreads(std::shared_ptr<NetworkDetectionState> state)
+{
+    /*-----------------------------------------------------*\
+    | Join the threads that have exited.  They only return  |
+    | after releasing ProbeMutex, so this does not block on |
+    | the lock held here.                                   |
+    \*-----------------------------------------------------*/
+    for(std::size_t thread_idx = 0; thread_idx < state->threads.size();)
+    {
+        std::vector<std::thread::id>::iterator exited = std::find(state->exited.begin(), state->exited.end(), state->threads[thread_idx]->get_id());
+
+        if(exited == state->exited.end())
+        {
+            thread_idx++;
+            continue;
+        }
+
+        state->exited.erase(exited);
+        state->threads[thread_idx]->join();
+        delete state->threads[thread_idx];
+        state->threads.erase(state->threads.begin() + thread_idx);
+    }
+
+    std::size_t wanted = std::min<std::size_t>(NETWORK_DETECTION_MAX_PROBES, state->workers + state->queue.size());
+
+    while(state->workers < wanted)
+    {
+        state->workers++;
+        state->threads.push_back(new std::thread(ProbeThreadFunction, state));
+    }
+}
+
+NetworkDetection::NetworkDetection(NetworkRegisterFunction register_function)
+{
+    state                       = std::make_shared<NetworkDetectionState>();
+
+    state->generation           = 0;
+    state->workers              = 0;
+    state->running              = true;
+    state->pass_active          = false;
+    state->pass_id              = 0;
+    state->pass_outstanding     = 0;
+    state->register_function    = register_function;
+
+    RetryThread                 = new std::thread(&NetworkDetection::RetryThreadFunction, this);
+}
+
+NetworkDetection::~NetworkDetection()
+{
+    CancelAll();
+
+    {
+        std::lock_guard<std::mutex> lock(state->ProbeMutex);
+        state->running = false;
+    }
+
+    state->ProbeCondition.notify_all();
+
+    RetryThread->join();
+    delete RetryThread;
+    RetryThread = nullptr;
+
+    /*-----------------------------------------------------*\
+    | Wait for the probe threads.  A probe still running    |
+    | finishes, finds its generation cancelled and throws   |
+    | its controller away, so none of them touches the      |
+    | register function after this.                         |
+    \*-----------------------------------------------------*/
+    std::vector<std::thread*> threads;
+
+    {
+        std::lock_guard<std::mutex> lock(state->ProbeMutex);
+        threads.swap(state->threads);
+        state->exited.clear();
+    }
+
+    for(std::thread* thread : threads)
+    {
+        thread->join();
+        delete thread;
+    }
+}
+
+void NetworkDetection::StartProbe(const std::string& location, NetworkProbeFunction probe)
+{
+    std::lock_guard<std::mutex> lock(state->ProbeMutex);
+
+    NetworkProbeEntry entry;
+
+    entry.location      = location;
+    entry.probe         = probe;
+    entry.generation    = state->generation;
+    entry.attempts      = 0;
+    entry.in_pass       = state->pass_active;
+    entry.pass          = state->pass_id;
+
+    if(entry.in_pass)
+    {
+        state->pass_outstanding++;
+    }
+
+    state->queue.push_back(entry);
+
+    SpawnProbeThreads(state);
+}
+
+void NetworkDetection::BeginPass()
+{
+    std::lock_guard<std::mutex> lock(state->ProbeMutex);
+
+    state->pass_active      = true;
+    state->pass_id++;
+    state->pass_outstanding = 0;
+    state->pass_start       = std::chrono::steady_clock::now();
+}
+
+RGBController* NetworkDetection::WaitForController(unsigned int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(state->ProbeMutex);
+
+    std::chrono::steady_clock::time_point deadline = state->pass_start + std::chrono::milliseconds(timeout_ms);
+
+    state->ProbeCondition.wait_until(lock, deadline, [this]()
+    {
+        return(!state->finished.empty() || (state->pass_outstanding == 0));
+    });
+
+    if(!state->finished.empty())
+    {
+        RGBController* controller = state->finished.front();
+        state->finished.pop_front();
+
+        return(controller);
+    }
+
+    /*-----------------------------------------------------*\
+    | The pass is over, controllers found from now on are   |
+    | registered through the register function              |
+    \*-----------------------------------------------------*/
+    if(state->pass_active && (state->pass_outstanding > 0))
+    {
+        LOG_INFO("[NetworkDetection] %u devices still probing after %u ms, continuing in background", state->pass_outstanding, timeout_ms);
+    }
+
+    state->pass_active      = false;
+    state->pass_outstanding = 0;
+
+    return(nullptr);
+}
+
+void NetworkDetection::CancelAll()
+{
+    std::deque<RGBController*> unregistered;
+
+    {
+        std::lock_guard<std::mutex> lock(state->ProbeMutex);
+
+        state->generation++;
+        state->queue.clear();
+        state->pending.clear();
+        state->pass_active      = false;
+        state->pass_outstanding = 0;
+
+        unregistered.swap(state->finished);
+    }
+
+    state->ProbeCondition.notify_all();
+
+    for(RGBController* controller : unregistered)
+    {
+        delete controller;
+    }
+
+    /*-----------------------------------------------------*\
+    | Wait for a registration that passed its check before  |
+    | the generation changed                                |
+    \*-----------------------------------------------------*/
+    std::lock_guard<std::mutex> register_lock(state->RegisterMutex);
+}
+
+std::size_t NetworkDetection::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(state->ProbeMutex);
+
+    return(state->pending.size());
+}
+
+void NetworkDetection::RetryThreadFunction()
+{
+    std::unique_lock<std::mutex> lock(state->ProbeMutex);
+
+    while(state->running)
+    {
+        std::chrono::steady_clock::time_point now        = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point next_retry = std::chrono::steady_clock::time_point::max();
+
+        /*-------------------------------------------------*\
+        | Queue the probes that are due, remember when the  |
+        | next one is                                       |
+        \*-------------------------------------------------*/
+        for(std::size_t pending_idx = 0; pending_idx < state->pending.size();)
+        {
+            if(state->pending[pending_idx].retry_time <= now)
+            {
+                state->queue.push_back(state->pending[pending_idx]);
+                state->pending.erase(state->pending.begin() + pending_idx);
+                continue;
+            }
+
+            next_retry = std::min(next_retry, state->pending[pending_idx].retry_time);
+            pending_idx++;
+        }
+
+        SpawnProbeThreads(state);
+
+        std::size_t num_pending = state->pending.size();
+
+        if(next_retry == std::chrono::steady_clock::time_point::max())
+        {
+            state->ProbeCondition.wait(lock, [this, num_pending]()
+            {
+                return(!state->running || (state->pending.size() != num_pending));
+            });
+        }
+        else
+        {
+            state->ProbeCondition.wait_until(lock, next_retry, [this, num_pending]()
+            {
+                return(!state->running || (state->pending.size() != num_pending));
+            });
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*---------------------------------------------------------*\
+| NetworkDetection.h                                        |
+|                                                           |
+|   Concurrent probing of configured network devices with   |
+|   a shared deadline and background retry                  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "RGBController.h"
+
+#define NETWORK_DETECTION_TIMEOUT_MS        3000    /* Shared deadline of one detection pass    */
+#define NETWORK_DETECTION_MAX_PROBES        16      /* Probes running at the same time          */
+#define NETWORK_DETECTION_RETRY_MIN_MS      5000    /* First retry of an unreachable device     */
+#define NETWORK_DETECTION_RETRY_MAX_MS      300000  /* Retry interval backs off up to this      */
+
+/*------------------------------------------------------------------*\
+| Probe function, run on a probe thread.  Connects to one configured |
+| device and returns its controller, or nullptr if the device did    |
+| not answer.  It must not register the controller itself.           |
+\*------------------------------------------------------------------*/
+typedef std::function<RGBController*()> NetworkProbeFunction;
+
+/*------------------------------------------------------------------*\
+| Called with controllers found outside of a detection pass, from a  |
+| probe thread                                                       |
+\*------------------------------------------------------------------*/
+typedef std::function<void(RGBController*)> NetworkRegisterFunction;
+
+class NetworkDetectionState;
+
+class NetworkDetection
+{
+public:
+    NetworkDetection(NetworkRegisterFunction register_function);
+    ~NetworkDetection();
+
+    /*---------------------------------------------------------*\
+    | Called by network detectors, one probe per configured     |
+    | device.  Returns immediately, the probe runs in the       |
+    | background.                                               |
+    \*---------------------------------------------------------*/
+    void                    StartProbe(const std::string& location, NetworkProbeFunction probe);
+
+    /*---------------------------------------------------------*\
+    | Detection pass                                            |
+    |                                                           |
+    | BeginPass() starts the shared deadline.  The detection    |
+    | thread then calls WaitForController() and registers each  |
+    | controller returned, until it returns nullptr once every  |
+    | probe of the pass has finished or the deadline passed.    |
+    | Probes still running then, and devices that did not       |
+    | answer, are retried in the background and registered      |
+    | through the register function when they answer.           |
+    \*---------------------------------------------------------*/
+    void                    BeginPass();
+    RGBController*          WaitForController(unsigned int timeout_ms);
+
+    /*---------------------------------------------------------*\
+    | Drop all pending probes.  Once this returns no controller |
+    | will be registered through the register function until    |
+    | the next probe is started.                                |
+    \*---------------------------------------------------------*/
+    void                    CancelAll();
+
+    std::size_t             GetPendingCount();
+
+private:
+    std::shared_ptr<NetworkDetectionState>  state;
+    std::thread*                            RetryThread;
+
+    void                    RetryThreadFunction();
+};
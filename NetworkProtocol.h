@@ -21,8 +21,12 @@
 |   4:      Add segments field to zones, network plugins (Release 0.9)  |
 |   5:      Zone flags, controller flags, resizable effects-only zones  |
                 (Release 1.0)                                           |
+|   6:      Controller update statistics (GETSTATS 1150), color         |
+|           correction (GETCORRECTION 1151, SETCORRECTION 1152), rate   |
+|           control (GETRATE 1153), server side effects (STARTEFFECT    |
+|           1200, STOPEFFECT 1201)                                      |
 \*---------------------------------------------------------------------*/
-#define OPENRGB_SDK_PROTOCOL_VERSION    5
+#define OPENRGB_SDK_PROTOCOL_VERSION    6
 
 /*-----------------------------------------------------*\
 | Default Interface to bind to.                         |
@@ -87,6 +91,14 @@ enum
     NET_PACKET_ID_RGBCONTROLLER_SETCUSTOMMODE   = 1100, /* RGBController::SetCustomMode()                       */
     NET_PACKET_ID_RGBCONTROLLER_UPDATEMODE      = 1101, /* RGBController::UpdateMode()                          */
     NET_PACKET_ID_RGBCONTROLLER_SAVEMODE        = 1102, /* RGBController::SaveMode()                            */
+
+    NET_PACKET_ID_RGBCONTROLLER_GETSTATS        = 1150, /* RGBController::GetStatsDescription()                 */
+    NET_PACKET_ID_RGBCONTROLLER_GETCORRECTION   = 1151, /* RGBController::GetColorCorrection()                  */
+    NET_PACKET_ID_RGBCONTROLLER_SETCORRECTION   = 1152, /* RGBController::SetColorCorrection()                  */
+    NET_PACKET_ID_RGBCONTROLLER_GETRATE         = 1153, /* RGBController::GetRateControl()                      */
+
+    NET_PACKET_ID_RGBCONTROLLER_STARTEFFECT     = 1200, /* EffectsEngine::StartEffect()                         */
+    NET_PACKET_ID_RGBCONTROLLER_STOPEFFECT      = 1201, /* EffectsEngine::StopEffect()                          */
 };
 
 void InitNetPacketHeader
@@ -11,6 +11,7 @@
 
 #include <cstring>
 #include "NetworkServer.h"
+#include "EffectsEngine.h"
 #include "LogManager.h"
 
 #ifndef WIN32
@@ -70,6 +71,7 @@ NetworkServer::NetworkServer(std::vector<RGBController *>& control) : controller
     }
 
     profile_manager  = nullptr;
+    effects_engine   = nullptr;
 }
 
 NetworkServer::~NetworkServer()
@@ -858,6 +860,73 @@ void NetworkServer::ListenThreadFunction(NetworkClientInfo * client_info)
                 }
                 break;
 
+            case NET_PACKET_ID_RGBCONTROLLER_GETSTATS:
+                SendReply_ControllerStats(client_sock, header.pkt_dev_idx);
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_GETCORRECTION:
+                SendReply_ControllerCorrection(client_sock, header.pkt_dev_idx);
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_GETRATE:
+                SendReply_ControllerRate(client_sock, header.pkt_dev_idx);
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_SETCORRECTION:
+                if(data == NULL)
+                {
+                    break;
+                }
+
+                /*---------------------------------------------------------*\
+                | Verify the correction description size (first 4 bytes of |
+                | data) matches the packet size in the header               |
+                \*---------------------------------------------------------*/
+                if((header.pkt_size >= sizeof(unsigned int)) && (header.pkt_size == *((unsigned int*)data)))
+                {
+                    if(header.pkt_dev_idx < controllers.size())
+                    {
+                        unsigned char* correction_buf = controllers[header.pkt_dev_idx]->GetColorCorrectionDescription();
+                        unsigned int   correction_size;
+
+                        memcpy(&correction_size, correction_buf, sizeof(correction_size));
+                        delete[] correction_buf;
+
+                        if(header.pkt_size == correction_size)
+                        {
+                            rgb_color_correction correction;
+
+                            controllers[header.pkt_dev_idx]->ReadColorCorrectionDescription((unsigned char *)data, &correction);
+                            controllers[header.pkt_dev_idx]->SetColorCorrection(correction);
+                        }
+                    }
+                }
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_STARTEFFECT:
+                if(data == NULL)
+                {
+                    break;
+                }
+
+                if(effects_engine && (header.pkt_dev_idx < controllers.size()))
+                {
+                    EffectParams params;
+
+                    if(EffectsEngine::ReadEffectDescription((unsigned char *)data, header.pkt_size, &params))
+                    {
+                        effects_engine->StartEffect(controllers[header.pkt_dev_idx], params);
+                    }
+                }
+                break;
+
+            case NET_PACKET_ID_RGBCONTROLLER_STOPEFFECT:
+                if(effects_engine && (header.pkt_dev_idx < controllers.size()))
+                {
+                    effects_engine->StopEffect(controllers[header.pkt_dev_idx]);
+                }
+                break;
+
             case NET_PACKET_ID_REQUEST_PROFILE_LIST:
                 SendReply_ProfileList(client_sock);
                 break;
@@ -1106,6 +1175,69 @@ void NetworkServer::SendReply_ProtocolVersion(SOCKET client_sock)
     send_in_progress.unlock();
 }
 
+void NetworkServer::SendReply_ControllerStats(SOCKET client_sock, unsigned int dev_idx)
+{
+    if(dev_idx < controllers.size())
+    {
+        NetPacketHeader reply_hdr;
+        unsigned char *reply_data = controllers[dev_idx]->GetStatsDescription();
+        unsigned int   reply_size;
+
+        memcpy(&reply_size, reply_data, sizeof(reply_size));
+
+        InitNetPacketHeader(&reply_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETSTATS, reply_size);
+
+        send_in_progress.lock();
+        send(client_sock, (const char *)&reply_hdr, sizeof(NetPacketHeader), 0);
+        send(client_sock, (const char *)reply_data, reply_size, 0);
+        send_in_progress.unlock();
+
+        delete[] reply_data;
+    }
+}
+
+void NetworkServer::SendReply_ControllerCorrection(SOCKET client_sock, unsigned int dev_idx)
+{
+    if(dev_idx < controllers.size())
+    {
+        NetPacketHeader reply_hdr;
+        unsigned char *reply_data = controllers[dev_idx]->GetColorCorrectionDescription();
+        unsigned int   reply_size;
+
+        memcpy(&reply_size, reply_data, sizeof(reply_size));
+
+        InitNetPacketHeader(&reply_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETCORRECTION, reply_size);
+
+        send_in_progress.lock();
+        send(client_sock, (const char *)&reply_hdr, sizeof(NetPacketHeader), 0);
+        send(client_sock, (const char *)reply_data, reply_size, 0);
+        send_in_progress.unlock();
+
+        delete[] reply_data;
+    }
+}
+
+void NetworkServer::SendReply_ControllerRate(SOCKET client_sock, unsigned int dev_idx)
+{
+    if(dev_idx < controllers.size())
+    {
+        NetPacketHeader reply_hdr;
+        unsigned char *reply_data = controllers[dev_idx]->GetRateControlDescription();
+        unsigned int   reply_size;
+
+        memcpy(&reply_size, reply_data, sizeof(reply_size));
+
+        InitNetPacketHeader(&reply_hdr, dev_idx, NET_PACKET_ID_RGBCONTROLLER_GETRATE, reply_size);
+
+        send_in_progress.lock();
+        send(client_sock, (const char *)&reply_hdr, sizeof(NetPacketHeader), 0);
+        send(client_sock, (const char *)reply_data, reply_size, 0);
+        send_in_progress.unlock();
+
+        delete[] reply_data;
+    }
+}
+
 void NetworkServer::SendRequest_DeviceListChanged(SOCKET client_sock)
 {
     NetPacketHeader pkt_hdr;
@@ -1260,6 +1392,11 @@ void NetworkServer::SetProfileManager(ProfileManagerInterface* profile_manager_p
     profile_manager = profile_manager_pointer;
 }
 
+void NetworkServer::SetEffectsEngine(EffectsEngine* effects_engine_pointer)
+{
+    effects_engine = effects_engine_pointer;
+}
+
 void NetworkServer::RegisterPlugin(NetworkPlugin plugin)
 {
     plugins.push_back(plugin);
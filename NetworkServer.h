@@ -20,6 +20,8 @@
 #include "ProfileManager.h"
 #include "ResourceManager.h"
 
+class EffectsEngine;
+
 #define MAXSOCK 32
 #define TCP_TIMEOUT_SECONDS 5
 
@@ -88,6 +90,9 @@ public:
     void                                SendReply_ControllerCount(SOCKET client_sock);
     void                                SendReply_ControllerData(SOCKET client_sock, unsigned int dev_idx, unsigned int protocol_version);
     void                                SendReply_ProtocolVersion(SOCKET client_sock);
+    void                                SendReply_ControllerStats(SOCKET client_sock, unsigned int dev_idx);
+    void                                SendReply_ControllerCorrection(SOCKET client_sock, unsigned int dev_idx);
+    void                                SendReply_ControllerRate(SOCKET client_sock, unsigned int dev_idx);
 
     void                                SendRequest_DeviceListChanged(SOCKET client_sock);
     void                                SendReply_ProfileList(SOCKET client_sock);
@@ -95,6 +100,7 @@ public:
     void                                SendReply_PluginSpecific(SOCKET client_sock, unsigned int pkt_type, unsigned char* data, unsigned int data_size);
 
     void                                SetProfileManager(ProfileManagerInterface* profile_manager_pointer);
+    void                                SetEffectsEngine(EffectsEngine* effects_engine_pointer);
 
     void                                RegisterPlugin(NetworkPlugin plugin);
     void                                UnregisterPlugin(std::string plugin_name);
@@ -120,6 +126,7 @@ protected:
     std::vector<void *>                 ServerListeningChangeCallbackArgs;
 
     ProfileManagerInterface*            profile_manager;
+    EffectsEngine*                      effects_engine;
 
     std::vector<NetworkPlugin>          plugins;
 
@@ -172,8 +172,11 @@ HEADERS +=
     Colors.h                                                                                    \
     dependencies/ColorWheel/ColorWheel.h                                                        \
     dependencies/json/nlohmann/json.hpp                                                         \
+    EffectsEngine.h                                                                             \
+    FrameClock.h                                                                                \
     LogManager.h                                                                                \
     NetworkClient.h                                                                             \
+    NetworkDetection.h                                                                          \
     NetworkProtocol.h                                                                           \
     NetworkServer.h                                                                             \
     OpenRGBPluginInterface.h                                                                    \
@@ -185,14 +188,20 @@ HEADERS +=
     Detector.h                                                                                  \
     DeviceDetector.h                                                                            \
     dmiinfo/dmiinfo.h                                                                           \
+    FileUtils.h                                                                                 \
     filesystem.h                                                                                \
+    hidapi_wrapper/HIDFrameUploader.h                                                           \
+    hidapi_wrapper/HIDReportPacer.h                                                             \
     hidapi_wrapper/hidapi_wrapper.h                                                             \
     i2c_smbus/i2c_smbus.h                                                                       \
+    i2c_smbus/i2c_smbus_sim.h                                                                   \
     i2c_tools/i2c_tools.h                                                                       \
     interop/DeviceGuard.h                                                                       \
     interop/DeviceGuardLock.h                                                                   \
     interop/DeviceGuardManager.h                                                                \
     net_port/net_port.h                                                                         \
+    net_port/net_reactor.h                                                                      \
+    net_port/tcp_connection.h                                                                   \
     pci_ids/pci_ids.h                                                                           \
     scsiapi/scsiapi.h                                                                           \
     serial_port/find_usb_serial_port.h                                                          \
@@ -204,7 +213,10 @@ HEADERS +=
     KeyboardLayoutManager/KeyboardLayoutManager.h                                               \
     RGBController/RGBController.h                                                               \
     RGBController/RGBController_Dummy.h                                                         \
+    RGBController/RGBControllerColorFormat.h                                                    \
     RGBController/RGBControllerKeyNames.h                                                       \
+    RGBController/RGBControllerRateControl.h                                                    \
+    RGBController/RGBControllerStats.h                                                          \
     RGBController/RGBController_Network.h                                                       \
     startup/startup.h                                                                           \
 
@@ -244,8 +256,12 @@ SOURCES +=
     startup/startup.cpp                                                                         \
     cli.cpp                                                                                     \
     dmiinfo/dmiinfo.cpp                                                                         \
+    EffectsEngine.cpp                                                                           \
+    FileUtils.cpp                                                                               \
+    FrameClock.cpp                                                                              \
     LogManager.cpp                                                                              \
     NetworkClient.cpp                                                                           \
+    NetworkDetection.cpp                                                                        \
     NetworkProtocol.cpp                                                                         \
     NetworkServer.cpp                                                                           \
     PluginManager.cpp                                                                           \
@@ -257,12 +273,18 @@ SOURCES +=
     SPDAccessor/SPDDetector.cpp                                                                 \
     SPDAccessor/SPDWrapper.cpp                                                                  \
     SettingsManager.cpp                                                                         \
+    hidapi_wrapper/HIDFrameUploader.cpp                                                         \
+    hidapi_wrapper/HIDReportPacer.cpp                                                           \
+    hidapi_wrapper/hidapi_wrapper.cpp                                                           \
     i2c_smbus/i2c_smbus.cpp                                                                     \
+    i2c_smbus/i2c_smbus_sim.cpp                                                                 \
     i2c_tools/i2c_tools.cpp                                                                     \
     interop/DeviceGuard.cpp                                                                     \
     interop/DeviceGuardLock.cpp                                                                 \
     interop/DeviceGuardManager.cpp                                                              \
     net_port/net_port.cpp                                                                       \
+    net_port/net_reactor.cpp                                                                    \
+    net_port/tcp_connection.cpp                                                                 \
     serial_port/serial_port.cpp                                                                 \
     StringUtils.cpp                                                                             \
     super_io/super_io.cpp                                                                       \
@@ -270,7 +292,10 @@ SOURCES +=
     KeyboardLayoutManager/KeyboardLayoutManager.cpp                                             \
     RGBController/RGBController.cpp                                                             \
     RGBController/RGBController_Dummy.cpp                                                       \
+    RGBController/RGBControllerColorFormat.cpp                                                  \
     RGBController/RGBControllerKeyNames.cpp                                                     \
+    RGBController/RGBControllerRateControl.cpp                                                  \
+    RGBController/RGBControllerStats.cpp                                                        \
     RGBController/RGBController_Network.cpp                                                     \
 
 RESOURCES +=                                                                                    \
@@ -7,9 +7,11 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <cstring>
+#include <unordered_map>
 #include "ProfileManager.h"
 #include "ResourceManager.h"
 #include "RGBController_Dummy.h"
@@ -130,7 +132,55 @@ void ProfileManager::SetConfigurationDirectory(const filesystem::path& directory
 bool ProfileManager::LoadProfile(std::string profile_name)
 {
     profile_name = StringUtils::remove_null_terminating_chars(profile_name);
-    return(LoadProfileWithOptions(profile_name, false, true));
+
+    bool ret_val = LoadProfileWithOptions(profile_name, false, true);
+
+    if(ret_val)
+    {
+        std::lock_guard<std::mutex> lock(loaded_profile_mutex);
+        loaded_profile = profile_name;
+    }
+
+    return(ret_val);
+}
+
+bool ProfileManager::LoadProfileToController(RGBController* load_controller)
+{
+    std::string profile_name;
+
+    {
+        std::lock_guard<std::mutex> lock(loaded_profile_mutex);
+        profile_name = loaded_profile;
+    }
+
+    if(profile_name.empty())
+    {
+        return(false);
+    }
+
+    std::vector<RGBController*> temp_controllers        = LoadProfileToList(profile_name);
+    std::vector<bool>           temp_controller_used(temp_controllers.size(), false);
+
+    bool ret_val = LoadDeviceFromListWithOptions(temp_controllers, temp_controller_used, load_controller, false, true);
+
+    for(unsigned int controller_idx = 0; controller_idx < temp_controllers.size(); controller_idx++)
+    {
+        delete temp_controllers[controller_idx];
+    }
+
+    std::string current_name = load_controller->name + " @ " + load_controller->location;
+    LOG_INFO("[ProfileManager] Profile %s loading: %s for %s", profile_name.c_str(), ( ret_val ? "Succeeded" : "FAILED!" ), current_name.c_str());
+
+    /*---------------------------------------------------------*\
+    | Send the loaded mode and colors to the device             |
+    \*---------------------------------------------------------*/
+    if(ret_val)
+    {
+        load_controller->UpdateMode();
+        load_controller->UpdateLEDs();
+    }
+
+    return(ret_val);
 }
 
 bool ProfileManager::LoadSizeFromProfile(std::string profile_name)
@@ -167,9 +217,24 @@ std::vector<RGBController*> ProfileManager::LoadProfileToList
     }
 
     /*---------------------------------------------------------*\
-    | Open input file in binary mode                            |
+    | Read the whole file with a single read and parse the      |
+    | controller records out of memory                          |
     \*---------------------------------------------------------*/
-    std::ifstream controller_file(filename, std::ios::in | std::ios::binary);
+    std::ifstream               controller_file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    std::vector<unsigned char>  profile_data;
+
+    if(controller_file.is_open())
+    {
+        std::streamoff file_size = controller_file.tellg();
+
+        if(file_size > 0)
+        {
+            profile_data.resize((std::size_t)file_size);
+
+            controller_file.seekg(0);
+            controller_file.read((char *)profile_data.data(), file_size);
+        }
+    }
 
     /*---------------------------------------------------------*\
     | Read and verify file header                               |
@@ -177,8 +242,14 @@ std::vector<RGBController*> ProfileManager::LoadProfileToList
     char            profile_string[16]  = "";
     unsigned int    profile_version     = 0;
 
-    controller_file.read(profile_string, 16);
-    controller_file.read((char *)&profile_version, sizeof(unsigned int));
+    if(profile_data.size() < (16 + sizeof(unsigned int)))
+    {
+        return(temp_controllers);
+    }
+
+    memcpy(profile_string, &profile_data[0], 16);
+    profile_string[15] = '\0';
+    memcpy(&profile_version, &profile_data[16], sizeof(unsigned int));
 
     /*---------------------------------------------------------*\
     | Profile version started at 1 and protocol version started |
@@ -191,35 +262,32 @@ std::vector<RGBController*> ProfileManager::LoadProfileToList
     }
 
     controller_offset += 16 + sizeof(unsigned int);
-    controller_file.seekg(controller_offset);
 
     if(strcmp(profile_string, OPENRGB_PROFILE_HEADER) == 0)
     {
         if(profile_version <= OPENRGB_PROFILE_VERSION)
         {
             /*---------------------------------------------------------*\
-            | Read controller data from file until EOF                  |
+            | Read controller data until the end of the file, stopping  |
+            | at a truncated record                                     |
             \*---------------------------------------------------------*/
-            while(!(controller_file.peek() == EOF))
+            while((controller_offset + sizeof(controller_size)) <= profile_data.size())
             {
-                controller_file.read((char *)&controller_size, sizeof(controller_size));
-
-                unsigned char *controller_data = new unsigned char[controller_size];
-
-                controller_file.seekg(controller_offset);
+                memcpy(&controller_size, &profile_data[controller_offset], sizeof(controller_size));
 
-                controller_file.read((char *)controller_data, controller_size);
+                if((controller_size < sizeof(controller_size)) || (controller_size > (profile_data.size() - controller_offset)))
+                {
+                    LOG_WARNING("[ProfileManager] Profile %s is truncated, ignoring remaining data", profile_name.c_str());
+                    break;
+                }
 
                 RGBController_Dummy *temp_controller = new RGBController_Dummy();
 
-                temp_controller->ReadDeviceDescription(controller_data, profile_version);
+                temp_controller->ReadDeviceDescription(&profile_data[controller_offset], profile_version);
 
                 temp_controllers.push_back(temp_controller);
 
-                delete[] controller_data;
-
                 controller_offset += controller_size;
-                controller_file.seekg(controller_offset);
             }
         }
     }
@@ -238,145 +306,177 @@ bool ProfileManager::LoadDeviceFromListWithOptions
 {
     for(std::size_t temp_index = 0; temp_index < temp_controllers.size(); temp_index++)
     {
-        RGBController *temp_controller = temp_controllers[temp_index];
+        if((temp_controller_used[temp_index] == false)
+         &&(ControllerMatches(temp_controllers[temp_index], load_controller)))
+        {
+            /*---------------------------------------------------------*\
+            | Set used flag for this temp device                        |
+            \*---------------------------------------------------------*/
+            temp_controller_used[temp_index] = true;
 
-        /*---------------------------------------------------------*\
-        | Do not compare location string for HID devices, as the    |
-        | location string may change between runs as devices are    |
-        | connected and disconnected. Also do not compare the I2C   |
-        | bus number, since it is not persistent across reboots     |
-        | on Linux - strip the I2C number and compare only address. |
-        \*---------------------------------------------------------*/
-        bool location_check;
+            ApplyControllerWithOptions(temp_controllers[temp_index], load_controller, load_size, load_settings);
 
-        if(load_controller->location.find("HID: ") == 0)
-        {
-            location_check = true;
+            return(true);
         }
-        else if(load_controller->location.find("I2C: ") == 0)
+    }
+
+    return(false);
+}
+
+/*---------------------------------------------------------*\
+| Hash of the fields that must match exactly between a      |
+| saved and a live controller, used to index saved          |
+| controllers so matching does not scan the whole profile   |
+\*---------------------------------------------------------*/
+std::size_t ProfileManager::ControllerKey(RGBController* controller)
+{
+    std::hash<std::string>  string_hash;
+    std::size_t             key         = std::hash<int>()(controller->type);
+
+    key ^= string_hash(controller->name)        + 0x9E3779B9 + (key << 6) + (key >> 2);
+    key ^= string_hash(controller->description) + 0x9E3779B9 + (key << 6) + (key >> 2);
+    key ^= string_hash(controller->version)     + 0x9E3779B9 + (key << 6) + (key >> 2);
+    key ^= string_hash(controller->serial)      + 0x9E3779B9 + (key << 6) + (key >> 2);
+
+    return(key);
+}
+
+bool ProfileManager::ControllerMatches(RGBController* temp_controller, RGBController* load_controller)
+{
+    /*---------------------------------------------------------*\
+    | Do not compare location string for HID devices, as the    |
+    | location string may change between runs as devices are    |
+    | connected and disconnected. Also do not compare the I2C   |
+    | bus number, since it is not persistent across reboots     |
+    | on Linux - strip the I2C number and compare only address. |
+    \*---------------------------------------------------------*/
+    bool location_check;
+
+    if(load_controller->location.find("HID: ") == 0)
+    {
+        location_check = true;
+    }
+    else if(load_controller->location.find("I2C: ") == 0)
+    {
+        std::size_t loc = load_controller->location.rfind(", ");
+        if(loc == std::string::npos)
         {
-            std::size_t loc = load_controller->location.rfind(", ");
-            if(loc == std::string::npos)
-            {
-                location_check = false;
-            }
-            else
-            {
-                std::string i2c_address = load_controller->location.substr(loc + 2);
-                location_check = temp_controller->location.find(i2c_address) != std::string::npos;
-            }
+            location_check = false;
         }
         else
         {
-            location_check = temp_controller->location == load_controller->location;
+            std::string i2c_address = load_controller->location.substr(loc + 2);
+            location_check = temp_controller->location.find(i2c_address) != std::string::npos;
         }
+    }
+    else
+    {
+        location_check = temp_controller->location == load_controller->location;
+    }
 
-        /*---------------------------------------------------------*\
-        | Test if saved controller data matches this controller     |
-        \*---------------------------------------------------------*/
-        if((temp_controller_used[temp_index]    == false                       )
-         &&(temp_controller->type               == load_controller->type       )
+    /*---------------------------------------------------------*\
+    | Test if saved controller data matches this controller     |
+    \*---------------------------------------------------------*/
+    return((temp_controller->type               == load_controller->type       )
          &&(temp_controller->name               == load_controller->name       )
          &&(temp_controller->description        == load_controller->description)
          &&(temp_controller->version            == load_controller->version    )
          &&(temp_controller->serial             == load_controller->serial     )
-         &&(location_check                      == true                        ))
-        {
-            /*---------------------------------------------------------*\
-            | Set used flag for this temp device                        |
-            \*---------------------------------------------------------*/
-            temp_controller_used[temp_index] = true;
+         &&(location_check                      == true                        ));
+}
 
-            /*---------------------------------------------------------*\
-            | Update zone sizes if requested                            |
-            \*---------------------------------------------------------*/
-            if(load_size)
+void ProfileManager::ApplyControllerWithOptions
+    (
+    RGBController*                  temp_controller,
+    RGBController*                  load_controller,
+    bool                            load_size,
+    bool                            load_settings
+    )
+{
+    /*---------------------------------------------------------*\
+    | Update zone sizes if requested                            |
+    \*---------------------------------------------------------*/
+    if(load_size)
+    {
+        if(temp_controller->zones.size() == load_controller->zones.size())
+        {
+            for(std::size_t zone_idx = 0; zone_idx < temp_controller->zones.size(); zone_idx++)
             {
-                if(temp_controller->zones.size() == load_controller->zones.size())
+                if((temp_controller->zones[zone_idx].name       == load_controller->zones[zone_idx].name      )
+                 &&(temp_controller->zones[zone_idx].type       == load_controller->zones[zone_idx].type      )
+                 &&(temp_controller->zones[zone_idx].leds_min   == load_controller->zones[zone_idx].leds_min  )
+                 &&(temp_controller->zones[zone_idx].leds_max   == load_controller->zones[zone_idx].leds_max  ))
                 {
-                    for(std::size_t zone_idx = 0; zone_idx < temp_controller->zones.size(); zone_idx++)
+                    if(temp_controller->zones[zone_idx].leds_count != load_controller->zones[zone_idx].leds_count)
                     {
-                        if((temp_controller->zones[zone_idx].name       == load_controller->zones[zone_idx].name      )
-                         &&(temp_controller->zones[zone_idx].type       == load_controller->zones[zone_idx].type      )
-                         &&(temp_controller->zones[zone_idx].leds_min   == load_controller->zones[zone_idx].leds_min  )
-                         &&(temp_controller->zones[zone_idx].leds_max   == load_controller->zones[zone_idx].leds_max  ))
+                        load_controller->ResizeZone((int)zone_idx, temp_controller->zones[zone_idx].leds_count);
+                    }
+
+                    if(temp_controller->zones[zone_idx].segments.size() != load_controller->zones[zone_idx].segments.size())
+                    {
+                        load_controller->zones[zone_idx].segments.clear();
+
+                        for(std::size_t segment_idx = 0; segment_idx < temp_controller->zones[zone_idx].segments.size(); segment_idx++)
                         {
-                            if(temp_controller->zones[zone_idx].leds_count != load_controller->zones[zone_idx].leds_count)
-                            {
-                                load_controller->ResizeZone((int)zone_idx, temp_controller->zones[zone_idx].leds_count);
-                            }
-
-                            if(temp_controller->zones[zone_idx].segments.size() != load_controller->zones[zone_idx].segments.size())
-                            {
-                                load_controller->zones[zone_idx].segments.clear();
-
-                                for(std::size_t segment_idx = 0; segment_idx < temp_controller->zones[zone_idx].segments.size(); segment_idx++)
-                                {
-                                    load_controller->zones[zone_idx].segments.push_back(temp_controller->zones[zone_idx].segments[segment_idx]);
-                                }
-                            }
+                            load_controller->zones[zone_idx].segments.push_back(temp_controller->zones[zone_idx].segments[segment_idx]);
                         }
                     }
                 }
             }
+        }
+    }
 
-            /*---------------------------------------------------------*\
-            | Update settings if requested                              |
-            \*---------------------------------------------------------*/
-            if(load_settings)
+    /*---------------------------------------------------------*\
+    | Update settings if requested                              |
+    \*---------------------------------------------------------*/
+    if(load_settings)
+    {
+        /*---------------------------------------------------------*\
+        | Update all modes                                          |
+        \*---------------------------------------------------------*/
+        if(temp_controller->modes.size() == load_controller->modes.size())
+        {
+            for(std::size_t mode_index = 0; mode_index < temp_controller->modes.size(); mode_index++)
             {
-                /*---------------------------------------------------------*\
-                | Update all modes                                          |
-                \*---------------------------------------------------------*/
-                if(temp_controller->modes.size() == load_controller->modes.size())
+                if((temp_controller->modes[mode_index].name             == load_controller->modes[mode_index].name          )
+                 &&(temp_controller->modes[mode_index].value            == load_controller->modes[mode_index].value         )
+                 &&(temp_controller->modes[mode_index].flags            == load_controller->modes[mode_index].flags         )
+                 &&(temp_controller->modes[mode_index].speed_min        == load_controller->modes[mode_index].speed_min     )
+                 &&(temp_controller->modes[mode_index].speed_max        == load_controller->modes[mode_index].speed_max     )
+               //&&(temp_controller->modes[mode_index].brightness_min   == load_controller->modes[mode_index].brightness_min)
+               //&&(temp_controller->modes[mode_index].brightness_max   == load_controller->modes[mode_index].brightness_max)
+                 &&(temp_controller->modes[mode_index].colors_min       == load_controller->modes[mode_index].colors_min    )
+                 &&(temp_controller->modes[mode_index].colors_max       == load_controller->modes[mode_index].colors_max   ))
                 {
-                    for(std::size_t mode_index = 0; mode_index < temp_controller->modes.size(); mode_index++)
-                    {
-                        if((temp_controller->modes[mode_index].name             == load_controller->modes[mode_index].name          )
-                         &&(temp_controller->modes[mode_index].value            == load_controller->modes[mode_index].value         )
-                         &&(temp_controller->modes[mode_index].flags            == load_controller->modes[mode_index].flags         )
-                         &&(temp_controller->modes[mode_index].speed_min        == load_controller->modes[mode_index].speed_min     )
-                         &&(temp_controller->modes[mode_index].speed_max        == load_controller->modes[mode_index].speed_max     )
-                       //&&(temp_controller->modes[mode_index].brightness_min   == load_controller->modes[mode_index].brightness_min)
-                       //&&(temp_controller->modes[mode_index].brightness_max   == load_controller->modes[mode_index].brightness_max)
-                         &&(temp_controller->modes[mode_index].colors_min       == load_controller->modes[mode_index].colors_min    )
-                         &&(temp_controller->modes[mode_index].colors_max       == load_controller->modes[mode_index].colors_max   ))
-                        {
-                            load_controller->modes[mode_index].speed            = temp_controller->modes[mode_index].speed;
-                            load_controller->modes[mode_index].brightness       = temp_controller->modes[mode_index].brightness;
-                            load_controller->modes[mode_index].direction        = temp_controller->modes[mode_index].direction;
-                            load_controller->modes[mode_index].color_mode       = temp_controller->modes[mode_index].color_mode;
-
-                            load_controller->modes[mode_index].colors.resize(temp_controller->modes[mode_index].colors.size());
-
-                            for(std::size_t mode_color_index = 0; mode_color_index < temp_controller->modes[mode_index].colors.size(); mode_color_index++)
-                            {
-                                load_controller->modes[mode_index].colors[mode_color_index] = temp_controller->modes[mode_index].colors[mode_color_index];
-                            }
-                        }
-
-                    }
+                    load_controller->modes[mode_index].speed            = temp_controller->modes[mode_index].speed;
+                    load_controller->modes[mode_index].brightness       = temp_controller->modes[mode_index].brightness;
+                    load_controller->modes[mode_index].direction        = temp_controller->modes[mode_index].direction;
+                    load_controller->modes[mode_index].color_mode       = temp_controller->modes[mode_index].color_mode;
 
-                    load_controller->active_mode = temp_controller->active_mode;
-                }
+                    load_controller->modes[mode_index].colors.resize(temp_controller->modes[mode_index].colors.size());
 
-                /*---------------------------------------------------------*\
-                | Update all colors                                         |
-                \*---------------------------------------------------------*/
-                if(temp_controller->colors.size() == load_controller->colors.size())
-                {
-                    for(std::size_t color_index = 0; color_index < temp_controller->colors.size(); color_index++)
+                    for(std::size_t mode_color_index = 0; mode_color_index < temp_controller->modes[mode_index].colors.size(); mode_color_index++)
                     {
-                        load_controller->colors[color_index] = temp_controller->colors[color_index];
+                        load_controller->modes[mode_index].colors[mode_color_index] = temp_controller->modes[mode_index].colors[mode_color_index];
                     }
                 }
+
             }
 
-            return(true);
+            load_controller->active_mode = temp_controller->active_mode;
         }
-    }
 
-    return(false);
+        /*---------------------------------------------------------*\
+        | Update all colors                                         |
+        \*---------------------------------------------------------*/
+        if(temp_controller->colors.size() == load_controller->colors.size())
+        {
+            for(std::size_t color_index = 0; color_index < temp_controller->colors.size(); color_index++)
+            {
+                load_controller->colors[color_index] = temp_controller->colors[color_index];
+            }
+        }
+    }
 }
 
 bool ProfileManager::LoadProfileWithOptions
@@ -386,9 +486,12 @@ bool ProfileManager::LoadProfileWithOptions
     bool            load_settings
     )
 {
-    std::vector<RGBController*> temp_controllers;
-    std::vector<bool>           temp_controller_used;
-    bool                        ret_val = false;
+    std::vector<RGBController*>                                 temp_controllers;
+    std::vector<bool>                                           temp_controller_used;
+    std::unordered_map<std::size_t, std::vector<std::size_t>>   temp_controller_index;
+    bool                                                        ret_val = false;
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
 
     /*---------------------------------------------------------*\
     | Get the list of controllers from the resource manager     |
@@ -410,13 +513,46 @@ bool ProfileManager::LoadProfileWithOptions
         temp_controller_used[controller_idx] = false;
     }
 
+    /*---------------------------------------------------------*\
+    | Index saved controllers by key, keeping file order within |
+    | each key so identical devices are matched in order        |
+    \*---------------------------------------------------------*/
+    for(std::size_t temp_index = 0; temp_index < temp_controllers.size(); temp_index++)
+    {
+        temp_controller_index[ControllerKey(temp_controllers[temp_index])].push_back(temp_index);
+    }
+
     /*---------------------------------------------------------*\
     | Loop through all controllers.  For each controller, search|
-    | all saved controllers until a match is found              |
+    | the saved controllers with the same key until a match is  |
+    | found                                                     |
     \*---------------------------------------------------------*/
     for(std::size_t controller_index = 0; controller_index < controllers.size(); controller_index++)
     {
-        bool temp_ret_val = LoadDeviceFromListWithOptions(temp_controllers, temp_controller_used, controllers[controller_index], load_size, load_settings);
+        RGBController*  load_controller = controllers[controller_index];
+        bool            temp_ret_val    = false;
+
+        std::unordered_map<std::size_t, std::vector<std::size_t>>::iterator candidates = temp_controller_index.find(ControllerKey(load_controller));
+
+        if(candidates != temp_controller_index.end())
+        {
+            for(std::size_t candidate_idx = 0; candidate_idx < candidates->second.size(); candidate_idx++)
+            {
+                std::size_t temp_index = candidates->second[candidate_idx];
+
+                if((temp_controller_used[temp_index] == false)
+                 &&(ControllerMatches(temp_controllers[temp_index], load_controller)))
+                {
+                    temp_controller_used[temp_index] = true;
+
+                    ApplyControllerWithOptions(temp_controllers[temp_index], load_controller, load_size, load_settings);
+
+                    temp_ret_val = true;
+                    break;
+                }
+            }
+        }
+
         std::string current_name = controllers[controller_index]->name + " @ " + controllers[controller_index]->location;
         LOG_INFO("[ProfileManager] Profile loading: %s for %s", ( temp_ret_val ? "Succeeded" : "FAILED!" ), current_name.c_str());
         ret_val |= temp_ret_val;
@@ -430,6 +566,9 @@ bool ProfileManager::LoadProfileWithOptions
         delete temp_controllers[controller_idx];
     }
 
+    LOG_INFO("[ProfileManager] Profile %s loaded for %d controllers in %lld us", profile_name.c_str(), (int)controllers.size(),
+             (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+
     return(ret_val);
 }
 
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "RGBController.h"
 #include "filesystem.h"
 
@@ -82,10 +83,29 @@ public:
 
     void SetConfigurationDirectory(const filesystem::path& directory);
 
+    /*---------------------------------------------------------*\
+    | Apply the profile last loaded with LoadProfile() to a     |
+    | controller registered after it was loaded                 |
+    \*---------------------------------------------------------*/
+    bool LoadProfileToController(RGBController* load_controller);
+
 private:
     filesystem::path configuration_directory;
+    std::mutex       loaded_profile_mutex;
+    std::string      loaded_profile;
 
     void UpdateProfileList();
+
+    static std::size_t  ControllerKey(RGBController* controller);
+    static bool         ControllerMatches(RGBController* temp_controller, RGBController* load_controller);
+    void                ApplyControllerWithOptions
+            (
+            RGBController*  temp_controller,
+            RGBController*  load_controller,
+            bool            load_size,
+            bool            load_settings
+            );
+
     bool LoadProfileWithOptions
             (
             std::string     profile_name,
@@ -10,6 +10,7 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include <cstring>
 #include "RGBController.h"
 
@@ -59,15 +60,28 @@ zone::~zone()
 RGBController::RGBController()
 {
     flags       = 0;
+    CallFlag_UpdateLEDs = false;
+    CallFlag_UpdateMode = false;
     DeviceThreadRunning = true;
-    DeviceCallThread = new std::thread(&RGBController::DeviceCallThreadFunction, this);
+    DeviceCallThread = NULL;
+    CorrectionUseLUT    = false;
+    CorrectionEnabled   = false;
+    CorrectionApplied   = false;
+
+    rgb_color_correction_init(&Correction);
 }
 
 RGBController::~RGBController()
 {
     DeviceThreadRunning = false;
-    DeviceCallThread->join();
-    delete DeviceCallThread;
+
+    WakeDeviceThread();
+
+    if(DeviceCallThread != NULL)
+    {
+        DeviceCallThread->join();
+        delete DeviceCallThread;
+    }
 
     leds.clear();
     colors.clear();
@@ -705,13 +719,10 @@ unsigned char * RGBController::GetDeviceDescription(unsigned int protocol_versio
     /*---------------------------------------------------------*\
     | Copy in colors                                            |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
+    if(num_colors > 0)
     {
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&data_buf[data_ptr], &colors[color_index], sizeof(colors[color_index]));
-        data_ptr += sizeof(colors[color_index]);
+        memcpy(&data_buf[data_ptr], colors.data(), num_colors * sizeof(RGBColor));
+        data_ptr += num_colors * sizeof(RGBColor);
     }
 
     /*---------------------------------------------------------*\
@@ -1165,17 +1176,14 @@ void RGBController::ReadDeviceDescription(unsigned char* data_buf, unsigned int
     /*---------------------------------------------------------*\
     | Copy in colors                                            |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
-    {
-        RGBColor new_color;
+    std::size_t colors_base = colors.size();
 
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&new_color, &data_buf[data_ptr], sizeof(RGBColor));
-        data_ptr += sizeof(RGBColor);
+    colors.resize(colors_base + num_colors);
 
-        colors.push_back(new_color);
+    if(num_colors > 0)
+    {
+        memcpy(&colors[colors_base], &data_buf[data_ptr], num_colors * sizeof(RGBColor));
+        data_ptr += num_colors * sizeof(RGBColor);
     }
 
     /*---------------------------------------------------------*\
@@ -1556,13 +1564,9 @@ unsigned char * RGBController::GetColorDescription()
     /*---------------------------------------------------------*\
     | Copy in colors                                            |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
+    if(num_colors > 0)
     {
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&data_buf[data_ptr], &colors[color_index], sizeof(colors[color_index]));
-        data_ptr += sizeof(colors[color_index]);
+        memcpy(&data_buf[data_ptr], colors.data(), num_colors * sizeof(RGBColor));
     }
 
     return(data_buf);
@@ -1590,17 +1594,9 @@ void RGBController::SetColorDescription(unsigned char* data_buf)
     /*---------------------------------------------------------*\
     | Copy in colors                                            |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
+    if(num_colors > 0)
     {
-        RGBColor new_color;
-
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&new_color, &data_buf[data_ptr], sizeof(RGBColor));
-        data_ptr += sizeof(RGBColor);
-
-        colors[color_index] = new_color;
+        memcpy(colors.data(), &data_buf[data_ptr], num_colors * sizeof(RGBColor));
     }
 }
 
@@ -1609,7 +1605,13 @@ unsigned char * RGBController::GetZoneColorDescription(int zone)
     unsigned int data_ptr = 0;
     unsigned int data_size = 0;
 
-    unsigned short num_colors = zones[zone].leds_count;
+    /*---------------------------------------------------------*\
+    | Use the zone's color span rather than leds_count so that  |
+    | effects-only zones never read past the color buffer       |
+    \*---------------------------------------------------------*/
+    rgb_span<RGBColor> zone_colors = GetZoneColors(zone);
+
+    unsigned short num_colors = (unsigned short)zone_colors.size();
 
     /*---------------------------------------------------------*\
     | Calculate data size                                       |
@@ -1645,13 +1647,9 @@ unsigned char * RGBController::GetZoneColorDescription(int zone)
     /*---------------------------------------------------------*\
     | Copy in colors                                            |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
+    if(num_colors > 0)
     {
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&data_buf[data_ptr], &zones[zone].colors[color_index], sizeof(zones[zone].colors[color_index]));
-        data_ptr += sizeof(zones[zone].colors[color_index]);
+        memcpy(&data_buf[data_ptr], zone_colors.data(), num_colors * sizeof(RGBColor));
     }
 
     return(data_buf);
@@ -1671,7 +1669,7 @@ void RGBController::SetZoneColorDescription(unsigned char* data_buf)
     /*---------------------------------------------------------*\
     | Check if we aren't reading beyond the list of zones.      |
     \*---------------------------------------------------------*/
-    if(((size_t)zone_idx) > zones.size())
+    if(((size_t)zone_idx) >= zones.size())
     {
         return;
     }
@@ -1684,19 +1682,21 @@ void RGBController::SetZoneColorDescription(unsigned char* data_buf)
     data_ptr += sizeof(unsigned short);
 
     /*---------------------------------------------------------*\
-    | Copy in colors                                            |
+    | Check if we aren't writing beyond the zone's colors.      |
     \*---------------------------------------------------------*/
-    for(int color_index = 0; color_index < num_colors; color_index++)
-    {
-        RGBColor new_color;
+    rgb_span<RGBColor> zone_colors = GetZoneColors(zone_idx);
 
-        /*---------------------------------------------------------*\
-        | Copy in color (data)                                      |
-        \*---------------------------------------------------------*/
-        memcpy(&new_color, &data_buf[data_ptr], sizeof(RGBColor));
-        data_ptr += sizeof(RGBColor);
+    if(((size_t)num_colors) > zone_colors.size())
+    {
+        return;
+    }
 
-        zones[zone_idx].colors[color_index] = new_color;
+    /*---------------------------------------------------------*\
+    | Copy in colors                                            |
+    \*---------------------------------------------------------*/
+    if(num_colors > 0)
+    {
+        memcpy(zone_colors.data(), &data_buf[data_ptr], num_colors * sizeof(RGBColor));
     }
 }
 
@@ -1892,6 +1892,530 @@ void RGBController::SetSegmentDescription(unsigned char* data_buf)
     delete[] segment_name;
 }
 
+static unsigned int GetStatsHistogramSize()
+{
+    return(3 * sizeof(unsigned long long) + sizeof(unsigned short) + (RGBCONTROLLER_STATS_NUM_BUCKETS * sizeof(unsigned int)));
+}
+
+static void CopyStatsHistogram(unsigned char* data_buf, unsigned int* data_ptr, const stats_histogram& histogram)
+{
+    unsigned short num_buckets = RGBCONTROLLER_STATS_NUM_BUCKETS;
+
+    memcpy(&data_buf[*data_ptr], &histogram.count, sizeof(histogram.count));
+    *data_ptr += sizeof(histogram.count);
+
+    memcpy(&data_buf[*data_ptr], &histogram.total_us, sizeof(histogram.total_us));
+    *data_ptr += sizeof(histogram.total_us);
+
+    memcpy(&data_buf[*data_ptr], &histogram.max_us, sizeof(histogram.max_us));
+    *data_ptr += sizeof(histogram.max_us);
+
+    memcpy(&data_buf[*data_ptr], &num_buckets, sizeof(num_buckets));
+    *data_ptr += sizeof(num_buckets);
+
+    memcpy(&data_buf[*data_ptr], histogram.buckets, num_buckets * sizeof(unsigned int));
+    *data_ptr += num_buckets * sizeof(unsigned int);
+}
+
+unsigned char * RGBController::GetStatsDescription()
+{
+    unsigned int            data_ptr        = 0;
+    unsigned int            data_size       = 0;
+    unsigned short          num_transports  = RGBCONTROLLER_TRANSPORT_COUNT;
+    rgb_controller_stats    stats;
+
+    GetStats(&stats);
+
+    /*---------------------------------------------------------*\
+    | Calculate data size                                       |
+    \*---------------------------------------------------------*/
+    data_size += sizeof(data_size);
+    data_size += sizeof(stats.frames_requested);
+    data_size += sizeof(stats.frames_written);
+    data_size += sizeof(stats.frames_coalesced);
+    data_size += 2 * GetStatsHistogramSize();
+    data_size += sizeof(num_transports);
+    data_size += num_transports * (sizeof(unsigned long long) + sizeof(unsigned long long));
+    data_size += 2 * GetStatsHistogramSize();
+
+    /*---------------------------------------------------------*\
+    | Create data buffer                                        |
+    \*---------------------------------------------------------*/
+    unsigned char *data_buf = new unsigned char[data_size];
+
+    /*---------------------------------------------------------*\
+    | Copy in data size                                         |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &data_size, sizeof(data_size));
+    data_ptr += sizeof(data_size);
+
+    /*---------------------------------------------------------*\
+    | Copy in frame counters                                    |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &stats.frames_requested, sizeof(stats.frames_requested));
+    data_ptr += sizeof(stats.frames_requested);
+
+    memcpy(&data_buf[data_ptr], &stats.frames_written, sizeof(stats.frames_written));
+    data_ptr += sizeof(stats.frames_written);
+
+    memcpy(&data_buf[data_ptr], &stats.frames_coalesced, sizeof(stats.frames_coalesced));
+    data_ptr += sizeof(stats.frames_coalesced);
+
+    /*---------------------------------------------------------*\
+    | Copy in queue wait and update time histograms             |
+    \*---------------------------------------------------------*/
+    CopyStatsHistogram(data_buf, &data_ptr, stats.queue_wait);
+    CopyStatsHistogram(data_buf, &data_ptr, stats.update_time);
+
+    /*---------------------------------------------------------*\
+    | Copy in per-transport counters                            |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &num_transports, sizeof(num_transports));
+    data_ptr += sizeof(num_transports);
+
+    for(unsigned int transport_idx = 0; transport_idx < num_transports; transport_idx++)
+    {
+        memcpy(&data_buf[data_ptr], &stats.transport_bytes[transport_idx], sizeof(stats.transport_bytes[transport_idx]));
+        data_ptr += sizeof(stats.transport_bytes[transport_idx]);
+
+        memcpy(&data_buf[data_ptr], &stats.transport_writes[transport_idx], sizeof(stats.transport_writes[transport_idx]));
+        data_ptr += sizeof(stats.transport_writes[transport_idx]);
+    }
+
+    /*---------------------------------------------------------*\
+    | Copy in frame clock dispatch jitter and commit latency    |
+    | histograms                                                |
+    \*---------------------------------------------------------*/
+    CopyStatsHistogram(data_buf, &data_ptr, stats.dispatch_jitter);
+    CopyStatsHistogram(data_buf, &data_ptr, stats.commit_latency);
+
+    return(data_buf);
+}
+
+static void ReadStatsHistogram(unsigned char* data_buf, unsigned int* data_ptr, stats_histogram* histogram)
+{
+    unsigned short num_buckets;
+
+    memcpy(&histogram->count, &data_buf[*data_ptr], sizeof(histogram->count));
+    *data_ptr += sizeof(histogram->count);
+
+    memcpy(&histogram->total_us, &data_buf[*data_ptr], sizeof(histogram->total_us));
+    *data_ptr += sizeof(histogram->total_us);
+
+    memcpy(&histogram->max_us, &data_buf[*data_ptr], sizeof(histogram->max_us));
+    *data_ptr += sizeof(histogram->max_us);
+
+    memcpy(&num_buckets, &data_buf[*data_ptr], sizeof(num_buckets));
+    *data_ptr += sizeof(num_buckets);
+
+    for(unsigned int bucket_idx = 0; bucket_idx < num_buckets; bucket_idx++)
+    {
+        unsigned int bucket;
+
+        memcpy(&bucket, &data_buf[*data_ptr], sizeof(bucket));
+        *data_ptr += sizeof(bucket);
+
+        /*---------------------------------------------------------*\
+        | Fold any buckets beyond our own range into the last one   |
+        \*---------------------------------------------------------*/
+        if(bucket_idx < RGBCONTROLLER_STATS_NUM_BUCKETS)
+        {
+            histogram->buckets[bucket_idx] = bucket;
+        }
+        else
+        {
+            histogram->buckets[RGBCONTROLLER_STATS_NUM_BUCKETS - 1] += bucket;
+        }
+    }
+
+    for(unsigned int bucket_idx = num_buckets; bucket_idx < RGBCONTROLLER_STATS_NUM_BUCKETS; bucket_idx++)
+    {
+        histogram->buckets[bucket_idx] = 0;
+    }
+}
+
+void RGBController::ReadStatsDescription(unsigned char* data_buf, rgb_controller_stats* stats)
+{
+    unsigned int data_size;
+    unsigned int data_ptr = sizeof(unsigned int);
+
+    memcpy(&data_size, data_buf, sizeof(data_size));
+
+    /*---------------------------------------------------------*\
+    | Copy in frame counters                                    |
+    \*---------------------------------------------------------*/
+    memcpy(&stats->frames_requested, &data_buf[data_ptr], sizeof(stats->frames_requested));
+    data_ptr += sizeof(stats->frames_requested);
+
+    memcpy(&stats->frames_written, &data_buf[data_ptr], sizeof(stats->frames_written));
+    data_ptr += sizeof(stats->frames_written);
+
+    memcpy(&stats->frames_coalesced, &data_buf[data_ptr], sizeof(stats->frames_coalesced));
+    data_ptr += sizeof(stats->frames_coalesced);
+
+    /*---------------------------------------------------------*\
+    | Copy in queue wait and update time histograms             |
+    \*---------------------------------------------------------*/
+    ReadStatsHistogram(data_buf, &data_ptr, &stats->queue_wait);
+    ReadStatsHistogram(data_buf, &data_ptr, &stats->update_time);
+
+    /*---------------------------------------------------------*\
+    | Copy in per-transport counters                            |
+    \*---------------------------------------------------------*/
+    unsigned short num_transports;
+
+    memcpy(&num_transports, &data_buf[data_ptr], sizeof(num_transports));
+    data_ptr += sizeof(num_transports);
+
+    for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        stats->transport_bytes[transport_idx]  = 0;
+        stats->transport_writes[transport_idx] = 0;
+    }
+
+    for(unsigned int transport_idx = 0; transport_idx < num_transports; transport_idx++)
+    {
+        unsigned long long transport_bytes;
+        unsigned long long transport_writes;
+
+        memcpy(&transport_bytes, &data_buf[data_ptr], sizeof(transport_bytes));
+        data_ptr += sizeof(transport_bytes);
+
+        memcpy(&transport_writes, &data_buf[data_ptr], sizeof(transport_writes));
+        data_ptr += sizeof(transport_writes);
+
+        if(transport_idx < RGBCONTROLLER_TRANSPORT_COUNT)
+        {
+            stats->transport_bytes[transport_idx]  = transport_bytes;
+            stats->transport_writes[transport_idx] = transport_writes;
+        }
+    }
+
+    /*---------------------------------------------------------*\
+    | Copy in frame clock histograms if the server sent them    |
+    \*---------------------------------------------------------*/
+    memset(&stats->dispatch_jitter, 0, sizeof(stats->dispatch_jitter));
+    memset(&stats->commit_latency, 0, sizeof(stats->commit_latency));
+
+    if(data_size >= (data_ptr + (2 * GetStatsHistogramSize())))
+    {
+        ReadStatsHistogram(data_buf, &data_ptr, &stats->dispatch_jitter);
+        ReadStatsHistogram(data_buf, &data_ptr, &stats->commit_latency);
+    }
+}
+
+void RGBController::GetStats(rgb_controller_stats* stats)
+{
+    Stats.GetStats(stats);
+}
+
+void RGBController::ResetStats()
+{
+    Stats.Reset();
+}
+
+unsigned char * RGBController::GetColorCorrectionDescription()
+{
+    unsigned int            data_ptr    = 0;
+    unsigned int            data_size   = 0;
+    rgb_color_correction    correction;
+
+    /*---------------------------------------------------------*\
+    | Serialize the local settings, not the virtual getter, so  |
+    | a network controller can describe what it sends           |
+    \*---------------------------------------------------------*/
+    CorrectionMutex.lock();
+    correction = Correction;
+    CorrectionMutex.unlock();
+
+    /*---------------------------------------------------------*\
+    | Calculate data size                                       |
+    \*---------------------------------------------------------*/
+    data_size += sizeof(data_size);
+    data_size += sizeof(correction.brightness);
+    data_size += sizeof(correction.white_balance);
+    data_size += sizeof(correction.gamma);
+    data_size += sizeof(correction.channel_order);
+
+    /*---------------------------------------------------------*\
+    | Create data buffer                                        |
+    \*---------------------------------------------------------*/
+    unsigned char *data_buf = new unsigned char[data_size];
+
+    /*---------------------------------------------------------*\
+    | Copy in data size                                         |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &data_size, sizeof(data_size));
+    data_ptr += sizeof(data_size);
+
+    /*---------------------------------------------------------*\
+    | Copy in brightness and white balance                      |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &correction.brightness, sizeof(correction.brightness));
+    data_ptr += sizeof(correction.brightness);
+
+    memcpy(&data_buf[data_ptr], correction.white_balance, sizeof(correction.white_balance));
+    data_ptr += sizeof(correction.white_balance);
+
+    /*---------------------------------------------------------*\
+    | Copy in gamma and channel order                           |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &correction.gamma, sizeof(correction.gamma));
+    data_ptr += sizeof(correction.gamma);
+
+    memcpy(&data_buf[data_ptr], &correction.channel_order, sizeof(correction.channel_order));
+    data_ptr += sizeof(correction.channel_order);
+
+    return(data_buf);
+}
+
+void RGBController::ReadColorCorrectionDescription(unsigned char* data_buf, rgb_color_correction* correction)
+{
+    unsigned int data_ptr = sizeof(unsigned int);
+
+    /*---------------------------------------------------------*\
+    | Copy out brightness and white balance                     |
+    \*---------------------------------------------------------*/
+    memcpy(&correction->brightness, &data_buf[data_ptr], sizeof(correction->brightness));
+    data_ptr += sizeof(correction->brightness);
+
+    memcpy(correction->white_balance, &data_buf[data_ptr], sizeof(correction->white_balance));
+    data_ptr += sizeof(correction->white_balance);
+
+    /*---------------------------------------------------------*\
+    | Copy out gamma and channel order                          |
+    \*---------------------------------------------------------*/
+    memcpy(&correction->gamma, &data_buf[data_ptr], sizeof(correction->gamma));
+    data_ptr += sizeof(correction->gamma);
+
+    memcpy(&correction->channel_order, &data_buf[data_ptr], sizeof(correction->channel_order));
+    data_ptr += sizeof(correction->channel_order);
+}
+
+void RGBController::GetColorCorrection(rgb_color_correction* correction)
+{
+    std::lock_guard<std::mutex> lock(CorrectionMutex);
+
+    *correction = Correction;
+}
+
+void RGBController::SetColorCorrection(const rgb_color_correction& correction)
+{
+    std::lock_guard<std::mutex> lock(CorrectionMutex);
+
+    Correction = correction;
+
+    if((Correction.channel_order < 0) || (Correction.channel_order >= RGB_COLOR_ORDER_COUNT))
+    {
+        Correction.channel_order = RGB_COLOR_ORDER_RGB;
+    }
+
+    if(!(Correction.gamma > 0.0f))
+    {
+        Correction.gamma = 1.0f;
+    }
+
+    CorrectionUseLUT = rgb_color_correction_needs_lut(&Correction);
+
+    if(CorrectionUseLUT)
+    {
+        rgb_color_correction_build_lut(&CorrectionLUT, &Correction);
+    }
+
+    CorrectionEnabled = !rgb_color_correction_is_identity(&Correction);
+}
+
+unsigned char * RGBController::GetRateControlDescription()
+{
+    unsigned int            data_ptr    = 0;
+    unsigned int            data_size   = 0;
+    rgb_rate_control        rate;
+    unsigned char           enabled;
+
+    /*---------------------------------------------------------*\
+    | Serialize the local rate control, not the virtual getter  |
+    \*---------------------------------------------------------*/
+    RateControl.GetRateControl(&rate);
+
+    enabled = rate.enabled ? 1 : 0;
+
+    /*---------------------------------------------------------*\
+    | Calculate data size                                       |
+    \*---------------------------------------------------------*/
+    data_size += sizeof(data_size);
+    data_size += sizeof(enabled);
+    data_size += sizeof(rate.min_fps);
+    data_size += sizeof(rate.max_fps);
+    data_size += sizeof(rate.current_fps);
+    data_size += sizeof(rate.achieved_fps);
+    data_size += sizeof(rate.latency_us);
+    data_size += sizeof(rate.baseline_us);
+    data_size += sizeof(rate.decreases);
+    data_size += sizeof(rate.congestion_events);
+
+    /*---------------------------------------------------------*\
+    | Create data buffer                                        |
+    \*---------------------------------------------------------*/
+    unsigned char *data_buf = new unsigned char[data_size];
+
+    /*---------------------------------------------------------*\
+    | Copy in data size and enabled flag                        |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &data_size, sizeof(data_size));
+    data_ptr += sizeof(data_size);
+
+    memcpy(&data_buf[data_ptr], &enabled, sizeof(enabled));
+    data_ptr += sizeof(enabled);
+
+    /*---------------------------------------------------------*\
+    | Copy in rate limits and rates                             |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &rate.min_fps, sizeof(rate.min_fps));
+    data_ptr += sizeof(rate.min_fps);
+
+    memcpy(&data_buf[data_ptr], &rate.max_fps, sizeof(rate.max_fps));
+    data_ptr += sizeof(rate.max_fps);
+
+    memcpy(&data_buf[data_ptr], &rate.current_fps, sizeof(rate.current_fps));
+    data_ptr += sizeof(rate.current_fps);
+
+    memcpy(&data_buf[data_ptr], &rate.achieved_fps, sizeof(rate.achieved_fps));
+    data_ptr += sizeof(rate.achieved_fps);
+
+    /*---------------------------------------------------------*\
+    | Copy in latency and counters                              |
+    \*---------------------------------------------------------*/
+    memcpy(&data_buf[data_ptr], &rate.latency_us, sizeof(rate.latency_us));
+    data_ptr += sizeof(rate.latency_us);
+
+    memcpy(&data_buf[data_ptr], &rate.baseline_us, sizeof(rate.baseline_us));
+    data_ptr += sizeof(rate.baseline_us);
+
+    memcpy(&data_buf[data_ptr], &rate.decreases, sizeof(rate.decreases));
+    data_ptr += sizeof(rate.decreases);
+
+    memcpy(&data_buf[data_ptr], &rate.congestion_events, sizeof(rate.congestion_events));
+    data_ptr += sizeof(rate.congestion_events);
+
+    return(data_buf);
+}
+
+void RGBController::ReadRateControlDescription(unsigned char* data_buf, rgb_rate_control* rate)
+{
+    unsigned int    data_ptr = sizeof(unsigned int);
+    unsigned char   enabled;
+
+    /*---------------------------------------------------------*\
+    | Copy out enabled flag                                     |
+    \*---------------------------------------------------------*/
+    memcpy(&enabled, &data_buf[data_ptr], sizeof(enabled));
+    data_ptr += sizeof(enabled);
+
+    rate->enabled = (enabled != 0);
+
+    /*---------------------------------------------------------*\
+    | Copy out rate limits and rates                            |
+    \*---------------------------------------------------------*/
+    memcpy(&rate->min_fps, &data_buf[data_ptr], sizeof(rate->min_fps));
+    data_ptr += sizeof(rate->min_fps);
+
+    memcpy(&rate->max_fps, &data_buf[data_ptr], sizeof(rate->max_fps));
+    data_ptr += sizeof(rate->max_fps);
+
+    memcpy(&rate->current_fps, &data_buf[data_ptr], sizeof(rate->current_fps));
+    data_ptr += sizeof(rate->current_fps);
+
+    memcpy(&rate->achieved_fps, &data_buf[data_ptr], sizeof(rate->achieved_fps));
+    data_ptr += sizeof(rate->achieved_fps);
+
+    /*---------------------------------------------------------*\
+    | Copy out latency and counters                             |
+    \*---------------------------------------------------------*/
+    memcpy(&rate->latency_us, &data_buf[data_ptr], sizeof(rate->latency_us));
+    data_ptr += sizeof(rate->latency_us);
+
+    memcpy(&rate->baseline_us, &data_buf[data_ptr], sizeof(rate->baseline_us));
+    data_ptr += sizeof(rate->baseline_us);
+
+    memcpy(&rate->decreases, &data_buf[data_ptr], sizeof(rate->decreases));
+    data_ptr += sizeof(rate->decreases);
+
+    memcpy(&rate->congestion_events, &data_buf[data_ptr], sizeof(rate->congestion_events));
+    data_ptr += sizeof(rate->congestion_events);
+}
+
+void RGBController::GetRateControl(rgb_rate_control* rate)
+{
+    RateControl.GetRateControl(rate);
+}
+
+void RGBController::SetRateControlLimits(bool enabled, float min_fps, float max_fps)
+{
+    RateControl.SetLimits(enabled, min_fps, max_fps);
+}
+
+/*---------------------------------------------------------*\
+| Controller whose device thread is the calling thread, set |
+| by DeviceCallThreadFunction() itself so no other thread   |
+| ever writes it                                            |
+\*---------------------------------------------------------*/
+static thread_local RGBController* device_thread_controller = NULL;
+
+/*---------------------------------------------------------*\
+| Copy colors into CorrectionFrame, a buffer of its own,    |
+| applying the correction if enabled and leaving colors to  |
+| the clients.  Drivers that set                            |
+| CONTROLLER_FLAG_OUTPUT_COLORS read it through             |
+| GetOutputColors() in DeviceUpdateLEDs().                  |
+\*---------------------------------------------------------*/
+bool RGBController::SnapshotOutputColors()
+{
+    if(!(flags & CONTROLLER_FLAG_OUTPUT_COLORS))
+    {
+        return(false);
+    }
+
+    std::lock_guard<std::mutex> lock(CorrectionMutex);
+
+    std::size_t num_colors = colors.size();
+
+    if(num_colors == 0)
+    {
+        return(false);
+    }
+
+    CorrectionFrame.resize(num_colors);
+
+    if(!CorrectionEnabled.load())
+    {
+        std::copy(colors.begin(), colors.end(), CorrectionFrame.begin());
+    }
+    else if(CorrectionUseLUT)
+    {
+        rgb_color_correct_lut(colors.data(), (unsigned int)num_colors, CorrectionFrame.data(), Correction.channel_order, &CorrectionLUT);
+    }
+    else
+    {
+        rgb_color_correct(colors.data(), (unsigned int)num_colors, CorrectionFrame.data(), Correction.channel_order, Correction.brightness);
+    }
+
+    return(true);
+}
+
+const std::vector<RGBColor>& RGBController::GetOutputColors()
+{
+    /*---------------------------------------------------------*\
+    | The corrected frame only belongs to the update the device |
+    | thread is running, any other caller gets colors           |
+    \*---------------------------------------------------------*/
+    if(CorrectionApplied && (device_thread_controller == this))
+    {
+        return(CorrectionFrame);
+    }
+
+    return(colors);
+}
+
 void RGBController::SetupColors()
 {
     unsigned int total_led_count;
@@ -1960,6 +2484,39 @@ unsigned int RGBController::GetLEDsInZone(unsigned int zone)
     return(leds_count);
 }
 
+/*---------------------------------------------------------*\
+| Zone views are computed from the zone's start index and   |
+| LED count against the controller's leds/colors vectors,   |
+| clamped to the vector size so a zone whose counts are out |
+| of step with the buffers yields a short or empty view     |
+| instead of an out of bounds pointer.                      |
+\*---------------------------------------------------------*/
+rgb_span<led> RGBController::GetZoneLEDs(unsigned int zone)
+{
+    if(zone >= zones.size() || zones[zone].start_idx >= leds.size())
+    {
+        return(rgb_span<led>());
+    }
+
+    std::size_t start_idx   = zones[zone].start_idx;
+    std::size_t count       = std::min((std::size_t)GetLEDsInZone(zone), leds.size() - start_idx);
+
+    return(rgb_span<led>(&leds[start_idx], count));
+}
+
+rgb_span<RGBColor> RGBController::GetZoneColors(unsigned int zone)
+{
+    if(zone >= zones.size() || zones[zone].start_idx >= colors.size())
+    {
+        return(rgb_span<RGBColor>());
+    }
+
+    std::size_t start_idx   = zones[zone].start_idx;
+    std::size_t count       = std::min((std::size_t)GetLEDsInZone(zone), colors.size() - start_idx);
+
+    return(rgb_span<RGBColor>(&colors[start_idx], count));
+}
+
 RGBColor RGBController::GetLED(unsigned int led)
 {
     if(led < colors.size())
@@ -1990,10 +2547,14 @@ void RGBController::SetAllLEDs(RGBColor color)
 
 void RGBController::SetAllZoneLEDs(int zone, RGBColor color)
 {
-    for (std::size_t color_idx = 0; color_idx < GetLEDsInZone(zone); color_idx++)
+    if(zone < 0)
     {
-        zones[zone].colors[color_idx] = color;
+        return;
     }
+
+    rgb_span<RGBColor> zone_colors = GetZoneColors((unsigned int)zone);
+
+    std::fill(zone_colors.begin(), zone_colors.end(), color);
 }
 
 int RGBController::GetMode()
@@ -2050,14 +2611,61 @@ void RGBController::SignalUpdate()
 }
 void RGBController::UpdateLEDs()
 {
+    Stats.RecordFrameRequested(CallFlag_UpdateLEDs.load());
+
     CallFlag_UpdateLEDs = true;
 
+    StartDeviceThread();
+    WakeDeviceThread();
+
     SignalUpdate();
 }
 
+void RGBController::UpdateLEDsCommitted(long long commit_us, long long tick_us)
+{
+    Stats.RecordFrameCommitted(commit_us, tick_us);
+
+    UpdateLEDs();
+}
+
+int RGBController::GetPrimaryTransport()
+{
+    return(Stats.GetPrimaryTransport());
+}
+
 void RGBController::UpdateMode()
 {
     CallFlag_UpdateMode = true;
+
+    StartDeviceThread();
+    WakeDeviceThread();
+}
+
+/*---------------------------------------------------------*\
+| Taking the mutex before notifying ensures the device      |
+| thread is either before its flag check or already         |
+| waiting, so the wakeup cannot be lost                     |
+\*---------------------------------------------------------*/
+void RGBController::WakeDeviceThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(DeviceCallMutex);
+    }
+
+    DeviceCallCondition.notify_one();
+}
+
+/*---------------------------------------------------------*\
+| The device thread is only started once an update is       |
+| requested, so controllers that only hold data (profile    |
+| contents, network client copies) never spawn one          |
+\*---------------------------------------------------------*/
+void RGBController::StartDeviceThread()
+{
+    std::call_once(DeviceThreadStarted, [this]()
+    {
+        DeviceCallThread = new std::thread(&RGBController::DeviceCallThreadFunction, this);
+    });
 }
 
 void RGBController::SaveMode()
@@ -2110,13 +2718,14 @@ void RGBController::DeviceUpdateMode()
 
 void RGBController::DeviceCallThreadFunction()
 {
-    CallFlag_UpdateLEDs = false;
-    CallFlag_UpdateMode = false;
+    device_thread_controller = this;
 
     while(DeviceThreadRunning.load() == true)
     {
         if(CallFlag_UpdateMode.load() == true)
         {
+            Stats.BeginModeUpdate();
+
             if(flags & CONTROLLER_FLAG_RESET_BEFORE_UPDATE)
             {
                 CallFlag_UpdateMode = false;
@@ -2127,23 +2736,78 @@ void RGBController::DeviceCallThreadFunction()
                 DeviceUpdateMode();
                 CallFlag_UpdateMode = false;
             }
+
+            Stats.EndModeUpdate();
         }
         if(CallFlag_UpdateLEDs.load() == true)
         {
+            /*---------------------------------------------*\
+            | Hold the frame back until the rate limit      |
+            | allows it.  UpdateLEDs() calls meanwhile are  |
+            | merged into it.  A mode update or shutdown    |
+            | ends the wait early.                          |
+            \*---------------------------------------------*/
+            long long delay_us = RateControl.GetFrameDelay(RGBControllerStats::NowMicroseconds());
+
+            if(delay_us > 0)
+            {
+                std::unique_lock<std::mutex> lock(DeviceCallMutex);
+
+                DeviceCallCondition.wait_for(lock, std::chrono::microseconds(delay_us), [this]()
+                {
+                    return(CallFlag_UpdateMode.load() || !DeviceThreadRunning.load());
+                });
+
+                continue;
+            }
+
+            unsigned long long writes = Stats.GetTransportWriteCount();
+
+            Stats.BeginDeviceUpdate();
+            RateControl.BeginDeviceUpdate(RGBControllerStats::NowMicroseconds());
+
             if(flags & CONTROLLER_FLAG_RESET_BEFORE_UPDATE)
             {
                 CallFlag_UpdateLEDs = false;
-                DeviceUpdateLEDs();
             }
-            else
+
+            /*---------------------------------------------*\
+            | Hold colors_mutex only while colors are       |
+            | copied to the output frame, so the device     |
+            | write never holds off the effects engine.     |
+            | Drivers without CONTROLLER_FLAG_OUTPUT_COLORS |
+            | read colors directly, unlocked.               |
+            \*---------------------------------------------*/
+            colors_mutex.lock();
+            CorrectionApplied = SnapshotOutputColors();
+            colors_mutex.unlock();
+
+            DeviceUpdateLEDs();
+
+            CorrectionApplied = false;
+
+            if(!(flags & CONTROLLER_FLAG_RESET_BEFORE_UPDATE))
             {
-                DeviceUpdateLEDs();
                 CallFlag_UpdateLEDs = false;
             }
+
+            RateControl.EndDeviceUpdate(RGBControllerStats::NowMicroseconds(), Stats.GetTransportWriteCount() - writes);
+            Stats.EndDeviceUpdate();
         }
         else
         {
-           std::this_thread::sleep_for(1ms);
+            /*---------------------------------------------*\
+            | Sleep until UpdateLEDs() or UpdateMode()      |
+            | wakes the thread so frames dispatched         |
+            | together by the frame clock start together.   |
+            | The timeout only bounds shutdown latency.     |
+            \*---------------------------------------------*/
+            std::unique_lock<std::mutex> lock(DeviceCallMutex);
+
+            DeviceCallCondition.wait_for(lock, 100ms, [this]()
+            {
+                return(CallFlag_UpdateLEDs.load() || CallFlag_UpdateMode.load() || !DeviceThreadRunning.load());
+            });
         }
     }
 }
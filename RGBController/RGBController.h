@@ -17,7 +17,11 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include "RGBControllerColorFormat.h"
+#include "RGBControllerStats.h"
+#include "RGBControllerRateControl.h"
 
 /*------------------------------------------------------------------*\
 | RGB Color Type and Conversion Macros                               |
@@ -183,6 +187,31 @@ public:
     ~zone();
 };
 
+/*------------------------------------------------------------------*\
+| Span Template                                                      |
+|   Non-owning view of a contiguous range within the controller's    |
+|   leds or colors vector.  Views are invalidated whenever those     |
+|   vectors are resized, the same as the zone leds/colors pointers.  |
+\*------------------------------------------------------------------*/
+template<typename T>
+class rgb_span
+{
+public:
+    rgb_span() : data_ptr(NULL), data_count(0) {}
+    rgb_span(T* data, std::size_t count) : data_ptr(data), data_count(count) {}
+
+    T*                      begin() const                       { return(data_ptr);                 }
+    T*                      end() const                         { return(data_ptr + data_count);    }
+    T*                      data() const                        { return(data_ptr);                 }
+    std::size_t             size() const                        { return(data_count);               }
+    bool                    empty() const                       { return(data_count == 0);          }
+    T&                      operator[](std::size_t idx) const   { return(data_ptr[idx]);            }
+
+private:
+    T*                      data_ptr;
+    std::size_t             data_count;
+};
+
 /*------------------------------------------------------------------*\
 | Device Types                                                       |
 |   The enum order should be maintained as is for the API however    |
@@ -228,6 +257,10 @@ enum
 
     CONTROLLER_FLAG_RESET_BEFORE_UPDATE = (1 << 8), /* Device resets update flag before */
                                                     /* calling update function          */
+    CONTROLLER_FLAG_ADAPTIVE_RATE       = (1 << 9), /* Device link may not keep up with */
+                                                    /* frames, enable rate control      */
+    CONTROLLER_FLAG_OUTPUT_COLORS       = (1 << 10),/* Device reads GetOutputColors(),  */
+                                                    /* color correction applies         */
 };
 
 /*------------------------------------------------------------------*\
@@ -309,6 +342,13 @@ public:
     virtual void            DeviceSaveMode()                                                                    = 0;
 
     virtual void            SetCustomMode()                                                                     = 0;
+
+    virtual void            GetStats(rgb_controller_stats* stats)                                               = 0;
+
+    virtual void            GetColorCorrection(rgb_color_correction* correction)                                = 0;
+    virtual void            SetColorCorrection(const rgb_color_correction& correction)                          = 0;
+
+    virtual void            GetRateControl(rgb_rate_control* rate)                                              = 0;
 };
 
 class RGBController : public RGBControllerInterface
@@ -329,6 +369,7 @@ public:
     std::vector<std::string>
                             led_alt_names;  /* alternate LED names      */
     unsigned int            flags;          /* controller flags         */
+    std::mutex              colors_mutex;   /* color buffer update lock */
 
     /*---------------------------------------------------------*\
     | RGBController base class constructor                      |
@@ -353,6 +394,9 @@ public:
     std::string             GetZoneName(unsigned int zone);
     std::string             GetLEDName(unsigned int led);
 
+    rgb_span<led>           GetZoneLEDs(unsigned int zone);
+    rgb_span<RGBColor>      GetZoneColors(unsigned int zone);
+
     RGBColor                GetLED(unsigned int led);
     void                    SetLED(unsigned int led, RGBColor color);
     void                    SetAllLEDs(RGBColor color);
@@ -379,12 +423,34 @@ public:
     unsigned char *         GetSegmentDescription(int zone, segment new_segment);
     void                    SetSegmentDescription(unsigned char* data_buf);
 
+    unsigned char *         GetStatsDescription();
+    void                    ReadStatsDescription(unsigned char* data_buf, rgb_controller_stats* stats);
+
+    virtual void            GetStats(rgb_controller_stats* stats);
+    void                    ResetStats();
+    int                     GetPrimaryTransport();
+
+    unsigned char *         GetColorCorrectionDescription();
+    void                    ReadColorCorrectionDescription(unsigned char* data_buf, rgb_color_correction* correction);
+
+    virtual void            GetColorCorrection(rgb_color_correction* correction);
+    virtual void            SetColorCorrection(const rgb_color_correction& correction);
+
+    const std::vector<RGBColor>& GetOutputColors();
+
+    unsigned char *         GetRateControlDescription();
+    void                    ReadRateControlDescription(unsigned char* data_buf, rgb_rate_control* rate);
+
+    virtual void            GetRateControl(rgb_rate_control* rate);
+    void                    SetRateControlLimits(bool enabled, float min_fps, float max_fps);
+
     void                    RegisterUpdateCallback(RGBControllerCallback new_callback, void * new_callback_arg);
     void                    UnregisterUpdateCallback(void * callback_arg);
     void                    ClearCallbacks();
     void                    SignalUpdate();
 
     void                    UpdateLEDs();
+    void                    UpdateLEDsCommitted(long long commit_us, long long tick_us);
     //void                    UpdateZoneLEDs(int zone);
     //void                    UpdateSingleLED(int led);
 
@@ -414,9 +480,12 @@ public:
 
 private:
     std::thread*            DeviceCallThread;
+    std::once_flag          DeviceThreadStarted;
     std::atomic<bool>       CallFlag_UpdateLEDs;
     std::atomic<bool>       CallFlag_UpdateMode;
     std::atomic<bool>       DeviceThreadRunning;
+    std::mutex              DeviceCallMutex;
+    std::condition_variable DeviceCallCondition;
     //bool                    CallFlag_UpdateZoneLEDs                     = false;
     //bool                    CallFlag_UpdateSingleLED                    = false;
     //bool                    CallFlag_UpdateMode                         = false;
@@ -424,4 +493,26 @@ private:
     std::mutex                          UpdateMutex;
     std::vector<RGBControllerCallback>  UpdateCallbacks;
     std::vector<void *>                 UpdateCallbackArgs;
+
+    RGBControllerStats                  Stats;
+    RGBControllerRateControl            RateControl;
+
+    /*---------------------------------------------------------*\
+    | Output color correction.  CorrectionFrame holds the       |
+    | output colors, corrected if enabled, while                |
+    | CorrectionApplied is set, during the device thread's      |
+    | DeviceUpdateLEDs() call.                                  |
+    \*---------------------------------------------------------*/
+    std::mutex                          CorrectionMutex;
+    rgb_color_correction                Correction;
+    rgb_color_lut                       CorrectionLUT;
+    bool                                CorrectionUseLUT;
+    std::atomic<bool>                   CorrectionEnabled;
+    std::atomic<bool>                   CorrectionApplied;
+    std::vector<RGBColor>               CorrectionFrame;
+
+    void                    StartDeviceThread();
+    void                    WakeDeviceThread();
+
+    bool                    SnapshotOutputColors();
 };
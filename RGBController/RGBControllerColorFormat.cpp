@@ -0,0 +1,684 @@
+/*---------------------------------------------------------*\
+| RGBControllerColorFormat.cpp                              |
+|                                                           |
+|   Shared conversion kernels between RGBColor buffers and  |
+|   packed 3 byte per LED device channel orders             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <cmath>
+#include <cstring>
+#include "RGBControllerColorFormat.h"
+
+/*---------------------------------------------------------*\
+| Kernel selection                                          |
+|   x86 uses SSSE3 byte shuffles.  SSE2 alone has no byte   |
+|   shuffle and AVX2 shuffles cannot cross 128-bit lanes,   |
+|   so 12 byte groups gain nothing from the wider vectors.  |
+|   GCC/Clang builds that do not target SSSE3 compile the   |
+|   kernel with a target attribute and check the CPU at     |
+|   runtime, MSVC checks CPUID.  ARM uses NEON interleaved  |
+|   loads and stores.  Everything else is scalar.           |
+\*---------------------------------------------------------*/
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define RGB_COLOR_FORMAT_X86
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RGB_COLOR_FORMAT_SSSE3_TARGET
+#elif defined(__SSSE3__)
+#define RGB_COLOR_FORMAT_SSSE3_TARGET
+#else
+#define RGB_COLOR_FORMAT_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RGB_COLOR_FORMAT_NEON
+#include <arm_neon.h>
+#endif
+
+/*---------------------------------------------------------*\
+| Source channel (0 = R, 1 = G, 2 = B) for each packed byte |
+\*---------------------------------------------------------*/
+const unsigned char rgb_color_order_channels[RGB_COLOR_ORDER_COUNT][3] =
+{
+    { 0, 1, 2 },    /* RGB */
+    { 0, 2, 1 },    /* RBG */
+    { 1, 0, 2 },    /* GRB */
+    { 1, 2, 0 },    /* GBR */
+    { 2, 0, 1 },    /* BRG */
+    { 2, 1, 0 },    /* BGR */
+};
+
+static const char* order_names[RGB_COLOR_ORDER_COUNT] =
+{
+    "RGB",
+    "RBG",
+    "GRB",
+    "GBR",
+    "BRG",
+    "BGR",
+};
+
+const char* rgb_color_order_to_str(int order)
+{
+    if((order < 0) || (order >= RGB_COLOR_ORDER_COUNT))
+    {
+        return("Unknown");
+    }
+
+    return(order_names[order]);
+}
+
+int rgb_color_order_from_str(const char* str)
+{
+    for(int order = 0; order < RGB_COLOR_ORDER_COUNT; order++)
+    {
+        if(strcmp(str, order_names[order]) == 0)
+        {
+            return(order);
+        }
+    }
+
+    return(-1);
+}
+
+static inline unsigned char scale_channel(unsigned int value, unsigned int scale)
+{
+    return((unsigned char)((value * scale) >> 8));
+}
+
+/*---------------------------------------------------------*\
+| Scalar kernels, also used for the tail of SIMD kernels.   |
+|   The channel order is a template parameter so each order |
+|   compiles to straight byte moves like a hand-written     |
+|   driver loop.                                            |
+\*---------------------------------------------------------*/
+template<unsigned int C0, unsigned int C1, unsigned int C2>
+static void pack_scalar_order(const RGBColor* colors, unsigned int count, unsigned char* out, unsigned int scale)
+{
+    for(unsigned int color_idx = 0; color_idx < count; color_idx++)
+    {
+        RGBColor color = colors[color_idx];
+
+        out[0] = scale_channel((color >> (C0 * 8)) & 0xFF, scale);
+        out[1] = scale_channel((color >> (C1 * 8)) & 0xFF, scale);
+        out[2] = scale_channel((color >> (C2 * 8)) & 0xFF, scale);
+
+        out += 3;
+    }
+}
+
+template<unsigned int C0, unsigned int C1, unsigned int C2>
+static void unpack_scalar_order(const unsigned char* in, unsigned int count, RGBColor* colors)
+{
+    for(unsigned int color_idx = 0; color_idx < count; color_idx++)
+    {
+        colors[color_idx] = ((RGBColor)in[0] << (C0 * 8))
+                          | ((RGBColor)in[1] << (C1 * 8))
+                          | ((RGBColor)in[2] << (C2 * 8));
+
+        in += 3;
+    }
+}
+
+template<unsigned int C0, unsigned int C1, unsigned int C2>
+static void pack_lut_order(const RGBColor* colors, unsigned int count, unsigned char* out, const rgb_color_lut* lut)
+{
+    const unsigned char* tables[3] = { lut->r, lut->g, lut->b };
+
+    for(unsigned int color_idx = 0; color_idx < count; color_idx++)
+    {
+        RGBColor color = colors[color_idx];
+
+        out[0] = tables[C0][(color >> (C0 * 8)) & 0xFF];
+        out[1] = tables[C1][(color >> (C1 * 8)) & 0xFF];
+        out[2] = tables[C2][(color >> (C2 * 8)) & 0xFF];
+
+        out += 3;
+    }
+}
+
+static void pack_scalar(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned int scale)
+{
+    switch(order)
+    {
+    case RGB_COLOR_ORDER_RGB:
+        pack_scalar_order<0, 1, 2>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_RBG:
+        pack_scalar_order<0, 2, 1>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_GRB:
+        pack_scalar_order<1, 0, 2>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_GBR:
+        pack_scalar_order<1, 2, 0>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_BRG:
+        pack_scalar_order<2, 0, 1>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_BGR:
+        pack_scalar_order<2, 1, 0>(colors, count, out, scale);
+        break;
+    }
+}
+
+static void unpack_scalar(const unsigned char* in, unsigned int count, RGBColor* colors, int order)
+{
+    switch(order)
+    {
+    case RGB_COLOR_ORDER_RGB:
+        unpack_scalar_order<0, 1, 2>(in, count, colors);
+        break;
+    case RGB_COLOR_ORDER_RBG:
+        unpack_scalar_order<0, 2, 1>(in, count, colors);
+        break;
+    case RGB_COLOR_ORDER_GRB:
+        unpack_scalar_order<1, 0, 2>(in, count, colors);
+        break;
+    case RGB_COLOR_ORDER_GBR:
+        unpack_scalar_order<1, 2, 0>(in, count, colors);
+        break;
+    case RGB_COLOR_ORDER_BRG:
+        unpack_scalar_order<2, 0, 1>(in, count, colors);
+        break;
+    case RGB_COLOR_ORDER_BGR:
+        unpack_scalar_order<2, 1, 0>(in, count, colors);
+        break;
+    }
+}
+
+template<unsigned int C0, unsigned int C1, unsigned int C2>
+static void correct_scalar_order(const RGBColor* colors, unsigned int count, RGBColor* out, unsigned int scale)
+{
+    for(unsigned int color_idx = 0; color_idx < count; color_idx++)
+    {
+        RGBColor color = colors[color_idx];
+
+        out[color_idx] = ((RGBColor)scale_channel((color >> (C0 * 8)) & 0xFF, scale))
+                       | ((RGBColor)scale_channel((color >> (C1 * 8)) & 0xFF, scale) << 8)
+                       | ((RGBColor)scale_channel((color >> (C2 * 8)) & 0xFF, scale) << 16);
+    }
+}
+
+template<unsigned int C0, unsigned int C1, unsigned int C2>
+static void correct_lut_order(const RGBColor* colors, unsigned int count, RGBColor* out, const rgb_color_lut* lut)
+{
+    const unsigned char* tables[3] = { lut->r, lut->g, lut->b };
+
+    for(unsigned int color_idx = 0; color_idx < count; color_idx++)
+    {
+        RGBColor color = colors[color_idx];
+
+        out[color_idx] = ((RGBColor)tables[C0][(color >> (C0 * 8)) & 0xFF])
+                       | ((RGBColor)tables[C1][(color >> (C1 * 8)) & 0xFF] << 8)
+                       | ((RGBColor)tables[C2][(color >> (C2 * 8)) & 0xFF] << 16);
+    }
+}
+
+static void correct_scalar(const RGBColor* colors, unsigned int count, RGBColor* out, int order, unsigned int scale)
+{
+    switch(order)
+    {
+    case RGB_COLOR_ORDER_RGB:
+        correct_scalar_order<0, 1, 2>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_RBG:
+        correct_scalar_order<0, 2, 1>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_GRB:
+        correct_scalar_order<1, 0, 2>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_GBR:
+        correct_scalar_order<1, 2, 0>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_BRG:
+        correct_scalar_order<2, 0, 1>(colors, count, out, scale);
+        break;
+    case RGB_COLOR_ORDER_BGR:
+        correct_scalar_order<2, 1, 0>(colors, count, out, scale);
+        break;
+    }
+}
+
+#ifdef RGB_COLOR_FORMAT_X86
+/*---------------------------------------------------------*\
+| SSSE3 kernels                                             |
+|   One iteration converts 4 LEDs (16 bytes of RGBColor to  |
+|   12 packed bytes or back).  Loads and stores are 16      |
+|   bytes wide, so the loop stops while at least 6 LEDs     |
+|   remain and the scalar kernel finishes the tail.         |
+\*---------------------------------------------------------*/
+RGB_COLOR_FORMAT_SSSE3_TARGET
+static unsigned int pack_ssse3(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned int scale)
+{
+    const unsigned char*    ch      = rgb_color_order_channels[order];
+    char                    mask[16];
+
+    for(unsigned int byte_idx = 0; byte_idx < 16; byte_idx++)
+    {
+        mask[byte_idx] = (char)0x80;
+    }
+
+    for(unsigned int pixel_idx = 0; pixel_idx < 4; pixel_idx++)
+    {
+        for(unsigned int byte_idx = 0; byte_idx < 3; byte_idx++)
+        {
+            mask[(pixel_idx * 3) + byte_idx] = (char)((pixel_idx * 4) + ch[byte_idx]);
+        }
+    }
+
+    __m128i shuffle = _mm_loadu_si128((const __m128i*)mask);
+    __m128i factor  = _mm_set1_epi16((short)scale);
+    __m128i zero    = _mm_setzero_si128();
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 6; color_idx += 4)
+    {
+        __m128i data = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&colors[color_idx]), shuffle);
+
+        if(scale != 256)
+        {
+            __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(data, zero), factor), 8);
+            __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(data, zero), factor), 8);
+
+            data = _mm_packus_epi16(lo, hi);
+        }
+
+        _mm_storeu_si128((__m128i*)&out[color_idx * 3], data);
+    }
+
+    return(color_idx);
+}
+
+RGB_COLOR_FORMAT_SSSE3_TARGET
+static unsigned int unpack_ssse3(const unsigned char* in, unsigned int count, RGBColor* colors, int order)
+{
+    const unsigned char*    ch      = rgb_color_order_channels[order];
+    char                    mask[16];
+
+    for(unsigned int pixel_idx = 0; pixel_idx < 4; pixel_idx++)
+    {
+        for(unsigned int byte_idx = 0; byte_idx < 3; byte_idx++)
+        {
+            mask[(pixel_idx * 4) + ch[byte_idx]] = (char)((pixel_idx * 3) + byte_idx);
+        }
+
+        mask[(pixel_idx * 4) + 3] = (char)0x80;
+    }
+
+    __m128i shuffle = _mm_loadu_si128((const __m128i*)mask);
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 6; color_idx += 4)
+    {
+        __m128i data = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[color_idx * 3]), shuffle);
+
+        _mm_storeu_si128((__m128i*)&colors[color_idx], data);
+    }
+
+    return(color_idx);
+}
+
+RGB_COLOR_FORMAT_SSSE3_TARGET
+static unsigned int correct_ssse3(const RGBColor* colors, unsigned int count, RGBColor* out, int order, unsigned int scale)
+{
+    const unsigned char*    ch      = rgb_color_order_channels[order];
+    char                    mask[16];
+
+    for(unsigned int pixel_idx = 0; pixel_idx < 4; pixel_idx++)
+    {
+        for(unsigned int byte_idx = 0; byte_idx < 3; byte_idx++)
+        {
+            mask[(pixel_idx * 4) + byte_idx] = (char)((pixel_idx * 4) + ch[byte_idx]);
+        }
+
+        mask[(pixel_idx * 4) + 3] = (char)0x80;
+    }
+
+    __m128i shuffle = _mm_loadu_si128((const __m128i*)mask);
+    __m128i factor  = _mm_set1_epi16((short)scale);
+    __m128i zero    = _mm_setzero_si128();
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 4; color_idx += 4)
+    {
+        __m128i data = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&colors[color_idx]), shuffle);
+
+        if(scale != 256)
+        {
+            __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(data, zero), factor), 8);
+            __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(data, zero), factor), 8);
+
+            data = _mm_packus_epi16(lo, hi);
+        }
+
+        _mm_storeu_si128((__m128i*)&out[color_idx], data);
+    }
+
+    return(color_idx);
+}
+
+static bool cpu_has_ssse3()
+{
+#if defined(__SSSE3__)
+    return(true);
+#elif defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 1);
+
+    return((info[2] & (1 << 9)) != 0);
+#else
+    __builtin_cpu_init();
+
+    return(__builtin_cpu_supports("ssse3"));
+#endif
+}
+
+static const bool use_ssse3 = cpu_has_ssse3();
+#endif
+
+#ifdef RGB_COLOR_FORMAT_NEON
+/*---------------------------------------------------------*\
+| NEON kernels                                              |
+|   vld4/vst3 deinterleave 16 LEDs into channel planes and  |
+|   reinterleave them in the requested order                |
+\*---------------------------------------------------------*/
+static unsigned int pack_neon(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned int scale)
+{
+    const unsigned char*    ch      = rgb_color_order_channels[order];
+    uint8x8_t               factor  = vdup_n_u8((uint8_t)(scale - 1));
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 16; color_idx += 16)
+    {
+        uint8x16x4_t    src = vld4q_u8((const uint8_t*)&colors[color_idx]);
+        uint8x16x3_t    dst;
+
+        dst.val[0] = src.val[ch[0]];
+        dst.val[1] = src.val[ch[1]];
+        dst.val[2] = src.val[ch[2]];
+
+        if(scale != 256)
+        {
+            /*---------------------------------------------*\
+            | (value * scale) >> 8 with scale = factor + 1  |
+            | is (value * factor + value) >> 8              |
+            \*---------------------------------------------*/
+            for(unsigned int plane_idx = 0; plane_idx < 3; plane_idx++)
+            {
+                uint16x8_t lo = vmlal_u8(vmovl_u8(vget_low_u8(dst.val[plane_idx])), vget_low_u8(dst.val[plane_idx]), factor);
+                uint16x8_t hi = vmlal_u8(vmovl_u8(vget_high_u8(dst.val[plane_idx])), vget_high_u8(dst.val[plane_idx]), factor);
+
+                dst.val[plane_idx] = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+            }
+        }
+
+        vst3q_u8(&out[color_idx * 3], dst);
+    }
+
+    return(color_idx);
+}
+
+static unsigned int unpack_neon(const unsigned char* in, unsigned int count, RGBColor* colors, int order)
+{
+    const unsigned char* ch = rgb_color_order_channels[order];
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 16; color_idx += 16)
+    {
+        uint8x16x3_t    src = vld3q_u8(&in[color_idx * 3]);
+        uint8x16x4_t    dst;
+
+        dst.val[ch[0]] = src.val[0];
+        dst.val[ch[1]] = src.val[1];
+        dst.val[ch[2]] = src.val[2];
+        dst.val[3]     = vdupq_n_u8(0);
+
+        vst4q_u8((uint8_t*)&colors[color_idx], dst);
+    }
+
+    return(color_idx);
+}
+
+static unsigned int correct_neon(const RGBColor* colors, unsigned int count, RGBColor* out, int order, unsigned int scale)
+{
+    const unsigned char*    ch      = rgb_color_order_channels[order];
+    uint8x8_t               factor  = vdup_n_u8((uint8_t)(scale - 1));
+
+    unsigned int color_idx = 0;
+
+    for(; (count - color_idx) >= 16; color_idx += 16)
+    {
+        uint8x16x4_t    src = vld4q_u8((const uint8_t*)&colors[color_idx]);
+        uint8x16x4_t    dst;
+
+        dst.val[0] = src.val[ch[0]];
+        dst.val[1] = src.val[ch[1]];
+        dst.val[2] = src.val[ch[2]];
+        dst.val[3] = vdupq_n_u8(0);
+
+        if(scale != 256)
+        {
+            for(unsigned int plane_idx = 0; plane_idx < 3; plane_idx++)
+            {
+                uint16x8_t lo = vmlal_u8(vmovl_u8(vget_low_u8(dst.val[plane_idx])), vget_low_u8(dst.val[plane_idx]), factor);
+                uint16x8_t hi = vmlal_u8(vmovl_u8(vget_high_u8(dst.val[plane_idx])), vget_high_u8(dst.val[plane_idx]), factor);
+
+                dst.val[plane_idx] = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+            }
+        }
+
+        vst4q_u8((uint8_t*)&out[color_idx], dst);
+    }
+
+    return(color_idx);
+}
+#endif
+
+static void pack(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned int scale)
+{
+    unsigned int done = 0;
+
+    if((order < 0) || (order >= RGB_COLOR_ORDER_COUNT))
+    {
+        order = RGB_COLOR_ORDER_RGB;
+    }
+
+#ifdef RGB_COLOR_FORMAT_X86
+    if(use_ssse3)
+    {
+        done = pack_ssse3(colors, count, out, order, scale);
+    }
+#elif defined(RGB_COLOR_FORMAT_NEON)
+    done = pack_neon(colors, count, out, order, scale);
+#endif
+
+    pack_scalar(&colors[done], count - done, &out[done * 3], order, scale);
+}
+
+void rgb_color_pack(const RGBColor* colors, unsigned int count, unsigned char* out, int order)
+{
+    pack(colors, count, out, order, 256);
+}
+
+void rgb_color_pack_scaled(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned char brightness)
+{
+    pack(colors, count, out, order, (unsigned int)brightness + 1);
+}
+
+/*---------------------------------------------------------*\
+| Table lookups do not vectorize on SSE/NEON (no byte       |
+| gather), so the LUT kernel is scalar.  It is still a      |
+| single pass with no per-channel branching.                |
+\*---------------------------------------------------------*/
+void rgb_color_pack_lut(const RGBColor* colors, unsigned int count, unsigned char* out, int order, const rgb_color_lut* lut)
+{
+    switch(order)
+    {
+    case RGB_COLOR_ORDER_RBG:
+        pack_lut_order<0, 2, 1>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_GRB:
+        pack_lut_order<1, 0, 2>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_GBR:
+        pack_lut_order<1, 2, 0>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_BRG:
+        pack_lut_order<2, 0, 1>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_BGR:
+        pack_lut_order<2, 1, 0>(colors, count, out, lut);
+        break;
+    default:
+        pack_lut_order<0, 1, 2>(colors, count, out, lut);
+        break;
+    }
+}
+
+void rgb_color_unpack(const unsigned char* in, unsigned int count, RGBColor* colors, int order)
+{
+    unsigned int done = 0;
+
+    if((order < 0) || (order >= RGB_COLOR_ORDER_COUNT))
+    {
+        order = RGB_COLOR_ORDER_RGB;
+    }
+
+#ifdef RGB_COLOR_FORMAT_X86
+    if(use_ssse3)
+    {
+        done = unpack_ssse3(in, count, colors, order);
+    }
+#elif defined(RGB_COLOR_FORMAT_NEON)
+    done = unpack_neon(in, count, colors, order);
+#endif
+
+    unpack_scalar(&in[done * 3], count - done, &colors[done], order);
+}
+
+void rgb_color_correct(const RGBColor* colors, unsigned int count, RGBColor* out, int order, unsigned char brightness)
+{
+    unsigned int done  = 0;
+    unsigned int scale = (unsigned int)brightness + 1;
+
+    if((order < 0) || (order >= RGB_COLOR_ORDER_COUNT))
+    {
+        order = RGB_COLOR_ORDER_RGB;
+    }
+
+#ifdef RGB_COLOR_FORMAT_X86
+    if(use_ssse3)
+    {
+        done = correct_ssse3(colors, count, out, order, scale);
+    }
+#elif defined(RGB_COLOR_FORMAT_NEON)
+    done = correct_neon(colors, count, out, order, scale);
+#endif
+
+    correct_scalar(&colors[done], count - done, &out[done], order, scale);
+}
+
+void rgb_color_correct_lut(const RGBColor* colors, unsigned int count, RGBColor* out, int order, const rgb_color_lut* lut)
+{
+    switch(order)
+    {
+    case RGB_COLOR_ORDER_RBG:
+        correct_lut_order<0, 2, 1>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_GRB:
+        correct_lut_order<1, 0, 2>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_GBR:
+        correct_lut_order<1, 2, 0>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_BRG:
+        correct_lut_order<2, 0, 1>(colors, count, out, lut);
+        break;
+    case RGB_COLOR_ORDER_BGR:
+        correct_lut_order<2, 1, 0>(colors, count, out, lut);
+        break;
+    default:
+        correct_lut_order<0, 1, 2>(colors, count, out, lut);
+        break;
+    }
+}
+
+void rgb_color_build_lut(rgb_color_lut* lut, unsigned char brightness, float gamma)
+{
+    rgb_color_correction correction;
+
+    rgb_color_correction_init(&correction);
+
+    correction.brightness   = brightness;
+    correction.gamma        = gamma;
+
+    rgb_color_correction_build_lut(lut, &correction);
+}
+
+void rgb_color_correction_init(rgb_color_correction* correction)
+{
+    correction->brightness          = 255;
+    correction->white_balance[0]    = 255;
+    correction->white_balance[1]    = 255;
+    correction->white_balance[2]    = 255;
+    correction->gamma               = 1.0f;
+    correction->channel_order       = RGB_COLOR_ORDER_RGB;
+}
+
+bool rgb_color_correction_needs_lut(const rgb_color_correction* correction)
+{
+    return((correction->gamma != 1.0f)
+        || (correction->white_balance[0] != 255)
+        || (correction->white_balance[1] != 255)
+        || (correction->white_balance[2] != 255));
+}
+
+bool rgb_color_correction_is_identity(const rgb_color_correction* correction)
+{
+    return((correction->brightness == 255)
+        && (correction->channel_order == RGB_COLOR_ORDER_RGB)
+        && !rgb_color_correction_needs_lut(correction));
+}
+
+/*---------------------------------------------------------*\
+| Each channel is scaled by brightness, then by its white   |
+| balance gain, then mapped through the gamma curve         |
+\*---------------------------------------------------------*/
+void rgb_color_correction_build_lut(rgb_color_lut* lut, const rgb_color_correction* correction)
+{
+    unsigned char*  tables[3]   = { lut->r, lut->g, lut->b };
+    unsigned int    scale       = (unsigned int)correction->brightness + 1;
+    float           gamma       = correction->gamma;
+
+    if(!(gamma > 0.0f))
+    {
+        gamma = 1.0f;
+    }
+
+    for(unsigned int channel_idx = 0; channel_idx < 3; channel_idx++)
+    {
+        unsigned int gain = (unsigned int)correction->white_balance[channel_idx] + 1;
+
+        for(unsigned int value = 0; value < 256; value++)
+        {
+            unsigned char scaled = scale_channel(scale_channel(value, scale), gain);
+
+            if(gamma != 1.0f)
+            {
+                scaled = (unsigned char)lroundf(powf(scaled / 255.0f, gamma) * 255.0f);
+            }
+
+            tables[channel_idx][value] = scaled;
+        }
+    }
+}
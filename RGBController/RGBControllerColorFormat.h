@@ -0,0 +1,104 @@
+/*---------------------------------------------------------*\
+| RGBControllerColorFormat.h                                |
+|                                                           |
+|   Shared conversion kernels between RGBColor buffers and  |
+|   packed 3 byte per LED device channel orders             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+/*------------------------------------------------------------------*\
+| Same type as RGBController.h, which includes this header           |
+\*------------------------------------------------------------------*/
+typedef unsigned int RGBColor;
+
+/*------------------------------------------------------------------*\
+| Channel Orders                                                     |
+|   Byte order of one LED in the packed device buffer                |
+\*------------------------------------------------------------------*/
+enum
+{
+    RGB_COLOR_ORDER_RGB                 = 0,
+    RGB_COLOR_ORDER_RBG                 = 1,
+    RGB_COLOR_ORDER_GRB                 = 2,
+    RGB_COLOR_ORDER_GBR                 = 3,
+    RGB_COLOR_ORDER_BRG                 = 4,
+    RGB_COLOR_ORDER_BGR                 = 5,
+    RGB_COLOR_ORDER_COUNT
+};
+
+/*------------------------------------------------------------------*\
+| Per-channel lookup table, 256 entries per channel.  Built by       |
+| rgb_color_build_lut() from a brightness and gamma or filled in     |
+| directly for device specific curves.                               |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    unsigned char           r[256];
+    unsigned char           g[256];
+    unsigned char           b[256];
+} rgb_color_lut;
+
+/*------------------------------------------------------------------*\
+| Per-controller output correction, applied between the client       |
+| visible color buffer and the device                                |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    unsigned char           brightness;         /* Overall scale, 255 = unchanged           */
+    unsigned char           white_balance[3];   /* R, G, B channel gain, 255 = unchanged    */
+    float                   gamma;              /* Gamma exponent, 1.0 = linear             */
+    int                     channel_order;      /* RGB_COLOR_ORDER_* swizzle, output byte   */
+                                                /* N takes the Nth channel of the order     */
+} rgb_color_correction;
+
+/*------------------------------------------------------------------*\
+| Source channel (0 = R, 1 = G, 2 = B) of each packed byte, per      |
+| channel order                                                      |
+\*------------------------------------------------------------------*/
+extern const unsigned char rgb_color_order_channels[RGB_COLOR_ORDER_COUNT][3];
+
+const char*     rgb_color_order_to_str(int order);
+int             rgb_color_order_from_str(const char* str);
+
+/*------------------------------------------------------------------*\
+| Pack count colors into out (count * 3 bytes) in the given channel  |
+| order.  brightness scales each channel by (brightness + 1) / 256,  |
+| so 255 is an exact copy.  out must not overlap colors.             |
+\*------------------------------------------------------------------*/
+void            rgb_color_pack(const RGBColor* colors, unsigned int count, unsigned char* out, int order);
+void            rgb_color_pack_scaled(const RGBColor* colors, unsigned int count, unsigned char* out, int order, unsigned char brightness);
+void            rgb_color_pack_lut(const RGBColor* colors, unsigned int count, unsigned char* out, int order, const rgb_color_lut* lut);
+
+/*------------------------------------------------------------------*\
+| Unpack count packed LEDs from in (count * 3 bytes) in the given    |
+| channel order into colors                                          |
+\*------------------------------------------------------------------*/
+void            rgb_color_unpack(const unsigned char* in, unsigned int count, RGBColor* colors, int order);
+
+/*------------------------------------------------------------------*\
+| Correct count colors into out, RGBColor to RGBColor.  The channel  |
+| order is applied as a swizzle and brightness/LUT behave as in the  |
+| pack functions.  out may be the same buffer as colors.             |
+\*------------------------------------------------------------------*/
+void            rgb_color_correct(const RGBColor* colors, unsigned int count, RGBColor* out, int order, unsigned char brightness);
+void            rgb_color_correct_lut(const RGBColor* colors, unsigned int count, RGBColor* out, int order, const rgb_color_lut* lut);
+
+/*------------------------------------------------------------------*\
+| Build a lookup table applying brightness (0-255) followed by a     |
+| gamma curve (1.0 is linear)                                        |
+\*------------------------------------------------------------------*/
+void            rgb_color_build_lut(rgb_color_lut* lut, unsigned char brightness, float gamma);
+
+/*------------------------------------------------------------------*\
+| Color correction helpers.  A correction with no gamma and no white |
+| balance only needs rgb_color_correct(), otherwise build a LUT with |
+| rgb_color_correction_build_lut() and use rgb_color_correct_lut().  |
+\*------------------------------------------------------------------*/
+void            rgb_color_correction_init(rgb_color_correction* correction);
+bool            rgb_color_correction_is_identity(const rgb_color_correction* correction);
+bool            rgb_color_correction_needs_lut(const rgb_color_correction* correction);
+void            rgb_color_correction_build_lut(rgb_color_lut* lut, const rgb_color_correction* correction);
@@ -0,0 +1,251 @@
+/*---------------------------------------------------------*\
+| RGBControllerRateControl.cpp                              |
+|                                                           |
+|   Adaptive update rate limit for RGBController devices    |
+|   with slow or buffered links                             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include "RGBControllerRateControl.h"
+
+thread_local RGBControllerRateControl* RGBControllerRateControl::current = nullptr;
+
+RGBControllerRateControl::RGBControllerRateControl()
+{
+    enabled             = false;
+    min_fps             = RGBCONTROLLER_RATE_MIN_FPS;
+    max_fps             = RGBCONTROLLER_RATE_MAX_FPS;
+
+    update_start_us     = 0;
+    update_reply_us     = 0;
+    update_congested    = false;
+
+    Reset();
+}
+
+void RGBControllerRateControl::Reset()
+{
+    current_fps         = max_fps;
+    achieved_fps        = 0.0f;
+    latency_us          = 0;
+    baseline_us         = 0;
+    window_min_us       = 0;
+    window_start_us     = 0;
+    decreases           = 0;
+    congestion_events   = 0;
+    last_start_us       = 0;
+    last_end_us         = 0;
+    holdoff_until_us    = 0;
+}
+
+void RGBControllerRateControl::SetLimits(bool enabled, float min_fps, float max_fps)
+{
+    std::lock_guard<std::mutex> lock(RateMutex);
+
+    if(!(min_fps > 0.0f))
+    {
+        min_fps = RGBCONTROLLER_RATE_MIN_FPS;
+    }
+
+    if(!(max_fps >= min_fps))
+    {
+        max_fps = std::max(min_fps, RGBCONTROLLER_RATE_MAX_FPS);
+    }
+
+    this->enabled       = enabled;
+    this->min_fps       = min_fps;
+    this->max_fps       = max_fps;
+
+    Reset();
+}
+
+void RGBControllerRateControl::GetRateControl(rgb_rate_control* rate)
+{
+    std::lock_guard<std::mutex> lock(RateMutex);
+
+    rate->enabled           = enabled;
+    rate->min_fps           = min_fps;
+    rate->max_fps           = max_fps;
+    rate->current_fps       = current_fps;
+    rate->achieved_fps      = achieved_fps;
+    rate->latency_us        = (unsigned long long)latency_us;
+    rate->baseline_us       = (unsigned long long)baseline_us;
+    rate->decreases         = decreases;
+    rate->congestion_events = congestion_events;
+}
+
+bool RGBControllerRateControl::GetEnabled()
+{
+    std::lock_guard<std::mutex> lock(RateMutex);
+
+    return(enabled);
+}
+
+long long RGBControllerRateControl::GetFrameDelay(long long now_us)
+{
+    std::lock_guard<std::mutex> lock(RateMutex);
+
+    if(!enabled || (last_start_us == 0))
+    {
+        return(0);
+    }
+
+    long long next_us = last_start_us + (long long)(1000000.0f / current_fps);
+
+    return(std::max(next_us - now_us, 0LL));
+}
+
+void RGBControllerRateControl::BeginDeviceUpdate(long long start_us)
+{
+    update_start_us     = start_us;
+    update_reply_us     = 0;
+    update_congested    = false;
+
+    current             = this;
+}
+
+void RGBControllerRateControl::EndDeviceUpdate(long long end_us, unsigned long long writes)
+{
+    current = nullptr;
+
+    std::lock_guard<std::mutex> lock(RateMutex);
+
+    if(!enabled)
+    {
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Track the rate updates actually run at.  Idle gaps    |
+    | say nothing about the link and are left out.          |
+    \*-----------------------------------------------------*/
+    long long interval_us = update_start_us - last_start_us;
+
+    if((last_start_us != 0) && (interval_us > 0) && (interval_us < RGBCONTROLLER_RATE_IDLE_US))
+    {
+        float update_fps = 1000000.0f / (float)interval_us;
+
+        if(achieved_fps == 0.0f)
+        {
+            achieved_fps  = update_fps;
+        }
+        else
+        {
+            achieved_fps += (update_fps - achieved_fps) / 8.0f;
+        }
+    }
+
+    last_start_us = update_start_us;
+
+    /*-----------------------------------------------------*\
+    | Latency sample.  Drivers that write only what changed |
+    | take longer for busier frames, so the write time is   |
+    | taken per write.  A reply latency reported by the     |
+    | transport is used as is.                              |
+    \*-----------------------------------------------------*/
+    long long sample_us;
+
+    if(update_reply_us > 0)
+    {
+        sample_us = update_reply_us;
+    }
+    else
+    {
+        sample_us = (end_us - update_start_us) / (long long)std::max(writes, 1ULL);
+    }
+
+    sample_us = std::max(sample_us, 0LL);
+
+    if(latency_us == 0)
+    {
+        latency_us  = sample_us;
+    }
+    else
+    {
+        latency_us += (sample_us - latency_us) / 8;
+    }
+
+    /*-----------------------------------------------------*\
+    | The baseline is the lowest latency of the previous    |
+    | window, so it follows a link that got slower for good |
+    \*-----------------------------------------------------*/
+    if((window_start_us == 0) || (sample_us < window_min_us))
+    {
+        window_min_us = sample_us;
+    }
+
+    if((baseline_us == 0) || (sample_us < baseline_us))
+    {
+        baseline_us = sample_us;
+    }
+
+    if(window_start_us == 0)
+    {
+        window_start_us = end_us;
+    }
+    else if((end_us - window_start_us) >= RGBCONTROLLER_RATE_BASELINE_WINDOW_US)
+    {
+        baseline_us     = window_min_us;
+        window_min_us   = sample_us;
+        window_start_us = end_us;
+    }
+
+    bool congested = update_congested
+                  || (latency_us > ((baseline_us * RGBCONTROLLER_RATE_LATENCY_FACTOR) + RGBCONTROLLER_RATE_LATENCY_SLACK_US));
+
+    if(congested)
+    {
+        congestion_events++;
+
+        /*-------------------------------------------------*\
+        | Cut from the rate the device actually managed, a  |
+        | limit far above it would not slow anything down.  |
+        | Wait for the cut to take effect before the next.  |
+        \*-------------------------------------------------*/
+        if(end_us >= holdoff_until_us)
+        {
+            float base_fps = current_fps;
+
+            if(achieved_fps > 0.0f)
+            {
+                base_fps = std::min(base_fps, achieved_fps);
+            }
+
+            current_fps         = std::max(min_fps, base_fps * RGBCONTROLLER_RATE_DECREASE);
+            holdoff_until_us    = end_us + RGBCONTROLLER_RATE_HOLDOFF_US + (long long)(1000000.0f / current_fps);
+
+            decreases++;
+        }
+    }
+    else if(last_end_us != 0)
+    {
+        float elapsed_s = (float)(end_us - last_end_us) / 1000000.0f;
+
+        current_fps = std::min(max_fps, current_fps + (RGBCONTROLLER_RATE_INCREASE_FPS * elapsed_s));
+    }
+
+    last_end_us = end_us;
+}
+
+void RGBControllerRateControl::RecordReplyLatency(long long latency_us)
+{
+    RGBControllerRateControl* rate = current;
+
+    if(rate != nullptr)
+    {
+        rate->update_reply_us = std::max(rate->update_reply_us, latency_us);
+    }
+}
+
+void RGBControllerRateControl::RecordCongestion()
+{
+    RGBControllerRateControl* rate = current;
+
+    if(rate != nullptr)
+    {
+        rate->update_congested = true;
+    }
+}
@@ -0,0 +1,118 @@
+/*---------------------------------------------------------*\
+| RGBControllerRateControl.h                                |
+|                                                           |
+|   Adaptive update rate limit for RGBController devices    |
+|   with slow or buffered links                             |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <mutex>
+
+/*------------------------------------------------------------------*\
+| Rate control parameters                                            |
+|                                                                    |
+|   The rate limit is raised additively while the device keeps up    |
+|   and cut multiplicatively when it shows congestion (AIMD).  A     |
+|   device is congested when a transport reports it, or when its     |
+|   smoothed latency per write exceeds LATENCY_FACTOR times the      |
+|   lowest latency seen in the last BASELINE_WINDOW plus             |
+|   LATENCY_SLACK.                                                   |
+\*------------------------------------------------------------------*/
+#define RGBCONTROLLER_RATE_MIN_FPS              1.0f        /* Default lowest rate limit        */
+#define RGBCONTROLLER_RATE_MAX_FPS              240.0f      /* Default highest rate limit       */
+#define RGBCONTROLLER_RATE_INCREASE_FPS         5.0f        /* Increase per second, no congest. */
+#define RGBCONTROLLER_RATE_DECREASE             0.7f        /* Factor applied on congestion     */
+#define RGBCONTROLLER_RATE_HOLDOFF_US           250000      /* No second cut within this time   */
+#define RGBCONTROLLER_RATE_LATENCY_FACTOR       2           /* Latency inflation threshold      */
+#define RGBCONTROLLER_RATE_LATENCY_SLACK_US     2000        /* Latency jitter allowance         */
+#define RGBCONTROLLER_RATE_BASELINE_WINDOW_US   10000000    /* Baseline latency window          */
+#define RGBCONTROLLER_RATE_IDLE_US              1000000     /* Gap not counted as update rate   */
+
+/*------------------------------------------------------------------*\
+| Rate control snapshot                                              |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    bool                enabled;            /* Rate control active for this device      */
+    float               min_fps;            /* Lowest rate limit                        */
+    float               max_fps;            /* Highest rate limit                       */
+    float               current_fps;        /* Rate limit currently applied             */
+    float               achieved_fps;       /* Smoothed rate of DeviceUpdateLEDs()      */
+    unsigned long long  latency_us;         /* Smoothed latency per write or reply      */
+    unsigned long long  baseline_us;        /* Lowest latency in the baseline window    */
+    unsigned long long  decreases;          /* Number of rate cuts                      */
+    unsigned long long  congestion_events;  /* Updates that showed congestion           */
+} rgb_rate_control;
+
+class RGBControllerRateControl
+{
+public:
+    RGBControllerRateControl();
+
+    /*---------------------------------------------------------*\
+    | Enable or disable rate control and set the range of the   |
+    | rate limit.  Resets the measurements.                     |
+    \*---------------------------------------------------------*/
+    void                    SetLimits(bool enabled, float min_fps, float max_fps);
+    void                    GetRateControl(rgb_rate_control* rate);
+    bool                    GetEnabled();
+
+    /*---------------------------------------------------------*\
+    | Called by RGBController from the device thread.           |
+    | GetFrameDelay() returns how long to hold back the next    |
+    | DeviceUpdateLEDs(), Begin/EndDeviceUpdate() bracket it    |
+    | and make this object the current target of the transport |
+    | reports on the device thread.                             |
+    \*---------------------------------------------------------*/
+    long long               GetFrameDelay(long long now_us);
+    void                    BeginDeviceUpdate(long long start_us);
+    void                    EndDeviceUpdate(long long end_us, unsigned long long writes);
+
+    /*---------------------------------------------------------*\
+    | Called by transports on the device thread.  A reply       |
+    | latency replaces the write time as latency sample, a      |
+    | congestion report marks the update as congested, e.g. a   |
+    | queued command that was replaced before it could be sent. |
+    \*---------------------------------------------------------*/
+    static void             RecordReplyLatency(long long latency_us);
+    static void             RecordCongestion();
+
+private:
+    std::mutex              RateMutex;
+
+    bool                    enabled;
+    float                   min_fps;
+    float                   max_fps;
+    float                   current_fps;
+    float                   achieved_fps;
+
+    long long               latency_us;
+    long long               baseline_us;
+    long long               window_min_us;
+    long long               window_start_us;
+
+    unsigned long long      decreases;
+    unsigned long long      congestion_events;
+
+    long long               last_start_us;
+    long long               last_end_us;
+    long long               holdoff_until_us;
+
+    /*---------------------------------------------------------*\
+    | Reports for the update in progress, device thread only    |
+    \*---------------------------------------------------------*/
+    long long               update_start_us;
+    long long               update_reply_us;
+    bool                    update_congested;
+
+    void                    Reset();
+
+    /*---------------------------------------------------------*\
+    | Controller being updated on this thread, if any           |
+    \*---------------------------------------------------------*/
+    static thread_local RGBControllerRateControl*   current;
+};
@@ -0,0 +1,330 @@
+/*---------------------------------------------------------*\
+| RGBControllerStats.cpp                                    |
+|                                                           |
+|   Low overhead timing and throughput statistics for the   |
+|   RGBController update pipeline                           |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include "RGBControllerStats.h"
+
+thread_local RGBControllerStats* RGBControllerStats::current = nullptr;
+thread_local RGBControllerStats* RGBControllerStats::current_mode = nullptr;
+
+const char* rgb_controller_transport_to_str(int transport)
+{
+    switch(transport)
+    {
+    case RGBCONTROLLER_TRANSPORT_HID:
+        return "HID";
+    case RGBCONTROLLER_TRANSPORT_SERIAL:
+        return "Serial";
+    case RGBCONTROLLER_TRANSPORT_I2C:
+        return "I2C";
+    case RGBCONTROLLER_TRANSPORT_NETWORK:
+        return "Network";
+    default:
+        return "Unknown";
+    }
+}
+
+unsigned long long stats_histogram_average(const stats_histogram& histogram)
+{
+    if(histogram.count == 0)
+    {
+        return(0);
+    }
+
+    return(histogram.total_us / histogram.count);
+}
+
+/*---------------------------------------------------------*\
+| Returns the upper bound of the bucket containing the      |
+| requested percentile, clamped to the largest sample       |
+\*---------------------------------------------------------*/
+unsigned long long stats_histogram_percentile(const stats_histogram& histogram, double percentile)
+{
+    unsigned long long bucket_total = 0;
+
+    for(unsigned int bucket_idx = 0; bucket_idx < RGBCONTROLLER_STATS_NUM_BUCKETS; bucket_idx++)
+    {
+        bucket_total += histogram.buckets[bucket_idx];
+    }
+
+    if(bucket_total == 0)
+    {
+        return(0);
+    }
+
+    unsigned long long target   = (unsigned long long)((percentile / 100.0) * bucket_total);
+    unsigned long long seen     = 0;
+
+    if(target == 0)
+    {
+        target = 1;
+    }
+
+    for(unsigned int bucket_idx = 0; bucket_idx < (RGBCONTROLLER_STATS_NUM_BUCKETS - 1); bucket_idx++)
+    {
+        seen += histogram.buckets[bucket_idx];
+
+        if(seen >= target)
+        {
+            unsigned long long upper = (1ULL << bucket_idx);
+
+            return((upper < histogram.max_us) ? upper : histogram.max_us);
+        }
+    }
+
+    return(histogram.max_us);
+}
+
+RGBControllerStatsHistogram::RGBControllerStatsHistogram()
+{
+    Reset();
+}
+
+void RGBControllerStatsHistogram::Record(unsigned long long value_us)
+{
+    unsigned int bucket_idx = 0;
+
+    while((bucket_idx < (RGBCONTROLLER_STATS_NUM_BUCKETS - 1)) && ((1ULL << bucket_idx) <= value_us))
+    {
+        bucket_idx++;
+    }
+
+    buckets[bucket_idx].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_us.fetch_add(value_us, std::memory_order_relaxed);
+
+    unsigned long long prev_max = max_us.load(std::memory_order_relaxed);
+
+    while((value_us > prev_max) && !max_us.compare_exchange_weak(prev_max, value_us, std::memory_order_relaxed))
+    {
+    }
+}
+
+void RGBControllerStatsHistogram::Snapshot(stats_histogram* histogram)
+{
+    histogram->count    = count.load(std::memory_order_relaxed);
+    histogram->total_us = total_us.load(std::memory_order_relaxed);
+    histogram->max_us   = max_us.load(std::memory_order_relaxed);
+
+    for(unsigned int bucket_idx = 0; bucket_idx < RGBCONTROLLER_STATS_NUM_BUCKETS; bucket_idx++)
+    {
+        histogram->buckets[bucket_idx] = buckets[bucket_idx].load(std::memory_order_relaxed);
+    }
+}
+
+void RGBControllerStatsHistogram::Reset()
+{
+    count       = 0;
+    total_us    = 0;
+    max_us      = 0;
+
+    for(unsigned int bucket_idx = 0; bucket_idx < RGBCONTROLLER_STATS_NUM_BUCKETS; bucket_idx++)
+    {
+        buckets[bucket_idx] = 0;
+    }
+}
+
+RGBControllerStats::RGBControllerStats()
+{
+    update_start_us     = 0;
+    update_commit_us    = 0;
+    mode_start_us       = 0;
+
+    Reset();
+}
+
+long long RGBControllerStats::NowMicroseconds()
+{
+    return(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void RGBControllerStats::RecordFrameRequested(bool already_pending)
+{
+    frames_requested.fetch_add(1, std::memory_order_relaxed);
+
+    /*-----------------------------------------------------*\
+    | If a frame is already waiting on the device thread,   |
+    | this request is merged into it.  Keep the original    |
+    | request time so queue wait reflects the oldest data.  |
+    \*-----------------------------------------------------*/
+    if(already_pending)
+    {
+        frames_coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        request_time_us.store(NowMicroseconds(), std::memory_order_relaxed);
+    }
+}
+
+void RGBControllerStats::RecordFrameCommitted(long long commit_us, long long tick_us)
+{
+    commit_time_us.store(commit_us, std::memory_order_relaxed);
+    tick_time_us.store(tick_us, std::memory_order_relaxed);
+}
+
+void RGBControllerStats::BeginDeviceUpdate()
+{
+    update_start_us = NowMicroseconds();
+
+    long long request_us = request_time_us.load(std::memory_order_relaxed);
+
+    if((request_us != 0) && (update_start_us >= request_us))
+    {
+        queue_wait.Record((unsigned long long)(update_start_us - request_us));
+    }
+
+    /*-----------------------------------------------------*\
+    | Frame clock frames also record how far this device    |
+    | started from the shared tick.  The commit time is     |
+    | kept for EndDeviceUpdate() so a commit arriving while |
+    | this update runs is left for the next one.            |
+    \*-----------------------------------------------------*/
+    long long tick_us   = tick_time_us.exchange(0, std::memory_order_relaxed);
+    update_commit_us    = commit_time_us.exchange(0, std::memory_order_relaxed);
+
+    if((tick_us != 0) && (update_start_us >= tick_us))
+    {
+        dispatch_jitter.Record((unsigned long long)(update_start_us - tick_us));
+    }
+
+    current = this;
+}
+
+void RGBControllerStats::EndDeviceUpdate()
+{
+    current = nullptr;
+
+    long long end_us = NowMicroseconds();
+
+    update_time.Record((unsigned long long)(end_us - update_start_us));
+    frames_written.fetch_add(1, std::memory_order_relaxed);
+
+    if((update_commit_us != 0) && (end_us >= update_commit_us))
+    {
+        commit_latency.Record((unsigned long long)(end_us - update_commit_us));
+    }
+}
+
+void RGBControllerStats::BeginModeUpdate()
+{
+    mode_start_us   = NowMicroseconds();
+
+    current_mode    = this;
+}
+
+void RGBControllerStats::EndModeUpdate()
+{
+    current_mode = nullptr;
+
+    mode_time.Record((unsigned long long)(NowMicroseconds() - mode_start_us));
+    modes_written.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RGBControllerStats::RecordTransportWrite(int transport, int bytes)
+{
+    RGBControllerStats* stats = current;
+
+    if((stats == nullptr) && (current_mode != nullptr))
+    {
+        current_mode->mode_writes.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if((stats == nullptr) || (transport < 0) || (transport >= RGBCONTROLLER_TRANSPORT_COUNT) || (bytes < 0))
+    {
+        return;
+    }
+
+    stats->transport_bytes[transport].fetch_add((unsigned long long)bytes, std::memory_order_relaxed);
+    stats->transport_writes[transport].fetch_add(1, std::memory_order_relaxed);
+}
+
+bool RGBControllerStats::InDeviceUpdate()
+{
+    return(current != nullptr);
+}
+
+void RGBControllerStats::GetStats(rgb_controller_stats* stats)
+{
+    stats->frames_requested = frames_requested.load(std::memory_order_relaxed);
+    stats->frames_written   = frames_written.load(std::memory_order_relaxed);
+    stats->frames_coalesced = frames_coalesced.load(std::memory_order_relaxed);
+
+    queue_wait.Snapshot(&stats->queue_wait);
+    update_time.Snapshot(&stats->update_time);
+    dispatch_jitter.Snapshot(&stats->dispatch_jitter);
+    commit_latency.Snapshot(&stats->commit_latency);
+    mode_time.Snapshot(&stats->mode_time);
+
+    stats->modes_written    = modes_written.load(std::memory_order_relaxed);
+    stats->mode_writes      = mode_writes.load(std::memory_order_relaxed);
+
+    for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        stats->transport_bytes[transport_idx]  = transport_bytes[transport_idx].load(std::memory_order_relaxed);
+        stats->transport_writes[transport_idx] = transport_writes[transport_idx].load(std::memory_order_relaxed);
+    }
+}
+
+void RGBControllerStats::Reset()
+{
+    frames_requested    = 0;
+    frames_written      = 0;
+    frames_coalesced    = 0;
+    request_time_us     = 0;
+    commit_time_us      = 0;
+    tick_time_us        = 0;
+
+    queue_wait.Reset();
+    update_time.Reset();
+    dispatch_jitter.Reset();
+    commit_latency.Reset();
+    mode_time.Reset();
+
+    modes_written       = 0;
+    mode_writes         = 0;
+
+    for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        transport_bytes[transport_idx]  = 0;
+        transport_writes[transport_idx] = 0;
+    }
+}
+
+int RGBControllerStats::GetPrimaryTransport()
+{
+    int                 primary_transport   = -1;
+    unsigned long long  primary_writes      = 0;
+
+    for(int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        unsigned long long writes = transport_writes[transport_idx].load(std::memory_order_relaxed);
+
+        if(writes > primary_writes)
+        {
+            primary_transport   = transport_idx;
+            primary_writes      = writes;
+        }
+    }
+
+    return(primary_transport);
+}
+
+unsigned long long RGBControllerStats::GetTransportWriteCount()
+{
+    unsigned long long writes = 0;
+
+    for(int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        writes += transport_writes[transport_idx].load(std::memory_order_relaxed);
+    }
+
+    return(writes);
+}
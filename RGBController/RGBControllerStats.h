@@ -0,0 +1,183 @@
+/*---------------------------------------------------------*\
+| RGBControllerStats.h                                      |
+|                                                           |
+|   Low overhead timing and throughput statistics for the   |
+|   RGBController update pipeline                           |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+/*------------------------------------------------------------------*\
+| Histogram buckets are powers of two in microseconds.  Bucket 0     |
+| holds values below 1us, bucket N holds [2^(N-1), 2^N) us and the   |
+| last bucket holds everything above ~0.5s                           |
+\*------------------------------------------------------------------*/
+#define RGBCONTROLLER_STATS_NUM_BUCKETS     20
+
+/*------------------------------------------------------------------*\
+| Transport Types                                                    |
+\*------------------------------------------------------------------*/
+enum
+{
+    RGBCONTROLLER_TRANSPORT_HID         = 0,    /* hidapi reports               */
+    RGBCONTROLLER_TRANSPORT_SERIAL      = 1,    /* Serial port writes           */
+    RGBCONTROLLER_TRANSPORT_I2C         = 2,    /* I2C/SMBus transactions       */
+    RGBCONTROLLER_TRANSPORT_NETWORK     = 3,    /* TCP/UDP network writes       */
+    RGBCONTROLLER_TRANSPORT_COUNT
+};
+
+const char* rgb_controller_transport_to_str(int transport);
+
+/*------------------------------------------------------------------*\
+| Histogram snapshot, plain data copied out of the live counters     |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    unsigned long long  count;                                      /* Number of samples    */
+    unsigned long long  total_us;                                   /* Sum of all samples   */
+    unsigned long long  max_us;                                     /* Largest sample       */
+    unsigned int        buckets[RGBCONTROLLER_STATS_NUM_BUCKETS];   /* Sample distribution  */
+} stats_histogram;
+
+unsigned long long stats_histogram_average(const stats_histogram& histogram);
+unsigned long long stats_histogram_percentile(const stats_histogram& histogram, double percentile);
+
+/*------------------------------------------------------------------*\
+| Statistics snapshot                                                |
+\*------------------------------------------------------------------*/
+typedef struct
+{
+    unsigned long long  frames_requested;   /* UpdateLEDs() calls                       */
+    unsigned long long  frames_written;     /* DeviceUpdateLEDs() calls                 */
+    unsigned long long  frames_coalesced;   /* UpdateLEDs() calls merged into a pending */
+                                            /* frame before the device thread ran       */
+    stats_histogram     queue_wait;         /* UpdateLEDs() to DeviceUpdateLEDs() start */
+    stats_histogram     update_time;        /* DeviceUpdateLEDs() duration              */
+    unsigned long long  transport_bytes[RGBCONTROLLER_TRANSPORT_COUNT];
+    unsigned long long  transport_writes[RGBCONTROLLER_TRANSPORT_COUNT];
+    stats_histogram     dispatch_jitter;    /* Frame clock tick to DeviceUpdateLEDs()   */
+                                            /* start, frame clock frames only           */
+    stats_histogram     commit_latency;     /* CommitFrame() to DeviceUpdateLEDs() end, */
+                                            /* frame clock frames only                  */
+    unsigned long long  modes_written;      /* DeviceUpdateMode() calls                 */
+    stats_histogram     mode_time;          /* DeviceUpdateMode() duration              */
+    unsigned long long  mode_writes;        /* Transport writes in DeviceUpdateMode()   */
+} rgb_controller_stats;
+
+/*------------------------------------------------------------------*\
+| Live histogram                                                     |
+|   Each field is an independent relaxed atomic so recording never   |
+|   blocks.  A snapshot may be torn by one in-flight sample, which   |
+|   is acceptable for statistics.                                    |
+\*------------------------------------------------------------------*/
+class RGBControllerStatsHistogram
+{
+public:
+    RGBControllerStatsHistogram();
+
+    void Record(unsigned long long value_us);
+    void Snapshot(stats_histogram* histogram);
+    void Reset();
+
+private:
+    std::atomic<unsigned long long>     count;
+    std::atomic<unsigned long long>     total_us;
+    std::atomic<unsigned long long>     max_us;
+    std::atomic<unsigned int>           buckets[RGBCONTROLLER_STATS_NUM_BUCKETS];
+};
+
+class RGBControllerStats
+{
+public:
+    RGBControllerStats();
+
+    /*---------------------------------------------------------*\
+    | Called by RGBController from the UpdateLEDs() caller      |
+    \*---------------------------------------------------------*/
+    void                    RecordFrameRequested(bool already_pending);
+
+    /*---------------------------------------------------------*\
+    | Called by RGBController when the frame clock dispatches a |
+    | committed frame, before RecordFrameRequested()            |
+    \*---------------------------------------------------------*/
+    void                    RecordFrameCommitted(long long commit_us, long long tick_us);
+
+    /*---------------------------------------------------------*\
+    | Called by RGBController from the device thread, brackets  |
+    | DeviceUpdateLEDs() and makes this object the current      |
+    | transport accounting target for the device thread         |
+    \*---------------------------------------------------------*/
+    void                    BeginDeviceUpdate();
+    void                    EndDeviceUpdate();
+
+    /*---------------------------------------------------------*\
+    | Same for DeviceUpdateMode(), whose writes are counted     |
+    | apart from the color update writes                        |
+    \*---------------------------------------------------------*/
+    void                    BeginModeUpdate();
+    void                    EndModeUpdate();
+
+    /*---------------------------------------------------------*\
+    | Called by transports (hidapi wrapper, serial_port,        |
+    | net_port, i2c_smbus) after each write.  Accounts the      |
+    | write to the controller currently updating on the calling |
+    | thread, or does nothing if there is none.                 |
+    \*---------------------------------------------------------*/
+    static void             RecordTransportWrite(int transport, int bytes);
+
+    /*---------------------------------------------------------*\
+    | True while the calling thread runs DeviceUpdateLEDs(),    |
+    | transports use it to tell color updates from other writes |
+    \*---------------------------------------------------------*/
+    static bool             InDeviceUpdate();
+
+    void                    GetStats(rgb_controller_stats* stats);
+    void                    Reset();
+
+    /*---------------------------------------------------------*\
+    | Transport with the most writes so far, or -1 if the       |
+    | controller has not written anything yet                   |
+    \*---------------------------------------------------------*/
+    int                     GetPrimaryTransport();
+
+    /*---------------------------------------------------------*\
+    | Total number of transport writes so far                   |
+    \*---------------------------------------------------------*/
+    unsigned long long      GetTransportWriteCount();
+
+    static long long        NowMicroseconds();
+
+private:
+    std::atomic<unsigned long long>     frames_requested;
+    std::atomic<unsigned long long>     frames_written;
+    std::atomic<unsigned long long>     frames_coalesced;
+    std::atomic<long long>              request_time_us;
+    std::atomic<long long>              commit_time_us;
+    std::atomic<long long>              tick_time_us;
+    long long                           update_start_us;
+    long long                           update_commit_us;
+    long long                           mode_start_us;
+    std::atomic<unsigned long long>     modes_written;
+    std::atomic<unsigned long long>     mode_writes;
+
+    RGBControllerStatsHistogram         queue_wait;
+    RGBControllerStatsHistogram         update_time;
+    RGBControllerStatsHistogram         dispatch_jitter;
+    RGBControllerStatsHistogram         commit_latency;
+    RGBControllerStatsHistogram         mode_time;
+
+    std::atomic<unsigned long long>     transport_bytes[RGBCONTROLLER_TRANSPORT_COUNT];
+    std::atomic<unsigned long long>     transport_writes[RGBCONTROLLER_TRANSPORT_COUNT];
+
+    /*---------------------------------------------------------*\
+    | Controller being updated on this thread, if any           |
+    \*---------------------------------------------------------*/
+    static thread_local RGBControllerStats*     current;
+    static thread_local RGBControllerStats*     current_mode;
+};
@@ -10,6 +10,8 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <chrono>
+#include <thread>
 #include "RGBController_Dummy.h"
 
 /**------------------------------------------------------------------*\
@@ -34,7 +36,20 @@
 
 RGBController_Dummy::RGBController_Dummy()
 {
+    sim_transport   = -1;
+    sim_latency_us  = 0;
+}
 
+/*---------------------------------------------------------*\
+| Account each LED update as a write of 3 bytes per LED on  |
+| the given transport and block for latency_us, roughly how |
+| a real device of that type behaves.  A transport of -1    |
+| disables the simulation.                                  |
+\*---------------------------------------------------------*/
+void RGBController_Dummy::SetSimulatedTransport(int transport, unsigned int latency_us)
+{
+    sim_transport   = transport;
+    sim_latency_us  = latency_us;
 }
 
 void RGBController_Dummy::SetupZones()
@@ -49,7 +64,17 @@ void RGBController_Dummy::ResizeZone(int /*zone*/, int /*new_size*/)
 
 void RGBController_Dummy::DeviceUpdateLEDs()
 {
+    if(sim_transport < 0)
+    {
+        return;
+    }
+
+    RGBControllerStats::RecordTransportWrite(sim_transport, (int)(colors.size() * 3));
 
+    if(sim_latency_us > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(sim_latency_us));
+    }
 }
 
 void RGBController_Dummy::UpdateZoneLEDs(int /*zone*/)
@@ -19,6 +19,8 @@ class RGBController_Dummy : public RGBController
 public:
     RGBController_Dummy();
 
+    void        SetSimulatedTransport(int transport, unsigned int latency_us);
+
     void        SetupZones();
 
     void        ResizeZone(int zone, int new_size);
@@ -29,4 +31,12 @@ public:
 
     void        SetCustomMode();
     void        DeviceUpdateMode();
+
+private:
+    /*---------------------------------------------------------*\
+    | Simulated transport, lets debug devices stand in for real |
+    | hardware when measuring the update pipeline               |
+    \*---------------------------------------------------------*/
+    int             sim_transport;
+    unsigned int    sim_latency_us;
 };
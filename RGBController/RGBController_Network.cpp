@@ -134,3 +134,74 @@ void RGBController_Network::UpdateLEDs()
 {
     DeviceUpdateLEDs();
 }
+
+/*-----------------------------------------------------*\
+| Local statistics are meaningless for a network        |
+| controller as updates are sent synchronously.  Ask    |
+| the server for the real controller's statistics.      |
+\*-----------------------------------------------------*/
+void RGBController_Network::GetStats(rgb_controller_stats* stats)
+{
+    if(client->GetProtocolVersion() >= 6)
+    {
+        if(client->RequestControllerStats(dev_idx, stats))
+        {
+            return;
+        }
+    }
+
+    RGBController::GetStats(stats);
+}
+
+/*-----------------------------------------------------*\
+| Color correction is applied by the server's device    |
+| thread, so read and write the server's settings.  The |
+| local copy is kept so that it can be serialized and   |
+| as a fallback for servers older than protocol 6.      |
+\*-----------------------------------------------------*/
+void RGBController_Network::GetColorCorrection(rgb_color_correction* correction)
+{
+    if(client->GetProtocolVersion() >= 6)
+    {
+        if(client->RequestControllerCorrection(dev_idx, correction))
+        {
+            return;
+        }
+    }
+
+    RGBController::GetColorCorrection(correction);
+}
+
+void RGBController_Network::SetColorCorrection(const rgb_color_correction& correction)
+{
+    RGBController::SetColorCorrection(correction);
+
+    if(client->GetProtocolVersion() >= 6)
+    {
+        unsigned char * data = RGBController::GetColorCorrectionDescription();
+        unsigned int size;
+
+        memcpy(&size, &data[0], sizeof(unsigned int));
+
+        client->SendRequest_RGBController_SetCorrection(dev_idx, data, size);
+
+        delete[] data;
+    }
+}
+
+/*-----------------------------------------------------*\
+| Rate control runs on the server's device thread, so   |
+| report the server's rate                              |
+\*-----------------------------------------------------*/
+void RGBController_Network::GetRateControl(rgb_rate_control* rate)
+{
+    if(client->GetProtocolVersion() >= 6)
+    {
+        if(client->RequestControllerRate(dev_idx, rate))
+        {
+            return;
+        }
+    }
+
+    RGBController::GetRateControl(rate);
+}
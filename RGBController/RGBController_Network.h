@@ -36,6 +36,13 @@ public:
 
     void        UpdateLEDs();
 
+    void        GetStats(rgb_controller_stats* stats);
+
+    void        GetColorCorrection(rgb_color_correction* correction);
+    void        SetColorCorrection(const rgb_color_correction& correction);
+
+    void        GetRateControl(rgb_rate_control* rate);
+
 private:
     NetworkClient *     client;
     unsigned int        dev_idx;
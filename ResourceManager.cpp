@@ -20,15 +20,19 @@
 #include <string>
 #include <hidapi.h>
 #include "cli.h"
+#include "EffectsEngine.h"
+#include "FrameClock.h"
 #include "pci_ids/pci_ids.h"
 #include "ResourceManager.h"
 #include "ProfileManager.h"
 #include "LogManager.h"
+#include "NetworkDetection.h"
 #include "SettingsManager.h"
 #include "NetworkClient.h"
 #include "NetworkServer.h"
 #include "filesystem.h"
 #include "StringUtils.h"
+#include "i2c_smbus_sim.h"
 
 /*---------------------------------------------------------*\
 | Translation Strings                                       |
@@ -66,19 +70,6 @@ const char* UDEV_MUTLI =    QT_TRANSLATE_NOOP("ResourceManager",
                                               "<p>Multiple udev rules files can conflict, it is recommended to remove one of them.</p>");
 
 
-const hidapi_wrapper default_wrapper =
-{
-    NULL,
-    (hidapi_wrapper_send_feature_report)        hid_send_feature_report,
-    (hidapi_wrapper_get_feature_report)         hid_get_feature_report,
-    (hidapi_wrapper_get_serial_number_string)   hid_get_serial_number_string,
-    (hidapi_wrapper_open_path)                  hid_open_path,
-    (hidapi_wrapper_enumerate)                  hid_enumerate,
-    (hidapi_wrapper_free_enumeration)           hid_free_enumeration,
-    (hidapi_wrapper_close)                      hid_close,
-    (hidapi_wrapper_error)                      hid_error
-};
-
 bool BasicHIDBlock::compare(hid_device_info* info)
 {
     return ( (vid == info->vendor_id)
@@ -189,12 +180,47 @@ ResourceManager::ResourceManager()
     profile_manager         = new ProfileManager(GetConfigurationDirectory());
     server->SetProfileManager(profile_manager);
     rgb_controllers_sizes   = profile_manager->LoadProfileToList("sizes", true);
+
+    /*-----------------------------------------------------*\
+    | Create the shared frame clock and the built-in        |
+    | effects engine that renders on it                     |
+    \*-----------------------------------------------------*/
+    frame_clock             = new FrameClock();
+    effects_engine          = new EffectsEngine(frame_clock);
+    server->SetEffectsEngine(effects_engine);
+
+    /*-----------------------------------------------------*\
+    | Create the network detection prober.  Devices that    |
+    | answer after detection are registered under the       |
+    | detection mutex so they never race a detection pass,  |
+    | and get the profile already loaded for the others     |
+    \*-----------------------------------------------------*/
+    network_detection       = new NetworkDetection([this](RGBController* rgb_controller)
+    {
+        std::lock_guard<std::mutex> lock(DetectDeviceMutex);
+        RegisterRGBController(rgb_controller);
+        profile_manager->LoadProfileToController(rgb_controller);
+    });
 }
 
 ResourceManager::~ResourceManager()
 {
     Cleanup();
 
+    delete network_detection;
+    network_detection = nullptr;
+
+    /*-----------------------------------------------------*\
+    | Stop the effects engine before anything else can      |
+    | delete the controllers it is driving                  |
+    \*-----------------------------------------------------*/
+    server->SetEffectsEngine(nullptr);
+    delete effects_engine;
+    effects_engine = nullptr;
+
+    delete frame_clock;
+    frame_clock = nullptr;
+
     /*-----------------------------------------------------*\
     | Mark the background detection thread as not running   |
     | and then wake it up so it knows that it has to stop   |
@@ -233,6 +259,10 @@ void ResourceManager::RegisterRGBController(RGBController *rgb_controller)
     rgb_controller->flags |= CONTROLLER_FLAG_LOCAL;
 
     LOG_INFO("[%s] Registering RGB controller", rgb_controller->name.c_str());
+
+    LoadColorCorrectionSettings(rgb_controller);
+    LoadRateControlSettings(rgb_controller);
+
     rgb_controllers_hw.push_back(rgb_controller);
 
     /*-----------------------------------------------------*\
@@ -262,6 +292,129 @@ void ResourceManager::RegisterRGBController(RGBController *rgb_controller)
     UpdateDeviceList();
 }
 
+/*---------------------------------------------------------*\
+| Color correction settings format:                         |
+|                                                           |
+|   "ColorCorrection" : {                                   |
+|       "devices" : [                                       |
+|           {                                               |
+|               "name"          : "<controller name>",      |
+|               "location"      : "<location, optional>",   |
+|               "serial"        : "<serial, optional>",     |
+|               "brightness"    : 0-255,                    |
+|               "white_balance" : [ r, g, b ],              |
+|               "gamma"         : 1.0,                      |
+|               "channel_order" : "RGB"                     |
+|           }                                               |
+|       ]                                                   |
+|   }                                                       |
+\*---------------------------------------------------------*/
+void ResourceManager::LoadColorCorrectionSettings(RGBController* rgb_controller)
+{
+    json correction_settings = settings_manager->GetSettings("ColorCorrection");
+
+    if(!correction_settings.contains("devices") || !correction_settings["devices"].is_array())
+    {
+        return;
+    }
+
+    for(const json& device : correction_settings["devices"])
+    {
+        if(!device.is_object()
+        || (device.value("name", "") != rgb_controller->GetName())
+        || (device.contains("location") && (device.value("location", "") != rgb_controller->GetLocation()))
+        || (device.contains("serial") && (device.value("serial", "") != rgb_controller->GetSerial())))
+        {
+            continue;
+        }
+
+        rgb_color_correction correction;
+
+        rgb_color_correction_init(&correction);
+
+        correction.brightness   = (unsigned char)std::min(std::max(device.value("brightness", 255), 0), 255);
+        correction.gamma        = device.value("gamma", 1.0f);
+
+        if(device.contains("white_balance") && device["white_balance"].is_array() && (device["white_balance"].size() == 3))
+        {
+            for(unsigned int channel_idx = 0; channel_idx < 3; channel_idx++)
+            {
+                correction.white_balance[channel_idx] = device["white_balance"][channel_idx].get<unsigned char>();
+            }
+        }
+
+        if(device.contains("channel_order"))
+        {
+            int channel_order = rgb_color_order_from_str(device.value("channel_order", "RGB").c_str());
+
+            if(channel_order >= 0)
+            {
+                correction.channel_order = channel_order;
+            }
+        }
+
+        LOG_INFO("[%s] Applying color correction, brightness %d, gamma %.2f, order %s", rgb_controller->name.c_str(), correction.brightness, correction.gamma, rgb_color_order_to_str(correction.channel_order));
+
+        rgb_controller->SetColorCorrection(correction);
+        break;
+    }
+}
+
+/*---------------------------------------------------------*\
+| Rate control settings format:                             |
+|                                                           |
+|   "RateControl" : {                                       |
+|       "enabled" : true,                                   |
+|       "devices" : [                                       |
+|           {                                               |
+|               "name"          : "<controller name>",      |
+|               "location"      : "<location, optional>",   |
+|               "serial"        : "<serial, optional>",     |
+|               "enabled"       : true,                     |
+|               "min_fps"       : 1.0,                      |
+|               "max_fps"       : 240.0                     |
+|           }                                               |
+|       ]                                                   |
+|   }                                                       |
+|                                                           |
+| Rate control is enabled for controllers flagged with      |
+| CONTROLLER_FLAG_ADAPTIVE_RATE unless "enabled" is false.  |
+| A device entry enables or disables it for one controller. |
+\*---------------------------------------------------------*/
+void ResourceManager::LoadRateControlSettings(RGBController* rgb_controller)
+{
+    json    rate_settings   = settings_manager->GetSettings("RateControl");
+    bool    enabled         = (rgb_controller->flags & CONTROLLER_FLAG_ADAPTIVE_RATE) && rate_settings.value("enabled", true);
+    float   min_fps         = RGBCONTROLLER_RATE_MIN_FPS;
+    float   max_fps         = RGBCONTROLLER_RATE_MAX_FPS;
+
+    if(rate_settings.contains("devices") && rate_settings["devices"].is_array())
+    {
+        for(const json& device : rate_settings["devices"])
+        {
+            if(!device.is_object()
+            || (device.value("name", "") != rgb_controller->GetName())
+            || (device.contains("location") && (device.value("location", "") != rgb_controller->GetLocation()))
+            || (device.contains("serial") && (device.value("serial", "") != rgb_controller->GetSerial())))
+            {
+                continue;
+            }
+
+            enabled = device.value("enabled", true);
+            min_fps = device.value("min_fps", min_fps);
+            max_fps = device.value("max_fps", max_fps);
+            break;
+        }
+    }
+
+    if(enabled)
+    {
+        LOG_INFO("[%s] Enabling rate control, %.1f to %.1f FPS", rgb_controller->name.c_str(), min_fps, max_fps);
+    }
+
+    rgb_controller->SetRateControlLimits(enabled, min_fps, max_fps);
+}
+
 void ResourceManager::UnregisterRGBController(RGBController* rgb_controller)
 {
     LOG_INFO("[%s] Unregistering RGB controller", rgb_controller->name.c_str());
@@ -271,6 +424,13 @@ void ResourceManager::UnregisterRGBController(RGBController* rgb_controller)
     \*-----------------------------------------------------*/
     rgb_controller->ClearCallbacks();
 
+    /*-----------------------------------------------------*\
+    | Stop any built-in effect running on the controller    |
+    | and drop it from the pending frame                    |
+    \*-----------------------------------------------------*/
+    effects_engine->StopEffect(rgb_controller);
+    frame_clock->RemoveController(rgb_controller);
+
     /*-----------------------------------------------------*\
     | Find the controller to remove and remove it from the  |
     | hardware list                                         |
@@ -372,7 +532,8 @@ void ResourceManager::RegisterHIDWrappedDeviceDetector(std::string name,
                                                        uint16_t pid,
                                                        int interface,
                                                        int usage_page,
-                                                       int usage)
+                                                       int usage,
+                                                       bool libusb)
 {
     HIDWrappedDeviceDetectorBlock block;
 
@@ -383,6 +544,7 @@ void ResourceManager::RegisterHIDWrappedDeviceDetector(std::string name,
     block.interface     = interface;
     block.usage_page    = usage_page;
     block.usage         = usage;
+    block.libusb        = libusb;
 
     hid_wrapped_device_detectors.push_back(block);
 }
@@ -819,6 +981,21 @@ std::vector<NetworkClient*>& ResourceManager::GetClients()
     return(clients);
 }
 
+EffectsEngine* ResourceManager::GetEffectsEngine()
+{
+    return(effects_engine);
+}
+
+FrameClock* ResourceManager::GetFrameClock()
+{
+    return(frame_clock);
+}
+
+NetworkDetection* ResourceManager::GetNetworkDetection()
+{
+    return(network_detection);
+}
+
 ProfileManager* ResourceManager::GetProfileManager()
 {
     return(profile_manager);
@@ -846,6 +1023,12 @@ const char *ResourceManager::GetDetectionString()
 
 void ResourceManager::Cleanup()
 {
+    /*-----------------------------------------------------*\
+    | Stop background network probes first so none of them  |
+    | registers a controller while the list is torn down    |
+    \*-----------------------------------------------------*/
+    network_detection->CancelAll();
+
     ResourceManager::get()->WaitForDeviceDetection();
 
     std::vector<RGBController *> rgb_controllers_hw_copy = rgb_controllers_hw;
@@ -869,6 +1052,16 @@ void ResourceManager::Cleanup()
     rgb_controllers_hw.clear();
     detection_prev_size = 0;
 
+    /*-----------------------------------------------------*\
+    | Stop built-in effects and drop pending frames before  |
+    | deleting the controllers                              |
+    \*-----------------------------------------------------*/
+    for(RGBController* rgb_controller : rgb_controllers_hw_copy)
+    {
+        effects_engine->StopEffect(rgb_controller);
+        frame_clock->RemoveController(rgb_controller);
+    }
+
     for(RGBController* rgb_controller : rgb_controllers_hw_copy)
     {
         delete rgb_controller;
@@ -1062,6 +1255,7 @@ void ResourceManager::DetectDevicesCoroutine()
     unsigned int        hid_device_count    = 0;
     hid_device_info*    hid_devices         = NULL;
     bool                hid_safe_mode       = false;
+    hidapi_wrapper      hid_wrapper         = hidapi_wrapper_get_default();
 
     LOG_INFO("------------------------------------------------------");
     LOG_INFO("|               Start device detection               |");
@@ -1083,6 +1277,11 @@ void ResourceManager::DetectDevicesCoroutine()
     \*-----------------------------------------------------*/
     detector_settings = settings_manager->GetSettings("Detectors");
 
+    /*-----------------------------------------------------*\
+    | Start the shared deadline for network device probes   |
+    \*-----------------------------------------------------*/
+    network_detection->BeginPass();
+
     /*-----------------------------------------------------*\
     | Check HID safe mode setting                           |
     \*-----------------------------------------------------*/
@@ -1091,6 +1290,20 @@ void ResourceManager::DetectDevicesCoroutine()
         hid_safe_mode = detector_settings["hid_safe_mode"];
     }
 
+    /*-----------------------------------------------------*\
+    | Check HID capture setting.  When set, traffic of the  |
+    | wrapped HID detectors and controllers is recorded to  |
+    | the given file for later replay.                      |
+    \*-----------------------------------------------------*/
+    if(detector_settings.contains("hid_record_file"))
+    {
+        hidapi_wrapper_start_recording(detector_settings["hid_record_file"]);
+    }
+    else
+    {
+        hidapi_wrapper_stop_recording();
+    }
+
     /*-----------------------------------------------------*\
     | Calculate the percentage denominator by adding the    |
     | number of I2C and miscellaneous detectors and the     |
@@ -1101,7 +1314,7 @@ void ResourceManager::DetectDevicesCoroutine()
     \*-----------------------------------------------------*/
     if(!hid_safe_mode)
     {
-        hid_devices = hid_enumerate(0, 0);
+        hid_devices = hid_wrapper.hid_enumerate(0, 0);
     }
 
     current_hid_device = hid_devices;
@@ -1151,8 +1364,21 @@ void ResourceManager::DetectDevicesCoroutine()
     LOG_INFO("------------------------------------------------------");
 
     bool i2c_interface_fail = false;
+    bool i2c_sim_exclusive  = false;
 
-    for(unsigned int i2c_bus_detector_idx = 0; i2c_bus_detector_idx < (unsigned int)i2c_bus_detectors.size() && detection_is_required.load(); i2c_bus_detector_idx++)
+    /*-----------------------------------------------------*\
+    | Check I2C simulation setting.  When set, simulated    |
+    | busses described by the given file are registered,    |
+    | instead of the hardware busses if the file says so.   |
+    \*-----------------------------------------------------*/
+    if(detector_settings.contains("i2c_sim_file"))
+    {
+        i2c_smbus_sim_detect(detector_settings["i2c_sim_file"], &i2c_sim_exclusive);
+
+        I2CBusListChanged();
+    }
+
+    for(unsigned int i2c_bus_detector_idx = 0; i2c_bus_detector_idx < (unsigned int)i2c_bus_detectors.size() && detection_is_required.load() && !i2c_sim_exclusive; i2c_bus_detector_idx++)
     {
         if(i2c_bus_detectors[i2c_bus_detector_idx]() == false)
         {
@@ -1463,7 +1689,7 @@ void ResourceManager::DetectDevicesCoroutine()
                     {
                         DetectionProgressChanged();
 
-                        detector.function(default_wrapper, current_hid_device, hid_wrapped_device_detectors[hid_detector_idx].name);
+                        detector.function(hid_wrapper, current_hid_device, hid_wrapped_device_detectors[hid_detector_idx].name);
                     }
                 }
             }
@@ -1486,7 +1712,7 @@ void ResourceManager::DetectDevicesCoroutine()
         /*-------------------------------------------------*\
         | Done using the device list, free it               |
         \*-------------------------------------------------*/
-        hid_free_enumeration(hid_devices);
+        hid_wrapper.hid_free_enumeration(hid_devices);
     }
 
     /*-----------------------------------------------------*\
@@ -1525,7 +1751,13 @@ void ResourceManager::DetectDevicesCoroutine()
             .hid_enumerate                  = (hidapi_wrapper_enumerate)                    dlsym(dyn_handle,"hid_enumerate"),
             .hid_free_enumeration           = (hidapi_wrapper_free_enumeration)             dlsym(dyn_handle,"hid_free_enumeration"),
             .hid_close                      = (hidapi_wrapper_close)                        dlsym(dyn_handle,"hid_close"),
-            .hid_error                      = (hidapi_wrapper_error)                        dlsym(dyn_handle,"hid_free_enumeration")
+            .hid_error                      = (hidapi_wrapper_error)                        dlsym(dyn_handle,"hid_error"),
+            .hid_write                      = (hidapi_wrapper_write)                        dlsym(dyn_handle,"hid_write"),
+            .hid_read                       = (hidapi_wrapper_read)                         dlsym(dyn_handle,"hid_read"),
+            .hid_read_timeout               = (hidapi_wrapper_read_timeout)                 dlsym(dyn_handle,"hid_read_timeout"),
+            .hid_set_nonblocking            = (hidapi_wrapper_set_nonblocking)              dlsym(dyn_handle,"hid_set_nonblocking"),
+            .hid_get_manufacturer_string    = (hidapi_wrapper_get_manufacturer_string)      dlsym(dyn_handle,"hid_get_manufacturer_string"),
+            .hid_get_product_string         = (hidapi_wrapper_get_product_string)           dlsym(dyn_handle,"hid_get_product_string")
         };
 
         hid_devices = wrapper.hid_enumerate(0, 0);
@@ -1550,14 +1782,16 @@ void ResourceManager::DetectDevicesCoroutine()
             DetectionProgressChanged();
 
             /*---------------------------------------------*\
-            | Loop through all available wrapped HID        |
-            | detectors.  If all required information       |
-            | matches, run the detector                     |
+            | Loop through the wrapped HID detectors that   |
+            | need the libusb backend.  If all required     |
+            | information matches, run the detector.  The   |
+            | other wrapped detectors already ran against   |
+            | the default backend.                          |
             \*---------------------------------------------*/
             for(unsigned int hid_detector_idx = 0; hid_detector_idx < (unsigned int)hid_wrapped_device_detectors.size() && detection_is_required.load(); hid_detector_idx++)
             {
                 HIDWrappedDeviceDetectorBlock & detector = hid_wrapped_device_detectors[hid_detector_idx];
-                if(detector.compare(current_hid_device))
+                if(detector.libusb && detector.compare(current_hid_device))
                 {
                     detection_string = detector.name.c_str();
 
@@ -1605,6 +1839,41 @@ void ResourceManager::DetectDevicesCoroutine()
 #endif
 #endif
 
+    /*-----------------------------------------------------*\
+    | Detect replayed HID devices                           |
+    |                                                       |
+    | Run the wrapped HID detectors against the devices in  |
+    | a capture file recorded with hid_record_file          |
+    \*-----------------------------------------------------*/
+    hidapi_wrapper replay_wrapper;
+
+    if(detector_settings.contains("hid_replay_file") && hidapi_wrapper_load_replay(detector_settings["hid_replay_file"], &replay_wrapper))
+    {
+        LOG_INFO("------------------------------------------------------");
+        LOG_INFO("|            Detecting replayed HID devices          |");
+        LOG_INFO("------------------------------------------------------");
+
+        hid_devices = replay_wrapper.hid_enumerate(0, 0);
+
+        for(current_hid_device = hid_devices; current_hid_device; current_hid_device = current_hid_device->next)
+        {
+            for(unsigned int hid_detector_idx = 0; hid_detector_idx < (unsigned int)hid_wrapped_device_detectors.size() && detection_is_required.load(); hid_detector_idx++)
+            {
+                HIDWrappedDeviceDetectorBlock & detector = hid_wrapped_device_detectors[hid_detector_idx];
+
+                if(detector.compare(current_hid_device))
+                {
+                    detection_string = detector.name.c_str();
+                    DetectionProgressChanged();
+
+                    detector.function(replay_wrapper, current_hid_device, detector.name);
+                }
+            }
+        }
+
+        replay_wrapper.hid_free_enumeration(hid_devices);
+    }
+
     /*-----------------------------------------------------*\
     | Detect other devices                                  |
     \*-----------------------------------------------------*/
@@ -1644,6 +1913,25 @@ void ResourceManager::DetectDevicesCoroutine()
         detection_percent = (unsigned int)(percent * 100.0f);
     }
 
+    /*-----------------------------------------------------*\
+    | Register network devices as their probes answer, up   |
+    | to the shared deadline.  Devices that have not        |
+    | answered by then keep being probed in the background. |
+    \*-----------------------------------------------------*/
+    unsigned int network_timeout_ms = NETWORK_DETECTION_TIMEOUT_MS;
+
+    if(detector_settings.contains("network_timeout_ms"))
+    {
+        network_timeout_ms = detector_settings["network_timeout_ms"];
+    }
+
+    RGBController* network_controller;
+
+    while((network_controller = network_detection->WaitForController(network_timeout_ms)) != nullptr)
+    {
+        RegisterRGBController(network_controller);
+    }
+
     /*-----------------------------------------------------*\
     | Make sure that when the detection is done, progress   |
     | bar is set to 100%                                    |
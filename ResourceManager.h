@@ -33,7 +33,10 @@ using json = nlohmann::json;
 #define HID_USAGE_PAGE_ANY  -1
 
 struct hid_device_info;
+class EffectsEngine;
+class FrameClock;
 class NetworkClient;
+class NetworkDetection;
 class NetworkServer;
 class ProfileManager;
 class RGBController;
@@ -72,6 +75,7 @@ class HIDWrappedDeviceDetectorBlock : public BasicHIDBlock
 {
 public:
     HIDWrappedDeviceDetectorFunction    function;
+    bool                                libusb;
 };
 
 typedef struct
@@ -137,7 +141,8 @@ public:
                                             uint16_t pid,
                                             int interface  = HID_INTERFACE_ANY,
                                             int usage_page = HID_USAGE_PAGE_ANY,
-                                            int usage      = HID_USAGE_ANY);
+                                            int usage      = HID_USAGE_ANY,
+                                            bool libusb    = false);
     void RegisterDynamicDetector        (std::string name, DynamicDetectorFunction detector);
     void RegisterPreDetectionHook       (PreDetectionHookFunction hook);
 
@@ -167,6 +172,9 @@ public:
     std::vector<NetworkClient*>&    GetClients();
     NetworkServer*                  GetServer();
 
+    EffectsEngine*                  GetEffectsEngine();
+    FrameClock*                     GetFrameClock();
+    NetworkDetection*               GetNetworkDetection();
     ProfileManager*                 GetProfileManager();
     SettingsManager*                GetSettingsManager();
 
@@ -197,6 +205,8 @@ public:
 
 private:
     void UpdateDetectorSettings();
+    void LoadColorCorrectionSettings(RGBController* rgb_controller);
+    void LoadRateControlSettings(RGBController* rgb_controller);
     void SetupConfigurationDirectory();
     bool AttemptLocalConnection();
     bool ProcessPreDetection();
@@ -259,6 +269,21 @@ private:
     \*-----------------------------------------------------*/
     ProfileManager*                             profile_manager;
 
+    /*-----------------------------------------------------*\
+    | Frame Clock                                           |
+    \*-----------------------------------------------------*/
+    FrameClock*                                 frame_clock;
+
+    /*-----------------------------------------------------*\
+    | Effects Engine                                        |
+    \*-----------------------------------------------------*/
+    EffectsEngine*                              effects_engine;
+
+    /*-----------------------------------------------------*\
+    | Network Detection                                     |
+    \*-----------------------------------------------------*/
+    NetworkDetection*                           network_detection;
+
     /*-----------------------------------------------------*\
     | Settings Manager                                      |
     \*-----------------------------------------------------*/
@@ -11,19 +11,75 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #include "SettingsManager.h"
+#include "FileUtils.h"
 #include "LogManager.h"
 
+/*---------------------------------------------------------*\
+| Time to wait after the last SaveSettings() call before    |
+| writing, so bursts of changes result in a single write    |
+\*---------------------------------------------------------*/
+#define SETTINGS_SAVE_DEBOUNCE_MS   500
+
+/*---------------------------------------------------------*\
+| Live instances, flushed when the process exits so that a  |
+| pending save is not lost on exit()                        |
+\*---------------------------------------------------------*/
+static std::mutex                       instances_mutex;
+static std::vector<SettingsManager*>    instances;
+static std::once_flag                   atexit_registered;
+
 SettingsManager::SettingsManager()
 {
-    config_found = false;
+    config_found        = false;
+    settings_data       = std::make_shared<const json>();
+    save_thread         = nullptr;
+    save_pending        = false;
+    save_thread_running = false;
+
+    std::call_once(atexit_registered, []()
+    {
+        std::atexit(FlushAllAtExit);
+    });
+
+    std::lock_guard<std::mutex> instances_lock(instances_mutex);
+    instances.push_back(this);
 }
 
 SettingsManager::~SettingsManager()
 {
+    {
+        std::lock_guard<std::mutex> instances_lock(instances_mutex);
+        instances.erase(std::remove(instances.begin(), instances.end(), this), instances.end());
+    }
+
+    FlushSettings();
+
+    /*-----------------------------------------------------*\
+    | Stop the save thread                                  |
+    \*-----------------------------------------------------*/
+    {
+        std::lock_guard<std::mutex> save_lock(save_mutex);
+        save_thread_running = false;
+    }
+    save_cv.notify_all();
+
+    if(save_thread)
+    {
+        save_thread->join();
+        delete save_thread;
+        save_thread = nullptr;
+    }
+}
 
+std::shared_ptr<const json> SettingsManager::GetSnapshot()
+{
+    return(std::atomic_load(&settings_data));
 }
 
 json SettingsManager::GetSettings(std::string settings_key)
@@ -31,38 +87,49 @@ json SettingsManager::GetSettings(std::string settings_key)
     /*-----------------------------------------------------*\
     | Check to see if the key exists in the settings store  |
     | and return the settings associated with the key if it |
-    | exists.  We lock the mutex to protect the value from  |
-    | changing while data is being read and copy before     |
-    | unlocking.                                            |
+    | exists.  The snapshot is immutable so no lock is      |
+    | needed while copying.                                 |
     \*-----------------------------------------------------*/
-    json result;
+    std::shared_ptr<const json> snapshot = GetSnapshot();
+    json::const_iterator        key_it   = snapshot->find(settings_key);
 
-    mutex.lock();
-    if(settings_data.contains(settings_key))
+    if(key_it != snapshot->end())
     {
-        result = settings_data[settings_key];
+        return(*key_it);
     }
 
-    mutex.unlock();
-
-    return result;
+    return(json());
 }
 
 void SettingsManager::SetSettings(std::string settings_key, json new_settings)
 {
-    mutex.lock();
-    settings_data[settings_key] = new_settings;
-    mutex.unlock();
+    /*-----------------------------------------------------*\
+    | Copy the current document, modify the copy and then   |
+    | publish it.  Readers holding the old snapshot are     |
+    | unaffected.                                           |
+    \*-----------------------------------------------------*/
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::shared_ptr<json> new_data = std::make_shared<json>(*settings_data);
+
+    (*new_data)[settings_key] = new_settings;
+
+    std::atomic_store(&settings_data, std::shared_ptr<const json>(new_data));
 }
 
 void SettingsManager::LoadSettings(const filesystem::path& filename)
 {
     /*-----------------------------------------------------*\
-    | Clear any stored settings before loading              |
+    | Write out anything pending for the previous file      |
     \*-----------------------------------------------------*/
-    mutex.lock();
+    FlushSettings();
 
-    settings_data.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    /*-----------------------------------------------------*\
+    | Clear any stored settings before loading              |
+    \*-----------------------------------------------------*/
+    std::shared_ptr<json> new_data = std::make_shared<json>();
 
     /*-----------------------------------------------------*\
     | Store settings filename, so we can save to it later   |
@@ -84,7 +151,7 @@ void SettingsManager::LoadSettings(const filesystem::path& filename)
         {
             try
             {
-                settings_file >> settings_data;
+                settings_file >> *new_data;
             }
             catch(const std::exception& e)
             {
@@ -97,33 +164,121 @@ void SettingsManager::LoadSettings(const filesystem::path& filename)
                 \*-----------------------------------------*/
                 LOG_ERROR("[SettingsManager] JSON parsing failed: %s", e.what());
 
-                settings_data.clear();
+                new_data->clear();
             }
         }
 
         settings_file.close();
     }
 
-    mutex.unlock();
+    std::atomic_store(&settings_data, std::shared_ptr<const json>(new_data));
 }
 
 void SettingsManager::SaveSettings()
 {
-    mutex.lock();
-    std::ofstream settings_file(settings_filename, std::ios::out | std::ios::binary);
+    /*-----------------------------------------------------*\
+    | Schedule a write on the save thread.  Each call moves |
+    | the deadline, so a burst of changes is written once.  |
+    \*-----------------------------------------------------*/
+    {
+        std::lock_guard<std::mutex> save_lock(save_mutex);
+
+        save_pending  = true;
+        save_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SETTINGS_SAVE_DEBOUNCE_MS);
+
+        if(save_thread == nullptr)
+        {
+            save_thread_running = true;
+            save_thread         = new std::thread(&SettingsManager::SaveThreadFunction, this);
+        }
+    }
+
+    save_cv.notify_all();
+}
+
+void SettingsManager::FlushSettings()
+{
+    /*-----------------------------------------------------*\
+    | Holding write_mutex waits out a write already in      |
+    | progress on the save thread                           |
+    \*-----------------------------------------------------*/
+    std::lock_guard<std::mutex> write_lock(write_mutex);
+
+    bool pending;
 
-    if(settings_file)
     {
-        try
+        std::lock_guard<std::mutex> save_lock(save_mutex);
+
+        pending      = save_pending;
+        save_pending = false;
+    }
+
+    if(!pending)
+    {
+        return;
+    }
+
+    filesystem::path filename;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        filename = settings_filename;
+    }
+
+    WriteSettings(*GetSnapshot(), filename);
+}
+
+void SettingsManager::SaveThreadFunction()
+{
+    std::unique_lock<std::mutex> save_lock(save_mutex);
+
+    while(save_thread_running)
+    {
+        if(!save_pending)
+        {
+            save_cv.wait(save_lock);
+        }
+        else if(std::chrono::steady_clock::now() < save_deadline)
         {
-            settings_file << settings_data.dump(4);
+            save_cv.wait_until(save_lock, save_deadline);
         }
-        catch(const std::exception& e)
+        else
         {
-            LOG_ERROR("[SettingsManager] Cannot write to file: %s", e.what());
+            save_lock.unlock();
+            FlushSettings();
+            save_lock.lock();
         }
+    }
+}
 
-        settings_file.close();
+void SettingsManager::WriteSettings(const json& data, const filesystem::path& filename)
+{
+    std::string settings_string;
+
+    try
+    {
+        settings_string = data.dump(4);
+    }
+    catch(const std::exception& e)
+    {
+        LOG_ERROR("[SettingsManager] Cannot serialize settings: %s", e.what());
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Replace the settings file in one step, so an          |
+    | interrupted write never leaves it truncated           |
+    \*-----------------------------------------------------*/
+    FileUtils::write_file_atomic(filename, settings_string);
+}
+
+void SettingsManager::FlushAllAtExit()
+{
+    std::lock_guard<std::mutex> instances_lock(instances_mutex);
+
+    for(SettingsManager* instance : instances)
+    {
+        instance->FlushSettings();
     }
-    mutex.unlock();
 }
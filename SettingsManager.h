@@ -14,7 +14,11 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <thread>
 #include "filesystem.h"
 
 using json = nlohmann::json;
@@ -44,10 +48,77 @@ public:
     void LoadSettings(const filesystem::path& filename) override;
     void SaveSettings() override;
 
+    /*---------------------------------------------------------*\
+    | Lock-free read access.  The returned snapshot is never    |
+    | modified and stays valid for as long as it is held, even  |
+    | if the settings are changed in the meantime.              |
+    \*---------------------------------------------------------*/
+    std::shared_ptr<const json> GetSnapshot();
+
+    /*---------------------------------------------------------*\
+    | Typed read of a single value without copying the subtree  |
+    | of the settings key.  Returns default_value if the value  |
+    | is missing or has the wrong type.                         |
+    \*---------------------------------------------------------*/
+    template<typename T>
+    T GetSetting(const std::string& settings_key, const std::string& value_key, const T& default_value)
+    {
+        std::shared_ptr<const json> snapshot = GetSnapshot();
+
+        json::const_iterator key_it = snapshot->find(settings_key);
+
+        if((key_it == snapshot->end()) || !key_it->is_object())
+        {
+            return(default_value);
+        }
+
+        json::const_iterator value_it = key_it->find(value_key);
+
+        if(value_it == key_it->end())
+        {
+            return(default_value);
+        }
+
+        try
+        {
+            return(value_it->get<T>());
+        }
+        catch(const std::exception&)
+        {
+            return(default_value);
+        }
+    }
+
+    /*---------------------------------------------------------*\
+    | Writes a pending SaveSettings() to disk before returning  |
+    \*---------------------------------------------------------*/
+    void FlushSettings();
+
 private:
-    json             settings_data;
-    json             settings_prototype;
-    filesystem::path settings_filename;
-    std::mutex       mutex;
-    bool             config_found;
+    /*---------------------------------------------------------*\
+    | Current settings document.  Only accessed through         |
+    | std::atomic_load/std::atomic_store, writers replace it    |
+    | with a modified copy while holding mutex.                 |
+    \*---------------------------------------------------------*/
+    std::shared_ptr<const json>             settings_data;
+    json                                    settings_prototype;
+    filesystem::path                        settings_filename;
+    std::mutex                              mutex;
+    bool                                    config_found;
+
+    /*---------------------------------------------------------*\
+    | Debounced background save                                 |
+    \*---------------------------------------------------------*/
+    std::thread*                            save_thread;
+    std::mutex                              save_mutex;
+    std::mutex                              write_mutex;
+    std::condition_variable                 save_cv;
+    std::chrono::steady_clock::time_point   save_deadline;
+    bool                                    save_pending;
+    bool                                    save_thread_running;
+
+    void SaveThreadFunction();
+    void WriteSettings(const json& data, const filesystem::path& filename);
+
+    static void FlushAllAtExit();
 };
@@ -7,13 +7,18 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include <vector>
 #include <cstring>
 #include <string>
 #include <tuple>
 #include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
 #include "AutoStart.h"
 #include "filesystem.h"
+#include "FrameClock.h"
 #include "ProfileManager.h"
 #include "ResourceManager.h"
 #include "RGBController.h"
@@ -22,6 +27,7 @@
 #include "NetworkServer.h"
 #include "LogManager.h"
 #include "Colors.h"
+#include <nlohmann/json.hpp>
 
 /*-------------------------------------------------------------*\
 | Quirk for MSVC; which doesn't support this case-insensitive   |
@@ -33,10 +39,12 @@
 #endif
 
 using namespace std::chrono_literals;
+using json = nlohmann::json;
 
 static std::string                 profile_save_filename = "";
 const unsigned int                 brightness_percentage = 100;
 const unsigned int                 speed_percentage      = 100;
+const unsigned int                 mode_update_count     = 10;
 
 static int preserve_argc = 0;
 static char** preserve_argv = nullptr;
@@ -401,6 +409,12 @@ void OptionHelp()
     help_text += "--server-host                            Sets the SDK's server host. Default: 0.0.0.0 (all network interfaces)\n";
     help_text += "--server-port                            Sets the SDK's server port. Default: 6742 (1024-65535)\n";
     help_text += "-l,  --list-devices                      Lists every compatible device with their number\n";
+    help_text += "--stats                                  Prints update timing and transport statistics for every device and SMBus\n";
+    help_text += "--benchmark [frames]                     Drives every device with a number of frames (default 1000) as fast as possible and prints statistics\n";
+    help_text += "                                           Configure debug devices with a simulated transport in the DebugDevices settings to benchmark headless\n";
+    help_text += "--benchmark-budget [file] [frames]       Runs --benchmark and checks every device against its budget in the given JSON file, exits with 1 if any is over\n";
+    help_text += "                                           Budgets are keyed by device name, with limits writes_per_frame, bus_us_per_frame, update_us,\n";
+    help_text += "                                           writes_per_mode, bus_us_per_mode and mode_us\n";
     help_text += "-d,  --device [0-9 | \"name\"]             Selects device to apply colors and/or effect to, or applies to all devices if omitted\n";
     help_text += "                                           Basic string search is implemented 3 characters or more\n";
     help_text += "                                           Can be specified multiple times with different modes and colors\n";
@@ -559,6 +573,466 @@ void OptionListDevices(std::vector<RGBController *>& rgb_controllers)
     }
 }
 
+void PrintStatsHistogram(std::string label, const stats_histogram& histogram)
+{
+    label.resize(16, ' ');
+
+    std::cout << "  " << label  << "avg "   << stats_histogram_average(histogram)          << "us"
+                                << ", p50 " << stats_histogram_percentile(histogram, 50.0)  << "us"
+                                << ", p99 " << stats_histogram_percentile(histogram, 99.0)  << "us"
+                                << ", max " << histogram.max_us                             << "us" << std::endl;
+}
+
+void PrintStatsTransports(const rgb_controller_stats& stats)
+{
+    /*---------------------------------------------------------*\
+    | Print per-transport counters, skipping unused transports  |
+    \*---------------------------------------------------------*/
+    for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+    {
+        if(stats.transport_writes[transport_idx] > 0)
+        {
+            std::string transport_str = rgb_controller_transport_to_str(transport_idx);
+
+            transport_str += ":";
+            transport_str.resize(16, ' ');
+
+            std::cout << "  " << transport_str << stats.transport_bytes[transport_idx] << " bytes in "
+                      << stats.transport_writes[transport_idx] << " writes" << std::endl;
+        }
+    }
+}
+
+void OptionStats(std::vector<RGBController *>& rgb_controllers)
+{
+    ResourceManager::get()->WaitForDeviceDetection();
+
+    /*---------------------------------------------------------*\
+    | Print frame clock statistics                              |
+    \*---------------------------------------------------------*/
+    frame_clock_stats clock_stats;
+
+    ResourceManager::get()->GetFrameClock()->GetStats(&clock_stats);
+
+    std::cout << "Frame Clock: " << clock_stats.frame_rate << " FPS" << std::endl;
+    std::cout << "  Ticks:          " << clock_stats.ticks              << " run, "
+                                      << clock_stats.frames_dispatched  << " dispatched, "
+                                      << clock_stats.frames_deferred    << " deferred" << std::endl;
+
+    PrintStatsHistogram("Tick Jitter:", clock_stats.tick_jitter);
+    PrintStatsHistogram("Dispatch Time:", clock_stats.dispatch_time);
+
+    for(unsigned int group_idx = 0; group_idx < FRAME_CLOCK_NUM_GROUPS; group_idx++)
+    {
+        if(clock_stats.devices_dispatched[group_idx] > 0)
+        {
+            std::string group_str = rgb_controller_transport_to_str(group_idx);
+
+            group_str += ":";
+            group_str.resize(16, ' ');
+
+            std::cout << "  " << group_str << clock_stats.devices_dispatched[group_idx] << " device frames" << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+
+    /*---------------------------------------------------------*\
+    | Print SMBus scheduler statistics for busses in use        |
+    \*---------------------------------------------------------*/
+    std::vector<i2c_smbus_interface*>& busses = ResourceManager::get()->GetI2CBusses();
+
+    for(std::size_t bus_idx = 0; bus_idx < busses.size(); bus_idx++)
+    {
+        i2c_smbus_bus_stats bus_stats;
+
+        busses[bus_idx]->get_bus_stats(&bus_stats);
+
+        if((bus_stats.transactions[I2C_SMBUS_PRIORITY_COLOR] + bus_stats.transactions[I2C_SMBUS_PRIORITY_OTHER]) == 0)
+        {
+            continue;
+        }
+
+        std::cout << "I2C Bus " << bus_idx << ": " << busses[bus_idx]->device_name << std::endl;
+        std::cout << "  Utilization:    " << (bus_stats.utilization * 100.0f) << "%, "
+                                          << bus_stats.busy_us << "us busy" << std::endl;
+        std::cout << "  Transactions:   " << bus_stats.transactions[I2C_SMBUS_PRIORITY_COLOR] << " color, "
+                                          << bus_stats.transactions[I2C_SMBUS_PRIORITY_OTHER] << " other, "
+                                          << bus_stats.promoted << " promoted" << std::endl;
+
+        PrintStatsHistogram("Color Wait:", bus_stats.wait_time[I2C_SMBUS_PRIORITY_COLOR]);
+        PrintStatsHistogram("Other Wait:", bus_stats.wait_time[I2C_SMBUS_PRIORITY_OTHER]);
+        PrintStatsHistogram("Transaction:", bus_stats.xfer_time);
+
+        std::cout << std::endl;
+    }
+
+    for(std::size_t controller_idx = 0; controller_idx < rgb_controllers.size(); controller_idx++)
+    {
+        RGBController *         controller = rgb_controllers[controller_idx];
+        rgb_controller_stats    stats;
+
+        controller->GetStats(&stats);
+
+        /*---------------------------------------------------------*\
+        | Print device name                                         |
+        \*---------------------------------------------------------*/
+        std::cout << controller_idx << ": " << controller->name << std::endl;
+
+        /*---------------------------------------------------------*\
+        | Print frame counters                                      |
+        \*---------------------------------------------------------*/
+        std::cout << "  Frames:         " << stats.frames_requested << " requested, "
+                                          << stats.frames_written   << " written, "
+                                          << stats.frames_coalesced << " coalesced" << std::endl;
+
+        /*---------------------------------------------------------*\
+        | Print queue wait and update time distributions            |
+        \*---------------------------------------------------------*/
+        PrintStatsHistogram("Queue Wait:", stats.queue_wait);
+        PrintStatsHistogram("Update Time:", stats.update_time);
+
+        if(stats.modes_written > 0)
+        {
+            PrintStatsHistogram("Mode Time:", stats.mode_time);
+        }
+
+        /*---------------------------------------------------------*\
+        | Print frame clock timing if the frame clock has driven    |
+        | this device                                               |
+        \*---------------------------------------------------------*/
+        if(stats.commit_latency.count > 0)
+        {
+            PrintStatsHistogram("Tick Jitter:", stats.dispatch_jitter);
+            PrintStatsHistogram("Commit Latency:", stats.commit_latency);
+        }
+
+        /*---------------------------------------------------------*\
+        | Print the adaptive rate limit if it is active             |
+        \*---------------------------------------------------------*/
+        rgb_rate_control rate;
+
+        controller->GetRateControl(&rate);
+
+        if(rate.enabled)
+        {
+            std::cout << "  Rate Limit:     " << rate.current_fps  << " FPS, "
+                                              << rate.achieved_fps << " FPS achieved, "
+                                              << rate.decreases    << " cuts" << std::endl;
+            std::cout << "  Rate Latency:   " << rate.latency_us   << "us, "
+                                              << rate.baseline_us  << "us baseline" << std::endl;
+        }
+
+        PrintStatsTransports(stats);
+
+        std::cout << std::endl;
+    }
+}
+
+/*---------------------------------------------------------*\
+| Time the I2C busses were busy since their statistics were |
+| last reset                                                |
+\*---------------------------------------------------------*/
+unsigned long long GetI2CBusTime(std::vector<i2c_smbus_interface*>& busses, bool reset)
+{
+    unsigned long long busy_us = 0;
+
+    for(std::size_t bus_idx = 0; bus_idx < busses.size(); bus_idx++)
+    {
+        i2c_smbus_bus_stats bus_stats;
+
+        busses[bus_idx]->get_bus_stats(&bus_stats);
+
+        busy_us += bus_stats.busy_us;
+
+        if(reset)
+        {
+            busses[bus_idx]->reset_bus_stats();
+        }
+    }
+
+    return(busy_us);
+}
+
+/*---------------------------------------------------------*\
+| Compare a benchmark result against its budget, if the     |
+| budget has a limit for it                                 |
+\*---------------------------------------------------------*/
+bool CheckBenchmarkBudget(const json& budget, const char* key, double value)
+{
+    if(!budget.contains(key) || !budget[key].is_number())
+    {
+        return(true);
+    }
+
+    double limit = budget[key].get<double>();
+
+    if(value > limit)
+    {
+        std::cout << "  Over Budget:    " << key << " " << value << " > " << limit << std::endl;
+        return(false);
+    }
+
+    return(true);
+}
+
+bool OptionBenchmark(unsigned int frames, std::vector<RGBController *>& rgb_controllers, const std::string& budget_filename)
+{
+    ResourceManager::get()->WaitForDeviceDetection();
+
+    /*---------------------------------------------------------*\
+    | Load the budgets, keyed by controller name                |
+    \*---------------------------------------------------------*/
+    json budgets;
+    bool passed = true;
+
+    if(!budget_filename.empty())
+    {
+        std::ifstream budget_file(budget_filename);
+
+        try
+        {
+            budgets = json::parse(budget_file);
+        }
+        catch(const std::exception& e)
+        {
+            std::cout << "Error: Unable to read budget file " << budget_filename << ": " << e.what() << std::endl;
+            return(false);
+        }
+
+        if(!budgets.is_object())
+        {
+            std::cout << "Error: Budget file " << budget_filename << " is not an object keyed by controller name" << std::endl;
+            return(false);
+        }
+    }
+
+    std::vector<std::string> budgets_checked;
+
+    std::vector<i2c_smbus_interface*>& busses = ResourceManager::get()->GetI2CBusses();
+
+    for(std::size_t controller_idx = 0; controller_idx < rgb_controllers.size(); controller_idx++)
+    {
+        RGBController *             controller = rgb_controllers[controller_idx];
+        RGBControllerStatsHistogram sdk_time;
+        rgb_controller_stats        stats;
+
+        if(controller->colors.empty())
+        {
+            continue;
+        }
+
+        std::cout << controller_idx << ": " << controller->name << std::endl;
+
+        std::vector<RGBColor> saved_colors = controller->colors;
+
+        controller->ResetStats();
+
+        /*---------------------------------------------------------*\
+        | Only this controller is driven, so the time the I2C       |
+        | busses are busy from here on is its bus time              |
+        \*---------------------------------------------------------*/
+        GetI2CBusTime(busses, true);
+
+        /*---------------------------------------------------------*\
+        | Reapply the active mode a few times, one at a time so     |
+        | none of them are merged                                   |
+        \*---------------------------------------------------------*/
+        for(unsigned int mode_idx = 0; mode_idx < mode_update_count; mode_idx++)
+        {
+            controller->UpdateMode();
+
+            std::chrono::steady_clock::time_point mode_deadline = std::chrono::steady_clock::now() + 5s;
+
+            do
+            {
+                controller->GetStats(&stats);
+
+                if(stats.modes_written > mode_idx)
+                {
+                    break;
+                }
+
+                std::this_thread::sleep_for(1ms);
+            } while(std::chrono::steady_clock::now() < mode_deadline);
+        }
+
+        unsigned long long mode_bus_us = GetI2CBusTime(busses, true);
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        for(unsigned int frame_idx = 0; frame_idx < frames; frame_idx++)
+        {
+            /*---------------------------------------------------------*\
+            | Generate a moving gradient so every frame differs         |
+            \*---------------------------------------------------------*/
+            for(std::size_t color_idx = 0; color_idx < controller->colors.size(); color_idx++)
+            {
+                unsigned char step = (unsigned char)(frame_idx + color_idx);
+
+                controller->colors[color_idx] = ToRGBColor(step, (unsigned char)(255 - step), (unsigned char)(step ^ 0x80));
+            }
+
+            /*---------------------------------------------------------*\
+            | Pass the frame through the SDK color description path,    |
+            | as the server does for NET_PACKET_ID_RGBCONTROLLER_       |
+            | UPDATELEDS, then queue it for the device thread           |
+            \*---------------------------------------------------------*/
+            std::chrono::steady_clock::time_point sdk_start = std::chrono::steady_clock::now();
+
+            unsigned char* color_description = controller->GetColorDescription();
+            controller->SetColorDescription(color_description);
+            delete[] color_description;
+
+            sdk_time.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sdk_start).count());
+
+            controller->UpdateLEDs();
+        }
+
+        /*---------------------------------------------------------*\
+        | Wait for the device thread to write or coalesce every     |
+        | requested frame                                           |
+        \*---------------------------------------------------------*/
+        std::chrono::steady_clock::time_point drain_deadline = std::chrono::steady_clock::now() + 5s;
+
+        do
+        {
+            controller->GetStats(&stats);
+
+            if((stats.frames_written + stats.frames_coalesced) >= stats.frames_requested)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(1ms);
+        } while(std::chrono::steady_clock::now() < drain_deadline);
+
+        double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        unsigned long long frame_bus_us = GetI2CBusTime(busses, false);
+
+        stats_histogram sdk_stats;
+        sdk_time.Snapshot(&sdk_stats);
+
+        std::cout << "  Elapsed:        " << elapsed_sec << "s" << std::endl;
+        std::cout << "  Throughput:     " << (stats.frames_requested / elapsed_sec) << " frames/s requested, "
+                                          << (stats.frames_written   / elapsed_sec) << " frames/s written" << std::endl;
+        std::cout << "  Frames:         " << stats.frames_requested << " requested, "
+                                          << stats.frames_written   << " written, "
+                                          << stats.frames_coalesced << " coalesced" << std::endl;
+
+        PrintStatsHistogram("SDK Colors:", sdk_stats);
+        PrintStatsHistogram("Queue Wait:", stats.queue_wait);
+        PrintStatsHistogram("Update Time:", stats.update_time);
+        PrintStatsTransports(stats);
+
+        /*---------------------------------------------------------*\
+        | Print writes and bus time per written frame and per mode  |
+        | update.  The update time not spent on the bus is mostly   |
+        | the driver's own delays.                                  |
+        \*---------------------------------------------------------*/
+        double frame_writes     = 0.0;
+        double frame_bus        = 0.0;
+        double mode_writes      = 0.0;
+        double mode_bus         = 0.0;
+
+        if(stats.frames_written > 0)
+        {
+            unsigned long long writes = 0;
+
+            for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+            {
+                writes += stats.transport_writes[transport_idx];
+            }
+
+            frame_writes        = (double)writes / stats.frames_written;
+            frame_bus           = (double)frame_bus_us / stats.frames_written;
+
+            std::cout << "  Per Frame:      " << frame_writes << " writes, "
+                                              << frame_bus    << "us bus time" << std::endl;
+
+            /*-----------------------------------------------------*\
+            | Report rate while the driver is sending a frame, the  |
+            | rate its transport sustains for back to back writes   |
+            \*-----------------------------------------------------*/
+            double update_us    = (double)stats_histogram_average(stats.update_time);
+
+            if(update_us > 0.0)
+            {
+                std::cout << "  Write Rate:     " << (frame_writes * 1000000.0 / update_us) << " writes/s while updating" << std::endl;
+            }
+        }
+
+        if(stats.modes_written > 0)
+        {
+            mode_writes         = (double)stats.mode_writes / stats.modes_written;
+            mode_bus            = (double)mode_bus_us / stats.modes_written;
+
+            std::cout << "  Per Mode:       " << mode_writes << " writes, "
+                                              << mode_bus    << "us bus time" << std::endl;
+
+            PrintStatsHistogram("Mode Time:", stats.mode_time);
+        }
+
+        /*---------------------------------------------------------*\
+        | Check the results against the controller's budget         |
+        \*---------------------------------------------------------*/
+        if(budgets.is_object() && budgets.contains(controller->name))
+        {
+            const json& budget = budgets[controller->name];
+            bool        within = true;
+
+            budgets_checked.push_back(controller->name);
+
+            /*-----------------------------------------------------*\
+            | A device that wrote no frames has no results to hold  |
+            | against its budget                                    |
+            \*-----------------------------------------------------*/
+            if(stats.frames_written == 0)
+            {
+                std::cout << "  No Frames:      no frames were written" << std::endl;
+                within = false;
+            }
+
+            within &= CheckBenchmarkBudget(budget, "writes_per_frame", frame_writes);
+            within &= CheckBenchmarkBudget(budget, "bus_us_per_frame", frame_bus);
+            within &= CheckBenchmarkBudget(budget, "update_us", (double)stats_histogram_average(stats.update_time));
+            within &= CheckBenchmarkBudget(budget, "writes_per_mode", mode_writes);
+            within &= CheckBenchmarkBudget(budget, "bus_us_per_mode", mode_bus);
+            within &= CheckBenchmarkBudget(budget, "mode_us", (double)stats_histogram_average(stats.mode_time));
+
+            std::cout << "  Budget:         " << (within ? "passed" : "failed") << std::endl;
+
+            passed &= within;
+        }
+
+        /*---------------------------------------------------------*\
+        | Restore the colors the device had before the benchmark    |
+        \*---------------------------------------------------------*/
+        controller->colors = saved_colors;
+        controller->UpdateLEDs();
+
+        std::cout << std::endl;
+    }
+
+    /*---------------------------------------------------------*\
+    | Every budgeted device must have been detected and run     |
+    \*---------------------------------------------------------*/
+    if(budgets.is_object())
+    {
+        for(json::const_iterator budget = budgets.begin(); budget != budgets.end(); budget++)
+        {
+            if(std::find(budgets_checked.begin(), budgets_checked.end(), budget.key()) == budgets_checked.end())
+            {
+                std::cout << "Budget failed: " << budget.key() << " was not detected" << std::endl;
+                passed = false;
+            }
+        }
+    }
+
+    return(passed);
+}
+
 bool OptionDevice(std::vector<DeviceOptions>* current_devices, std::string argument, Options* options, std::vector<RGBController *>& rgb_controllers)
 {
     bool found = false;
@@ -958,6 +1432,75 @@ int ProcessOptions(Options* options, std::vector<RGBController *>& rgb_controlle
             exit(0);
         }
 
+        /*---------------------------------------------------------*\
+        | --stats (no arguments)                                    |
+        \*---------------------------------------------------------*/
+        else if(option == "--stats")
+        {
+            OptionStats(rgb_controllers);
+            exit(0);
+        }
+
+        /*---------------------------------------------------------*\
+        | --benchmark [frames]                                      |
+        \*---------------------------------------------------------*/
+        else if(option == "--benchmark")
+        {
+            unsigned int frames = 1000;
+
+            if(!argument.empty() && (argument.find_first_not_of("0123456789") == std::string::npos))
+            {
+                try
+                {
+                    frames = std::stoi(argument);
+                }
+                catch(std::exception& /*e*/)
+                {
+                    std::cout << "Error: Invalid frame count for --benchmark: " << argument << std::endl;
+                    return RET_FLAG_PRINT_HELP;
+                }
+
+                arg_index++;
+            }
+
+            OptionBenchmark(frames, rgb_controllers, "");
+            exit(0);
+        }
+
+        /*---------------------------------------------------------*\
+        | --benchmark-budget [file] [frames]                        |
+        \*---------------------------------------------------------*/
+        else if(option == "--benchmark-budget")
+        {
+            unsigned int frames = 1000;
+
+            if(argument.empty())
+            {
+                std::cout << "Error: --benchmark-budget requires a budget file" << std::endl;
+                return RET_FLAG_PRINT_HELP;
+            }
+
+            if(arg_index + 2 < preserve_argc)
+            {
+                std::string frames_argument = preserve_argv[arg_index + 2];
+
+                if(!frames_argument.empty() && (frames_argument.find_first_not_of("0123456789") == std::string::npos))
+                {
+                    try
+                    {
+                        frames = std::stoi(frames_argument);
+                    }
+                    catch(std::exception& /*e*/)
+                    {
+                        std::cout << "Error: Invalid frame count for --benchmark-budget: " << frames_argument << std::endl;
+                        return RET_FLAG_PRINT_HELP;
+                    }
+                }
+            }
+
+            exit(OptionBenchmark(frames, rgb_controllers, argument) ? 0 : 1);
+        }
+
         /*---------------------------------------------------------*\
         | -d / --device                                             |
         \*---------------------------------------------------------*/
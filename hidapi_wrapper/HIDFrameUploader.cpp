@@ -0,0 +1,347 @@
+/*---------------------------------------------------------*\
+| HIDFrameUploader.cpp                                      |
+|                                                           |
+|   Packs a frame of colors into a reused set of HID        |
+|   reports from a driver declared layout and sends them    |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstring>
+#include "HIDFrameUploader.h"
+
+HIDFrameUploader::HIDFrameUploader()
+{
+    wrapper                     = hidapi_wrapper_get_default();
+    dev                         = nullptr;
+    report_count                = 0;
+    frame_length                = 0;
+
+    layout.report_type          = HID_FRAME_REPORT_OUTPUT;
+    layout.report_size          = 0;
+    layout.payload_offset       = 0;
+    layout.first_payload_offset = 0;
+    layout.max_payload          = 0;
+    layout.length_offset        = -1;
+    layout.packing              = HID_FRAME_PACKING_INTERLEAVED;
+    layout.color_order          = RGB_COLOR_ORDER_RGB;
+    layout.ack_timeout          = -1;
+}
+
+void HIDFrameUploader::SetDevice(hidapi_wrapper wrapper, hid_device* dev)
+{
+    this->wrapper   = wrapper;
+    this->dev       = dev;
+}
+
+void HIDFrameUploader::SetLayout(const hid_frame_layout& layout)
+{
+    this->layout = layout;
+
+    if((this->layout.color_order < 0) || (this->layout.color_order >= RGB_COLOR_ORDER_COUNT))
+    {
+        this->layout.color_order = RGB_COLOR_ORDER_RGB;
+    }
+
+    /*-----------------------------------------------------*\
+    | Rebuild the reports with the new headers on the next  |
+    | upload                                                |
+    \*-----------------------------------------------------*/
+    reports.clear();
+    ack_buffer.resize(this->layout.report_size);
+    report_count    = 0;
+    frame_length    = 0;
+}
+
+int HIDFrameUploader::Upload(const RGBColor* colors, unsigned int count)
+{
+    BuildReports(count * 3);
+    PackFrame(colors, count);
+
+    return(SendReports());
+}
+
+int HIDFrameUploader::Upload(const std::vector<RGBColor *>& colors)
+{
+    /*-----------------------------------------------------*\
+    | Gather the colors first, so each pointer is followed  |
+    | once rather than once per planar channel              |
+    \*-----------------------------------------------------*/
+    gathered.resize(colors.size());
+
+    for(std::size_t led_idx = 0; led_idx < colors.size(); led_idx++)
+    {
+        gathered[led_idx] = *colors[led_idx];
+    }
+
+    BuildReports((unsigned int)gathered.size() * 3);
+    PackFrame(gathered.data(), (unsigned int)gathered.size());
+
+    return(SendReports());
+}
+
+int HIDFrameUploader::Upload(const unsigned char* data, unsigned int length)
+{
+    BuildReports(length);
+
+    for(unsigned int report_idx = 0; report_idx < report_count; report_idx++)
+    {
+        unsigned int size = payload_sizes[report_idx];
+
+        memcpy(Report(report_idx) + PayloadOffset(report_idx), data, size);
+        data += size;
+    }
+
+    return(SendReports());
+}
+
+unsigned int HIDFrameUploader::GetReportCount()
+{
+    return(report_count + (layout.commit.empty() ? 0 : 1));
+}
+
+unsigned int HIDFrameUploader::PayloadOffset(unsigned int report_idx)
+{
+    if((report_idx == 0) && !layout.first_header.empty())
+    {
+        return(layout.first_payload_offset);
+    }
+
+    return(layout.payload_offset);
+}
+
+unsigned int HIDFrameUploader::PayloadSize(unsigned int report_idx)
+{
+    /*-----------------------------------------------------*\
+    | Every report but the last is full, the last one holds |
+    | what is left of the frame                             |
+    \*-----------------------------------------------------*/
+    unsigned int first_capacity = layout.report_size - PayloadOffset(0);
+    unsigned int capacity       = layout.report_size - layout.payload_offset;
+
+    if(layout.max_payload != 0)
+    {
+        first_capacity          = std::min(first_capacity, layout.max_payload);
+        capacity                = std::min(capacity,       layout.max_payload);
+    }
+
+    if(report_idx == 0)
+    {
+        return(std::min(first_capacity, frame_length));
+    }
+
+    unsigned int start          = first_capacity + ((report_idx - 1) * capacity);
+
+    return(std::min(capacity, frame_length - start));
+}
+
+unsigned char* HIDFrameUploader::Report(unsigned int report_idx)
+{
+    return(&reports[report_idx * layout.report_size]);
+}
+
+void HIDFrameUploader::BuildReports(unsigned int length)
+{
+    if(!reports.empty() && (length == frame_length))
+    {
+        return;
+    }
+
+    frame_length = length;
+    report_count = 0;
+    payload_sizes.clear();
+
+    /*-----------------------------------------------------*\
+    | Count the reports the frame needs.  A layout whose    |
+    | header leaves no room for payload sends none.         |
+    \*-----------------------------------------------------*/
+    if((layout.report_size > PayloadOffset(0)) && (layout.report_size > layout.payload_offset))
+    {
+        unsigned int packed = 0;
+
+        while(packed < frame_length)
+        {
+            payload_sizes.push_back(PayloadSize(report_count));
+            packed += payload_sizes.back();
+            report_count++;
+        }
+    }
+
+    /*-----------------------------------------------------*\
+    | Zero the reports so the end of the last one is padded |
+    | and write the headers, which stay in place for every  |
+    | frame of this length                                  |
+    \*-----------------------------------------------------*/
+    reports.assign((std::size_t)std::max(report_count, 1u) * layout.report_size, 0);
+
+    for(unsigned int report_idx = 0; report_idx < report_count; report_idx++)
+    {
+        const std::vector<unsigned char>& header = ((report_idx == 0) && !layout.first_header.empty()) ? layout.first_header : layout.header;
+
+        memcpy(Report(report_idx), header.data(), std::min((unsigned int)header.size(), PayloadOffset(report_idx)));
+    }
+
+    if((report_count > 0) && (layout.length_offset >= 0) && ((unsigned int)layout.length_offset + 1 < layout.report_size))
+    {
+        Report(0)[layout.length_offset]     = (unsigned char)(frame_length & 0xFF);
+        Report(0)[layout.length_offset + 1] = (unsigned char)(frame_length >> 8);
+    }
+}
+
+int HIDFrameUploader::SendReports()
+{
+    if(dev == nullptr)
+    {
+        return(-1);
+    }
+
+    /*-----------------------------------------------------*\
+    | Send the reports back to back.  hidapi has no         |
+    | asynchronous write, so each write returns once the    |
+    | report is handed to the OS or transferred.            |
+    \*-----------------------------------------------------*/
+    unsigned int sent = 0;
+
+    for(unsigned int report_idx = 0; report_idx <= report_count; report_idx++)
+    {
+        const unsigned char*    report;
+        std::size_t             size;
+
+        if(report_idx < report_count)
+        {
+            report  = Report(report_idx);
+            size    = layout.report_size;
+        }
+        else if(!layout.commit.empty())
+        {
+            report  = layout.commit.data();
+            size    = layout.commit.size();
+        }
+        else
+        {
+            break;
+        }
+
+        int ret;
+
+        if(layout.report_type == HID_FRAME_REPORT_FEATURE)
+        {
+            ret = wrapper.hid_send_feature_report(dev, report, size);
+        }
+        else
+        {
+            ret = wrapper.hid_write(dev, report, size);
+        }
+
+        if(ret < 0)
+        {
+            return(-1);
+        }
+
+        if(layout.ack_timeout >= 0)
+        {
+            wrapper.hid_read_timeout(dev, ack_buffer.data(), ack_buffer.size(), layout.ack_timeout);
+        }
+
+        sent++;
+    }
+
+    return((int)sent);
+}
+
+void HIDFrameUploader::PackFrame(const RGBColor* colors, unsigned int count)
+{
+    /*-----------------------------------------------------*\
+    | Byte N of a packed LED is channel channels[N] of the  |
+    | RGBColor, 8 bits per channel                          |
+    \*-----------------------------------------------------*/
+    const unsigned char*    channels    = rgb_color_order_channels[layout.color_order];
+
+    if(report_count == 0)
+    {
+        return;
+    }
+
+    if(layout.packing == HID_FRAME_PACKING_PLANAR)
+    {
+        /*-------------------------------------------------*\
+        | Planes follow each other in the stream.  Copy the |
+        | run of a plane that fits in a report at a time.   |
+        \*-------------------------------------------------*/
+        unsigned int    report_idx  = 0;
+        unsigned char*  out         = Report(0) + PayloadOffset(0);
+        unsigned int    left        = payload_sizes[0];
+
+        for(unsigned int plane = 0; plane < 3; plane++)
+        {
+            unsigned int    plane_shift = channels[plane] * 8;
+            unsigned int    led_idx     = 0;
+
+            while(led_idx < count)
+            {
+                if(left == 0)
+                {
+                    report_idx++;
+                    out         = Report(report_idx) + PayloadOffset(report_idx);
+                    left        = payload_sizes[report_idx];
+                }
+
+                unsigned int run = std::min(left, count - led_idx);
+
+                for(unsigned int run_idx = 0; run_idx < run; run_idx++)
+                {
+                    out[run_idx] = (unsigned char)(colors[led_idx + run_idx] >> plane_shift);
+                }
+
+                out        += run;
+                left       -= run;
+                led_idx    += run;
+            }
+        }
+
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Interleaved, channel is the byte of the LED.  An LED  |
+    | split over two reports is finished one byte at a      |
+    | time, whole LEDs are packed together.                 |
+    \*-----------------------------------------------------*/
+    unsigned int led_idx = 0;
+    unsigned int channel = 0;
+
+    for(unsigned int report_idx = 0; report_idx < report_count; report_idx++)
+    {
+        unsigned char*  out     = Report(report_idx) + PayloadOffset(report_idx);
+        unsigned int    size    = payload_sizes[report_idx];
+
+        while((size > 0) && (channel != 0))
+        {
+            *out++  = (unsigned char)(colors[led_idx] >> (channels[channel] * 8));
+            size--;
+
+            if(++channel == 3)
+            {
+                channel = 0;
+                led_idx++;
+            }
+        }
+
+        unsigned int leds = size / 3;
+
+        rgb_color_pack(&colors[led_idx], leds, out, layout.color_order);
+
+        led_idx    += leds;
+        out        += leds * 3;
+        size       -= leds * 3;
+
+        while(size > 0)
+        {
+            *out++  = (unsigned char)(colors[led_idx] >> (channels[channel] * 8));
+            size--;
+            channel++;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*---------------------------------------------------------*\
+| HIDFrameUploader.h                                        |
+|                                                           |
+|   Packs a frame of colors into a reused set of HID        |
+|   reports from a driver declared layout and sends them    |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <vector>
+#include <hidapi.h>
+#include "hidapi_wrapper.h"
+#include "RGBControllerColorFormat.h"
+
+/*---------------------------------------------------------*\
+| Report Types                                              |
+\*---------------------------------------------------------*/
+enum
+{
+    HID_FRAME_REPORT_OUTPUT             = 0,    /* Sent with hid_write                  */
+    HID_FRAME_REPORT_FEATURE            = 1,    /* Sent with hid_send_feature_report    */
+};
+
+/*---------------------------------------------------------*\
+| Payload Packings                                          |
+\*---------------------------------------------------------*/
+enum
+{
+    HID_FRAME_PACKING_INTERLEAVED       = 0,    /* 3 bytes per LED in color_order       */
+    HID_FRAME_PACKING_PLANAR            = 1,    /* All red, then all green, then blue   */
+};
+
+/*---------------------------------------------------------*\
+| Packet layout of a device's frame upload.  The packed     |
+| frame is a byte stream split over as many reports as      |
+| needed, max_payload bytes each, placed after a fixed      |
+| header.  The first report may use its own header and      |
+| payload offset, as block writes that carry the frame      |
+| length in the first packet do.                            |
+\*---------------------------------------------------------*/
+typedef struct
+{
+    int                         report_type;
+    unsigned int                report_size;            /* Bytes per report, report ID included */
+    std::vector<unsigned char>  header;                 /* Start of every report                */
+    unsigned int                payload_offset;
+    std::vector<unsigned char>  first_header;           /* Start of the first report, if set    */
+    unsigned int                first_payload_offset;
+    unsigned int                max_payload;            /* Payload bytes per report, 0 for all  */
+                                                        /* bytes after the payload offset       */
+    int                         length_offset;          /* Frame length in the first report,    */
+                                                        /* 16-bit little endian, -1 for none    */
+    int                         packing;
+    int                         color_order;            /* RGB_COLOR_ORDER_*, both packings     */
+    int                         ack_timeout;            /* Read a response after each report,   */
+                                                        /* in ms, -1 to send back to back       */
+    std::vector<unsigned char>  commit;                 /* Sent after the frame, if set         */
+} hid_frame_layout;
+
+/*---------------------------------------------------------*\
+| HID Frame Uploader Class                                  |
+|                                                           |
+| Replaces the per-driver loops that pack one report at a   |
+| time and send it before building the next.  Reports are   |
+| built once per frame size with their headers in place, so |
+| each frame only packs colors into the payloads and sends  |
+| the reports from the same buffer.                         |
+\*---------------------------------------------------------*/
+class HIDFrameUploader
+{
+public:
+    HIDFrameUploader();
+
+    void                    SetDevice(hidapi_wrapper wrapper, hid_device* dev);
+    void                    SetLayout(const hid_frame_layout& layout);
+
+    /*---------------------------------------------------------*\
+    | Pack and send a frame, from a color buffer, from a map of |
+    | color pointers as drivers with sparse key maps keep, or   |
+    | from a frame the driver already packed.  Returns the      |
+    | number of reports sent, or -1 when a write failed.        |
+    \*---------------------------------------------------------*/
+    int                     Upload(const RGBColor* colors, unsigned int count);
+    int                     Upload(const std::vector<RGBColor *>& colors);
+    int                     Upload(const unsigned char* data, unsigned int length);
+
+    unsigned int            GetReportCount();
+
+private:
+    hidapi_wrapper                  wrapper;
+    hid_device*                     dev;
+    hid_frame_layout                layout;
+
+    std::vector<unsigned char>      reports;
+    std::vector<unsigned char>      ack_buffer;
+    std::vector<unsigned int>       payload_sizes;
+    std::vector<RGBColor>           gathered;
+    unsigned int                    report_count;
+    unsigned int                    frame_length;
+
+    unsigned int            PayloadOffset(unsigned int report_idx);
+    unsigned int            PayloadSize(unsigned int report_idx);
+    unsigned char*          Report(unsigned int report_idx);
+
+    void                    BuildReports(unsigned int length);
+    int                     SendReports();
+    void                    PackFrame(const RGBColor* colors, unsigned int count);
+};
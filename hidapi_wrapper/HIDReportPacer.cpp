@@ -0,0 +1,64 @@
+/*---------------------------------------------------------*\
+| HIDReportPacer.cpp                                        |
+|                                                           |
+|   Minimum spacing between the reports sent to a HID       |
+|   device, waited only when reports come too close         |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <thread>
+#include "HIDReportPacer.h"
+
+HIDReportPacer::HIDReportPacer() : HIDReportPacer(std::chrono::microseconds(0))
+{
+}
+
+HIDReportPacer::HIDReportPacer(std::chrono::microseconds spacing)
+{
+    this->spacing   = spacing;
+    next_report     = std::chrono::steady_clock::now();
+}
+
+void HIDReportPacer::SetSpacing(std::chrono::microseconds spacing)
+{
+    std::lock_guard<std::mutex> lock(PacerMutex);
+
+    this->spacing = spacing;
+}
+
+void HIDReportPacer::WaitForReport()
+{
+    std::chrono::steady_clock::time_point wait_until;
+
+    {
+        std::lock_guard<std::mutex> lock(PacerMutex);
+
+        wait_until = next_report;
+    }
+
+    std::this_thread::sleep_until(wait_until);
+}
+
+void HIDReportPacer::ReportSent()
+{
+    std::lock_guard<std::mutex> lock(PacerMutex);
+
+    next_report = std::chrono::steady_clock::now() + spacing;
+}
+
+void HIDReportPacer::ReportSent(std::chrono::microseconds gap)
+{
+    std::lock_guard<std::mutex> lock(PacerMutex);
+
+    next_report = std::chrono::steady_clock::now() + gap;
+}
+
+void HIDReportPacer::Delay(std::chrono::microseconds gap)
+{
+    std::lock_guard<std::mutex> lock(PacerMutex);
+
+    next_report = std::max(next_report, std::chrono::steady_clock::now()) + gap;
+}
@@ -0,0 +1,56 @@
+/*---------------------------------------------------------*\
+| HIDReportPacer.h                                          |
+|                                                           |
+|   Minimum spacing between the reports sent to a HID       |
+|   device, waited only when reports come too close         |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+/*---------------------------------------------------------*\
+| Drivers for devices that drop reports sent back to back   |
+| call WaitForReport() before and ReportSent() after each   |
+| report instead of sleeping after it.  The wait only lasts |
+| for what is left of the gap, so time spent elsewhere,     |
+| such as between two frames, counts towards it.            |
+\*---------------------------------------------------------*/
+class HIDReportPacer
+{
+public:
+    HIDReportPacer();
+    HIDReportPacer(std::chrono::microseconds spacing);
+
+    /*---------------------------------------------------------*\
+    | Gap used by ReportSent() without an argument              |
+    \*---------------------------------------------------------*/
+    void                    SetSpacing(std::chrono::microseconds spacing);
+
+    /*---------------------------------------------------------*\
+    | Wait until the gap after the previous report has passed   |
+    \*---------------------------------------------------------*/
+    void                    WaitForReport();
+
+    /*---------------------------------------------------------*\
+    | Start the gap before the next report, either the default  |
+    | spacing or one for this report, e.g. after a mode change  |
+    | the device takes longer to process                        |
+    \*---------------------------------------------------------*/
+    void                    ReportSent();
+    void                    ReportSent(std::chrono::microseconds gap);
+
+    /*---------------------------------------------------------*\
+    | Extend the gap before the next report                     |
+    \*---------------------------------------------------------*/
+    void                    Delay(std::chrono::microseconds gap);
+
+private:
+    std::mutex                              PacerMutex;
+    std::chrono::microseconds               spacing;
+    std::chrono::steady_clock::time_point   next_report;
+};
@@ -0,0 +1,698 @@
+/*---------------------------------------------------------*\
+| hidapi_wrapper.cpp                                        |
+|                                                           |
+|   Default, recording and replay backends for the hidapi   |
+|   wrapper                                                 |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "hidapi_wrapper.h"
+#include "LogManager.h"
+#include "RGBControllerStats.h"
+
+/*---------------------------------------------------------*\
+| Recording state                                           |
+\*---------------------------------------------------------*/
+static std::mutex                           record_mutex;
+static std::atomic<bool>                    record_active(false);
+static FILE*                                record_file         = NULL;
+static std::map<hid_device*, std::string>   record_paths;
+
+/*---------------------------------------------------------*\
+| Replay state                                              |
+\*---------------------------------------------------------*/
+struct replay_op
+{
+    char                        op;
+    int                         ret;
+    std::vector<unsigned char>  data;
+};
+
+struct replay_device
+{
+    std::string                 path;
+    unsigned short              vendor_id;
+    unsigned short              product_id;
+    int                         interface_number;
+    unsigned short              usage_page;
+    unsigned short              usage;
+    std::vector<replay_op>      ops;
+};
+
+struct replay_handle
+{
+    std::shared_ptr<replay_device>  device;
+    std::size_t                 position;
+};
+
+static std::mutex                           replay_mutex;
+static std::string                          replay_filename;
+static std::vector<std::shared_ptr<replay_device>>  replay_devices;
+
+static std::string BytesToHex(const unsigned char* data, int length)
+{
+    static const char   hex_digits[]    = "0123456789ABCDEF";
+    std::string         hex;
+
+    if((data == NULL) || (length <= 0))
+    {
+        return("-");
+    }
+
+    hex.reserve(length * 2);
+
+    for(int byte_idx = 0; byte_idx < length; byte_idx++)
+    {
+        hex.push_back(hex_digits[data[byte_idx] >> 4]);
+        hex.push_back(hex_digits[data[byte_idx] & 0x0F]);
+    }
+
+    return(hex);
+}
+
+static std::vector<unsigned char> HexToBytes(const std::string& hex)
+{
+    std::vector<unsigned char> data;
+
+    if(hex == "-")
+    {
+        return(data);
+    }
+
+    data.reserve(hex.size() / 2);
+
+    for(std::size_t char_idx = 0; (char_idx + 1) < hex.size(); char_idx += 2)
+    {
+        data.push_back((unsigned char)std::stoul(hex.substr(char_idx, 2), nullptr, 16));
+    }
+
+    return(data);
+}
+
+/*---------------------------------------------------------*\
+| Serial number, manufacturer and product strings are       |
+| stored as 2 bytes (4 hex digits) per character            |
+\*---------------------------------------------------------*/
+static std::vector<unsigned char> WideToBytes(const wchar_t* string)
+{
+    std::vector<unsigned char> data;
+
+    for(std::size_t char_idx = 0; string[char_idx] != 0; char_idx++)
+    {
+        data.push_back((unsigned char)((string[char_idx] >> 8) & 0xFF));
+        data.push_back((unsigned char)(string[char_idx] & 0xFF));
+    }
+
+    return(data);
+}
+
+static void RecordLine(char op, const std::string& ret, const std::string& hex, const std::string& path)
+{
+    if(record_file != NULL)
+    {
+        fprintf(record_file, "%c %s %s %s\n", op, ret.c_str(), hex.c_str(), path.c_str());
+        fflush(record_file);
+    }
+}
+
+static void RecordCall(hid_device* dev, char op, int ret, const unsigned char* data, int length)
+{
+    if(!record_active.load())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(record_mutex);
+
+    std::map<hid_device*, std::string>::iterator path = record_paths.find(dev);
+
+    if(path != record_paths.end())
+    {
+        RecordLine(op, std::to_string(ret), BytesToHex(data, length), path->second);
+    }
+}
+
+/*---------------------------------------------------------*\
+| Default backend                                           |
+\*---------------------------------------------------------*/
+static int default_hid_send_feature_report(hid_device* dev, const unsigned char* data, size_t length)
+{
+    int ret = hid_send_feature_report(dev, data, length);
+
+    if(ret >= 0)
+    {
+        RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_HID, ret);
+    }
+
+    RecordCall(dev, 'F', ret, data, (int)length);
+
+    return(ret);
+}
+
+static int default_hid_get_feature_report(hid_device* dev, unsigned char* data, size_t length)
+{
+    int ret = hid_get_feature_report(dev, data, length);
+
+    RecordCall(dev, 'G', ret, data, ret);
+
+    return(ret);
+}
+
+static void RecordString(hid_device* dev, char op, int ret, const wchar_t* string)
+{
+    if(record_active.load())
+    {
+        std::vector<unsigned char> bytes = (ret == 0) ? WideToBytes(string) : std::vector<unsigned char>();
+
+        RecordCall(dev, op, ret, bytes.data(), (int)bytes.size());
+    }
+}
+
+static int default_hid_get_serial_number_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    int ret = hid_get_serial_number_string(dev, string, maxlen);
+
+    RecordString(dev, 'S', ret, string);
+
+    return(ret);
+}
+
+static int default_hid_get_manufacturer_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    int ret = hid_get_manufacturer_string(dev, string, maxlen);
+
+    RecordString(dev, 'M', ret, string);
+
+    return(ret);
+}
+
+static int default_hid_get_product_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    int ret = hid_get_product_string(dev, string, maxlen);
+
+    RecordString(dev, 'P', ret, string);
+
+    return(ret);
+}
+
+static hid_device* default_hid_open_path(const char* path)
+{
+    hid_device* dev = hid_open_path(path);
+
+    if((dev != NULL) && record_active.load())
+    {
+        std::lock_guard<std::mutex> lock(record_mutex);
+
+        record_paths[dev] = path;
+    }
+
+    return(dev);
+}
+
+static hid_device_info* default_hid_enumerate(unsigned short vendor_id, unsigned short product_id)
+{
+    hid_device_info* devices = hid_enumerate(vendor_id, product_id);
+
+    if(record_active.load())
+    {
+        std::lock_guard<std::mutex> lock(record_mutex);
+
+        for(hid_device_info* info = devices; info != NULL; info = info->next)
+        {
+            char ids[32];
+
+            /*---------------------------------------------*\
+            | A negative interface number is written as -1  |
+            \*---------------------------------------------*/
+            if(info->interface_number < 0)
+            {
+                snprintf(ids, sizeof(ids), "%04X:%04X:-1:%04X:%04X", info->vendor_id, info->product_id, info->usage_page, info->usage);
+            }
+            else
+            {
+                snprintf(ids, sizeof(ids), "%04X:%04X:%02X:%04X:%04X", info->vendor_id, info->product_id, info->interface_number, info->usage_page, info->usage);
+            }
+
+            RecordLine('E', ids, "-", info->path);
+        }
+    }
+
+    return(devices);
+}
+
+static void default_hid_close(hid_device* dev)
+{
+    if(record_active.load())
+    {
+        std::lock_guard<std::mutex> lock(record_mutex);
+
+        record_paths.erase(dev);
+    }
+
+    hid_close(dev);
+}
+
+static int default_hid_write(hid_device* dev, const unsigned char* data, size_t length)
+{
+    int ret = hid_write(dev, data, length);
+
+    if(ret >= 0)
+    {
+        RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_HID, ret);
+    }
+
+    RecordCall(dev, 'W', ret, data, (int)length);
+
+    return(ret);
+}
+
+static int default_hid_read(hid_device* dev, unsigned char* data, size_t length)
+{
+    int ret = hid_read(dev, data, length);
+
+    RecordCall(dev, 'R', ret, data, ret);
+
+    return(ret);
+}
+
+static int default_hid_read_timeout(hid_device* dev, unsigned char* data, size_t length, int milliseconds)
+{
+    int ret = hid_read_timeout(dev, data, length, milliseconds);
+
+    RecordCall(dev, 'R', ret, data, ret);
+
+    return(ret);
+}
+
+hidapi_wrapper hidapi_wrapper_get_default()
+{
+    hidapi_wrapper wrapper =
+    {
+        NULL,
+        default_hid_send_feature_report,
+        default_hid_get_feature_report,
+        default_hid_get_serial_number_string,
+        default_hid_open_path,
+        default_hid_enumerate,
+        (hidapi_wrapper_free_enumeration)   hid_free_enumeration,
+        default_hid_close,
+        (hidapi_wrapper_error)              hid_error,
+        default_hid_write,
+        default_hid_read,
+        default_hid_read_timeout,
+        (hidapi_wrapper_set_nonblocking)    hid_set_nonblocking,
+        default_hid_get_manufacturer_string,
+        default_hid_get_product_string
+    };
+
+    return(wrapper);
+}
+
+bool hidapi_wrapper_start_recording(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(record_mutex);
+
+    if(record_file != NULL)
+    {
+        fclose(record_file);
+    }
+
+    record_file = fopen(filename.c_str(), "w");
+
+    if(record_file == NULL)
+    {
+        LOG_ERROR("[hidapi_wrapper] Unable to open capture file %s", filename.c_str());
+        record_active = false;
+        return(false);
+    }
+
+    LOG_INFO("[hidapi_wrapper] Recording HID traffic to %s", filename.c_str());
+
+    fprintf(record_file, "# OpenRGB HID capture\n");
+    record_active = true;
+
+    return(true);
+}
+
+void hidapi_wrapper_stop_recording()
+{
+    std::lock_guard<std::mutex> lock(record_mutex);
+
+    record_active = false;
+
+    if(record_file != NULL)
+    {
+        fclose(record_file);
+        record_file = NULL;
+    }
+
+    record_paths.clear();
+}
+
+/*---------------------------------------------------------*\
+| Replay backend                                            |
+\*---------------------------------------------------------*/
+static int ReplayFind(replay_handle* handle, char op)
+{
+    for(std::size_t op_idx = handle->position; op_idx < handle->device->ops.size(); op_idx++)
+    {
+        if(handle->device->ops[op_idx].op == op)
+        {
+            return((int)op_idx);
+        }
+    }
+
+    return(-1);
+}
+
+static int ReplayAnswer(hid_device* dev, char op, unsigned char* data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    replay_handle*  handle  = (replay_handle*)dev;
+    int             op_idx  = ReplayFind(handle, op);
+
+    if(op_idx < 0)
+    {
+        /*-------------------------------------------------*\
+        | Capture exhausted, reads time out and feature     |
+        | report reads fail                                 |
+        \*-------------------------------------------------*/
+        return((op == 'R') ? 0 : -1);
+    }
+
+    replay_op& answer   = handle->device->ops[op_idx];
+    handle->position    = op_idx + 1;
+
+    memcpy(data, answer.data.data(), std::min(length, answer.data.size()));
+
+    return(answer.ret);
+}
+
+static int ReplayWrite(hid_device* dev, char op, size_t length)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    replay_handle*  handle  = (replay_handle*)dev;
+    int             op_idx  = ReplayFind(handle, op);
+
+    if(op_idx >= 0)
+    {
+        handle->position = op_idx + 1;
+    }
+
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_HID, (int)length);
+
+    return((int)length);
+}
+
+static int replay_hid_send_feature_report(hid_device* dev, const unsigned char* /*data*/, size_t length)
+{
+    return(ReplayWrite(dev, 'F', length));
+}
+
+static int replay_hid_get_feature_report(hid_device* dev, unsigned char* data, size_t length)
+{
+    return(ReplayAnswer(dev, 'G', data, length));
+}
+
+static int ReplayString(hid_device* dev, char op, wchar_t* string, size_t maxlen)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    replay_handle*  handle  = (replay_handle*)dev;
+    int             op_idx  = ReplayFind(handle, op);
+
+    if((op_idx < 0) || (maxlen == 0))
+    {
+        return(-1);
+    }
+
+    replay_op&      answer  = handle->device->ops[op_idx];
+    std::size_t     char_idx;
+
+    handle->position = op_idx + 1;
+
+    if(answer.ret != 0)
+    {
+        return(answer.ret);
+    }
+
+    for(char_idx = 0; (char_idx < (answer.data.size() / 2)) && (char_idx < (maxlen - 1)); char_idx++)
+    {
+        string[char_idx] = (wchar_t)((answer.data[char_idx * 2] << 8) | answer.data[(char_idx * 2) + 1]);
+    }
+
+    string[char_idx] = 0;
+
+    return(0);
+}
+
+static int replay_hid_get_serial_number_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    return(ReplayString(dev, 'S', string, maxlen));
+}
+
+static int replay_hid_get_manufacturer_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    return(ReplayString(dev, 'M', string, maxlen));
+}
+
+static int replay_hid_get_product_string(hid_device* dev, wchar_t* string, size_t maxlen)
+{
+    return(ReplayString(dev, 'P', string, maxlen));
+}
+
+static hid_device* replay_hid_open_path(const char* path)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    for(std::size_t device_idx = 0; device_idx < replay_devices.size(); device_idx++)
+    {
+        if(replay_devices[device_idx]->path == path)
+        {
+            replay_handle* handle = new replay_handle;
+
+            handle->device      = replay_devices[device_idx];
+            handle->position    = 0;
+
+            return((hid_device*)handle);
+        }
+    }
+
+    return(NULL);
+}
+
+static hid_device_info* replay_hid_enumerate(unsigned short vendor_id, unsigned short product_id)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    hid_device_info*    devices = NULL;
+    hid_device_info**   next    = &devices;
+
+    for(std::size_t device_idx = 0; device_idx < replay_devices.size(); device_idx++)
+    {
+        const std::shared_ptr<replay_device>& device = replay_devices[device_idx];
+
+        if(((vendor_id != 0) && (vendor_id != device->vendor_id))
+        || ((product_id != 0) && (product_id != device->product_id)))
+        {
+            continue;
+        }
+
+        hid_device_info* info       = new hid_device_info();
+
+        info->path                  = new char[device->path.size() + 1];
+        info->vendor_id             = device->vendor_id;
+        info->product_id            = device->product_id;
+        info->serial_number         = new wchar_t[1]();
+        info->manufacturer_string   = new wchar_t[1]();
+        info->product_string        = new wchar_t[1]();
+        info->usage_page            = device->usage_page;
+        info->usage                 = device->usage;
+        info->interface_number      = device->interface_number;
+
+        strcpy(info->path, device->path.c_str());
+
+        *next = info;
+        next  = &info->next;
+    }
+
+    return(devices);
+}
+
+static void replay_hid_free_enumeration(hid_device_info* devices)
+{
+    while(devices != NULL)
+    {
+        hid_device_info* next = devices->next;
+
+        delete[] devices->path;
+        delete[] devices->serial_number;
+        delete[] devices->manufacturer_string;
+        delete[] devices->product_string;
+        delete devices;
+
+        devices = next;
+    }
+}
+
+static void replay_hid_close(hid_device* dev)
+{
+    delete (replay_handle*)dev;
+}
+
+static const wchar_t* replay_hid_error(hid_device* /*dev*/)
+{
+    return(L"HID replay device");
+}
+
+static int replay_hid_write(hid_device* dev, const unsigned char* /*data*/, size_t length)
+{
+    return(ReplayWrite(dev, 'W', length));
+}
+
+static int replay_hid_read(hid_device* dev, unsigned char* data, size_t length)
+{
+    return(ReplayAnswer(dev, 'R', data, length));
+}
+
+static int replay_hid_read_timeout(hid_device* dev, unsigned char* data, size_t length, int /*milliseconds*/)
+{
+    return(ReplayAnswer(dev, 'R', data, length));
+}
+
+static int replay_hid_set_nonblocking(hid_device* /*dev*/, int /*nonblock*/)
+{
+    return(0);
+}
+
+bool hidapi_wrapper_load_replay(const std::string& filename, hidapi_wrapper* wrapper)
+{
+    std::lock_guard<std::mutex> lock(replay_mutex);
+
+    /*-----------------------------------------------------*\
+    | Only parse each capture once.  Open handles share     |
+    | ownership of their device, so loading another capture |
+    | frees the old devices once those handles are closed.  |
+    \*-----------------------------------------------------*/
+    if(replay_filename != filename)
+    {
+        std::ifstream capture(filename);
+
+        if(!capture.is_open())
+        {
+            LOG_ERROR("[hidapi_wrapper] Unable to open capture file %s", filename.c_str());
+            return(false);
+        }
+
+        std::map<std::string, std::shared_ptr<replay_device>>   devices_by_path;
+        std::string                                             line;
+
+        replay_devices.clear();
+
+        while(std::getline(capture, line))
+        {
+            std::istringstream  line_stream(line);
+            std::string         op;
+            std::string         ret;
+            std::string         hex;
+            std::string         path;
+
+            if(line.empty() || (line[0] == '#'))
+            {
+                continue;
+            }
+
+            line_stream >> op >> ret >> hex;
+            std::getline(line_stream >> std::ws, path);
+
+            if((op.size() != 1) || path.empty())
+            {
+                continue;
+            }
+
+            try
+            {
+                if(op[0] == 'E')
+                {
+                    if(devices_by_path.count(path) == 0)
+                    {
+                        std::shared_ptr<replay_device>  device = std::make_shared<replay_device>();
+                        std::istringstream              ids(ret);
+                        std::string                     id;
+                        std::vector<int>                values;
+
+                        while(std::getline(ids, id, ':'))
+                        {
+                            values.push_back((int)std::stol(id, nullptr, 16));
+                        }
+
+                        values.resize(5, 0);
+
+                        device->path                = path;
+                        device->vendor_id           = (unsigned short)values[0];
+                        device->product_id          = (unsigned short)values[1];
+                        device->interface_number    = values[2];
+                        device->usage_page          = (unsigned short)values[3];
+                        device->usage               = (unsigned short)values[4];
+
+                        devices_by_path[path] = device;
+                        replay_devices.push_back(device);
+                    }
+                }
+                else if(devices_by_path.count(path) != 0)
+                {
+                    replay_op new_op;
+
+                    new_op.op   = op[0];
+                    new_op.ret  = std::stoi(ret);
+                    new_op.data = HexToBytes(hex);
+
+                    devices_by_path[path]->ops.push_back(new_op);
+                }
+            }
+            catch(const std::exception&)
+            {
+                LOG_WARNING("[hidapi_wrapper] Skipping malformed capture line: %s", line.c_str());
+            }
+        }
+
+        replay_filename = filename;
+
+        LOG_INFO("[hidapi_wrapper] Replaying %d HID devices from %s", (int)replay_devices.size(), filename.c_str());
+    }
+
+    *wrapper =
+    {
+        NULL,
+        replay_hid_send_feature_report,
+        replay_hid_get_feature_report,
+        replay_hid_get_serial_number_string,
+        replay_hid_open_path,
+        replay_hid_enumerate,
+        replay_hid_free_enumeration,
+        replay_hid_close,
+        replay_hid_error,
+        replay_hid_write,
+        replay_hid_read,
+        replay_hid_read_timeout,
+        replay_hid_set_nonblocking,
+        replay_hid_get_manufacturer_string,
+        replay_hid_get_product_string
+    };
+
+    return(true);
+}
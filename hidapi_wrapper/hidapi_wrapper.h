@@ -2,7 +2,8 @@
 | hidapi_wrapper.h                                          |
 |                                                           |
 |   Wrapper for hidapi that can select from default or      |
-|   libusb backends on Linux                                |
+|   libusb backends on Linux, and record or replay HID      |
+|   traffic for headless testing                            |
 |                                                           |
 |   Matt Silva (thesilvanator)                  2022        |
 |   Adam Honse (CalcProgrammer1)                2023        |
@@ -13,6 +14,7 @@
 
 #pragma once
 
+#include <string>
 #include <hidapi.h>
 
 #ifdef __linux__
@@ -30,6 +32,12 @@ typedef hid_device_info*    (*hidapi_wrapper_enumerate)             (unsigned sh
 typedef void                (*hidapi_wrapper_free_enumeration)      (hid_device_info*);
 typedef void                (*hidapi_wrapper_close)                 (hid_device*);
 typedef const wchar_t*      (*hidapi_wrapper_error)                 (hid_device*);
+typedef int                 (*hidapi_wrapper_write)                 (hid_device*, const unsigned char*, size_t);
+typedef int                 (*hidapi_wrapper_read)                  (hid_device*, unsigned char*, size_t);
+typedef int                 (*hidapi_wrapper_read_timeout)          (hid_device*, unsigned char*, size_t, int);
+typedef int                 (*hidapi_wrapper_set_nonblocking)       (hid_device*, int);
+typedef int                 (*hidapi_wrapper_get_manufacturer_string) (hid_device*, wchar_t*, size_t);
+typedef int                 (*hidapi_wrapper_get_product_string)    (hid_device*, wchar_t*, size_t);
 
 /*-----------------------------------------------------*\
 |  See comment at top of HyperXQuadcastSDetect.cpp for  |
@@ -46,4 +54,44 @@ struct hidapi_wrapper
     hidapi_wrapper_free_enumeration         hid_free_enumeration;
     hidapi_wrapper_close                    hid_close;
     hidapi_wrapper_error                    hid_error;
+    hidapi_wrapper_write                    hid_write;
+    hidapi_wrapper_read                     hid_read;
+    hidapi_wrapper_read_timeout             hid_read_timeout;
+    hidapi_wrapper_set_nonblocking          hid_set_nonblocking;
+    hidapi_wrapper_get_manufacturer_string  hid_get_manufacturer_string;
+    hidapi_wrapper_get_product_string       hid_get_product_string;
 };
+
+/*-----------------------------------------------------*\
+| Default hidapi backend.  Writes are accounted to the  |
+| controller statistics and, while a recording is       |
+| active, all traffic is logged to the capture file.    |
+\*-----------------------------------------------------*/
+hidapi_wrapper  hidapi_wrapper_get_default();
+
+/*-----------------------------------------------------*\
+| Capture file                                          |
+|   One line per call, "<op> <ret> <hex data> <path>",  |
+|   where op is one of                                  |
+|     E  enumerated device, ret is vid:pid:interface:   |
+|        usage_page:usage in hex, e.g. 1532:0084:00:    |
+|        FF00:0001, with an interface of -1 if none     |
+|     W  hid_write                                      |
+|     F  hid_send_feature_report                        |
+|     G  hid_get_feature_report                         |
+|     R  hid_read/hid_read_timeout                      |
+|     S  hid_get_serial_number_string                   |
+|     M  hid_get_manufacturer_string                    |
+|     P  hid_get_product_string                         |
+\*-----------------------------------------------------*/
+bool            hidapi_wrapper_start_recording(const std::string& filename);
+void            hidapi_wrapper_stop_recording();
+
+/*-----------------------------------------------------*\
+| Replay backend                                        |
+|   Enumerates the devices in a capture file and        |
+|   answers reads, feature report reads and string      |
+|   queries from it in order.  Writes are accepted and  |
+|   accounted but not compared.                         |
+\*-----------------------------------------------------*/
+bool            hidapi_wrapper_load_replay(const std::string& filename, hidapi_wrapper* wrapper);
@@ -11,6 +11,8 @@
 \*---------------------------------------------------------*/
 
 #include "i2c_smbus.h"
+#include "RGBControllerStats.h"
+#include <algorithm>
 #include <string.h>
 
 #ifdef WIN32
@@ -21,23 +23,29 @@
 
 i2c_smbus_interface::i2c_smbus_interface()
 {
-    i2c_smbus_start            = false;
-    i2c_smbus_done             = false;
     this->port_id              = -1;
     this->pci_device           = -1;
     this->pci_vendor           = -1;
     this->pci_subsystem_device = -1;
     this->pci_subsystem_vendor = -1;
     this->bus_id               = -1;
+    i2c_smbus_virtual_time     = 0;
+    i2c_smbus_sequence         = 0;
+
+    reset_bus_stats();
+
     i2c_smbus_thread_running   = true;
     i2c_smbus_thread           = new std::thread(&i2c_smbus_interface::i2c_smbus_thread_function, this);
 }
 
 i2c_smbus_interface::~i2c_smbus_interface()
 {
-    i2c_smbus_thread_running = false;
-    i2c_smbus_start = true;
-    i2c_smbus_start_cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(i2c_smbus_queue_mutex);
+        i2c_smbus_thread_running = false;
+    }
+
+    i2c_smbus_queue_cv.notify_all();
     i2c_smbus_thread->join();
     delete i2c_smbus_thread;
 }
@@ -164,53 +172,62 @@ s32 i2c_smbus_interface::i2c_smbus_write_i2c_block_data(u8 addr, u8 command, u8
 
 s32 i2c_smbus_interface::i2c_smbus_xfer_call(u8 addr, char read_write, u8 command, int size, i2c_smbus_data* data)
 {
-    i2c_smbus_xfer_mutex.lock();
+    i2c_smbus_request request;
 
-    i2c_addr        = addr;
-    i2c_read_write  = read_write;
-    i2c_command     = command;
-    i2c_size_smbus  = size;
-    i2c_data_smbus  = data;
-    smbus_xfer      = true;
+    request.smbus_xfer  = true;
+    request.addr        = addr;
+    request.read_write  = read_write;
+    request.command     = command;
+    request.size_smbus  = size;
+    request.data_smbus  = data;
 
-    std::unique_lock<std::mutex> start_lock(i2c_smbus_start_mutex);
-    i2c_smbus_start = true;
-    i2c_smbus_start_cv.notify_all();
-    start_lock.unlock();
+    s32 ret = i2c_smbus_schedule(&request);
 
-    std::unique_lock<std::mutex> done_lock(i2c_smbus_done_mutex);
+    /*-----------------------------------------------------*\
+    | Account the transaction payload for update statistics |
+    \*-----------------------------------------------------*/
+    int payload_bytes = 0;
 
-    i2c_smbus_done_cv.wait(done_lock, [this]{ return i2c_smbus_done.load(); });
-    i2c_smbus_done  = false;
+    switch(size)
+    {
+        case I2C_SMBUS_BYTE:
+        case I2C_SMBUS_BYTE_DATA:
+            payload_bytes = 1;
+            break;
 
-    i2c_smbus_xfer_mutex.unlock();
+        case I2C_SMBUS_WORD_DATA:
+        case I2C_SMBUS_PROC_CALL:
+            payload_bytes = 2;
+            break;
+
+        case I2C_SMBUS_BLOCK_DATA:
+        case I2C_SMBUS_I2C_BLOCK_BROKEN:
+        case I2C_SMBUS_BLOCK_PROC_CALL:
+        case I2C_SMBUS_I2C_BLOCK_DATA:
+            payload_bytes = (data != NULL) ? data->block[0] : 0;
+            break;
+    }
+
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_I2C, payload_bytes);
 
-    return(i2c_ret);
+    return(ret);
 }
 
 s32 i2c_smbus_interface::i2c_xfer_call(u8 addr, char read_write, int* size, u8 *data)
 {
-    i2c_smbus_xfer_mutex.lock();
-
-    i2c_addr        = addr;
-    i2c_read_write  = read_write;
-    i2c_size        = size;
-    i2c_data        = data;
-    smbus_xfer      = false;
+    i2c_smbus_request request;
 
-    std::unique_lock<std::mutex> start_lock(i2c_smbus_start_mutex);
-    i2c_smbus_start = true;
-    i2c_smbus_start_cv.notify_all();
-    start_lock.unlock();
+    request.smbus_xfer  = false;
+    request.addr        = addr;
+    request.read_write  = read_write;
+    request.size        = size;
+    request.data        = data;
 
-    std::unique_lock<std::mutex> done_lock(i2c_smbus_done_mutex);
+    s32 ret = i2c_smbus_schedule(&request);
 
-    i2c_smbus_done_cv.wait(done_lock, [this]{ return i2c_smbus_done.load(); });
-    i2c_smbus_done  = false;
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_I2C, (size != NULL) ? *size : 0);
 
-    i2c_smbus_xfer_mutex.unlock();
-
-    return(i2c_ret);
+    return(ret);
 }
 
 s32 i2c_smbus_interface::i2c_read_block(u8 addr, int* size, u8* data)
@@ -223,32 +240,220 @@ s32 i2c_smbus_interface::i2c_write_block(u8 addr, int size, u8 *data)
     return i2c_xfer_call(addr, I2C_SMBUS_WRITE, &size, data);
 }
 
+void i2c_smbus_interface::get_bus_stats(i2c_smbus_bus_stats* stats)
+{
+    for(unsigned int priority_idx = 0; priority_idx < I2C_SMBUS_PRIORITY_COUNT; priority_idx++)
+    {
+        stats->transactions[priority_idx] = i2c_smbus_transactions[priority_idx].load(std::memory_order_relaxed);
+        i2c_smbus_wait_time[priority_idx].Snapshot(&stats->wait_time[priority_idx]);
+    }
+
+    stats->promoted     = i2c_smbus_promoted.load(std::memory_order_relaxed);
+    stats->busy_us      = i2c_smbus_busy_us.load(std::memory_order_relaxed);
+
+    i2c_smbus_xfer_time.Snapshot(&stats->xfer_time);
+
+    /*-----------------------------------------------------*\
+    | A window still open past its length means the bus     |
+    | went quiet, report what it did since then             |
+    \*-----------------------------------------------------*/
+    std::lock_guard<std::mutex> lock(i2c_smbus_queue_mutex);
+
+    long long elapsed_us = RGBControllerStats::NowMicroseconds() - i2c_smbus_window_start_us;
+
+    if(elapsed_us >= I2C_SMBUS_UTILIZATION_WINDOW_US)
+    {
+        stats->utilization = (float)i2c_smbus_window_busy_us / (float)elapsed_us;
+    }
+    else
+    {
+        stats->utilization = i2c_smbus_utilization;
+    }
+}
+
+void i2c_smbus_interface::reset_bus_stats()
+{
+    for(unsigned int priority_idx = 0; priority_idx < I2C_SMBUS_PRIORITY_COUNT; priority_idx++)
+    {
+        i2c_smbus_transactions[priority_idx] = 0;
+        i2c_smbus_wait_time[priority_idx].Reset();
+    }
+
+    i2c_smbus_promoted  = 0;
+    i2c_smbus_busy_us   = 0;
+
+    i2c_smbus_xfer_time.Reset();
+
+    std::lock_guard<std::mutex> lock(i2c_smbus_queue_mutex);
+
+    i2c_smbus_window_start_us   = RGBControllerStats::NowMicroseconds();
+    i2c_smbus_window_busy_us    = 0;
+    i2c_smbus_utilization       = 0.0f;
+}
+
+s32 i2c_smbus_interface::i2c_smbus_schedule(i2c_smbus_request* request)
+{
+    request->done       = false;
+    request->ret        = -1;
+    request->source     = std::this_thread::get_id();
+    request->submit_us  = RGBControllerStats::NowMicroseconds();
+
+    if(RGBControllerStats::InDeviceUpdate())
+    {
+        request->priority = I2C_SMBUS_PRIORITY_COLOR;
+    }
+    else
+    {
+        request->priority = I2C_SMBUS_PRIORITY_OTHER;
+    }
+
+    std::unique_lock<std::mutex> lock(i2c_smbus_queue_mutex);
+
+    /*-----------------------------------------------------*\
+    | A caller that was idle starts at the current virtual  |
+    | time, so it can not claim the bus time it did not use |
+    \*-----------------------------------------------------*/
+    unsigned long long start_tag = i2c_smbus_virtual_time;
+
+    std::map<std::thread::id, unsigned long long>::iterator source = i2c_smbus_source_tags.find(request->source);
+
+    if((source != i2c_smbus_source_tags.end()) && (source->second > start_tag))
+    {
+        start_tag = source->second;
+    }
+
+    request->start_tag  = start_tag;
+    request->sequence   = i2c_smbus_sequence++;
+
+    i2c_smbus_queue.push_back(request);
+    i2c_smbus_queue_cv.notify_all();
+
+    i2c_smbus_done_cv.wait(lock, [request]{ return request->done; });
+
+    return(request->ret);
+}
+
+/*---------------------------------------------------------*\
+| Called with i2c_smbus_queue_mutex held                    |
+\*---------------------------------------------------------*/
+i2c_smbus_interface::i2c_smbus_request* i2c_smbus_interface::i2c_smbus_pick_request(long long now_us)
+{
+    std::size_t best_idx        = 0;
+    int         best_priority   = I2C_SMBUS_PRIORITY_COUNT;
+
+    for(std::size_t request_idx = 0; request_idx < i2c_smbus_queue.size(); request_idx++)
+    {
+        i2c_smbus_request*  request     = i2c_smbus_queue[request_idx];
+        int                 priority    = request->priority;
+
+        if((now_us - request->submit_us) >= I2C_SMBUS_PRIORITY_MAX_WAIT_US)
+        {
+            priority = I2C_SMBUS_PRIORITY_COLOR;
+        }
+
+        if((priority < best_priority)
+        || ((priority == best_priority)
+         && ((request->start_tag < i2c_smbus_queue[best_idx]->start_tag)
+          || ((request->start_tag == i2c_smbus_queue[best_idx]->start_tag) && (request->sequence < i2c_smbus_queue[best_idx]->sequence)))))
+        {
+            best_idx        = request_idx;
+            best_priority   = priority;
+        }
+    }
+
+    i2c_smbus_request* request = i2c_smbus_queue[best_idx];
+
+    i2c_smbus_queue.erase(i2c_smbus_queue.begin() + best_idx);
+
+    if(best_priority != request->priority)
+    {
+        i2c_smbus_promoted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return(request);
+}
+
 void i2c_smbus_interface::i2c_smbus_thread_function()
 {
+    std::unique_lock<std::mutex> lock(i2c_smbus_queue_mutex);
+
     while(1)
     {
-        std::unique_lock<std::mutex> start_lock(i2c_smbus_start_mutex);
-
-        i2c_smbus_start_cv.wait(start_lock, [this]{ return i2c_smbus_start.load(); });
-        i2c_smbus_start = false;
+        i2c_smbus_queue_cv.wait(lock, [this]{ return(!i2c_smbus_thread_running || !i2c_smbus_queue.empty()); });
 
-        if (!i2c_smbus_thread_running.load())
+        if(!i2c_smbus_thread_running)
         {
             break;
         }
 
-        if(smbus_xfer)
+        long long           start_us    = RGBControllerStats::NowMicroseconds();
+        i2c_smbus_request*  request     = i2c_smbus_pick_request(start_us);
+
+        if(request->start_tag > i2c_smbus_virtual_time)
+        {
+            i2c_smbus_virtual_time = request->start_tag;
+        }
+
+        lock.unlock();
+
+        s32 ret;
+
+        if(request->smbus_xfer)
         {
-            i2c_ret = i2c_smbus_xfer(i2c_addr, i2c_read_write, i2c_command, i2c_size_smbus, i2c_data_smbus);
+            ret = i2c_smbus_xfer(request->addr, request->read_write, request->command, request->size_smbus, request->data_smbus);
         }
         else
         {
-            i2c_ret = i2c_xfer(i2c_addr, i2c_read_write, i2c_size, i2c_data);
+            ret = i2c_xfer(request->addr, request->read_write, request->size, request->data);
         }
 
-        std::unique_lock<std::mutex> done_lock(i2c_smbus_done_mutex);
-        i2c_smbus_done  = true;
+        long long end_us    = RGBControllerStats::NowMicroseconds();
+        long long xfer_us   = end_us - start_us;
+
+        i2c_smbus_transactions[request->priority].fetch_add(1, std::memory_order_relaxed);
+        i2c_smbus_busy_us.fetch_add((unsigned long long)xfer_us, std::memory_order_relaxed);
+        i2c_smbus_wait_time[request->priority].Record((unsigned long long)(start_us - request->submit_us));
+        i2c_smbus_xfer_time.Record((unsigned long long)xfer_us);
+
+        lock.lock();
+
+        /*-------------------------------------------------*\
+        | Charge the bus time to the caller.  Tags at or    |
+        | behind the virtual time mean nothing, drop them   |
+        | so threads that are gone do not pile up.          |
+        \*-------------------------------------------------*/
+        i2c_smbus_source_tags[request->source] = request->start_tag + (unsigned long long)std::max(xfer_us, 1LL);
+
+        if(i2c_smbus_source_tags.size() > 64)
+        {
+            for(std::map<std::thread::id, unsigned long long>::iterator source = i2c_smbus_source_tags.begin(); source != i2c_smbus_source_tags.end();)
+            {
+                if(source->second <= i2c_smbus_virtual_time)
+                {
+                    source = i2c_smbus_source_tags.erase(source);
+                }
+                else
+                {
+                    source++;
+                }
+            }
+        }
+
+        /*-------------------------------------------------*\
+        | Bus utilization over the last full window         |
+        \*-------------------------------------------------*/
+        i2c_smbus_window_busy_us += (unsigned long long)xfer_us;
+
+        if((end_us - i2c_smbus_window_start_us) >= I2C_SMBUS_UTILIZATION_WINDOW_US)
+        {
+            i2c_smbus_utilization       = (float)i2c_smbus_window_busy_us / (float)(end_us - i2c_smbus_window_start_us);
+            i2c_smbus_window_start_us   = end_us;
+            i2c_smbus_window_busy_us    = 0;
+        }
+
+        request->ret    = ret;
+        request->done   = true;
+
         i2c_smbus_done_cv.notify_all();
-        done_lock.unlock();
     }
 }
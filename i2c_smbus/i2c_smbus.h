@@ -16,7 +16,10 @@
 #include <atomic>
 #include <thread>
 #include <condition_variable>
+#include <map>
 #include <mutex>
+#include <vector>
+#include "RGBControllerStats.h"
 
 typedef unsigned char   u8;
 typedef unsigned short  u16;
@@ -72,6 +75,31 @@ union i2c_smbus_data
 #define I2C_SMBUS_BLOCK_PROC_CALL   7           /* SMBus 2.0 */
 #define I2C_SMBUS_I2C_BLOCK_DATA    8
 
+// Bus scheduler priorities.  Transactions issued from DeviceUpdateLEDs()
+// are color updates and go first, mode and save writes and detection
+// follow.  A transaction that waited longer than the maximum wait is
+// served as a color update so it cannot starve.
+enum
+{
+    I2C_SMBUS_PRIORITY_COLOR    = 0,
+    I2C_SMBUS_PRIORITY_OTHER    = 1,
+    I2C_SMBUS_PRIORITY_COUNT
+};
+
+#define I2C_SMBUS_PRIORITY_MAX_WAIT_US      50000   /* Wait after which a transaction is promoted   */
+#define I2C_SMBUS_UTILIZATION_WINDOW_US     1000000 /* Window bus utilization is measured over      */
+
+// Bus scheduler statistics snapshot
+typedef struct
+{
+    unsigned long long  transactions[I2C_SMBUS_PRIORITY_COUNT]; /* Transactions per priority            */
+    unsigned long long  promoted;                               /* Transactions promoted after waiting  */
+    unsigned long long  busy_us;                                /* Total time the bus was busy          */
+    float               utilization;                            /* Busy fraction of the last window     */
+    stats_histogram     wait_time[I2C_SMBUS_PRIORITY_COUNT];    /* Queued until the bus started it      */
+    stats_histogram     xfer_time;                              /* Transaction duration on the bus      */
+} i2c_smbus_bus_stats;
+
 
 class i2c_smbus_interface
 {
@@ -112,32 +140,62 @@ public:
     s32 i2c_smbus_xfer_call(u8 addr, char read_write, u8 command, int size, i2c_smbus_data* data);
     s32 i2c_xfer_call(u8 addr, char read_write, int* size, u8 *data);
 
+    //Bus scheduler statistics
+    void get_bus_stats(i2c_smbus_bus_stats* stats);
+    void reset_bus_stats();
+
     virtual s32 i2c_smbus_xfer(u8 addr, char read_write, u8 command, int size, i2c_smbus_data* data) = 0;
     virtual s32 i2c_xfer(u8 addr, char read_write, int* size, u8* data) = 0;
 
 private:
+    //Transaction waiting for the bus, lives on the caller's stack
+    typedef struct
+    {
+        bool                smbus_xfer;
+        u8                  addr;
+        char                read_write;
+        u8                  command;
+        int                 size_smbus;
+        i2c_smbus_data*     data_smbus;
+        int*                size;
+        u8*                 data;
+        s32                 ret;
+        bool                done;
+
+        int                 priority;
+        std::thread::id     source;
+        unsigned long long  start_tag;
+        unsigned long long  sequence;
+        long long           submit_us;
+    } i2c_smbus_request;
+
     std::thread *           i2c_smbus_thread;
-    std::atomic<bool>       i2c_smbus_thread_running;
-
-    std::atomic<bool>       i2c_smbus_start;
-    std::condition_variable i2c_smbus_start_cv;
-    std::mutex              i2c_smbus_start_mutex;
-
-    std::atomic<bool>       i2c_smbus_done;
-    std::condition_variable i2c_smbus_done_cv;
-    std::mutex              i2c_smbus_done_mutex;
-
-    std::mutex              i2c_smbus_xfer_mutex;
-
-    u8                  i2c_addr;
-    char                i2c_read_write;
-    u8                  i2c_command;
-    int                 i2c_size_smbus;
-    int*                i2c_size;
-    i2c_smbus_data*     i2c_data_smbus;
-    u8*                 i2c_data;
-    s32                 i2c_ret;
-    bool                smbus_xfer;
+    bool                    i2c_smbus_thread_running;
+
+    //Transactions are queued per bus and the bus thread picks the
+    //next one by priority, then by the bus time its caller already
+    //received (start-time fair queueing), so controllers sharing the
+    //bus get equal bus time whatever order their threads wake in
+    std::mutex                                      i2c_smbus_queue_mutex;
+    std::condition_variable                         i2c_smbus_queue_cv;
+    std::condition_variable                         i2c_smbus_done_cv;
+    std::vector<i2c_smbus_request*>                 i2c_smbus_queue;
+    std::map<std::thread::id, unsigned long long>   i2c_smbus_source_tags;
+    unsigned long long                              i2c_smbus_virtual_time;
+    unsigned long long                              i2c_smbus_sequence;
+
+    //Bus statistics, window fields guarded by i2c_smbus_queue_mutex
+    std::atomic<unsigned long long>                 i2c_smbus_transactions[I2C_SMBUS_PRIORITY_COUNT];
+    std::atomic<unsigned long long>                 i2c_smbus_promoted;
+    std::atomic<unsigned long long>                 i2c_smbus_busy_us;
+    RGBControllerStatsHistogram                     i2c_smbus_wait_time[I2C_SMBUS_PRIORITY_COUNT];
+    RGBControllerStatsHistogram                     i2c_smbus_xfer_time;
+    long long                                       i2c_smbus_window_start_us;
+    unsigned long long                              i2c_smbus_window_busy_us;
+    float                                           i2c_smbus_utilization;
+
+    s32 i2c_smbus_schedule(i2c_smbus_request* request);
+    i2c_smbus_request* i2c_smbus_pick_request(long long now_us);
 };
 
 #endif /* I2C_SMBUS_H */
@@ -0,0 +1,444 @@
+/*---------------------------------------------------------*\
+| i2c_smbus_sim.cpp                                         |
+|                                                           |
+|   Simulated i2c/SMBus driver backed by register maps,     |
+|   for running SMBus drivers without hardware              |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include "i2c_smbus_sim.h"
+#include "LogManager.h"
+#include "ResourceManager.h"
+
+using json = nlohmann::json;
+
+i2c_smbus_sim::i2c_smbus_sim()
+{
+    transaction_us          = I2C_SMBUS_SIM_TRANSACTION_US;
+    byte_us                 = I2C_SMBUS_SIM_BYTE_US;
+    spd_page_select         = false;
+    spd_page                = 0;
+}
+
+u16 i2c_smbus_sim::register_address(i2c_smbus_sim_device& device, u8 command)
+{
+    if(device.paged)
+    {
+        return((u16)((spd_page << 8) | command));
+    }
+
+    return(command);
+}
+
+void i2c_smbus_sim::read_registers(i2c_smbus_sim_device& device, unsigned int address, u8* data, int length)
+{
+    for(int byte_idx = 0; byte_idx < length; byte_idx++)
+    {
+        data[byte_idx] = device.registers[(address + byte_idx) & 0xFFFF];
+    }
+}
+
+void i2c_smbus_sim::write_registers(i2c_smbus_sim_device& device, unsigned int address, const u8* data, int length)
+{
+    for(int byte_idx = 0; byte_idx < length; byte_idx++)
+    {
+        device.registers[(address + byte_idx) & 0xFFFF] = data[byte_idx];
+    }
+}
+
+void i2c_smbus_sim::wait_bus_time(long long start_us, int bytes)
+{
+    /*-----------------------------------------------------*\
+    | Hold the bus for as long as the transaction would     |
+    | take on the wire, so the bus statistics and the       |
+    | update times of the drivers come out as on hardware.  |
+    | Sleeps overshoot by more than a byte time, so the end |
+    | of the wait is spun.                                  |
+    \*-----------------------------------------------------*/
+    long long end_us    = start_us + transaction_us + ((long long)bytes * byte_us);
+    long long now_us    = RGBControllerStats::NowMicroseconds();
+
+    if((end_us - now_us) > I2C_SMBUS_SIM_SPIN_US)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(end_us - now_us - I2C_SMBUS_SIM_SPIN_US));
+    }
+
+    while(RGBControllerStats::NowMicroseconds() < end_us)
+    {
+        std::this_thread::yield();
+    }
+}
+
+s32 i2c_smbus_sim::i2c_smbus_xfer(u8 addr, char read_write, u8 command, int size, i2c_smbus_data* data)
+{
+    long long               start_us    = RGBControllerStats::NowMicroseconds();
+    i2c_smbus_sim_device*   device      = nullptr;
+    bool                    read        = (read_write == I2C_SMBUS_READ);
+    int                     bytes       = 0;
+    int                     length      = 0;
+    s32                     ret         = 0;
+
+    /*-----------------------------------------------------*\
+    | Writes to the EE1004 page select addresses switch the |
+    | page of every paged device on the bus                 |
+    \*-----------------------------------------------------*/
+    if(spd_page_select && !read && ((addr & 0xFE) == I2C_SMBUS_SIM_SPD_PAGE_ADDR))
+    {
+        spd_page = addr & 0x01;
+    }
+    else
+    {
+        std::map<u8, i2c_smbus_sim_device>::iterator device_it = devices.find(addr);
+
+        /*-------------------------------------------------*\
+        | No device, NACK after the address byte            |
+        \*-------------------------------------------------*/
+        if(device_it == devices.end())
+        {
+            wait_bus_time(start_us, 1);
+            return(-1);
+        }
+
+        device = &device_it->second;
+    }
+
+    switch(size)
+    {
+        case I2C_SMBUS_QUICK:
+            bytes = 1;
+            break;
+
+        case I2C_SMBUS_BYTE:
+            bytes = 2;
+
+            if(device != nullptr)
+            {
+                if(read)
+                {
+                    data->byte = device->registers[device->pointer];
+                    device->pointer++;
+                }
+                else
+                {
+                    device->pointer = register_address(*device, command);
+                }
+            }
+            break;
+
+        case I2C_SMBUS_BYTE_DATA:
+            bytes = read ? 4 : 3;
+
+            if(device != nullptr)
+            {
+                if(device->index_port && read && (command == device->read_command))
+                {
+                    data->byte = device->registers[device->index];
+                }
+                else if(device->index_port && !read && (command == device->write_command))
+                {
+                    device->registers[device->index] = data->byte;
+                }
+                else if(read)
+                {
+                    data->byte = device->registers[register_address(*device, command)];
+                }
+                else
+                {
+                    device->registers[register_address(*device, command)] = data->byte;
+                }
+            }
+            break;
+
+        case I2C_SMBUS_WORD_DATA:
+        case I2C_SMBUS_PROC_CALL:
+            bytes = (size == I2C_SMBUS_PROC_CALL) ? 6 : (read ? 5 : 4);
+
+            if(device != nullptr)
+            {
+                u8 word[2];
+
+                if(device->index_port && !read && (command == device->index_command))
+                {
+                    if(device->index_swap)
+                    {
+                        device->index = (u16)(((data->word & 0x00FF) << 8) | ((data->word >> 8) & 0x00FF));
+                    }
+                    else
+                    {
+                        device->index = data->word;
+                    }
+                    break;
+                }
+
+                if(!read)
+                {
+                    word[0] = (u8)(data->word & 0xFF);
+                    word[1] = (u8)(data->word >> 8);
+
+                    write_registers(*device, register_address(*device, command), word, 2);
+                }
+
+                if(read || (size == I2C_SMBUS_PROC_CALL))
+                {
+                    read_registers(*device, register_address(*device, command), word, 2);
+
+                    data->word = (u16)(word[0] | (word[1] << 8));
+                }
+            }
+            break;
+
+        case I2C_SMBUS_BLOCK_DATA:
+            if(read)
+            {
+                length = (device != nullptr) ? device->block_length : 0;
+
+                if(device != nullptr)
+                {
+                    data->block[0] = (u8)length;
+                    read_registers(*device, register_address(*device, command), &data->block[1], length);
+                }
+
+                bytes = 4 + length;
+            }
+            else
+            {
+                length = std::min((int)data->block[0], I2C_SMBUS_BLOCK_MAX);
+
+                if((device != nullptr) && device->index_port && (command == device->block_command))
+                {
+                    write_registers(*device, device->index, &data->block[1], length);
+                }
+                else if(device != nullptr)
+                {
+                    write_registers(*device, register_address(*device, command), &data->block[1], length);
+                }
+
+                bytes = 3 + length;
+            }
+            break;
+
+        case I2C_SMBUS_I2C_BLOCK_BROKEN:
+        case I2C_SMBUS_I2C_BLOCK_DATA:
+            length = std::min((int)data->block[0], I2C_SMBUS_BLOCK_MAX);
+
+            if(device != nullptr)
+            {
+                if(read)
+                {
+                    read_registers(*device, register_address(*device, command), &data->block[1], length);
+                }
+                else
+                {
+                    write_registers(*device, register_address(*device, command), &data->block[1], length);
+                }
+            }
+
+            bytes = (read ? 3 : 2) + length;
+            break;
+
+        default:
+            bytes   = 1;
+            ret     = -1;
+            break;
+    }
+
+    wait_bus_time(start_us, bytes);
+
+    return(ret);
+}
+
+s32 i2c_smbus_sim::i2c_xfer(u8 addr, char read_write, int* size, u8* data)
+{
+    long long start_us = RGBControllerStats::NowMicroseconds();
+
+    std::map<u8, i2c_smbus_sim_device>::iterator device_it = devices.find(addr);
+
+    if(device_it == devices.end())
+    {
+        wait_bus_time(start_us, 1);
+        return(-1);
+    }
+
+    /*-----------------------------------------------------*\
+    | Plain I2C writes start with the register pointer,     |
+    | reads continue from the pointer                       |
+    \*-----------------------------------------------------*/
+    i2c_smbus_sim_device& device = device_it->second;
+
+    if(read_write == I2C_SMBUS_READ)
+    {
+        read_registers(device, device.pointer, data, *size);
+        device.pointer = (u16)(device.pointer + *size);
+    }
+    else if(*size > 0)
+    {
+        device.pointer = register_address(device, data[0]);
+
+        write_registers(device, device.pointer, &data[1], *size - 1);
+        device.pointer = (u16)(device.pointer + *size - 1);
+    }
+
+    wait_bus_time(start_us, 1 + *size);
+
+    return(*size);
+}
+
+/*---------------------------------------------------------*\
+| Numbers in the simulation file may be given as JSON       |
+| numbers or as strings, so addresses can be written in hex |
+\*---------------------------------------------------------*/
+static unsigned int i2c_smbus_sim_number(const json& value)
+{
+    if(value.is_string())
+    {
+        return((unsigned int)std::stoul(value.get<std::string>(), nullptr, 0));
+    }
+
+    return(value.get<unsigned int>());
+}
+
+static unsigned int i2c_smbus_sim_number(const json& config, const char* key, unsigned int default_value)
+{
+    if(config.contains(key))
+    {
+        return(i2c_smbus_sim_number(config[key]));
+    }
+
+    return(default_value);
+}
+
+static void i2c_smbus_sim_load_device(const json& config, i2c_smbus_sim_device* device)
+{
+    device->registers.assign(0x10000, 0);
+    device->pointer         = 0;
+    device->paged           = config.value("paged", false);
+    device->block_length    = (u8)i2c_smbus_sim_number(config, "block_length", I2C_SMBUS_BLOCK_MAX);
+    device->index_port      = config.contains("index_port");
+    device->index_swap      = false;
+    device->index_command   = 0;
+    device->read_command    = 0;
+    device->write_command   = 0;
+    device->block_command   = 0;
+    device->index           = 0;
+
+    if(device->index_port)
+    {
+        const json& index_port = config["index_port"];
+
+        device->index_swap      = index_port.value("swap", false);
+        device->index_command   = (u8)i2c_smbus_sim_number(index_port, "index_command", 0);
+        device->read_command    = (u8)i2c_smbus_sim_number(index_port, "read_command", 0);
+        device->write_command   = (u8)i2c_smbus_sim_number(index_port, "write_command", 0);
+        device->block_command   = (u8)i2c_smbus_sim_number(index_port, "block_command", 0);
+    }
+
+    /*-----------------------------------------------------*\
+    | Register contents are keyed by their first address.   |
+    | A value is a byte, an array of bytes or a string that |
+    | is stored as its characters.                          |
+    \*-----------------------------------------------------*/
+    if(config.contains("registers"))
+    {
+        for(const auto& entry : config["registers"].items())
+        {
+            unsigned int    address = (unsigned int)std::stoul(entry.key(), nullptr, 0);
+            std::vector<u8> values;
+
+            if(entry.value().is_string())
+            {
+                std::string text = entry.value().get<std::string>();
+
+                values.assign(text.begin(), text.end());
+            }
+            else if(entry.value().is_array())
+            {
+                for(const json& value : entry.value())
+                {
+                    values.push_back((u8)i2c_smbus_sim_number(value));
+                }
+            }
+            else
+            {
+                values.push_back((u8)i2c_smbus_sim_number(entry.value()));
+            }
+
+            for(std::size_t value_idx = 0; value_idx < values.size(); value_idx++)
+            {
+                device->registers[(address + value_idx) & 0xFFFF] = values[value_idx];
+            }
+        }
+    }
+}
+
+bool i2c_smbus_sim_detect(const std::string& filename, bool* exclusive)
+{
+    std::ifstream sim_file(filename);
+
+    *exclusive = false;
+
+    if(!sim_file.is_open())
+    {
+        LOG_ERROR("[i2c_smbus_sim] Unable to open simulation file %s", filename.c_str());
+        return(false);
+    }
+
+    try
+    {
+        json sim = json::parse(sim_file);
+
+        *exclusive = sim.value("exclusive", false);
+
+        if(!sim.contains("busses"))
+        {
+            return(true);
+        }
+
+        for(const json& bus_config : sim["busses"])
+        {
+            i2c_smbus_sim* bus = new i2c_smbus_sim();
+
+            std::string name = bus_config.value("name", "Simulated SMBus");
+
+            strncpy(bus->device_name, name.c_str(), sizeof(bus->device_name) - 1);
+            bus->device_name[sizeof(bus->device_name) - 1] = '\0';
+
+            bus->pci_vendor             = i2c_smbus_sim_number(bus_config, "pci_vendor", 0);
+            bus->pci_device             = i2c_smbus_sim_number(bus_config, "pci_device", 0);
+            bus->pci_subsystem_vendor   = i2c_smbus_sim_number(bus_config, "pci_subsystem_vendor", 0);
+            bus->pci_subsystem_device   = i2c_smbus_sim_number(bus_config, "pci_subsystem_device", 0);
+            bus->port_id                = i2c_smbus_sim_number(bus_config, "port_id", 0);
+            bus->bus_id                 = i2c_smbus_sim_number(bus_config, "bus_id", 0);
+
+            bus->transaction_us         = i2c_smbus_sim_number(bus_config, "transaction_us", I2C_SMBUS_SIM_TRANSACTION_US);
+            bus->byte_us                = i2c_smbus_sim_number(bus_config, "byte_us", I2C_SMBUS_SIM_BYTE_US);
+            bus->spd_page_select        = bus_config.value("spd_page_select", false);
+
+            if(bus_config.contains("devices"))
+            {
+                for(const json& device_config : bus_config["devices"])
+                {
+                    u8 addr = (u8)i2c_smbus_sim_number(device_config, "address", 0);
+
+                    i2c_smbus_sim_load_device(device_config, &bus->devices[addr]);
+                }
+            }
+
+            ResourceManager::get()->RegisterI2CBus(bus);
+        }
+    }
+    catch(const std::exception& e)
+    {
+        LOG_ERROR("[i2c_smbus_sim] Invalid simulation file %s: %s", filename.c_str(), e.what());
+        return(false);
+    }
+
+    return(true);
+}
@@ -0,0 +1,73 @@
+/*---------------------------------------------------------*\
+| i2c_smbus_sim.h                                           |
+|                                                           |
+|   Simulated i2c/SMBus driver backed by register maps,     |
+|   for running SMBus drivers without hardware              |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "i2c_smbus.h"
+
+#define I2C_SMBUS_SIM_TRANSACTION_US    50      /* Default host overhead per transaction    */
+#define I2C_SMBUS_SIM_BYTE_US           90      /* Default time per byte, 9 bits at 100kHz  */
+#define I2C_SMBUS_SIM_SPIN_US           500     /* End of the bus time waited without sleep */
+#define I2C_SMBUS_SIM_SPD_PAGE_ADDR     0x36    /* EE1004 page 0 select, page 1 is 0x37     */
+
+/*---------------------------------------------------------*\
+| Simulated device at one address.  Registers are a 64K     |
+| byte map addressed by the SMBus command byte, or, with an |
+| index port, by a 16-bit pointer set through a word write  |
+| as on ENE controllers.  Paged devices add the EE1004 page |
+| selected on the bus to the command, as DDR4 SPD does.     |
+\*---------------------------------------------------------*/
+typedef struct
+{
+    std::vector<u8>     registers;
+    u16                 pointer;            /* Receive byte and raw I2C pointer         */
+    bool                paged;
+    u8                  block_length;       /* Count returned by SMBus block reads      */
+
+    bool                index_port;
+    bool                index_swap;         /* Index is sent high byte first            */
+    u8                  index_command;      /* Word write sets the index                */
+    u8                  read_command;       /* Byte read from the index                 */
+    u8                  write_command;      /* Byte write to the index                  */
+    u8                  block_command;      /* Block write to the index                 */
+    u16                 index;
+} i2c_smbus_sim_device;
+
+class i2c_smbus_sim : public i2c_smbus_interface
+{
+public:
+    i2c_smbus_sim();
+
+    unsigned int                        transaction_us;
+    unsigned int                        byte_us;
+    bool                                spd_page_select;
+    std::map<u8, i2c_smbus_sim_device>  devices;
+
+private:
+    unsigned int                        spd_page;
+
+    u16     register_address(i2c_smbus_sim_device& device, u8 command);
+    void    read_registers(i2c_smbus_sim_device& device, unsigned int address, u8* data, int length);
+    void    write_registers(i2c_smbus_sim_device& device, unsigned int address, const u8* data, int length);
+    void    wait_bus_time(long long start_us, int bytes);
+
+    s32 i2c_smbus_xfer(u8 addr, char read_write, u8 command, int size, i2c_smbus_data* data);
+    s32 i2c_xfer(u8 addr, char read_write, int* size, u8* data);
+};
+
+/*---------------------------------------------------------*\
+| Register the simulated busses described in a JSON file.   |
+| Sets exclusive when the file asks for the hardware busses |
+| to be skipped.                                            |
+\*---------------------------------------------------------*/
+bool i2c_smbus_sim_detect(const std::string& filename, bool* exclusive);
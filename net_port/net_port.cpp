@@ -12,6 +12,8 @@
 \*---------------------------------------------------------*/
 
 #include "net_port.h"
+#include "net_reactor.h"
+#include "RGBControllerStats.h"
 
 #ifndef WIN32
 #include <sys/ioctl.h>
@@ -22,6 +24,7 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <iostream>
+#include <algorithm>
 
 #ifdef _WIN32
 #define connect_socklen_t int
@@ -34,6 +37,7 @@ const char yes = 1;
 net_port::net_port()
 {
     result_list = NULL;
+    receive_handle = 0;
 }
 
 //net_port (constructor)
@@ -41,11 +45,14 @@ net_port::net_port()
 //	will automatically open client address <client_name> on port <port>
 net_port::net_port(const char * client_name, const char * port)
 {
+    receive_handle = 0;
     udp_client(client_name, port);
 }
 
 net_port::~net_port()
 {
+    clear_receive_callback();
+
     if(result_list)
     {
         freeaddrinfo(result_list);
@@ -132,9 +139,29 @@ void net_port::set_receive_timeout(int sec, int usec)
     setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof tv);
 }
 
+void net_port::set_receive_callback(net_port_receive_callback callback)
+{
+    clear_receive_callback();
+
+    receive_handle = net_reactor::get()->add_receiver(sock, callback);
+}
+
+void net_port::clear_receive_callback()
+{
+    if(receive_handle != 0)
+    {
+        net_reactor::get()->remove(receive_handle);
+        receive_handle = 0;
+    }
+}
+
 int net_port::udp_write(char * buffer, int length)
 {
-    return(sendto(sock, buffer, length, 0, (sockaddr *)&addrDest, sizeof(addrDest)));
+    int ret = sendto(sock, buffer, length, 0, (sockaddr *)&addrDest, sizeof(addrDest));
+
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_NETWORK, ret);
+
+    return(ret);
 }
 
 bool net_port::tcp_client(const char * client_name, const char * port)
@@ -315,12 +342,65 @@ SOCKET * net_port::tcp_server_listen()
     return client;
 }
 
+SOCKET * net_port::tcp_server_listen(int timeout_ms)
+{
+    /*-------------------------------------------------*\
+    | Wait for an incoming connection for up to         |
+    | timeout_ms before accepting it, return NULL if no |
+    | client connected in time                          |
+    \*-------------------------------------------------*/
+    fd_set  readfd;
+    timeval tv;
+
+    listen(sock, 10);
+
+    FD_ZERO(&readfd);
+    FD_SET(sock, &readfd);
+
+    tv.tv_sec   = timeout_ms / 1000;
+    tv.tv_usec  = (timeout_ms % 1000) * 1000;
+
+    if(select((int)sock + 1, &readfd, NULL, NULL, &tv) <= 0)
+    {
+        return(NULL);
+    }
+
+    return(tcp_server_listen());
+}
+
+void net_port::tcp_server_close_client(SOCKET * client)
+{
+    /*-------------------------------------------------*\
+    | Close a client socket returned by                 |
+    | tcp_server_listen(), remove it from the clients   |
+    | vector and free it                                |
+    \*-------------------------------------------------*/
+    std::vector<SOCKET *>::iterator client_it = std::find(clients.begin(), clients.end(), client);
+
+    if(client_it != clients.end())
+    {
+        clients.erase(client_it);
+    }
+
+    closesocket(*client);
+    delete client;
+}
+
 void net_port::tcp_close()
 {
+    clear_receive_callback();
+
     closesocket(sock);
     connected = false;
 }
 
+void net_port::udp_close()
+{
+    clear_receive_callback();
+
+    closesocket(sock);
+}
+
 int net_port::tcp_listen(char * recv_data, int length)
 {
     return(recv(sock, recv_data, length, 0));
@@ -328,7 +408,11 @@ int net_port::tcp_listen(char * recv_data, int length)
 
 int net_port::tcp_client_write(char * buffer, int length)
 {
-    return(send(sock, buffer, length, 0));
+    int ret = send(sock, buffer, length, 0);
+
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_NETWORK, ret);
+
+    return(ret);
 }
 
 int net_port::tcp_write(char * buffer, int length)
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #ifdef WIN32
@@ -43,6 +44,13 @@
 #define SD_RECEIVE SHUT_RD
 #endif
 
+//Receive Callback
+//Called on the shared net_reactor thread with data received on the
+//socket.  data has room for a terminating null after size bytes.  On
+//TCP sockets size is 0 or below once the connection closed.
+
+typedef std::function<void(char * data, int size)> net_port_receive_callback;
+
 //Network Port Class
 //The reason for this class is that network ports are treated differently
 //on Windows and Linux.  By creating a class, those differences can be
@@ -67,6 +75,8 @@ public:
     std::size_t tcp_server_num_clients();
     SOCKET *    tcp_server_get_client(std::size_t client_idx);
     SOCKET *    tcp_server_listen();
+    SOCKET *    tcp_server_listen(int timeout_ms);
+    void        tcp_server_close_client(SOCKET * client);
 
     void udp_join_multicast_group(const char * group_name);
 
@@ -79,9 +89,15 @@ public:
     int tcp_client_write(char * buffer, int length);
 
     void tcp_close();
+    void udp_close();
 
     void set_receive_timeout(int sec, int usec);
 
+    //Deliver received data to a callback on the shared net_reactor
+    //thread instead of reading it with udp_listen() or tcp_listen()
+    void set_receive_callback(net_port_receive_callback callback);
+    void clear_receive_callback();
+
     bool connected;
     SOCKET sock;
 
@@ -94,4 +110,6 @@ private:
 
     sockaddr addrDest;
     addrinfo*   result_list;
+
+    unsigned int receive_handle;
 };
@@ -0,0 +1,469 @@
+/*---------------------------------------------------------*\
+| net_reactor.cpp                                           |
+|                                                           |
+|   Shared I/O thread dispatching received network data     |
+|   and keepalive timers for network device drivers         |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <algorithm>
+#include <errno.h>
+#include <memory.h>
+#include "net_reactor.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#elif defined(WIN32)
+#define poll WSAPoll
+#else
+#include <poll.h>
+#include <sys/ioctl.h>
+#endif
+
+#ifdef _WIN32
+#define connect_socklen_t int
+#else
+#define connect_socklen_t socklen_t
+#endif
+
+/*---------------------------------------------------------*\
+| Handle 0 is never given out, the wake socket uses it      |
+\*---------------------------------------------------------*/
+#define NET_REACTOR_WAKE_HANDLE         0
+#define NET_REACTOR_MAX_EVENTS          64      /* Sockets handled per wait                 */
+#define NET_REACTOR_MAX_READS           16      /* Datagrams read per socket and wait       */
+
+net_reactor * net_reactor::get()
+{
+    static net_reactor reactor;
+
+    return(&reactor);
+}
+
+net_reactor::net_reactor()
+{
+    next_handle     = 1;
+    dispatching     = 0;
+    running         = true;
+
+    receive_buffer.resize(NET_REACTOR_RECEIVE_BUFFER_SIZE + 1);
+
+#ifdef WIN32
+    WSADATA wsa;
+
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+
+    /*-----------------------------------------------------*\
+    | Open the wake socket on a loopback port of its own,   |
+    | a datagram sent to it ends the wait                   |
+    \*-----------------------------------------------------*/
+    connect_socklen_t wake_addr_len = sizeof(wake_addr);
+
+    memset(&wake_addr, 0, sizeof(wake_addr));
+    wake_addr.sin_family        = AF_INET;
+    wake_addr.sin_addr.s_addr   = inet_addr("127.0.0.1");
+    wake_addr.sin_port          = 0;
+
+    wake_sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    bind(wake_sock, (sockaddr *)&wake_addr, sizeof(wake_addr));
+    getsockname(wake_sock, (sockaddr *)&wake_addr, &wake_addr_len);
+
+    u_long arg = 1;
+    ioctlsocket(wake_sock, FIONBIO, &arg);
+
+#ifdef __linux__
+    epoll_fd = epoll_create1(0);
+
+    epoll_event event   = {};
+    event.events        = EPOLLIN;
+    event.data.u32      = NET_REACTOR_WAKE_HANDLE;
+
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_sock, &event);
+#endif
+
+    reactor_thread = new std::thread(&net_reactor::reactor_thread_function, this);
+}
+
+net_reactor::~net_reactor()
+{
+    {
+        std::lock_guard<std::mutex> lock(reactor_mutex);
+        running = false;
+    }
+
+    wake();
+
+    reactor_thread->join();
+    delete reactor_thread;
+
+#ifdef __linux__
+    close(epoll_fd);
+#endif
+
+    closesocket(wake_sock);
+}
+
+unsigned int net_reactor::add_receiver(SOCKET sock, net_port_receive_callback callback)
+{
+    receiver_ptr receiver = std::make_shared<net_reactor_receiver>();
+
+    /*-----------------------------------------------------*\
+    | Reads must not block the other sockets if a readiness |
+    | notification turns out to be spurious                 |
+    \*-----------------------------------------------------*/
+    int                 sock_type       = SOCK_DGRAM;
+    connect_socklen_t   sock_type_len   = sizeof(sock_type);
+    u_long              arg             = 1;
+
+    getsockopt(sock, SOL_SOCKET, SO_TYPE, (char *)&sock_type, &sock_type_len);
+    ioctlsocket(sock, FIONBIO, &arg);
+
+    receiver->sock      = sock;
+    receiver->stream    = (sock_type == SOCK_STREAM);
+    receiver->callback  = callback;
+
+    std::lock_guard<std::mutex> lock(reactor_mutex);
+
+    unsigned int handle = next_handle++;
+
+    if(next_handle == NET_REACTOR_WAKE_HANDLE)
+    {
+        next_handle++;
+    }
+
+    receivers[handle] = receiver;
+
+#ifdef __linux__
+    epoll_event event   = {};
+    event.events        = EPOLLIN;
+    event.data.u32      = handle;
+
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock, &event);
+#else
+    wake();
+#endif
+
+    return(handle);
+}
+
+unsigned int net_reactor::add_timer(unsigned int interval_ms, net_reactor_timer_callback callback)
+{
+    timer_ptr timer = std::make_shared<net_reactor_timer>();
+
+    timer->interval = std::chrono::milliseconds(std::max(interval_ms, 1U));
+    timer->next     = std::chrono::steady_clock::now() + timer->interval;
+    timer->callback = callback;
+
+    std::lock_guard<std::mutex> lock(reactor_mutex);
+
+    unsigned int handle = next_handle++;
+
+    if(next_handle == NET_REACTOR_WAKE_HANDLE)
+    {
+        next_handle++;
+    }
+
+    timers[handle] = timer;
+
+    wake();
+
+    return(handle);
+}
+
+void net_reactor::remove(unsigned int handle)
+{
+    std::unique_lock<std::mutex> lock(reactor_mutex);
+
+    std::map<unsigned int, receiver_ptr>::iterator receiver = receivers.find(handle);
+
+    if(receiver != receivers.end())
+    {
+#ifdef __linux__
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, receiver->second->sock, NULL);
+#endif
+
+        receivers.erase(receiver);
+    }
+
+    timers.erase(handle);
+
+    wake();
+
+    /*-----------------------------------------------------*\
+    | A callback removing its own handle must not wait for  |
+    | itself                                                |
+    \*-----------------------------------------------------*/
+    if(!is_reactor_thread())
+    {
+        dispatch_cv.wait(lock, [this, handle]()
+        {
+            return(dispatching != handle);
+        });
+    }
+}
+
+bool net_reactor::is_reactor_thread()
+{
+    return(std::this_thread::get_id() == reactor_thread->get_id());
+}
+
+void net_reactor::wake()
+{
+    char wake_byte = 0;
+
+    sendto(wake_sock, &wake_byte, 1, 0, (sockaddr *)&wake_addr, sizeof(wake_addr));
+}
+
+void net_reactor::drain_wake()
+{
+    char wake_bytes[16];
+
+    while(recv(wake_sock, wake_bytes, sizeof(wake_bytes), 0) > 0)
+    {
+    }
+}
+
+void net_reactor::reactor_thread_function()
+{
+    std::unique_lock<std::mutex> lock(reactor_mutex);
+
+    while(running)
+    {
+        /*-------------------------------------------------*\
+        | Run the timers that are due and wait until the    |
+        | next one at most                                  |
+        \*-------------------------------------------------*/
+        std::chrono::steady_clock::time_point next_timer = dispatch_timers(lock);
+
+        if(!running)
+        {
+            break;
+        }
+
+        int timeout_ms = -1;
+
+        if(next_timer != std::chrono::steady_clock::time_point::max())
+        {
+            std::chrono::steady_clock::duration wait = next_timer - std::chrono::steady_clock::now();
+
+            timeout_ms = (int)std::max<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(wait + std::chrono::milliseconds(1)).count(), 0);
+        }
+
+        std::vector<unsigned int> ready;
+
+#ifdef __linux__
+        epoll_event events[NET_REACTOR_MAX_EVENTS];
+
+        lock.unlock();
+
+        int num_events = epoll_wait(epoll_fd, events, NET_REACTOR_MAX_EVENTS, timeout_ms);
+
+        lock.lock();
+
+        for(int event_idx = 0; event_idx < num_events; event_idx++)
+        {
+            ready.push_back(events[event_idx].data.u32);
+        }
+#else
+        /*-------------------------------------------------*\
+        | Without epoll the poll set is rebuilt every wait, |
+        | changes wake the wait so they are picked up       |
+        \*-------------------------------------------------*/
+        std::vector<pollfd>         poll_fds;
+        std::vector<unsigned int>   poll_handles;
+        pollfd                      poll_entry = {};
+
+        poll_entry.fd       = wake_sock;
+        poll_entry.events   = POLLIN;
+
+        poll_fds.push_back(poll_entry);
+        poll_handles.push_back(NET_REACTOR_WAKE_HANDLE);
+
+        for(std::map<unsigned int, receiver_ptr>::iterator receiver = receivers.begin(); receiver != receivers.end(); receiver++)
+        {
+            poll_entry.fd   = receiver->second->sock;
+
+            poll_fds.push_back(poll_entry);
+            poll_handles.push_back(receiver->first);
+        }
+
+        lock.unlock();
+
+        int num_events = poll(poll_fds.data(), (unsigned long)poll_fds.size(), timeout_ms);
+
+        lock.lock();
+
+        for(std::size_t poll_idx = 0; (num_events > 0) && (poll_idx < poll_fds.size()); poll_idx++)
+        {
+            if(poll_fds[poll_idx].revents != 0)
+            {
+                ready.push_back(poll_handles[poll_idx]);
+            }
+        }
+#endif
+
+        for(std::size_t ready_idx = 0; running && (ready_idx < ready.size()); ready_idx++)
+        {
+            if(ready[ready_idx] == NET_REACTOR_WAKE_HANDLE)
+            {
+                drain_wake();
+            }
+            else
+            {
+                dispatch_receiver(lock, ready[ready_idx]);
+            }
+        }
+    }
+}
+
+/*---------------------------------------------------------*\
+| The following functions are called with reactor_mutex     |
+| held, they release it while a callback runs               |
+\*---------------------------------------------------------*/
+void net_reactor::dispatch_receiver(std::unique_lock<std::mutex>& lock, unsigned int handle)
+{
+    for(unsigned int read_idx = 0; read_idx < NET_REACTOR_MAX_READS; read_idx++)
+    {
+        /*-------------------------------------------------*\
+        | The receiver may have been removed by an earlier  |
+        | callback                                          |
+        \*-------------------------------------------------*/
+        std::map<unsigned int, receiver_ptr>::iterator entry = receivers.find(handle);
+
+        if(entry == receivers.end())
+        {
+            return;
+        }
+
+        receiver_ptr receiver = entry->second;
+
+        int size = recv(receiver->sock, receive_buffer.data(), NET_REACTOR_RECEIVE_BUFFER_SIZE, 0);
+
+        /*-------------------------------------------------*\
+        | Datagram sockets report errors of earlier sends   |
+        | here, which are not a reason to stop listening    |
+        \*-------------------------------------------------*/
+        if((size <= 0) && !receiver->stream)
+        {
+            return;
+        }
+
+        if(size > 0)
+        {
+            receive_buffer[size] = '\0';
+        }
+        else
+        {
+#ifdef WIN32
+            bool would_block = (WSAGetLastError() == WSAEWOULDBLOCK);
+#else
+            bool would_block = (errno == EAGAIN) || (errno == EWOULDBLOCK);
+#endif
+
+            if((size < 0) && would_block)
+            {
+                return;
+            }
+
+#ifdef __linux__
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, receiver->sock, NULL);
+#endif
+
+            receivers.erase(handle);
+        }
+
+        dispatching = handle;
+
+        lock.unlock();
+
+        /*-------------------------------------------------*\
+        | A malformed response must not take down the       |
+        | thread all network devices share                  |
+        \*-------------------------------------------------*/
+        try
+        {
+            receiver->callback(receive_buffer.data(), size);
+        }
+        catch(...)
+        {
+        }
+
+        lock.lock();
+
+        dispatching = 0;
+        dispatch_cv.notify_all();
+
+        if(size <= 0)
+        {
+            return;
+        }
+    }
+}
+
+std::chrono::steady_clock::time_point net_reactor::dispatch_timers(std::unique_lock<std::mutex>& lock)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::vector<unsigned int>             due;
+
+    for(std::map<unsigned int, timer_ptr>::iterator timer = timers.begin(); timer != timers.end(); timer++)
+    {
+        if(timer->second->next <= now)
+        {
+            due.push_back(timer->first);
+        }
+    }
+
+    for(std::size_t due_idx = 0; running && (due_idx < due.size()); due_idx++)
+    {
+        std::map<unsigned int, timer_ptr>::iterator entry = timers.find(due[due_idx]);
+
+        if(entry == timers.end())
+        {
+            continue;
+        }
+
+        timer_ptr timer = entry->second;
+
+        /*-------------------------------------------------*\
+        | A timer that fell behind skips the missed runs    |
+        | instead of running them back to back              |
+        \*-------------------------------------------------*/
+        timer->next += timer->interval;
+
+        if(timer->next <= now)
+        {
+            timer->next = now + timer->interval;
+        }
+
+        dispatching = due[due_idx];
+
+        lock.unlock();
+
+        try
+        {
+            timer->callback();
+        }
+        catch(...)
+        {
+        }
+
+        lock.lock();
+
+        dispatching = 0;
+        dispatch_cv.notify_all();
+    }
+
+    std::chrono::steady_clock::time_point next_timer = std::chrono::steady_clock::time_point::max();
+
+    for(std::map<unsigned int, timer_ptr>::iterator timer = timers.begin(); timer != timers.end(); timer++)
+    {
+        next_timer = std::min(next_timer, timer->second->next);
+    }
+
+    return(next_timer);
+}
@@ -0,0 +1,97 @@
+/*---------------------------------------------------------*\
+| net_reactor.h                                             |
+|                                                           |
+|   Shared I/O thread dispatching received network data     |
+|   and keepalive timers for network device drivers         |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "net_port.h"
+
+#define NET_REACTOR_RECEIVE_BUFFER_SIZE 65536   /* Largest datagram delivered to a callback */
+
+/*---------------------------------------------------------*\
+| Called on the reactor thread every interval               |
+\*---------------------------------------------------------*/
+typedef std::function<void()> net_reactor_timer_callback;
+
+//Network Reactor Class
+//One thread waits on the sockets of all network devices and runs
+//their keepalive timers, instead of every driver polling its own
+//socket or sleeping in its own thread.  Sockets stay owned by their
+//net_port, the reactor only reads from them.  Callbacks run on the
+//reactor thread and must not block.
+
+class net_reactor
+{
+public:
+    static net_reactor * get();
+
+    unsigned int add_receiver(SOCKET sock, net_port_receive_callback callback);
+    unsigned int add_timer(unsigned int interval_ms, net_reactor_timer_callback callback);
+
+    //Stop a receiver or timer.  When called from another thread, waits
+    //for a callback of the handle that is running to return, so the
+    //callback's object can be deleted afterwards.
+    void remove(unsigned int handle);
+
+    bool is_reactor_thread();
+
+private:
+    net_reactor();
+    ~net_reactor();
+
+    typedef struct
+    {
+        SOCKET                                  sock;
+        bool                                    stream;
+        net_port_receive_callback               callback;
+    } net_reactor_receiver;
+
+    typedef struct
+    {
+        std::chrono::milliseconds               interval;
+        std::chrono::steady_clock::time_point   next;
+        net_reactor_timer_callback              callback;
+    } net_reactor_timer;
+
+    typedef std::shared_ptr<net_reactor_receiver>   receiver_ptr;
+    typedef std::shared_ptr<net_reactor_timer>      timer_ptr;
+
+    std::mutex                                  reactor_mutex;
+    std::condition_variable                     dispatch_cv;
+    std::map<unsigned int, receiver_ptr>        receivers;
+    std::map<unsigned int, timer_ptr>           timers;
+    unsigned int                                next_handle;
+    unsigned int                                dispatching;
+    bool                                        running;
+
+    std::thread *                               reactor_thread;
+    std::vector<char>                           receive_buffer;
+
+    //Loopback socket the wait is interrupted through after a change
+    SOCKET                                      wake_sock;
+    sockaddr_in                                 wake_addr;
+
+#ifdef __linux__
+    int                                         epoll_fd;
+#endif
+
+    void reactor_thread_function();
+    void wake();
+    void drain_wake();
+
+    void dispatch_receiver(std::unique_lock<std::mutex>& lock, unsigned int handle);
+    std::chrono::steady_clock::time_point dispatch_timers(std::unique_lock<std::mutex>& lock);
+};
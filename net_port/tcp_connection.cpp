@@ -0,0 +1,533 @@
+/*---------------------------------------------------------*\
+| tcp_connection.cpp                                        |
+|                                                           |
+|   Persistent TCP client connection on top of net_port,    |
+|   with reconnect on failure and a coalescing write queue  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include "tcp_connection.h"
+#include "RGBControllerRateControl.h"
+#include "RGBControllerStats.h"
+
+#ifdef _WIN32
+#define MSG_NOSIGNAL 0
+#endif
+
+tcp_connection::tcp_connection()
+{
+    resolved                = false;
+    connect_count           = 0;
+    queue_sending           = false;
+    pipeline_depth          = 0;
+    in_flight               = 0;
+    response_timeout_ms     = TCP_CONNECTION_RESPONSE_TIMEOUT_MS;
+    write_time_us           = 0;
+    response_latency_us     = 0;
+    queue_thread            = nullptr;
+    queue_thread_running    = false;
+    port.connected          = false;
+}
+
+tcp_connection::~tcp_connection()
+{
+    close();
+}
+
+bool tcp_connection::open(const char * client_name, const char * port_name)
+{
+    /*-----------------------------------------------------*\
+    | Keep copies of the address, net_port tokenizes the    |
+    | port string in place                                  |
+    \*-----------------------------------------------------*/
+    this->client_name       = client_name;
+    this->port_name         = port_name;
+
+    resolved                = port.tcp_client(this->client_name.c_str(), &this->port_name[0]);
+
+    return(resolved);
+}
+
+void tcp_connection::close()
+{
+    if(queue_thread != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            queue_thread_running = false;
+        }
+
+        queue_cv.notify_all();
+
+        queue_thread->join();
+        delete queue_thread;
+        queue_thread = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    disconnect();
+}
+
+void tcp_connection::set_response_delimiter(const char * delimiter)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    response_delimiter = delimiter;
+    response_tail.clear();
+}
+
+void tcp_connection::set_response_match(const char * match)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    response_match = match;
+    response_tail.clear();
+}
+
+void tcp_connection::set_pipeline_depth(unsigned int depth)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    pipeline_depth = depth;
+}
+
+void tcp_connection::set_response_timeout(int timeout_ms)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    response_timeout_ms = timeout_ms;
+}
+
+void tcp_connection::queue_write(const char * buffer, int length, int coalesce_key)
+{
+    /*-----------------------------------------------------*\
+    | Account the bytes here, on the caller's thread, so    |
+    | they are credited to the controller that sent them.   |
+    | The controller's rate control also gets the latest    |
+    | reply latency from here.                              |
+    \*-----------------------------------------------------*/
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_NETWORK, length);
+
+    long long latency_us = response_latency_us.load();
+
+    if(latency_us > 0)
+    {
+        RGBControllerRateControl::RecordReplyLatency(latency_us);
+    }
+
+    bool replaced = false;
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+
+        /*-------------------------------------------------*\
+        | Start the queue thread on first use, connections  |
+        | only used synchronously do not need one           |
+        \*-------------------------------------------------*/
+        if(queue_thread == nullptr)
+        {
+            queue_thread_running    = true;
+            queue_thread            = new std::thread(&tcp_connection::queue_thread_function, this);
+        }
+
+        /*-------------------------------------------------*\
+        | Replace a command with the same key that has not  |
+        | been sent yet, keeping its place in the queue     |
+        \*-------------------------------------------------*/
+        if(coalesce_key != 0)
+        {
+            for(tcp_connection_command& command : queue)
+            {
+                if(command.coalesce_key == coalesce_key)
+                {
+                    command.data.assign(buffer, length);
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+
+        if(!replaced)
+        {
+            tcp_connection_command new_command;
+
+            new_command.data.assign(buffer, length);
+            new_command.coalesce_key    = coalesce_key;
+
+            queue.push_back(new_command);
+        }
+    }
+
+    queue_cv.notify_all();
+
+    /*-----------------------------------------------------*\
+    | A replaced command means the device is not keeping up |
+    \*-----------------------------------------------------*/
+    if(replaced)
+    {
+        RGBControllerRateControl::RecordCongestion();
+    }
+}
+
+bool tcp_connection::flush(int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(queue_mutex);
+
+    return(queue_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]()
+    {
+        return(queue.empty() && !queue_sending);
+    }));
+}
+
+int tcp_connection::write(const char * buffer, int length)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_NETWORK, length);
+
+    /*-----------------------------------------------------*\
+    | A device that dropped an idle connection only shows   |
+    | up on the next send, so retry once on a fresh one     |
+    \*-----------------------------------------------------*/
+    for(unsigned int attempt = 0; attempt < 2; attempt++)
+    {
+        if(ensure_connected() && send_all(buffer, length))
+        {
+            write_time_us = RGBControllerStats::NowMicroseconds();
+            return(length);
+        }
+
+        disconnect();
+    }
+
+    return(-1);
+}
+
+int tcp_connection::read(char * recv_data, int length, int timeout_ms)
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    if(!port.connected)
+    {
+        return(-1);
+    }
+
+    /*-----------------------------------------------------*\
+    | Drop the connection on a timeout as well, otherwise a |
+    | late response would be read as the answer to the next |
+    | request                                               |
+    \*-----------------------------------------------------*/
+    int ret = -1;
+
+    if(wait_readable(timeout_ms) > 0)
+    {
+        ret = recv(port.sock, recv_data, length, 0);
+    }
+
+    if(ret <= 0)
+    {
+        disconnect();
+    }
+    else if(write_time_us != 0)
+    {
+        RGBControllerRateControl::RecordReplyLatency(RGBControllerStats::NowMicroseconds() - write_time_us);
+        write_time_us = 0;
+    }
+
+    return(ret);
+}
+
+bool tcp_connection::is_connected()
+{
+    std::lock_guard<std::mutex> lock(socket_mutex);
+
+    return(port.connected);
+}
+
+unsigned long long tcp_connection::get_connect_count()
+{
+    return(connect_count);
+}
+
+void tcp_connection::queue_thread_function()
+{
+    while(queue_thread_running)
+    {
+        tcp_connection_command command;
+
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+
+            queue_sending = false;
+            queue_cv.notify_all();
+
+            queue_cv.wait(lock, [this]()
+            {
+                return(!queue_thread_running || !queue.empty());
+            });
+
+            if(!queue_thread_running)
+            {
+                break;
+            }
+
+            command = queue.front();
+            queue.pop_front();
+            queue_sending = true;
+        }
+
+        bool sent = false;
+
+        {
+            std::lock_guard<std::mutex> lock(socket_mutex);
+
+            for(unsigned int attempt = 0; (attempt < 2) && !sent; attempt++)
+            {
+                if(!ensure_connected())
+                {
+                    break;
+                }
+
+                /*-----------------------------------------*\
+                | Consume replies to earlier commands,      |
+                | which also notices a connection that the  |
+                | device closed while idle                  |
+                \*-----------------------------------------*/
+                while(port.connected && (wait_readable(0) > 0))
+                {
+                    receive_responses(0);
+                }
+
+                if(!port.connected)
+                {
+                    continue;
+                }
+
+                if(!send_all(command.data.data(), (int)command.data.size()))
+                {
+                    disconnect();
+                    continue;
+                }
+
+                /*-----------------------------------------*\
+                | With pipelining, stop sending once depth  |
+                | requests are outstanding until one is     |
+                | answered.  A device that closes the       |
+                | connection or stops answering meanwhile   |
+                | is reconnected and the command resent.    |
+                \*-----------------------------------------*/
+                if(pipeline_depth > 0)
+                {
+                    long long send_us = RGBControllerStats::NowMicroseconds();
+
+                    in_flight++;
+
+                    while(port.connected && (in_flight >= pipeline_depth))
+                    {
+                        if(!receive_responses(response_timeout_ms))
+                        {
+                            disconnect();
+                        }
+                    }
+
+                    if(!port.connected)
+                    {
+                        continue;
+                    }
+
+                    response_latency_us = RGBControllerStats::NowMicroseconds() - send_us;
+                }
+
+                sent = true;
+            }
+        }
+
+        if(sent)
+        {
+            continue;
+        }
+
+        /*-------------------------------------------------*\
+        | The device is unreachable.  Put the command back  |
+        | unless a newer one with the same key replaced it  |
+        | meanwhile, then wait before reconnecting.         |
+        \*-------------------------------------------------*/
+        std::unique_lock<std::mutex> lock(queue_mutex);
+
+        bool superseded = false;
+
+        if(command.coalesce_key != 0)
+        {
+            for(const tcp_connection_command& queued : queue)
+            {
+                if(queued.coalesce_key == command.coalesce_key)
+                {
+                    superseded = true;
+                    break;
+                }
+            }
+        }
+
+        if(!superseded)
+        {
+            queue.push_front(command);
+        }
+
+        queue_cv.wait_for(lock, std::chrono::milliseconds(TCP_CONNECTION_RECONNECT_DELAY_MS), [this]()
+        {
+            return(!queue_thread_running);
+        });
+    }
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+
+    queue_sending = false;
+    queue_cv.notify_all();
+}
+
+/*---------------------------------------------------------*\
+| The following functions are called with socket_mutex held |
+\*---------------------------------------------------------*/
+bool tcp_connection::ensure_connected()
+{
+    if(port.connected)
+    {
+        return(true);
+    }
+
+    if(!resolved)
+    {
+        return(false);
+    }
+
+    if(port.tcp_client_connect())
+    {
+        connect_count++;
+        return(true);
+    }
+
+    return(false);
+}
+
+void tcp_connection::disconnect()
+{
+    if(port.connected)
+    {
+        port.tcp_close();
+    }
+
+    in_flight = 0;
+    response_tail.clear();
+}
+
+bool tcp_connection::send_all(const char * buffer, int length)
+{
+    while(length > 0)
+    {
+        int ret = send(port.sock, buffer, length, MSG_NOSIGNAL);
+
+        if(ret <= 0)
+        {
+            return(false);
+        }
+
+        buffer += ret;
+        length -= ret;
+    }
+
+    return(true);
+}
+
+int tcp_connection::wait_readable(int timeout_ms)
+{
+    fd_set  readfd;
+    timeval tv;
+
+    FD_ZERO(&readfd);
+    FD_SET(port.sock, &readfd);
+
+    tv.tv_sec   = timeout_ms / 1000;
+    tv.tv_usec  = (timeout_ms % 1000) * 1000;
+
+    return(select((int)port.sock + 1, &readfd, NULL, NULL, &tv));
+}
+
+bool tcp_connection::receive_responses(int timeout_ms)
+{
+    char recv_buf[1024];
+
+    if(wait_readable(timeout_ms) <= 0)
+    {
+        return(false);
+    }
+
+    int ret = recv(port.sock, recv_buf, sizeof(recv_buf), 0);
+
+    if(ret <= 0)
+    {
+        disconnect();
+        return(false);
+    }
+
+    if(response_delimiter.empty())
+    {
+        return(true);
+    }
+
+    /*-----------------------------------------------------*\
+    | Count delimiters, keeping the end of the data so a    |
+    | delimiter split across two reads is still found       |
+    \*-----------------------------------------------------*/
+    std::string search = response_tail + std::string(recv_buf, ret);
+    std::size_t start  = 0;
+    std::size_t pos    = 0;
+
+    while((pos = search.find(response_delimiter, pos)) != std::string::npos)
+    {
+        /*-------------------------------------------------*\
+        | With a match set, a message without it is a       |
+        | notification and does not answer a request        |
+        \*-------------------------------------------------*/
+        bool response = response_match.empty() || (search.find(response_match, start) < pos);
+
+        if(response && (in_flight > 0))
+        {
+            in_flight--;
+        }
+
+        pos   += response_delimiter.size();
+        start  = pos;
+    }
+
+    /*-----------------------------------------------------*\
+    | With a match set, keep the whole unfinished message   |
+    | so it can be matched once its delimiter arrives       |
+    \*-----------------------------------------------------*/
+    if(!response_match.empty())
+    {
+        response_tail = search.substr(start);
+
+        if(response_tail.size() > TCP_CONNECTION_MAX_MESSAGE_SIZE)
+        {
+            response_tail.clear();
+        }
+
+        return(true);
+    }
+
+    std::size_t keep = response_delimiter.size() - 1;
+
+    if(search.size() > keep)
+    {
+        response_tail = search.substr(search.size() - keep);
+    }
+    else
+    {
+        response_tail = search;
+    }
+
+    return(true);
+}
@@ -0,0 +1,119 @@
+/*---------------------------------------------------------*\
+| tcp_connection.h                                          |
+|                                                           |
+|   Persistent TCP client connection on top of net_port,    |
+|   with reconnect on failure and a coalescing write queue  |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "net_port.h"
+
+#define TCP_CONNECTION_RESPONSE_TIMEOUT_MS  1000
+#define TCP_CONNECTION_RECONNECT_DELAY_MS   1000
+#define TCP_CONNECTION_MAX_MESSAGE_SIZE     4096
+
+/*---------------------------------------------------------*\
+| HTTP responses start with the status line                 |
+\*---------------------------------------------------------*/
+#define TCP_CONNECTION_HTTP_DELIMITER       "HTTP/1."
+
+//TCP Connection Class
+//Keeps one connection to a device open across commands instead of
+//connecting for every write.  Commands can be written synchronously
+//or queued for a background thread that coalesces queued commands
+//sharing a key down to the newest one.
+
+class tcp_connection
+{
+public:
+    tcp_connection();
+    ~tcp_connection();
+
+    //Resolve the device address.  The connection itself is opened on
+    //first use.
+    bool open(const char * client_name, const char * port);
+    void close();
+
+    //Response tracking for queued writes.  Each occurrence of the
+    //delimiter in the received stream completes one request.  With a
+    //pipeline depth of 0 responses are discarded without waiting,
+    //otherwise up to depth requests are sent before waiting for a
+    //response.  A request not answered within the timeout drops the
+    //connection and reconnects.
+    void set_response_delimiter(const char * delimiter);
+    void set_pipeline_depth(unsigned int depth);
+    void set_response_timeout(int timeout_ms);
+
+    //Only count delimited messages containing match as responses,
+    //for devices that also send unsolicited notifications.  The
+    //message is the data before each delimiter.
+    void set_response_match(const char * match);
+
+    //Queue a command for the background thread.  A queued command
+    //not yet sent is replaced by a newer one with the same key, key 0
+    //commands are never replaced.
+    void queue_write(const char * buffer, int length, int coalesce_key = 0);
+
+    //Wait until all queued commands are sent or the timeout expires
+    bool flush(int timeout_ms);
+
+    //Synchronous access for request/response protocols.  write()
+    //reconnects and retries once if the connection was lost, read()
+    //drops the connection on timeout or error.  Not to be used while
+    //queued commands are pending.
+    int  write(const char * buffer, int length);
+    int  read(char * recv_data, int length, int timeout_ms);
+
+    bool is_connected();
+    unsigned long long get_connect_count();
+
+private:
+    typedef struct
+    {
+        std::string         data;
+        int                 coalesce_key;
+    } tcp_connection_command;
+
+    net_port                            port;
+    std::string                         client_name;
+    std::string                         port_name;
+    bool                                resolved;
+
+    std::mutex                          socket_mutex;
+    std::atomic<unsigned long long>     connect_count;
+
+    std::mutex                          queue_mutex;
+    std::condition_variable             queue_cv;
+    std::deque<tcp_connection_command>  queue;
+    bool                                queue_sending;
+
+    std::string                         response_delimiter;
+    std::string                         response_match;
+    std::string                         response_tail;
+    unsigned int                        pipeline_depth;
+    unsigned int                        in_flight;
+    int                                 response_timeout_ms;
+    long long                           write_time_us;
+    std::atomic<long long>              response_latency_us;
+
+    std::thread *                       queue_thread;
+    std::atomic<bool>                   queue_thread_running;
+
+    void queue_thread_function();
+
+    bool ensure_connected();
+    void disconnect();
+    bool send_all(const char * buffer, int length);
+    int  wait_readable(int timeout_ms);
+    bool receive_responses(int timeout_ms);
+};
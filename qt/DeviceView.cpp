@@ -9,6 +9,7 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <algorithm>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QStyleOption>
@@ -36,6 +37,7 @@ DeviceView::DeviceView(QWidget *parent) :
     controller = NULL;
     numerical_labels = false;
     per_led = true;
+    led_cache_valid = false;
     setMouseTracking(1);
 
     size = width();
@@ -387,20 +389,22 @@ void DeviceView::InitDeviceView()
                             | Fill Wide:                                            |
                             |    Space                                              |
                             \*-----------------------------------------------------*/
+                            std::string led_name = controller->GetLEDName(color_idx);
+
                             if(led_x < map->width - 1 && map->map[map_idx + 1] == 0xFFFFFFFF)
                             {
-                                if( ( controller->GetLEDName(color_idx) == KEY_EN_TAB        )
-                                 || ( controller->GetLEDName(color_idx) == KEY_EN_CAPS_LOCK  )
-                                 || ( controller->GetLEDName(color_idx) == KEY_EN_LEFT_SHIFT )
-                                 || ( controller->GetLEDName(color_idx) == KEY_EN_RIGHT_SHIFT)
-                                 || ( controller->GetLEDName(color_idx) == KEY_EN_BACKSPACE  )
-                                 || ( controller->GetLEDName(color_idx) == KEY_EN_NUMPAD_0   ) )
+                                if( ( led_name == KEY_EN_TAB        )
+                                 || ( led_name == KEY_EN_CAPS_LOCK  )
+                                 || ( led_name == KEY_EN_LEFT_SHIFT )
+                                 || ( led_name == KEY_EN_RIGHT_SHIFT)
+                                 || ( led_name == KEY_EN_BACKSPACE  )
+                                 || ( led_name == KEY_EN_NUMPAD_0   ) )
                                 {
                                     led_pos[color_idx].matrix_w += 1.0f;
                                 }
                             }
-                            if( ( controller->GetLEDName(color_idx) == KEY_EN_NUMPAD_ENTER   )
-                             || ( controller->GetLEDName(color_idx) == KEY_EN_NUMPAD_PLUS    ) )
+                            if( ( led_name == KEY_EN_NUMPAD_ENTER   )
+                             || ( led_name == KEY_EN_NUMPAD_PLUS    ) )
                             {
                                 if(led_y < map->height - 1 && map->map[map_idx + map->width] == 0xFFFFFFFF)
                                 {
@@ -413,7 +417,7 @@ void DeviceView::InitDeviceView()
                                     led_pos[color_idx].matrix_h += 1.0f;
                                 }
                             }
-                            else if(controller->GetLEDName(color_idx) == KEY_EN_SPACE)
+                            else if(led_name == KEY_EN_SPACE)
                             {
                                 for(unsigned int map_idx2 = map_idx - 1; map_idx2 > led_y * map->width && map->map[map_idx2] == 0xFFFFFFFF; map_idx2--)
                                 {
@@ -557,6 +561,148 @@ void DeviceView::InitDeviceView()
         size     = height() / matrix_h;
         offset_x = (width() - size) / 2;
     }
+
+    InvalidateCache();
+}
+
+void DeviceView::InvalidateCache()
+{
+    led_cache_valid = false;
+}
+
+void DeviceView::UpdateCache()
+{
+    std::size_t                 led_count   = controller->leds.size();
+    std::vector<unsigned int>   dirty_leds;
+    qreal                       pixel_ratio = devicePixelRatioF();
+
+    /*-----------------------------------------------------*\
+    | Rebuild the static layout: pixel rectangles, label    |
+    | font sizes and laid out label text.  Every LED is     |
+    | dirty after a rebuild.                                |
+    \*-----------------------------------------------------*/
+    if(!led_cache_valid || (led_cache.devicePixelRatio() != pixel_ratio))
+    {
+        led_cache = QPixmap(width() * pixel_ratio, height() * pixel_ratio);
+        led_cache.setDevicePixelRatio(pixel_ratio);
+        led_cache.fill(Qt::transparent);
+
+        led_rects.resize(led_count);
+        led_font_sizes.resize(led_count);
+        led_static_labels.resize(led_count);
+        painted_colors.resize(led_count);
+        painted_selection.assign(led_count, false);
+
+        QFont label_font = font();
+
+        for(unsigned int led_idx = 0; led_idx < led_count; led_idx++)
+        {
+            int posx = led_pos[led_idx].matrix_x * size + offset_x;
+            int posy = led_pos[led_idx].matrix_y * size;
+            int posw = led_pos[led_idx].matrix_w * size;
+            int posh = led_pos[led_idx].matrix_h * size;
+
+            led_rects[led_idx]      = {posx, posy, posw, posh};
+            led_font_sizes[led_idx] = std::max<int>(1, posh / 2);
+
+            label_font.setPixelSize(led_font_sizes[led_idx]);
+
+            led_static_labels[led_idx].setText(led_labels[led_idx]);
+            led_static_labels[led_idx].setTextFormat(Qt::PlainText);
+            led_static_labels[led_idx].prepare(QTransform(), label_font);
+
+            dirty_leds.push_back(led_idx);
+        }
+
+        led_cache_valid = true;
+    }
+    /*-----------------------------------------------------*\
+    | Otherwise only LEDs that changed since the last paint |
+    | need to be drawn                                      |
+    \*-----------------------------------------------------*/
+    else
+    {
+        for(unsigned int led_idx = 0; led_idx < led_count; led_idx++)
+        {
+            if((painted_colors[led_idx] != controller->colors[led_idx]) || (painted_selection[led_idx] != selectionFlags[led_idx]))
+            {
+                dirty_leds.push_back(led_idx);
+            }
+        }
+    }
+
+    if(dirty_leds.empty())
+    {
+        return;
+    }
+
+    /*-----------------------------------------------------*\
+    | Batch by color so the brush and label pen only change |
+    | once per distinct color                               |
+    \*-----------------------------------------------------*/
+    std::sort(dirty_leds.begin(), dirty_leds.end(), [this](unsigned int a, unsigned int b)
+    {
+        return(controller->colors[a] < controller->colors[b]);
+    });
+
+    QPainter    painter(&led_cache);
+    QFont       label_font          = font();
+    QColor      border_selected     = palette().highlight().color();
+    QColor      border_unselected   = palette().dark().color();
+    QColor      text_color;
+    RGBColor    last_color          = 0;
+    int         last_font_size      = 0;
+    bool        first               = true;
+
+    for(std::size_t dirty_idx = 0; dirty_idx < dirty_leds.size(); dirty_idx++)
+    {
+        unsigned int    led_idx     = dirty_leds[dirty_idx];
+        RGBColor        color       = controller->colors[led_idx];
+        bool            selected    = selectionFlags[led_idx];
+
+        /*-----------------------------------------------------*\
+        | Fill color and label color for this color batch       |
+        \*-----------------------------------------------------*/
+        if(first || (color != last_color))
+        {
+            QColor currentColor = QColor::fromRgb(RGBGetRValue(color), RGBGetGValue(color), RGBGetBValue(color));
+            painter.setBrush(currentColor);
+
+            unsigned int luma = (unsigned int)(0.2126f * currentColor.red() + 0.7152f * currentColor.green() + 0.0722f * currentColor.blue());
+
+            text_color = (luma > 127) ? QColor(Qt::black) : QColor(Qt::white);
+            last_color = color;
+            first      = false;
+        }
+
+        /*-----------------------------------------------------*\
+        | Border color                                          |
+        \*-----------------------------------------------------*/
+        painter.setPen(selected ? border_selected : border_unselected);
+        painter.drawRect(led_rects[led_idx]);
+
+        /*-----------------------------------------------------*\
+        | Label                                                 |
+        \*-----------------------------------------------------*/
+        if(!led_labels[led_idx].isEmpty())
+        {
+            if(led_font_sizes[led_idx] != last_font_size)
+            {
+                label_font.setPixelSize(led_font_sizes[led_idx]);
+                painter.setFont(label_font);
+                last_font_size = led_font_sizes[led_idx];
+            }
+
+            QRect   rect        = led_rects[led_idx];
+            QSizeF  label_size  = led_static_labels[led_idx].size();
+
+            painter.setPen(text_color);
+            painter.drawStaticText(QPointF(rect.x() + (rect.width() - label_size.width()) / 2.0, rect.y() + (rect.height() - label_size.height()) / 2.0), led_static_labels[led_idx]);
+        }
+
+        painted_colors[led_idx]     = color;
+        painted_selection[led_idx]  = selected;
+    }
 }
 
 void DeviceView::setNumericalLabels(bool enable)
@@ -717,9 +863,24 @@ void DeviceView::resizeEvent(QResizeEvent* /*event*/)
         size     = height() / matrix_h;
         offset_x = (width() - size) / 2;
     }
+
+    InvalidateCache();
     update();
 }
 
+void DeviceView::changeEvent(QEvent *event)
+{
+    /*-----------------------------------------------------*\
+    | Cached LEDs use palette and font, redraw on changes   |
+    \*-----------------------------------------------------*/
+    if((event->type() == QEvent::PaletteChange) || (event->type() == QEvent::FontChange) || (event->type() == QEvent::StyleChange))
+    {
+        InvalidateCache();
+    }
+
+    QWidget::changeEvent(event);
+}
+
 void DeviceView::paintEvent(QPaintEvent* /* event */)
 {
     QPainter painter(this);
@@ -760,58 +921,11 @@ void DeviceView::paintEvent(QPaintEvent* /* event */)
     }
 
     /*-----------------------------------------------------*\
-    | LED rectangles                                        |
+    | LED rectangles and labels                             |
     \*-----------------------------------------------------*/
-    for(unsigned int led_idx = 0; led_idx < controller->leds.size(); led_idx++)
-    {
-        int posx = led_pos[led_idx].matrix_x * size + offset_x;
-        int posy = led_pos[led_idx].matrix_y * size;
-        int posw = led_pos[led_idx].matrix_w * size;
-        int posh = led_pos[led_idx].matrix_h * size;
-
-        QRect rect = {posx, posy, posw, posh};
+    UpdateCache();
 
-        /*-----------------------------------------------------*\
-        | Fill color                                            |
-        \*-----------------------------------------------------*/
-        QColor currentColor = QColor::fromRgb(
-                    RGBGetRValue(controller->colors[led_idx]),
-                    RGBGetGValue(controller->colors[led_idx]),
-                    RGBGetBValue(controller->colors[led_idx]));
-        painter.setBrush(currentColor);
-
-        /*-----------------------------------------------------*\
-        | Border color                                          |
-        \*-----------------------------------------------------*/
-        if(selectionFlags[led_idx])
-        {
-            painter.setPen(palette().highlight().color());
-        }
-        else
-        {
-            painter.setPen(palette().dark().color());
-        }
-        painter.drawRect(rect);
-
-        /*-----------------------------------------------------*\
-        | Label                                                 |
-        | Set the font color so that the text is visible        |
-        \*-----------------------------------------------------*/
-        font.setPixelSize(std::max<int>(1, posh / 2));
-        painter.setFont(font);
-
-        unsigned int luma = (unsigned int)(0.2126f * currentColor.red() + 0.7152f * currentColor.green() + 0.0722f * currentColor.blue());
-
-        if(luma > 127)
-        {
-            painter.setPen(Qt::black);
-        }
-        else
-        {
-            painter.setPen(Qt::white);
-        }
-        painter.drawText(rect, Qt::AlignVCenter | Qt::AlignHCenter, QString(led_labels[led_idx]));
-    }
+    painter.drawPixmap(0, 0, led_cache);
 
     font.setPixelSize(12);
     painter.setFont(font);
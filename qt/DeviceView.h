@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <QPixmap>
+#include <QStaticText>
 #include <QWidget>
 #include "RGBController.h"
 
@@ -42,6 +44,7 @@ protected:
     void mouseReleaseEvent(QMouseEvent *);
     void resizeEvent(QResizeEvent *event);
     void paintEvent(QPaintEvent *);
+    void changeEvent(QEvent *event);
 
 private:
     QSize initSize;
@@ -67,10 +70,25 @@ private:
 
     bool                                numerical_labels;
 
+    /*---------------------------------------------------------*\
+    | Rendered LED layer.  Rebuilt when the layout changes and  |
+    | patched in place for LEDs whose color or selection state  |
+    | changed since the last paint.                             |
+    \*---------------------------------------------------------*/
+    QPixmap                             led_cache;
+    bool                                led_cache_valid;
+    std::vector<QRect>                  led_rects;
+    std::vector<int>                    led_font_sizes;
+    std::vector<QStaticText>            led_static_labels;
+    std::vector<RGBColor>               painted_colors;
+    std::vector<bool>                   painted_selection;
+
     RGBController* controller;
 
     QColor posColor(const QPoint &point);
     void InitDeviceView();
+    void InvalidateCache();
+    void UpdateCache();
     void updateSelection();
 
 signals:
@@ -7,7 +7,9 @@
 |   SPDX-License-Identifier: GPL-2.0-only                   |
 \*---------------------------------------------------------*/
 
+#include <QShowEvent>
 #include "OpenRGBDevicePage.h"
+#include "OpenRGBRefreshHub.h"
 #include "OpenRGBZoneResizeDialog.h"
 #include "ResourceManager.h"
 #include "SettingsManager.h"
@@ -17,7 +19,7 @@ static void UpdateCallback(void * this_ptr)
 {
     OpenRGBDevicePage * this_obj = (OpenRGBDevicePage *)this_ptr;
 
-    QMetaObject::invokeMethod(this_obj, "UpdateInterface", Qt::QueuedConnection);
+    this_obj->MarkDirty();
 }
 
 QString OpenRGBDevicePage::ModeDescription(const mode& m)
@@ -63,6 +65,14 @@ OpenRGBDevicePage::OpenRGBDevicePage(RGBController *dev, QWidget *parent) :
     \*-----------------------------------------------------*/
     device = dev;
 
+    /*-----------------------------------------------------*\
+    | Repaint through the refresh hub so that bursts of     |
+    | device updates cost at most one repaint per frame     |
+    \*-----------------------------------------------------*/
+    RefreshPending = false;
+
+    connect(OpenRGBRefreshHub::get(), &OpenRGBRefreshHub::Refresh, this, &OpenRGBDevicePage::OnRefresh);
+
     /*-----------------------------------------------------*\
     | Register update callback with the device              |
     \*-----------------------------------------------------*/
@@ -793,6 +803,44 @@ void OpenRGBDevicePage::UpdateInterface()
     ui->DeviceViewBox->repaint();
 }
 
+void OpenRGBDevicePage::MarkDirty()
+{
+    /*-----------------------------------------------------*\
+    | Device threads only flip the flag, the first update   |
+    | since the last repaint asks the hub for a frame       |
+    \*-----------------------------------------------------*/
+    if(!RefreshPending.exchange(true))
+    {
+        OpenRGBRefreshHub::get()->RequestRefresh();
+    }
+}
+
+void OpenRGBDevicePage::OnRefresh()
+{
+    /*-----------------------------------------------------*\
+    | Hidden pages stay dirty and repaint when shown        |
+    \*-----------------------------------------------------*/
+    if(!isVisible())
+    {
+        return;
+    }
+
+    if(RefreshPending.exchange(false))
+    {
+        UpdateInterface();
+    }
+}
+
+void OpenRGBDevicePage::showEvent(QShowEvent *event)
+{
+    QFrame::showEvent(event);
+
+    if(RefreshPending.exchange(false))
+    {
+        UpdateInterface();
+    }
+}
+
 void OpenRGBDevicePage::UpdateModeUi()
 {
     /*-----------------------------------------------------*\
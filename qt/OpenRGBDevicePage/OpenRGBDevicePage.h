@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <QFrame>
 #include "RGBController.h"
 
@@ -35,9 +36,18 @@ public:
     void ShowDeviceView();
     void HideDeviceView();
 
+    /*---------------------------------------------------------*\
+    | Called from the device update callback on any thread      |
+    \*---------------------------------------------------------*/
+    void MarkDirty();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private slots:
     void changeEvent(QEvent *event);
     void UpdateInterface();
+    void OnRefresh();
 
     void on_ColorWheelBox_colorChanged(const QColor color);
     void on_SwatchBox_swatchChanged(const QColor color);
@@ -79,6 +89,8 @@ private:
     bool UpdateHex          = true;
     bool HexFormatRGB       = true;
 
+    std::atomic<bool> RefreshPending;
+
     QColor current_color;
     void updateColorUi();
     void colorChanged();
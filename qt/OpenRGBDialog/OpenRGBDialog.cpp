@@ -14,6 +14,7 @@
 #include "OpenRGBDeviceInfoPage.h"
 #include "OpenRGBServerInfoPage.h"
 #include "OpenRGBConsolePage.h"
+#include "OpenRGBStatsPage.h"
 #include "OpenRGBPluginContainer.h"
 #include "OpenRGBProfileSaveDialog.h"
 #include "ResourceManager.h"
@@ -480,6 +481,11 @@ OpenRGBDialog::OpenRGBDialog(QWidget *parent) : QMainWindow(parent), ui(new Ui::
     \*-----------------------------------------------------*/
     AddSoftwareInfoPage();
 
+    /*-----------------------------------------------------*\
+    | Add the Statistics page                               |
+    \*-----------------------------------------------------*/
+    AddStatsPage();
+
     /*-----------------------------------------------------*\
     | Add the settings page                                 |
     \*-----------------------------------------------------*/
@@ -725,6 +731,23 @@ void OpenRGBDialog::AddSoftwareInfoPage()
     ui->InformationTabBar->tabBar()->setTabButton(ui->InformationTabBar->tabBar()->count() - 1, QTabBar::LeftSide, SoftwareTabLabel);
 }
 
+void OpenRGBDialog::AddStatsPage()
+{
+    /*-----------------------------------------------------*\
+    | Create the Statistics page                            |
+    \*-----------------------------------------------------*/
+    OpenRGBStatsPage* StatsPage = new OpenRGBStatsPage();
+
+    ui->InformationTabBar->addTab(StatsPage, "");
+
+    /*-----------------------------------------------------*\
+    | Create the tab label                                  |
+    \*-----------------------------------------------------*/
+    TabLabel* StatsTabLabel = new TabLabel(OpenRGBFont::data, tr("Statistics"), (char *)"Statistics", (char *)context);
+
+    ui->InformationTabBar->tabBar()->setTabButton(ui->InformationTabBar->tabBar()->count() - 1, QTabBar::LeftSide, StatsTabLabel);
+}
+
 void OpenRGBDialog::AddSupportedDevicesPage()
 {
     /*-----------------------------------------------------*\
@@ -117,6 +117,7 @@ private:
     void AddSettingsPage();
     void AddPluginsPage();
     void AddConsolePage();
+    void AddStatsPage();
     void AddManualDevicesSettingsPage();
 
     void ClearDevicesList();
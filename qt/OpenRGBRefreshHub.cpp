@@ -0,0 +1,89 @@
+/*---------------------------------------------------------*\
+| OpenRGBRefreshHub.cpp                                     |
+|                                                           |
+|   Coalesces device update notifications into at most one  |
+|   GUI refresh per display frame                           |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include "OpenRGBRefreshHub.h"
+
+/*---------------------------------------------------------*\
+| Refresh rate used when the screen does not report one     |
+\*---------------------------------------------------------*/
+#define OPENRGB_REFRESH_DEFAULT_HZ  60
+
+OpenRGBRefreshHub* OpenRGBRefreshHub::instance = nullptr;
+
+OpenRGBRefreshHub* OpenRGBRefreshHub::get()
+{
+    if(instance == nullptr)
+    {
+        instance = new OpenRGBRefreshHub(QCoreApplication::instance());
+    }
+
+    return(instance);
+}
+
+OpenRGBRefreshHub::OpenRGBRefreshHub(QObject *parent) : QObject(parent)
+{
+    scheduled = false;
+
+    timer.setSingleShot(true);
+    timer.setTimerType(Qt::PreciseTimer);
+
+    connect(&timer, &QTimer::timeout, this, &OpenRGBRefreshHub::OnTimeout);
+}
+
+void OpenRGBRefreshHub::RequestRefresh()
+{
+    /*-----------------------------------------------------*\
+    | Only the first request per frame posts to the GUI     |
+    | thread, later requests are absorbed by the pending    |
+    | frame                                                 |
+    \*-----------------------------------------------------*/
+    if(!scheduled.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, "StartTimer", Qt::QueuedConnection);
+    }
+}
+
+void OpenRGBRefreshHub::StartTimer()
+{
+    /*-----------------------------------------------------*\
+    | Pace refreshes to the display refresh rate, the       |
+    | screen may change while running so query each time    |
+    \*-----------------------------------------------------*/
+    qreal       refresh_hz  = OPENRGB_REFRESH_DEFAULT_HZ;
+    QScreen*    screen      = QGuiApplication::primaryScreen();
+
+    if((screen != nullptr) && (screen->refreshRate() >= 1.0))
+    {
+        refresh_hz = screen->refreshRate();
+    }
+
+    int interval_ms = (int)(1000.0 / refresh_hz);
+
+    if(interval_ms < 1)
+    {
+        interval_ms = 1;
+    }
+
+    timer.start(interval_ms);
+}
+
+void OpenRGBRefreshHub::OnTimeout()
+{
+    /*-----------------------------------------------------*\
+    | Clear before notifying so that updates arriving while |
+    | the pages repaint schedule the next frame             |
+    \*-----------------------------------------------------*/
+    scheduled = false;
+
+    emit Refresh();
+}
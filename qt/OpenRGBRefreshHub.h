@@ -0,0 +1,49 @@
+/*---------------------------------------------------------*\
+| OpenRGBRefreshHub.h                                       |
+|                                                           |
+|   Coalesces device update notifications into at most one  |
+|   GUI refresh per display frame                           |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <QObject>
+#include <QTimer>
+
+class OpenRGBRefreshHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*---------------------------------------------------------*\
+    | Must first be called from the GUI thread                  |
+    \*---------------------------------------------------------*/
+    static OpenRGBRefreshHub* get();
+
+    /*---------------------------------------------------------*\
+    | Thread safe.  Schedules a Refresh() signal for the next   |
+    | display frame if one is not already scheduled.  Callers   |
+    | should track their own dirty state and only request a     |
+    | refresh when it transitions from clean to dirty.          |
+    \*---------------------------------------------------------*/
+    void RequestRefresh();
+
+signals:
+    void Refresh();
+
+private slots:
+    void StartTimer();
+    void OnTimeout();
+
+private:
+    explicit OpenRGBRefreshHub(QObject *parent);
+
+    static OpenRGBRefreshHub*   instance;
+
+    QTimer                      timer;
+    std::atomic<bool>           scheduled;
+};
@@ -0,0 +1,151 @@
+/*---------------------------------------------------------*\
+| OpenRGBStatsPage.cpp                                      |
+|                                                           |
+|   User interface for OpenRGB device statistics page       |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#include "OpenRGBStatsPage.h"
+#include "ui_OpenRGBStatsPage.h"
+#include "ResourceManager.h"
+#include "RGBController.h"
+
+enum
+{
+    STATS_COLUMN_DEVICE,
+    STATS_COLUMN_REQUESTED,
+    STATS_COLUMN_WRITTEN,
+    STATS_COLUMN_COALESCED,
+    STATS_COLUMN_QUEUE_P50,
+    STATS_COLUMN_QUEUE_P99,
+    STATS_COLUMN_UPDATE_P50,
+    STATS_COLUMN_UPDATE_P99,
+    STATS_COLUMN_UPDATE_MAX,
+    STATS_COLUMN_JITTER_P99,
+    STATS_COLUMN_COMMIT_P99,
+    STATS_COLUMN_BYTES,
+    STATS_COLUMN_COUNT
+};
+
+OpenRGBStatsPage::OpenRGBStatsPage(QWidget *parent) :
+    QFrame(parent),
+    ui(new Ui::OpenRGBStatsPage)
+{
+    ui->setupUi(this);
+
+    ui->stats_table->setColumnCount(STATS_COLUMN_COUNT);
+    ui->stats_table->setHorizontalHeaderLabels(
+    {
+        tr("Device"),
+        tr("Requested"),
+        tr("Written"),
+        tr("Coalesced"),
+        tr("Queue p50 (us)"),
+        tr("Queue p99 (us)"),
+        tr("Update p50 (us)"),
+        tr("Update p99 (us)"),
+        tr("Update max (us)"),
+        tr("Jitter p99 (us)"),
+        tr("Commit p99 (us)"),
+        tr("Bytes")
+    });
+
+    /*-----------------------------------------------------*\
+    | Statistics are only polled while the page is shown   |
+    \*-----------------------------------------------------*/
+    refresh_timer = new QTimer(this);
+    connect(refresh_timer, SIGNAL(timeout()), this, SLOT(Refresh()));
+}
+
+OpenRGBStatsPage::~OpenRGBStatsPage()
+{
+    refresh_timer->stop();
+    delete ui;
+}
+
+void OpenRGBStatsPage::showEvent(QShowEvent *event)
+{
+    Refresh();
+    refresh_timer->start(1000);
+
+    QFrame::showEvent(event);
+}
+
+void OpenRGBStatsPage::hideEvent(QHideEvent *event)
+{
+    refresh_timer->stop();
+
+    QFrame::hideEvent(event);
+}
+
+void OpenRGBStatsPage::Refresh()
+{
+    std::vector<RGBController *>& controllers = ResourceManager::get()->GetRGBControllers();
+
+    ui->stats_table->setRowCount((int)controllers.size());
+
+    for(std::size_t controller_idx = 0; controller_idx < controllers.size(); controller_idx++)
+    {
+        rgb_controller_stats stats;
+
+        controllers[controller_idx]->GetStats(&stats);
+
+        unsigned long long total_bytes = 0;
+
+        for(unsigned int transport_idx = 0; transport_idx < RGBCONTROLLER_TRANSPORT_COUNT; transport_idx++)
+        {
+            total_bytes += stats.transport_bytes[transport_idx];
+        }
+
+        QStringList values =
+        {
+            QString::fromStdString(controllers[controller_idx]->name),
+            QString::number(stats.frames_requested),
+            QString::number(stats.frames_written),
+            QString::number(stats.frames_coalesced),
+            QString::number(stats_histogram_percentile(stats.queue_wait,  50.0)),
+            QString::number(stats_histogram_percentile(stats.queue_wait,  99.0)),
+            QString::number(stats_histogram_percentile(stats.update_time, 50.0)),
+            QString::number(stats_histogram_percentile(stats.update_time, 99.0)),
+            QString::number(stats.update_time.max_us),
+            QString::number(stats_histogram_percentile(stats.dispatch_jitter, 99.0)),
+            QString::number(stats_histogram_percentile(stats.commit_latency,  99.0)),
+            QString::number(total_bytes)
+        };
+
+        for(int column_idx = 0; column_idx < STATS_COLUMN_COUNT; column_idx++)
+        {
+            QTableWidgetItem* item = ui->stats_table->item((int)controller_idx, column_idx);
+
+            if(item == nullptr)
+            {
+                item = new QTableWidgetItem();
+                ui->stats_table->setItem((int)controller_idx, column_idx, item);
+            }
+
+            item->setText(values[column_idx]);
+        }
+    }
+}
+
+void OpenRGBStatsPage::on_reset_clicked()
+{
+    std::vector<RGBController *>& controllers = ResourceManager::get()->GetRGBControllers();
+
+    for(std::size_t controller_idx = 0; controller_idx < controllers.size(); controller_idx++)
+    {
+        controllers[controller_idx]->ResetStats();
+    }
+
+    Refresh();
+}
+
+void OpenRGBStatsPage::changeEvent(QEvent *event)
+{
+    if(event->type() == QEvent::LanguageChange)
+    {
+        ui->retranslateUi(this);
+    }
+}
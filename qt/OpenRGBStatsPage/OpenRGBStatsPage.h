@@ -0,0 +1,40 @@
+/*---------------------------------------------------------*\
+| OpenRGBStatsPage.h                                        |
+|                                                           |
+|   User interface for OpenRGB device statistics page       |
+|                                                           |
+|   This file is part of the OpenRGB project                |
+|   SPDX-License-Identifier: GPL-2.0-only                   |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QFrame>
+#include <QTimer>
+
+namespace Ui
+{
+    class OpenRGBStatsPage;
+}
+
+class OpenRGBStatsPage : public QFrame
+{
+    Q_OBJECT
+
+public:
+    explicit OpenRGBStatsPage(QWidget *parent = nullptr);
+    ~OpenRGBStatsPage();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void changeEvent(QEvent *event);
+    void on_reset_clicked();
+    void Refresh();
+
+private:
+    Ui::OpenRGBStatsPage*   ui;
+    QTimer*                 refresh_timer;
+};
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include "filesystem.h"
 #include "serial_port.h"
+#include "RGBControllerStats.h"
 
 #ifdef __APPLE__
 #include <regex>
@@ -680,6 +681,7 @@ int serial_port::serial_write(char * buffer, int length)
 #ifdef _WIN32
     DWORD byteswritten;
     WriteFile(file_descriptor, buffer, length, &byteswritten, NULL);
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_SERIAL, (int)byteswritten);
     return byteswritten;
 #endif
 
@@ -691,6 +693,7 @@ int serial_port::serial_write(char * buffer, int length)
     tcdrain(file_descriptor);
     byteswritten = write(file_descriptor, buffer, length);
     tcdrain(file_descriptor);
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_SERIAL, byteswritten);
     return byteswritten;
 #endif
 
@@ -703,6 +706,7 @@ int serial_port::serial_write(char * buffer, int length)
     printf("tcdrain %d\r\n",tcdrain(file_descriptor));
     printf("write %d\r\n", byteswritten = write(file_descriptor, buffer, length));
     printf("tcdrain %d\r\n", tcdrain(file_descriptor));
+    RGBControllerStats::RecordTransportWrite(RGBCONTROLLER_TRANSPORT_SERIAL, byteswritten);
     return byteswritten;
 #endif
 